@@ -90,32 +90,25 @@ static DeviceInfo kDevices[] = {
 };
 static constexpr size_t kDeviceCount = sizeof(kDevices) / sizeof(DeviceInfo);
 
-static String uptimeBuffer;
-static String clientCountBuffer;
-static String deviceCountBuffer;
-
 const char* getPageTitle() { return "DFTE Dashboard"; }
 const char* getTagline() { return "Rendered chunk-by-chunk from flash + dynamic data"; }
 
-const char* getDeviceCount() {
-  deviceCountBuffer = String(kDeviceCount);
-  return deviceCountBuffer.c_str();
-}
+// Numbers are formatted by the renderer or straight into the response chunk: no String buffers,
+// safe for concurrent requests
+static const uint32_t kDeviceTotal = kDeviceCount;
 
-const char* getUptime() {
-  uptimeBuffer = String(millis() / 1000) + "s";
-  return uptimeBuffer.c_str();
+int64_t readUptimeSeconds(void*) {
+  return millis() / 1000;
 }
 
-const char* getClientCount() {
-#if defined(ESP32)
-  clientCountBuffer = String(WiFi.softAPgetStationNum());
-#else
-  clientCountBuffer = String(WiFi.softAPgetStationNum());
-#endif
-  return clientCountBuffer.c_str();
+bool writeClientCount(PlaceholderWriter& out, void*) {
+  return out.printUnsigned(WiFi.softAPgetStationNum());
 }
 
+static const TypedValueDescriptor kDeviceCountValue = TypedValue::ofUint32(&kDeviceTotal);
+static const TypedValueDescriptor kUptimeValue = TypedValue::ofDuration(readUptimeSeconds);
+static const WriterDataDescriptor kClientCountWriter = {writeClientCount, nullptr};
+
 // ---------------------------------------------------------------------------
 // Iterator wiring for %DEVICE_ROWS%
 // ---------------------------------------------------------------------------
@@ -146,8 +139,7 @@ void initializeDeviceOverrides() {
 
     for (size_t field = 0; field < 4; ++field) {
       PlaceholderEntry& entry = gDeviceOverrides[i][field];
-      memset(entry.name, 0, sizeof(entry.name));
-      strncpy(entry.name, names[field], sizeof(entry.name) - 1);
+      entry.name = names[field];
       entry.type = PlaceholderType::PROGMEM_DATA;
       entry.data = values[field];
       entry.getLength = DeviceFrameworkPlaceholderRegistry::getProgmemLength;
@@ -205,9 +197,9 @@ void initialiseRegistry(PlaceholderRegistry& registryRef) {
   registryRef.registerRamData("%TAGLINE%", getTagline);
 
   // Overview metrics
-  registryRef.registerRamData("%CLIENT_COUNT%", getClientCount);
-  registryRef.registerRamData("%UPTIME%", getUptime);
-  registryRef.registerRamData("%DEVICE_COUNT%", getDeviceCount);
+  registryRef.registerWriter("%CLIENT_COUNT%", &kClientCountWriter);
+  registryRef.registerTypedValue("%UPTIME%", &kUptimeValue);
+  registryRef.registerTypedValue("%DEVICE_COUNT%", &kDeviceCountValue);
 
   // Iterator to populate the device table
   registryRef.registerIterator("%DEVICE_ROWS%", &gDeviceIterator);
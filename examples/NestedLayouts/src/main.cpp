@@ -70,15 +70,11 @@ inline const char PROGMEM MAINTENANCE_FALSE_TEMPLATE[] = R"HTML(
 )HTML";
 
 // RAM data
-static String bootCountBuffer;
 static uint32_t bootCount = 42;
 
 const char* getFirmwareVersion() { return "2.3.1"; }
 
-const char* getBootCount() {
-  bootCountBuffer = String(bootCount);
-  return bootCountBuffer.c_str();
-}
+const TypedValueDescriptor BOOT_COUNT_VALUE = TypedValue::ofUint32(&bootCount);
 
 // Conditional descriptor
 struct MaintenanceState {
@@ -109,19 +105,19 @@ void initialiseOverrides() {
     const SubsystemStatus& status = SUBSYSTEMS[i];
 
     PlaceholderEntry& name = subsystemOverrides[i][0];
-    strncpy(name.name, "%NAME%", sizeof(name.name) - 1);
+    name.name = "%NAME%";
     name.type = PlaceholderType::RAM_DATA;
     name.data = status.name;
     name.getLength = DeviceFrameworkPlaceholderRegistry::getRamLength;
 
     PlaceholderEntry& detail = subsystemOverrides[i][1];
-    strncpy(detail.name, "%DETAIL%", sizeof(detail.name) - 1);
+    detail.name = "%DETAIL%";
     detail.type = PlaceholderType::RAM_DATA;
     detail.data = status.detail;
     detail.getLength = DeviceFrameworkPlaceholderRegistry::getRamLength;
 
     PlaceholderEntry& severity = subsystemOverrides[i][2];
-    strncpy(severity.name, "%SEVERITY%", sizeof(severity.name) - 1);
+    severity.name = "%SEVERITY%";
     severity.type = PlaceholderType::RAM_DATA;
     severity.data = status.severityClass;
     severity.getLength = DeviceFrameworkPlaceholderRegistry::getRamLength;
@@ -167,7 +163,7 @@ std::shared_ptr<PlaceholderRegistry> buildRegistry() {
   registry->registerRamData("%PAGE_TITLE%", []() -> const char* { return "DFTE Nested Layouts"; });
   registry->registerRamData("%TAGLINE%", []() -> const char* { return "Composing templates with conditionals and iterators"; });
   registry->registerRamData("%FIRMWARE_VERSION%", getFirmwareVersion);
-  registry->registerRamData("%BOOT_COUNT%", getBootCount);
+  registry->registerTypedValue("%BOOT_COUNT%", &BOOT_COUNT_VALUE);
 
   registry->registerConditional("%MAINTENANCE_BANNER%", &MAINTENANCE_DESCRIPTOR);
   registry->registerProgmemTemplate("%MAINTENANCE_TRUE%", MAINTENANCE_TRUE_TEMPLATE);
@@ -46,29 +46,25 @@ inline const char PROGMEM PAGE_TEMPLATE[] = R"HTML(
       <h2>Device Snapshot</h2>
       <p><strong>Uptime:</strong> %UPTIME%</p>
       <p><strong>Connected Clients:</strong> %CLIENT_COUNT%</p>
+      <p><strong>Your Address:</strong> %CLIENT_IP%</p>
     </section>
     %FOOTER%
   </body>
 </html>
 )HTML";
 
-String uptimeBuffer;
-String clientBuffer;
-
-const char* getUptime() {
-  uptimeBuffer = String(millis() / 1000) + "s";
-  return uptimeBuffer.c_str();
+// Values are formatted by the renderer or written into the response chunk (no String buffers held in statics)
+int64_t readUptimeSeconds(void*) {
+  return millis() / 1000;
 }
 
-const char* getClientCount() {
-#if defined(ESP32)
-  clientBuffer = String(WiFi.softAPgetStationNum());
-#else
-  clientBuffer = String(WiFi.softAPgetStationNum());
-#endif
-  return clientBuffer.c_str();
+bool writeClientCount(PlaceholderWriter& out, void*) {
+  return out.printUnsigned(WiFi.softAPgetStationNum());
 }
 
+const TypedValueDescriptor uptimeValue = TypedValue::ofDuration(readUptimeSeconds);
+const WriterDataDescriptor clientCountWriter = {writeClientCount, nullptr};
+
 void initialiseRegistry(PlaceholderRegistry& registryRef) {
   registryRef.clear();
   registryRef.registerProgmemData("%CSS%", DFTEExamples::SHARED_CSS);
@@ -76,15 +72,26 @@ void initialiseRegistry(PlaceholderRegistry& registryRef) {
   registryRef.registerProgmemTemplate("%FOOTER%", DFTEExamples::SHARED_FOOTER);
   registryRef.registerRamData("%PAGE_TITLE%", []() -> const char* { return "DFTE Streaming Async"; });
   registryRef.registerRamData("%TAGLINE%", []() -> const char* { return "Chunked rendering with ESPAsyncWebServer"; });
-  registryRef.registerRamData("%UPTIME%", getUptime);
-  registryRef.registerRamData("%CLIENT_COUNT%", getClientCount);
+  registryRef.registerTypedValue("%UPTIME%", &uptimeValue);
+  registryRef.registerWriter("%CLIENT_COUNT%", &clientCountWriter);
 }
 
+// Per-request state: the overlay carries this client's values on top of the shared registry
+struct PortalRequest : TemplateContext {
+  explicit PortalRequest(PlaceholderRegistry* base) : overlay(base) {}
+
+  PlaceholderOverlay overlay;
+  char clientIp[16];
+};
+
 void streamTemplate(AsyncWebServerRequest* request,
                     std::shared_ptr<PlaceholderRegistry> registryPtr,
                     const char* tpl) {
-  auto ctx = std::make_shared<TemplateContext>();
-  ctx->setRegistry(registryPtr.get());
+  auto ctx = std::make_shared<PortalRequest>(registryPtr.get());
+  strncpy(ctx->clientIp, request->client()->remoteIP().toString().c_str(), sizeof(ctx->clientIp) - 1);
+  ctx->clientIp[sizeof(ctx->clientIp) - 1] = '\0';
+  ctx->overlay.registerString("%CLIENT_IP%", ctx->clientIp);
+  ctx->setRegistry(&ctx->overlay);
   TemplateRenderer::initializeContext(*ctx, tpl);
 
   AsyncWebServerResponse* response =
@@ -0,0 +1,129 @@
+#ifndef DEVICEFRAMEWORK_CACHED_VALUE_H
+#define DEVICEFRAMEWORK_CACHED_VALUE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkTaskMutex.h"
+
+#ifndef DFTE_CACHED_VALUE_CAPACITY_DEFAULT
+  #define DFTE_CACHED_VALUE_CAPACITY_DEFAULT 32
+#endif
+
+/**
+ * DeviceFramework Cached Value
+ * Time-to-live cache for an expensive placeholder getter, shared by every context that renders it
+ *
+ * The first render after the value expires calls the getter (a miss) and copies the result into the
+ * cache; renders within the TTL reuse the copy (hits). While one task runs the getter, other renders keep
+ * serving the expired value instead of waiting for it; only renders arriving before the very first value
+ * wait, on a DeviceFrameworkTaskMutex, for the one fill in flight. Call refreshIfDue() from loop() or a
+ * background task to recompute the value refreshAheadMs before it expires, so requests never pay the
+ * getter's latency.
+ *
+ * Values are double-buffered: the getter runs outside any lock a render takes, then a refresh writes the idle
+ * buffer and publishes it under a short lock. Renders never hold a buffer: the first get() of a render copies the
+ * value into its scratch arena (see DeviceFrameworkScratchArena.h) and every later get() of that render, in any
+ * iterator row, returns the same copy, so the render shows one value until it completes however often
+ * refresh(), invalidate() or expiry replace it meanwhile. Outside a render, when the arena is full, or for
+ * caches beyond DFTE_RENDER_CACHE_SLOTS_DEFAULT in one render, get() returns the buffer itself, which stays
+ * unchanged until the second refresh after the call.
+ *
+ * Usage:
+ *   DeviceFrameworkCachedValue stations(countStations, 2000, 500);   // 2 s TTL, refreshed 0.5 s early
+ *   registry.registerCachedData("%STATIONS%", &stations);
+ *   void loop() { stations.refreshIfDue(); }
+ */
+class DeviceFrameworkCachedValue {
+public:
+    /**
+     * @param getter Expensive getter (sensor read, scan); only called on refresh
+     * @param ttlMs How long a value is served before it must be recomputed
+     * @param refreshAheadMs How long before expiry refreshIfDue() recomputes (0 = only once expired);
+     *                       values not below ttlMs are clamped to half the TTL
+     * @param capacity Largest value kept, including the terminator (longer values are truncated)
+     */
+    DeviceFrameworkCachedValue(PlaceholderDataGetter getter, uint32_t ttlMs, uint32_t refreshAheadMs = 0,
+                               size_t capacity = DFTE_CACHED_VALUE_CAPACITY_DEFAULT);
+
+    /**
+     * Getter with user data (same contract as a DYNAMIC_DATA descriptor getter)
+     */
+    DeviceFrameworkCachedValue(DynamicTemplateGetter getter, void* userData, uint32_t ttlMs, uint32_t refreshAheadMs = 0,
+                               size_t capacity = DFTE_CACHED_VALUE_CAPACITY_DEFAULT);
+
+    ~DeviceFrameworkCachedValue();
+
+    // The descriptor handed to registries points at this object
+    DeviceFrameworkCachedValue(const DeviceFrameworkCachedValue&) = delete;
+    DeviceFrameworkCachedValue& operator=(const DeviceFrameworkCachedValue&) = delete;
+
+    /**
+     * Current value, refreshed first if it has expired and no other task is refreshing it (never nullptr;
+     * empty if the first value is still being computed and DFTE_TASK_MUTEX_BLOCKING is off)
+     * During a render: the render's one copy in its scratch arena, valid until the render completes
+     */
+    const char* get();
+
+    /**
+     * Recompute now, whatever the age of the current value
+     * @return false if the getter is missing or the buffers could not be allocated (or, without
+     *         DFTE_TASK_MUTEX_BLOCKING, another refresh is in flight)
+     */
+    bool refresh();
+
+    /**
+     * Recompute if the value is missing or within refreshAheadMs of expiring; call often from loop()
+     * @return true if the getter ran
+     */
+    bool refreshIfDue();
+
+    /**
+     * Expire the current value; the next get() or refreshIfDue() recomputes it
+     */
+    void invalidate();
+
+    /**
+     * DYNAMIC_DATA descriptor serving this cache (what registerCachedData() registers)
+     */
+    const DynamicDataDescriptor* getDescriptor() const { return &descriptor; }
+
+    uint32_t getTtl() const { return ttlMs; }
+
+    // get() calls served from the cache / that had to call the getter, and getter calls overall
+    uint32_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint32_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+    uint32_t getRefreshes() const { return refreshes.load(std::memory_order_relaxed); }
+    void resetStats();
+
+private:
+    static constexpr int8_t NO_VALUE = -1;
+
+    PlaceholderDataGetter ramGetter;
+    DynamicTemplateGetter dynamicGetter;
+    void* userData;
+    uint32_t ttlMs;
+    uint32_t refreshAheadMs;
+    size_t capacity;
+    char* buffers;                       // Two values of capacity bytes each
+    size_t lengths[2];
+    DynamicDataDescriptor descriptor;
+
+    std::atomic<int8_t> current;         // Buffer readers use, NO_VALUE before the first refresh
+    std::atomic<uint32_t> refreshedAt;   // millis() of the last refresh
+    std::atomic<uint32_t> invalidations; // invalidate() calls, so a getter already running publishes expired
+    DeviceFrameworkTaskMutex refreshing; // Held by the one caller running the getter
+    DeviceFrameworkTaskMutex buffersLock;// Held while a value is copied out of or published into the buffers
+    std::atomic<uint32_t> hits;
+    std::atomic<uint32_t> misses;
+    std::atomic<uint32_t> refreshes;
+
+    void allocate();
+    bool isDue(uint32_t now, uint32_t margin) const;
+    const char* serve();
+    bool refreshLocked();
+    static const char* getCachedValue(void* userData);
+    static size_t getCachedLength(const char* data, void* userData);
+};
+
+#endif // DEVICEFRAMEWORK_CACHED_VALUE_H
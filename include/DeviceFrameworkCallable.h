@@ -0,0 +1,119 @@
+#ifndef DEVICEFRAMEWORK_CALLABLE_H
+#define DEVICEFRAMEWORK_CALLABLE_H
+
+#include <Arduino.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Inline storage for captures: four pointers (16 bytes on ESP8266/ESP32), enough for an object plus a member pointer
+#ifndef DFTE_CALLABLE_STORAGE_DEFAULT
+  #define DFTE_CALLABLE_STORAGE_DEFAULT (4 * sizeof(void*))
+#endif
+
+template <typename Signature, size_t Capacity = DFTE_CALLABLE_STORAGE_DEFAULT>
+class DeviceFrameworkCallable;
+
+/**
+ * DeviceFramework Callable
+ * Capturing lambda or member-function binding behind the engine's (function pointer, void* userData) callbacks
+ *
+ * The captures live in fixed inline storage (no heap, unlike std::function) and the wrapper hands out a
+ * function pointer specialised for the stored callable plus itself as userData. Descriptors take the two
+ * like any other callback, so the render path makes the same single indirect call as with a plain function,
+ * and the callable's body is inlined into it. Per-instance state replaces the global statics handlers
+ * otherwise need, and two wrappers over one lambda type do not share anything.
+ *
+ * function() takes userData first (getters, evaluators, typed accessors, iterator open/next/close and
+ * producer read, whose handle is userData when there is no open hook); trailingFunction() takes it last
+ * (writer and data provider callbacks).
+ *
+ * The wrapper is what userData points at: it is neither copyable nor movable and must outlive the descriptor.
+ *
+ * Usage:
+ *   class Sensor {
+ *     DeviceFrameworkCallable<const char*()> label{[this] { return name; }};
+ *     DeviceFrameworkCallable<ConditionalBranchResult()> online{this, &Sensor::isOnline};
+ *     DynamicDataDescriptor labelData{label.function(), nullptr, label.context()};
+ *     ConditionalDescriptor onlineBranch{online.function(), "%ONLINE%", "%OFFLINE%", online.context()};
+ *   };
+ */
+template <typename R, typename... Args, size_t Capacity>
+class DeviceFrameworkCallable<R(Args...), Capacity> {
+public:
+    typedef R (*Function)(void* userData, Args... args);
+    typedef R (*TrailingFunction)(Args... args, void* userData);
+
+    static constexpr size_t CAPACITY = Capacity;
+
+    template <typename F, typename = typename std::enable_if<
+                              !std::is_same<typename std::decay<F>::type, DeviceFrameworkCallable>::value>::type>
+    DeviceFrameworkCallable(F&& callable) {
+        typedef typename std::decay<F>::type Stored;
+        static_assert(sizeof(Stored) <= Capacity,
+                      "Callable captures exceed the inline storage; capture less or raise the Capacity argument");
+        static_assert(alignof(Stored) <= alignof(Storage), "Callable captures need stricter alignment than the inline storage");
+        new (&storage) Stored(std::forward<F>(callable));
+        invoker = &invoke<Stored>;
+        trailingInvoker = &invokeTrailing<Stored>;
+        destroyer = std::is_trivially_destructible<Stored>::value ? nullptr : &destroy<Stored>;
+    }
+
+    // Member-function binding; a lambda capturing the object ([this] { ... }) inlines the call instead
+    template <typename T>
+    DeviceFrameworkCallable(T* object, R (T::*method)(Args...))
+        : DeviceFrameworkCallable(MemberBinding<T, R (T::*)(Args...)>{object, method}) {}
+
+    template <typename T>
+    DeviceFrameworkCallable(const T* object, R (T::*method)(Args...) const)
+        : DeviceFrameworkCallable(MemberBinding<const T, R (T::*)(Args...) const>{object, method}) {}
+
+    ~DeviceFrameworkCallable() {
+        if (destroyer) {
+            destroyer(&storage);
+        }
+    }
+
+    // Descriptors keep a pointer to the wrapper
+    DeviceFrameworkCallable(const DeviceFrameworkCallable&) = delete;
+    DeviceFrameworkCallable& operator=(const DeviceFrameworkCallable&) = delete;
+
+    R operator()(Args... args) { return invoker(this, std::forward<Args>(args)...); }
+
+    Function function() const { return invoker; }
+    TrailingFunction trailingFunction() const { return trailingInvoker; }
+    void* context() { return this; }
+
+private:
+    typedef typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type Storage;
+
+    template <typename T, typename Method>
+    struct MemberBinding {
+        T* object;
+        Method method;
+        R operator()(Args... args) const { return (object->*method)(std::forward<Args>(args)...); }
+    };
+
+    Storage storage;
+    Function invoker;
+    TrailingFunction trailingInvoker;
+    void (*destroyer)(void* storage);
+
+    template <typename Stored>
+    static R invoke(void* self, Args... args) {
+        return (*reinterpret_cast<Stored*>(&static_cast<DeviceFrameworkCallable*>(self)->storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Stored>
+    static R invokeTrailing(Args... args, void* self) {
+        return (*reinterpret_cast<Stored*>(&static_cast<DeviceFrameworkCallable*>(self)->storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Stored>
+    static void destroy(void* stored) {
+        reinterpret_cast<Stored*>(stored)->~Stored();
+    }
+};
+
+#endif // DEVICEFRAMEWORK_CALLABLE_H
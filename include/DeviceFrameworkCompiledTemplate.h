@@ -0,0 +1,43 @@
+#ifndef DEVICEFRAMEWORK_COMPILED_TEMPLATE_H
+#define DEVICEFRAMEWORK_COMPILED_TEMPLATE_H
+
+#include <Arduino.h>
+#include <pgmspace.h>
+#include "DeviceFrameworkTemplateTypes.h"
+
+/**
+ * DeviceFramework Compiled Templates
+ * Runtime support for emitters generated by tools/dfte_template_compiler.py
+ *
+ * Usage:
+ *   python tools/dfte_template_compiler.py data/templates src/generated/dfte_templates
+ *   #include "generated/dfte_templates.h"
+ *   DeviceFrameworkTemplateRenderer::initializeContext(ctx, dfte_tpl_index);
+ *   registry.registerCompiledTemplate("%STATUS%", &dfte_tpl_status);
+ *
+ * Generated code only calls the helpers below; it has no other dependency on engine internals.
+ */
+namespace dfte {
+
+/**
+ * Emit the rest of a PROGMEM literal run starting at cursor.offset
+ * @return true when the run is complete (cursor.offset is reset for the next run), false when buffer is full
+ */
+inline bool emitCompiledLiteral(CompiledTemplateCursor& cursor, const char* run, size_t runLength,
+                                uint8_t* buffer, size_t maxLen, size_t& written) {
+    size_t pending = runLength - cursor.offset;
+    size_t space = maxLen - written;
+    size_t count = pending < space ? pending : space;
+    memcpy_P(buffer + written, run + cursor.offset, count);
+    written += count;
+    if (count < pending) {
+        cursor.offset += count;
+        return false;
+    }
+    cursor.offset = 0;
+    return true;
+}
+
+} // namespace dfte
+
+#endif // DEVICEFRAMEWORK_COMPILED_TEMPLATE_H
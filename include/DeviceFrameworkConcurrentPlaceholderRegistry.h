@@ -0,0 +1,187 @@
+#ifndef DEVICEFRAMEWORK_CONCURRENT_PLACEHOLDER_REGISTRY_H
+#define DEVICEFRAMEWORK_CONCURRENT_PLACEHOLDER_REGISTRY_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkPlaceholderLookup.h"
+#include "DeviceFrameworkPlaceholderRegistry.h"
+
+#ifndef DFTE_RCU_READER_SLOTS_DEFAULT
+  #define DFTE_RCU_READER_SLOTS_DEFAULT 8
+#endif
+
+/**
+ * DeviceFramework Concurrent Placeholder Registry
+ * Read-copy-update registry for rendering on one task while registering on another
+ *
+ * Writers register into a private staging registry and publish an immutable snapshot (entries, name
+ * index and names in one allocation) with a single atomic pointer swap. Readers pin the current snapshot
+ * through a Reader, which is itself the lookup handed to a context: lookups are plain reads of the
+ * snapshot, and pinning/unpinning is one compare-and-swap on a reader slot, so readers never wait.
+ *
+ * Replaced snapshots are freed once no reader pinned before the swap is still active (epoch-based
+ * reclamation, DFTE_RCU_READER_SLOTS_DEFAULT concurrent readers). Writers serialize on a spin lock.
+ *
+ * Usage:
+ *   registry.update([](PlaceholderRegistry& staging) {   // several changes, one publish
+ *       staging.registerRamData("%TEMP%", getTemp);
+ *       return staging.registerRamData("%HUMIDITY%", getHumidity);
+ *   });
+ *
+ *   ConcurrentPlaceholderRegistry::Reader reader(registry);  // pins the current version
+ *   ctx.setRegistry(&reader);                                 // keep the reader alive for the whole render
+ *
+ * Snapshots have no plan cache, so PROGMEM templates rendered through a Reader are interpreted.
+ */
+class DeviceFrameworkConcurrentPlaceholderRegistry {
+private:
+    struct Snapshot;
+
+public:
+    static constexpr size_t READER_SLOTS = DFTE_RCU_READER_SLOTS_DEFAULT;
+    static_assert(READER_SLOTS > 0 && READER_SLOTS < 0xFF, "DFTE_RCU_READER_SLOTS_DEFAULT must be 1..254");
+
+    /**
+     * Pinned view of one published version (implements the lookup a context renders against)
+     * Entries stay valid until the reader is destroyed or refreshed, whatever writers do meanwhile.
+     */
+    class Reader : public DeviceFrameworkPlaceholderLookup {
+    public:
+        explicit Reader(const DeviceFrameworkConcurrentPlaceholderRegistry& registry);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * False when every reader slot was taken; lookups then find nothing
+         */
+        bool isPinned() const { return slot != NO_SLOT; }
+
+        /**
+         * Move to the latest published version (only between renders: earlier entries become invalid)
+         */
+        bool refresh();
+
+        /**
+         * Version of the pinned snapshot (0 when not pinned)
+         */
+        uint32_t getVersion() const;
+
+        const PlaceholderEntry* getPlaceholder(const char* name) const override;
+
+    private:
+        static constexpr uint8_t NO_SLOT = 0xFF;
+
+        const DeviceFrameworkConcurrentPlaceholderRegistry& registry;
+        const Snapshot* snapshot;
+        uint8_t slot;
+
+        void pin();
+        void unpin();
+    };
+
+    /**
+     * @param maxPlaceholders Most placeholders a published snapshot may hold (staging reserves twice this,
+     *        so one update can re-register every name)
+     */
+    explicit DeviceFrameworkConcurrentPlaceholderRegistry(uint16_t maxPlaceholders = DFTE_MAX_PLACEHOLDERS_DEFAULT);
+
+    /**
+     * No Reader may outlive the registry
+     */
+    ~DeviceFrameworkConcurrentPlaceholderRegistry();
+
+    DeviceFrameworkConcurrentPlaceholderRegistry(const DeviceFrameworkConcurrentPlaceholderRegistry&) = delete;
+    DeviceFrameworkConcurrentPlaceholderRegistry& operator=(const DeviceFrameworkConcurrentPlaceholderRegistry&) = delete;
+
+    /**
+     * Apply changes to the staging registry and publish them as one version
+     * @param change Callable taking DeviceFrameworkPlaceholderRegistry& and returning bool
+     * @return false if change returned false, the result exceeds maxPlaceholders or the snapshot could not be
+     *         allocated; the whole update is then rolled back and readers keep the current version
+     */
+    template <typename Change>
+    bool update(Change change) {
+        lockWriters();
+        bool ok = change(staging) && publishLocked();
+        if (!ok) {
+            rollbackLocked();
+        }
+        unlockWriters();
+        return ok;
+    }
+
+    // Single registrations, each published as its own version
+    bool registerProgmemData(const char* name, const char* progmemData);
+    bool registerProgmemTemplate(const char* name, const char* progmemTemplate);
+    bool registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize = false);
+    bool registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize = false);
+    bool registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize = false);
+    bool registerWriter(const char* name, const WriterDataDescriptor* descriptor);
+    bool registerTypedValue(const char* name, const TypedValueDescriptor* descriptor);
+    bool registerProducer(const char* name, const ProducerDescriptor* descriptor);
+    bool registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor);
+    bool registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor);
+    bool registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize = false);
+    bool registerIterator(const char* name, const IteratorDescriptor* descriptor);
+    bool registerStaticTemplate(const char* name, const StaticTemplate* staticTemplate);
+    bool registerCompiledTemplate(const char* name, const CompiledTemplate* compiledTemplate);
+    bool registerTokenizedTemplate(const char* name, const TokenizedTemplate* tokenizedTemplate);
+    bool registerCachedData(const char* name, DeviceFrameworkCachedValue* cache);
+    bool registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor);
+
+    /**
+     * Publish an empty version
+     */
+    void clear();
+
+    /**
+     * Version of the latest published snapshot (incremented on every publish)
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * Number of placeholders in the latest published snapshot
+     */
+    int getCount() const;
+
+    /**
+     * Replaced snapshots still waiting for readers to move on
+     */
+    size_t getRetiredCount() const;
+
+    /**
+     * Free replaced snapshots no reader can still see (publishing does this too)
+     */
+    void reclaim();
+
+    /**
+     * Heap bytes held by the staging registry, the published snapshot and retired snapshots
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    DeviceFrameworkPlaceholderRegistry staging;
+    std::atomic<const Snapshot*> current;
+    std::atomic<uint32_t> epoch;
+    mutable std::atomic<uint32_t> readerEpochs[READER_SLOTS];  // Epoch a reader pinned at, 0 = slot free
+    mutable std::atomic_flag writerLock;
+    Snapshot* retired;                                          // Writer-owned list of replaced snapshots
+    uint32_t version;
+    uint16_t maxPlaceholders;
+
+    void lockWriters() const;
+    void unlockWriters() const;
+    bool publishLocked();
+    void reclaimLocked();
+    void rollbackLocked();
+    Snapshot* buildSnapshot();
+    void compactStaging(const Snapshot* snapshot);
+    static void freeSnapshot(const Snapshot* snapshot);
+    static uint16_t stagingCapacity(uint16_t maxPlaceholders);
+    static uint32_t hashName(const char* name);
+};
+
+#endif // DEVICEFRAMEWORK_CONCURRENT_PLACEHOLDER_REGISTRY_H
@@ -0,0 +1,127 @@
+#ifndef DEVICEFRAMEWORK_DATA_PROVIDER_H
+#define DEVICEFRAMEWORK_DATA_PROVIDER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+#include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkTaskMutex.h"
+
+class DeviceFrameworkTemplateContext;
+
+/**
+ * DeviceFramework Data Provider
+ * One sample callback shared by several PROVIDER_FIELD placeholders
+ *
+ * The callback fills a caller-owned struct (voltage, current, power and temperature from one sensor read);
+ * each placeholder binds a field of that struct as a typed value. The first field a render reaches samples if
+ * the current sample is due, then copies the struct into the render's scratch arena; the render's other
+ * fields are formatted from that copy, so every field of a page comes from the same sample even when the TTL
+ * runs out mid-render or another task calls refresh() or refreshIfDue(). Without a TTL each render samples
+ * once; with one the sample is also shared across renders and contexts until it is ttlMs old, and
+ * refreshIfDue() from loop() takes samples before they expire.
+ *
+ * The callback fills a private staging copy of the struct, outside any lock a render takes, and a successful
+ * sample is then published into the struct under a short lock. A render finding the sample due while another
+ * task is taking the next one renders the current sample instead of waiting; only renders arriving before
+ * the first sample wait, on a DeviceFrameworkTaskMutex, for the callback in flight.
+ *
+ * When the arena is full the render's later fields read the live struct (without sampling again), and
+ * providers beyond DFTE_RENDER_PROVIDER_SLOTS_DEFAULT in one render are read field by field.
+ *
+ * Usage:
+ *   struct PowerSample { float voltage; float current; int32_t temperature; };
+ *   static PowerSample power;
+ *   bool readPower(void* sample, void*) { return ina219.read(*static_cast<PowerSample*>(sample)); }
+ *   static DataProvider powerProvider(readPower, &power, 1000);   // one read per second at most
+ *   static const ProviderFieldDescriptor kVoltage = {&powerProvider, TypedValue::ofFixed(&power.voltage, 2)};
+ *   registry.registerProviderField("%VOLTAGE%", &kVoltage);
+ */
+class DeviceFrameworkDataProvider {
+public:
+    /**
+     * @param fill Fills the struct it is given, a copy of `sample` holding the previous values (return false if
+     *             the read failed; the published sample is then left unchanged)
+     * @param sample Struct the fields point into (must outlive the provider; copied per render, so plain data)
+     * @param ttlMs How long a sample is reused across renders (0 = once per render)
+     * @param refreshAheadMs How long before expiry refreshIfDue() samples (TTL only)
+     */
+    template <typename Sample>
+    DeviceFrameworkDataProvider(DataProviderCallback fill, Sample* sample, uint32_t ttlMs = 0, uint32_t refreshAheadMs = 0,
+                                void* userData = nullptr)
+        : DeviceFrameworkDataProvider(fill, static_cast<void*>(sample), sizeof(Sample), ttlMs, refreshAheadMs, userData) {
+        static_assert(!std::is_void<Sample>::value, "Pass the sample size for an untyped sample");
+    }
+
+    /**
+     * Untyped sample of sampleSize bytes
+     */
+    DeviceFrameworkDataProvider(DataProviderCallback fill, void* sample, size_t sampleSize, uint32_t ttlMs,
+                                uint32_t refreshAheadMs, void* userData);
+
+    ~DeviceFrameworkDataProvider();
+
+    // Field descriptors point at this object
+    DeviceFrameworkDataProvider(const DeviceFrameworkDataProvider&) = delete;
+    DeviceFrameworkDataProvider& operator=(const DeviceFrameworkDataProvider&) = delete;
+
+    /**
+     * Check a field descriptor before it is registered (a provider and a valid typed value inside its sample)
+     */
+    static bool isValidField(const ProviderFieldDescriptor* descriptor);
+
+    /**
+     * Format `field` (see DeviceFrameworkTypedValue::format) from the sample this render read first,
+     * sampling if due when the render has none yet
+     * @param ctx Context being rendered; nullptr for callers outside a render (samples if due, reads live)
+     */
+    PlaceholderValue format(const TypedValueDescriptor& field, char* text, DeviceFrameworkTemplateContext* ctx);
+
+    /**
+     * Sample now, whatever the age of the current one
+     * @return false if the callback failed (or, without DFTE_TASK_MUTEX_BLOCKING, another sample is in flight)
+     */
+    bool refresh();
+
+    /**
+     * Sample if there is none yet or it is within refreshAheadMs of expiring; call often from loop()
+     * @return true if the callback ran and succeeded (always false without a TTL)
+     */
+    bool refreshIfDue();
+
+    /**
+     * Drop the current sample; the next field rendered samples again
+     */
+    void invalidate();
+
+    uint32_t getTtl() const { return ttlMs; }
+
+    // Fields served from an existing sample / callback runs (failed ones included)
+    uint32_t getHits() const { return hits.load(std::memory_order_relaxed); }
+    uint32_t getSamples() const { return samples.load(std::memory_order_relaxed); }
+    void resetStats();
+
+private:
+    DataProviderCallback fill;
+    void* sample;
+    size_t sampleSize;
+    void* userData;
+    uint32_t ttlMs;
+    uint32_t refreshAheadMs;
+    uint8_t* staging;                      // What the callback fills before it is published into sample
+
+    std::atomic<uint32_t> sampledAt;       // millis() of the last successful sample
+    std::atomic<bool> valid;               // A sample succeeded and has not been invalidated
+    std::atomic<uint32_t> invalidations;   // invalidate() calls, so a callback already running publishes invalid
+    DeviceFrameworkTaskMutex sampling;     // Held by the one caller running the callback
+    DeviceFrameworkTaskMutex busy;         // Held while the struct is published, copied or read
+    std::atomic<uint32_t> hits;
+    std::atomic<uint32_t> samples;
+
+    bool isDue(uint32_t now, uint32_t margin) const;
+    bool sampleLocked();
+    bool contains(const void* address) const;
+    PlaceholderValue formatFrom(const TypedValueDescriptor& field, const void* copy, char* text) const;
+};
+
+#endif // DEVICEFRAMEWORK_DATA_PROVIDER_H
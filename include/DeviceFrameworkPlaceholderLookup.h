@@ -0,0 +1,53 @@
+#ifndef DEVICEFRAMEWORK_PLACEHOLDER_LOOKUP_H
+#define DEVICEFRAMEWORK_PLACEHOLDER_LOOKUP_H
+
+#include <Arduino.h>
+#include "DeviceFrameworkTemplateTypes.h"
+
+/**
+ * DeviceFramework Placeholder Lookup
+ * What the renderer needs from a registry: name and token resolution, plus an optional plan cache
+ *
+ * DeviceFrameworkPlaceholderRegistry (runtime registration, RAM) and DeviceFrameworkStaticPlaceholderRegistry
+ * (DFTE_STATIC_REGISTRY, flash) both implement it, so either can be passed to
+ * DeviceFrameworkTemplateContext::setRegistry().
+ */
+class DeviceFrameworkPlaceholderLookup {
+public:
+    /**
+     * Find placeholder entry by name
+     * @return PlaceholderEntry pointer (valid while the lookup is unchanged) or nullptr if not found
+     */
+    virtual const PlaceholderEntry* getPlaceholder(const char* name) const = 0;
+
+    /**
+     * Find placeholder entry by token id (tokenized and compiled templates)
+     * Default: copy the name out of the PROGMEM table and call getPlaceholder()
+     */
+    virtual const PlaceholderEntry* getPlaceholderByToken(const TokenTable* table, uint32_t id) const;
+
+    /**
+     * Get a pinned compiled plan for a PROGMEM template (see DeviceFrameworkPlaceholderRegistry::acquirePlan)
+     * Default: no plan cache, the renderer interprets the template
+     */
+    virtual const TemplatePlan* acquirePlan(const char* progmemTemplate, size_t templateLen, const StaticTemplate* compiled = nullptr) {
+        (void)progmemTemplate;
+        (void)templateLen;
+        (void)compiled;
+        return nullptr;
+    }
+
+    /**
+     * Check that a plan was built by this lookup and is still valid
+     */
+    virtual bool isPlanCurrent(const TemplatePlan* plan) const {
+        (void)plan;
+        return false;
+    }
+
+protected:
+    // Not deletable through the interface; keeps implementations constant-initializable
+    ~DeviceFrameworkPlaceholderLookup() = default;
+};
+
+#endif // DEVICEFRAMEWORK_PLACEHOLDER_LOOKUP_H
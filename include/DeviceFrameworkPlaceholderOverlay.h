@@ -0,0 +1,116 @@
+#ifndef DEVICEFRAMEWORK_PLACEHOLDER_OVERLAY_H
+#define DEVICEFRAMEWORK_PLACEHOLDER_OVERLAY_H
+
+#include <Arduino.h>
+#include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkPlaceholderLookup.h"
+
+#ifndef DFTE_OVERLAY_CAPACITY_DEFAULT
+  #define DFTE_OVERLAY_CAPACITY_DEFAULT 8
+#endif
+
+/**
+ * DeviceFramework Placeholder Overlay
+ * Request-scoped bindings layered over a shared registry
+ *
+ * Lookups check the overlay's own bindings first and fall through to the base, so each render can carry
+ * its own values (query parameters, the signed-in user, a selected device) without touching the shared
+ * registry. Storage is a fixed array inside the object: no heap, and names are not copied, so they and
+ * any bound values must outlive the renders that use them.
+ *
+ * Usage (one overlay per context, the base is shared):
+ *   DeviceFrameworkPlaceholderOverlay overlay(&sharedRegistry);
+ *   overlay.registerString("%USER%", userName);
+ *   ctx.setRegistry(&overlay);
+ *
+ * Templates keep their cached plans while no binding shadows a base name; shadowing renders are interpreted.
+ */
+class DeviceFrameworkPlaceholderOverlay : public DeviceFrameworkPlaceholderLookup {
+public:
+    static constexpr uint8_t CAPACITY = DFTE_OVERLAY_CAPACITY_DEFAULT;
+
+    /**
+     * @param base Lookup consulted for names the overlay does not bind (may be nullptr)
+     */
+    explicit DeviceFrameworkPlaceholderOverlay(DeviceFrameworkPlaceholderLookup* base = nullptr);
+
+    // Entries point at the per-slot string descriptors, so the overlay cannot move
+    DeviceFrameworkPlaceholderOverlay(const DeviceFrameworkPlaceholderOverlay&) = delete;
+    DeviceFrameworkPlaceholderOverlay& operator=(const DeviceFrameworkPlaceholderOverlay&) = delete;
+
+    /**
+     * Replace the base lookup (bindings are kept)
+     */
+    void setBase(DeviceFrameworkPlaceholderLookup* lookup);
+    DeviceFrameworkPlaceholderLookup* getBase() const { return base; }
+
+    /**
+     * Bind a RAM string to a placeholder for this overlay only
+     * @param name Placeholder name (e.g., "%USER%"); must outlive the overlay's use
+     * @param value NUL-terminated value rendered as raw bytes; must stay valid while templates render
+     * @return true if bound, false if the overlay is full or the arguments are invalid
+     * Binding a name again replaces its previous binding
+     */
+    bool registerString(const char* name, const char* value);
+
+    bool registerProgmemData(const char* name, const char* progmemData);
+    bool registerProgmemTemplate(const char* name, const char* progmemTemplate);
+    bool registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize = false);
+    bool registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize = false);
+    bool registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize = false);
+    bool registerWriter(const char* name, const WriterDataDescriptor* descriptor);
+    bool registerTypedValue(const char* name, const TypedValueDescriptor* descriptor);
+    bool registerProducer(const char* name, const ProducerDescriptor* descriptor);
+    bool registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor);
+    bool registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor);
+    bool registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor);
+    bool registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize = false);
+    bool registerIterator(const char* name, const IteratorDescriptor* descriptor);
+
+    /**
+     * Drop all bindings (the base is kept)
+     */
+    void clear();
+
+    /**
+     * Get number of bindings
+     */
+    int getCount() const { return count; }
+
+    /**
+     * Find placeholder entry by name: overlay bindings first, then the base
+     */
+    const PlaceholderEntry* getPlaceholder(const char* name) const override;
+
+    /**
+     * Find placeholder entry by token id
+     * With no bindings this is the base's token lookup (including its id index)
+     */
+    const PlaceholderEntry* getPlaceholderByToken(const TokenTable* table, uint32_t id) const override;
+
+    /**
+     * Forward to the base plan cache unless a binding shadows a base name
+     * (plans resolve placeholders against the base when they are built)
+     */
+    const TemplatePlan* acquirePlan(const char* progmemTemplate, size_t templateLen, const StaticTemplate* compiled = nullptr) override;
+    bool isPlanCurrent(const TemplatePlan* plan) const override {
+        return !shadowsBase && base != nullptr && base->isPlanCurrent(plan);
+    }
+
+private:
+    DeviceFrameworkPlaceholderLookup* base;
+    PlaceholderEntry entries[CAPACITY];
+    DynamicDataDescriptor strings[CAPACITY];  // Backing descriptors for registerString()
+    uint8_t count;
+    bool shadowsBase;                         // Some binding hides a base entry, so base plans are wrong here
+
+    PlaceholderEntry* bind(const char* name);
+    bool addEntry(const char* name, PlaceholderType type, const void* data, bool valid, const char* kind,
+                  bool memoize = false, PlaceholderLengthGetter getLength = nullptr);
+    const PlaceholderEntry* findEntry(const char* name, uint32_t hash) const;
+    bool refreshShadowing();
+    static uint32_t hashName(const char* name);
+    static const char* getStringValue(void* userData);
+};
+
+#endif // DEVICEFRAMEWORK_PLACEHOLDER_OVERLAY_H
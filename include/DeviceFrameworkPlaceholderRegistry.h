@@ -3,7 +3,11 @@
 
 #include <Arduino.h>
 #include <stdio.h>
+#include <atomic>
 #include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkPlaceholderLookup.h"
+
+class DeviceFrameworkCachedValue;
 
 // Fallback defaults when DeviceFrameworkConfig is not available (standalone usage)
 // Always use internal macro names (DFTE_*) to avoid conflicts with DeviceFrameworkConfig extern declarations
@@ -26,6 +30,18 @@
   #define DFTE_RAM_CHUNK_SIZE_DEFAULT 128
 #endif
 
+#ifndef DFTE_PLAN_CACHE_SIZE_DEFAULT
+  #define DFTE_PLAN_CACHE_SIZE_DEFAULT 8
+#endif
+
+#ifndef DFTE_PLAN_MAX_SEGMENTS_DEFAULT
+  #define DFTE_PLAN_MAX_SEGMENTS_DEFAULT 256
+#endif
+
+#ifndef DFTE_TOKEN_BINDING_SLOTS_DEFAULT
+  #define DFTE_TOKEN_BINDING_SLOTS_DEFAULT 4
+#endif
+
 // Use DeviceFramework config defaults at compile-time if available, otherwise use internal defaults
 #ifdef DEVICEFRAMEWORK_CONFIG_H
   // DeviceFramework is present - use config defaults
@@ -40,18 +56,25 @@
   #else
     #define DFTE_RAM_CHUNK_SIZE DFTE_RAM_CHUNK_SIZE_DEFAULT
   #endif
+  #ifdef CONFIG_templatePlanCacheSize_default
+    #define DFTE_PLAN_CACHE_SIZE CONFIG_templatePlanCacheSize_default
+  #else
+    #define DFTE_PLAN_CACHE_SIZE DFTE_PLAN_CACHE_SIZE_DEFAULT
+  #endif
 #else
   // Standalone usage - use internal defaults
   #define DFTE_PROGMEM_CHUNK_SIZE DFTE_PROGMEM_CHUNK_SIZE_DEFAULT
   #define DFTE_RAM_CHUNK_SIZE DFTE_RAM_CHUNK_SIZE_DEFAULT
+  #define DFTE_PLAN_CACHE_SIZE DFTE_PLAN_CACHE_SIZE_DEFAULT
 #endif
 
 /**
  * DeviceFramework Placeholder Registry
  * Manages runtime registration of template placeholders
  * Registry starts empty - users must register their placeholders
+ * For placeholders fixed at build time see DFTE_STATIC_REGISTRY (DeviceFrameworkStaticPlaceholderRegistry.h)
  */
-class DeviceFrameworkPlaceholderRegistry {
+class DeviceFrameworkPlaceholderRegistry : public DeviceFrameworkPlaceholderLookup {
 public:
     /**
      * Constructor with optional max placeholders parameter
@@ -61,7 +84,7 @@ public:
      */
     explicit DeviceFrameworkPlaceholderRegistry(uint16_t maxPlaceholders = DFTE_MAX_PLACEHOLDERS_DEFAULT);
     
-    ~DeviceFrameworkPlaceholderRegistry();
+    virtual ~DeviceFrameworkPlaceholderRegistry();
     
     // Prevent copying
     DeviceFrameworkPlaceholderRegistry(const DeviceFrameworkPlaceholderRegistry&) = delete;
@@ -87,13 +110,123 @@ public:
      * Register a RAM data placeholder with getter function
      * @param name Placeholder name (e.g., "%PAGE_TITLE%")
      * @param getter Function that returns current value
+     * @param memoize Call the getter once per render and reuse the value for every occurrence of the token
+     *        (later occurrences read a copy in the render's scratch arena; a value that does not fit is
+     *        fetched per occurrence instead)
      * @return true if registered successfully
      */
-    bool registerRamData(const char* name, PlaceholderDataGetter getter);
-    bool registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor);
+    bool registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize = false);
+    bool registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize = false);
     bool registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor);
-    bool registerConditional(const char* name, const ConditionalDescriptor* descriptor);
+
+    /**
+     * Register a RAM data placeholder whose getter returns pointer and length
+     * The value is written byte for byte (binary and embedded NULs are fine) and never measured with strlen
+     * @param name Placeholder name (e.g., "%LOG_DUMP%")
+     * @param descriptor Getter plus userData (must outlive the registry)
+     * @param memoize Call the getter once per render (see registerRamData)
+     * @return true if registered successfully
+     */
+    bool registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize = false);
+
+    /**
+     * Register a placeholder whose callback formats the value straight into the output chunk
+     * No getter buffer is involved: numbers and short strings need no String or static storage, and the
+     * callback may be shared by concurrent renders (see DeviceFrameworkPlaceholderWriter)
+     * @param name Placeholder name (e.g., "%UPTIME%")
+     * @param descriptor Callback plus userData (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerWriter(const char* name, const WriterDataDescriptor* descriptor);
+
+    /**
+     * Register a number, bool, IPv4 address or duration formatted by the renderer
+     * The variable or accessor is read when the token is reached and formatted into the render frame,
+     * with no getter buffer or String (build descriptors with DeviceFrameworkTypedValue::of*)
+     * @param name Placeholder name (e.g., "%RSSI%")
+     * @param descriptor Value source and kind (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerTypedValue(const char* name, const TypedValueDescriptor* descriptor);
+
+    /**
+     * Register a placeholder whose content is pulled in chunk-sized pieces (logs, JSON dumps, scan results)
+     * The renderer calls read with the running offset until it returns 0, straight into the chunk buffer,
+     * so content of any size renders with no RAM copy of the value. open/close bracket each occurrence.
+     * @param name Placeholder name (e.g., "%EVENT_LOG%")
+     * @param descriptor Callbacks plus userData (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerProducer(const char* name, const ProducerDescriptor* descriptor);
+
+    /**
+     * Register a circular RAM buffer (e.g. an event log) rendered oldest byte first
+     * The indices are read once per occurrence and the two contiguous segments are copied straight from
+     * the ring into the output, so the log is never linearized into a temporary string.
+     * @param name Placeholder name (e.g., "%EVENT_LOG%")
+     * @param descriptor Storage and index pointers (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor);
+
+    /**
+     * @param memoize Evaluate once per render and take the same branch at every occurrence (iterator rows included)
+     */
+    bool registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize = false);
     bool registerIterator(const char* name, const IteratorDescriptor* descriptor);
+
+    /**
+     * Register a nested template compiled with DFTE_TEMPLATE
+     * @param name Placeholder name (e.g., "%LAYOUT%")
+     * @param staticTemplate Static template descriptor (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerStaticTemplate(const char* name, const StaticTemplate* staticTemplate);
+
+    /**
+     * Register a nested template generated by tools/dfte_template_compiler.py
+     * @param name Placeholder name (e.g., "%STATUS_PAGE%")
+     * @param compiledTemplate Generated template descriptor (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerCompiledTemplate(const char* name, const CompiledTemplate* compiledTemplate);
+
+    /**
+     * Register a nested template in the tokenized format (tools/dfte_template_compiler.py --format tokenized)
+     * Its token table is bound as well (see bindTokenTable)
+     * @param name Placeholder name (e.g., "%HEADER%")
+     * @param tokenizedTemplate Encoded template descriptor (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerTokenizedTemplate(const char* name, const TokenizedTemplate* tokenizedTemplate);
+
+    /**
+     * Index a token table: resolve every name once into an id -> entry table
+     * Later registrations and clear() keep the index current, so renders only read it. Tables of registered
+     * tokenized and compiled templates are bound automatically; bind the table of a tokenized or compiled
+     * template rendered as the root (initializeContext) yourself. Tables that are not bound, or that arrive
+     * once all DFTE_TOKEN_BINDING_SLOTS_DEFAULT slots are used, fall back to a name lookup per token.
+     * Like registrations, must not run while a context renders from this registry.
+     * @return true if the table is indexed
+     */
+    bool bindTokenTable(const TokenTable* table);
+
+    /**
+     * Register a value served from a TTL cache shared by every context (see DeviceFrameworkCachedValue.h)
+     * @param name Placeholder name (e.g., "%STATIONS%")
+     * @param cache Cache wrapping the expensive getter (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerCachedData(const char* name, DeviceFrameworkCachedValue* cache);
+
+    /**
+     * Register a field of a grouped provider's sample (see DeviceFrameworkDataProvider)
+     * Every field of one provider shares a single sample per render, or per TTL
+     * @param name Placeholder name (e.g., "%VOLTAGE%")
+     * @param descriptor Provider plus the typed field (must outlive the registry)
+     * @return true if registered successfully
+     */
+    bool registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor);
     
     /**
      * Clear all registered placeholders
@@ -109,39 +242,151 @@ public:
      * Get maximum number of placeholders
      */
     uint16_t getMaxPlaceholders() const { return maxPlaceholders; }
+
+    /**
+     * Heap bytes held for entries, the name index and interned names (plan cache and token tables excluded)
+     */
+    size_t getMemoryUsage() const;
     
     /**
-     * Find placeholder entry by name
+     * Find placeholder entry by name (hash index, O(1) for hits and misses)
+     * When a name was registered more than once the latest registration is returned
      * @return PlaceholderEntry pointer or nullptr if not found
      */
-    const PlaceholderEntry* getPlaceholder(const char* name) const;
+    const PlaceholderEntry* getPlaceholder(const char* name) const override;
+
+    /**
+     * Find placeholder entry by token id (tokenized and compiled templates)
+     * A single index for bound tables (see bindTokenTable), a name lookup otherwise; read-only, so any
+     * number of contexts may call it at once
+     * @return PlaceholderEntry pointer or nullptr if the token is not registered
+     */
+    const PlaceholderEntry* getPlaceholderByToken(const TokenTable* table, uint32_t id) const override;
     
     /**
      * Render placeholder content at given offset
+     * Only reads the entry, so it serves entries from any DeviceFrameworkPlaceholderLookup
      */
-    size_t renderPlaceholder(const PlaceholderEntry* entry, size_t offset, 
-                            uint8_t* buffer, size_t maxLen) const;
+    static size_t renderPlaceholder(const PlaceholderEntry* entry, size_t offset, 
+                                    uint8_t* buffer, size_t maxLen);
     
+    /**
+     * Get the compiled plan for a PROGMEM template, building and caching it on first use
+     * The plan is pinned for the caller; hand it back with releasePlan() when done
+     * Any registration or clear() bumps the generation, so later lookups rebuild against the new entries
+     * Safe from concurrent renders on several tasks (the cache is behind a short lock; plans are built outside it),
+     * though registrations must not run while those renders are in flight (see ConcurrentPlaceholderRegistry)
+     * @param progmemTemplate Pointer to PROGMEM template (cache key)
+     * @param templateLen Template length in bytes
+     * @param compiled Compile-time segment table for this template (skips the scan), or nullptr
+     * @return Pinned plan, or nullptr when the template should be interpreted
+     */
+    const TemplatePlan* acquirePlan(const char* progmemTemplate, size_t templateLen, const StaticTemplate* compiled = nullptr) override;
+
+    /**
+     * Unpin a plan returned by acquirePlan (frees it if the cache has already evicted it)
+     */
+    static void releasePlan(const TemplatePlan* plan);
+
+    /**
+     * Check that a plan was built by this registry and no placeholder changed since
+     */
+    bool isPlanCurrent(const TemplatePlan* plan) const override {
+        return plan != nullptr && plan->owner == this && plan->generation == generation;
+    }
+
+    /**
+     * FNV-1a hash of a placeholder name, as stored in PlaceholderEntry::nameHash
+     * Every lookup (overlays, static and concurrent registries, iterator scopes) hashes names with this
+     */
+    static uint32_t hashName(const char* name);
+
+    /**
+     * Registration generation (incremented on every registration and clear)
+     */
+    uint32_t getGeneration() const { return generation; }
+
     // Static helper functions for length calculation
     static size_t getProgmemLength(const void* data);
     static size_t getRamLength(const void* data);
     static size_t getDynamicDataLength(const DynamicDataDescriptor* descriptor, const char* data);
     static size_t getDynamicTemplateLength(const DynamicTemplateDescriptor* descriptor, const char* templateData);
+    static size_t getStaticTemplateLength(const void* data);
+    static size_t getTokenizedTemplateLength(const void* data);
+
+    /**
+     * Read a ring's indices and split its contents into two segments (both empty for an invalid ring)
+     */
+    static RingBufferSnapshot snapshotRing(const RingBufferDescriptor* descriptor);
+    static bool isValidRing(const RingBufferDescriptor* descriptor);
     
 private:
+    // Builds immutable snapshots from a staging registry
+    friend class DeviceFrameworkConcurrentPlaceholderRegistry;
+
     static constexpr uint16_t MAX_PLACEHOLDER_NAME_SIZE = DFTE_PLACEHOLDER_NAME_SIZE;
+    static constexpr size_t PLAN_CACHE_SIZE = DFTE_PLAN_CACHE_SIZE;
+    static constexpr size_t PLAN_MAX_SEGMENTS = DFTE_PLAN_MAX_SEGMENTS_DEFAULT;
+    static constexpr size_t TOKEN_BINDING_SLOTS = DFTE_TOKEN_BINDING_SLOTS_DEFAULT;
+    static constexpr size_t NAME_POOL_BLOCK_SIZE = 128;
+    static constexpr uint8_t RING_SNAPSHOT_RETRIES = 3;
+    static constexpr size_t NAME_POOL_HEADER = sizeof(char*);
     
     PlaceholderEntry* placeholders;  // Dynamically allocated array
     uint16_t maxPlaceholders;        // Configurable size
     int count;
+    uint32_t generation;             // Bumped on every change so cached plans go stale
+
+    // Open-addressing hash index over entry names: slot holds entry index + 1, 0 = empty
+    uint16_t* nameIndex;
+    uint32_t nameIndexMask;          // Slot count - 1 (power of two, at least 2x maxPlaceholders)
+
+    // Interned names: each distinct name is copied once, entries point into the pool
+    char* namePool;                  // Newest block; its first NAME_POOL_HEADER bytes link to the previous block
+    size_t namePoolUsed;
+    size_t namePoolSize;
+    size_t namePoolBytes;            // All blocks
+
+    // Compiled plans keyed by template pointer (+1 keeps the array legal when the cache is disabled)
+    TemplatePlan* planCache[PLAN_CACHE_SIZE + 1];
+    size_t planCacheNext;            // Round-robin eviction cursor
+    std::atomic_flag planLock;       // Held while planCache or planCacheNext is read or changed
+
+    // Token id -> entry per bound token table (+1 as for planCache); only registrations and clear() write them
+    struct TokenBinding {
+        const TokenTable* table;
+        const PlaceholderEntry** entries;
+    };
+    TokenBinding tokenBindings[TOKEN_BINDING_SLOTS + 1];
+    size_t tokenBindingCount;
     
     bool validatePlaceholderName(const char* name) const;
+    // Checks and fills the next entry for every register*(); `valid` is the type's own descriptor check
+    // and `kind` names the type when it fails
+    bool addEntry(const char* name, PlaceholderType type, const void* data, bool valid, const char* kind,
+                  bool memoize = false, PlaceholderLengthGetter getLength = nullptr);
+    void commitEntry();
+    bool assignName(PlaceholderEntry& entry, const char* name);
+    const char* internName(const char* name);
+    void releaseNamePool();
+    const PlaceholderEntry* findEntry(const char* name, uint32_t hash) const;
+    TemplatePlan* buildPlan(const char* progmemTemplate, size_t templateLen, const StaticTemplate* compiled) const;
+    size_t scanTemplate(const char* progmemTemplate, size_t templateLen, TemplateSegment* segments, size_t maxSegments) const;
+    TemplatePlan* findCachedPlan(const char* progmemTemplate, size_t& slot) const;
+    static const TemplatePlan* pinPlan(TemplatePlan* plan);
+    void lockPlans();
+    void unlockPlans();
+    void rebindToken(const PlaceholderEntry& entry);
     static size_t copyProgmemData(const char* source, size_t offset, 
                                  uint8_t* dest, size_t maxLen);
     static size_t copyRamData(PlaceholderDataGetter getter, size_t offset, 
                              uint8_t* dest, size_t maxLen);
     static size_t copyDynamicData(const DynamicDataDescriptor* descriptor, size_t offset,
                                  uint8_t* dest, size_t maxLen);
+    static size_t copySizedData(const SizedDataDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen);
+    static size_t copyTypedValue(const TypedValueDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen);
+    static size_t copyProviderField(const ProviderFieldDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen);
+    static size_t copyRingData(const RingBufferDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen);
 };
 
 #endif // DEVICEFRAMEWORK_PLACEHOLDER_REGISTRY_H
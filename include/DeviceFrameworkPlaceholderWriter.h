@@ -0,0 +1,77 @@
+#ifndef DEVICEFRAMEWORK_PLACEHOLDER_WRITER_H
+#define DEVICEFRAMEWORK_PLACEHOLDER_WRITER_H
+
+#include <Arduino.h>
+#include "DeviceFrameworkTemplateTypes.h"
+
+static_assert(DFTE_WRITER_SPILL_SIZE > 0 && DFTE_WRITER_SPILL_SIZE <= 255,
+              "DFTE_WRITER_SPILL_SIZE must be between 1 and 255");
+
+/**
+ * DeviceFramework Placeholder Writer
+ * Bounded writer handed to WRITER_DATA callbacks; bytes go straight into the chunk buffer being rendered
+ *
+ * The writer accepts up to remaining() bytes: whatever is left of the caller's chunk plus
+ * DFTE_WRITER_SPILL_SIZE bytes of spill kept in the render frame and written at the start of the next
+ * chunk. Every call starts with at least DFTE_WRITER_SPILL_SIZE + 1 bytes available, so short values
+ * (numbers, names, addresses) are formatted in one call whatever the chunk boundaries are.
+ *
+ * Longer values are produced in pieces: write pieces while they fit, record progress in cookie() and
+ * return false; the callback is called again with the next chunk and the cookie as it was left.
+ *
+ * Usage:
+ *   bool writeUptime(PlaceholderWriter& out, void*) {
+ *       out.printUnsigned(millis() / 1000);
+ *       return out.write('s');
+ *   }
+ *   static const WriterDataDescriptor uptime = {writeUptime, nullptr};
+ *   registry.registerWriter("%UPTIME%", &uptime);
+ */
+class DeviceFrameworkPlaceholderWriter {
+public:
+    DeviceFrameworkPlaceholderWriter(uint8_t* buffer, size_t capacity, char* spill, size_t spillCapacity, uint32_t& cookie)
+        : buffer(buffer), capacity(capacity), spill(spill), spillCapacity(spillCapacity), cookieRef(cookie),
+          bufferUsed(0), spillUsed(0), overflowed(false) {}
+
+    /**
+     * Write raw bytes (may contain NULs)
+     * @return Bytes accepted; anything past remaining() is dropped and hasOverflowed() turns true
+     */
+    size_t write(const void* data, size_t length);
+    bool write(char c) { return write(&c, 1) == 1; }
+
+    /**
+     * Write a NUL-terminated RAM / PROGMEM string
+     * @return false if it did not fit completely
+     */
+    bool print(const char* text);
+    bool printProgmem(const char* text);
+
+    // Decimal numbers without an intermediate String or snprintf (see DeviceFrameworkTypedValue)
+    bool printUnsigned(uint32_t value);
+    bool printSigned(int32_t value);
+    bool printFixed(float value, uint8_t decimals);
+
+    // Bytes that can still be written in this call
+    size_t remaining() const { return (capacity - bufferUsed) + (spillCapacity - spillUsed); }
+
+    // Bytes accepted in this call, and how many of them went to the spill
+    size_t getWritten() const { return bufferUsed + spillUsed; }
+    size_t getSpilled() const { return spillUsed; }
+    bool hasOverflowed() const { return overflowed; }
+
+    // Callback-owned resume state, kept in the render frame between calls (0 on the first call)
+    uint32_t& cookie() { return cookieRef; }
+
+private:
+    uint8_t* buffer;
+    size_t capacity;
+    char* spill;
+    size_t spillCapacity;
+    uint32_t& cookieRef;
+    size_t bufferUsed;
+    size_t spillUsed;
+    bool overflowed;
+};
+
+#endif // DEVICEFRAMEWORK_PLACEHOLDER_WRITER_H
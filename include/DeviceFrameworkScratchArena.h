@@ -0,0 +1,167 @@
+#ifndef DEVICEFRAMEWORK_SCRATCH_ARENA_H
+#define DEVICEFRAMEWORK_SCRATCH_ARENA_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <cstddef>
+
+#ifndef DFTE_SCRATCH_ARENA_SIZE_DEFAULT
+  #define DFTE_SCRATCH_ARENA_SIZE_DEFAULT 256
+#endif
+
+/**
+ * DeviceFramework Scratch Arena
+ * Bump-pointer memory for values produced during one render
+ *
+ * Getters, evaluators and iterator handlers called by renderNextChunk() reach the arena of the context being
+ * rendered through current(), and return pointers into it instead of into static buffers: two contexts
+ * rendering the same page (two clients served chunk by chunk) each get their own arena, so one cannot
+ * overwrite a value the other is still streaming. Allocations are never freed one by one; the whole arena
+ * is reset in one step when the render completes, fails or the context is reset, so a returned pointer stays
+ * valid for the rest of the render (memoized values included) and nothing touches the heap per request.
+ *
+ * An iterator that formats every row can take a mark() in open() and rewind() to it at the start of each
+ * next(): the previous row has been written by then, so a long list reuses the same bytes. Values the
+ * context keeps for the rest of the render (memoized results, data provider samples) are pin()ned, so
+ * rewinding never frees them.
+ *
+ * Every context owns an arena of DFTE_SCRATCH_ARENA_SIZE_DEFAULT bytes whose buffer is allocated the first
+ * time it is used and then kept; contexts given a DeviceFrameworkScratchArenaPool borrow an arena from it
+ * for each render instead. getHighWater() reports the most any render has used, to size the arena.
+ *
+ * Usage:
+ *   const char* getUptime() {
+ *     ScratchArena* scratch = ScratchArena::current();
+ *     return scratch ? scratch->format("%lus", millis() / 1000) : "";
+ *   }
+ */
+class DeviceFrameworkScratchArena {
+public:
+    /**
+     * Arena with its own buffer, allocated on the first allocation
+     */
+    explicit DeviceFrameworkScratchArena(size_t capacity = DFTE_SCRATCH_ARENA_SIZE_DEFAULT);
+
+    /**
+     * Arena over caller-owned storage (must outlive the arena)
+     */
+    DeviceFrameworkScratchArena(uint8_t* storage, size_t capacity);
+
+    ~DeviceFrameworkScratchArena();
+
+    // Handed out by pointer from contexts and pools
+    DeviceFrameworkScratchArena(const DeviceFrameworkScratchArena&) = delete;
+    DeviceFrameworkScratchArena& operator=(const DeviceFrameworkScratchArena&) = delete;
+
+    /**
+     * Arena of the context being rendered on this task, nullptr outside renderNextChunk()
+     * (renderPlaceholder(), CachedValue and DataProvider refreshes from loop())
+     */
+    static DeviceFrameworkScratchArena* current();
+
+    /**
+     * @param alignment Power of two
+     * @return nullptr when the arena is full (counted by getFailures())
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Room for `length` characters plus the terminator, returned as an empty string
+     */
+    char* allocateText(size_t length);
+
+    /**
+     * Terminated copy of `length` bytes (or of the whole string)
+     */
+    const char* copy(const char* text, size_t length);
+    const char* copy(const char* text);
+
+    /**
+     * snprintf into the arena, using only the bytes the result needs
+     * @return nullptr if the result does not fit
+     */
+    const char* format(const char* pattern, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * Current fill level; rewind() frees everything allocated after it (but nothing below the last pin())
+     */
+    size_t mark() const { return used; }
+    void rewind(size_t position);
+
+    /**
+     * Keep everything allocated so far until reset(), whatever later rewind() calls ask for
+     */
+    void pin() { pinned = used; }
+
+    /**
+     * True if `address` lies in a live allocation of this arena
+     */
+    bool contains(const void* address) const {
+        return base != nullptr && address >= base && address < base + used;
+    }
+
+    /**
+     * Free every allocation at once (the buffer is kept)
+     */
+    void reset() { used = 0; pinned = 0; }
+
+    size_t getCapacity() const { return capacity; }
+    size_t getUsed() const { return used; }
+    size_t getHighWater() const { return highWater; }
+    uint32_t getFailures() const { return failures; }
+    void resetStats();
+
+private:
+    uint8_t* base;
+    size_t capacity;
+    size_t used;
+    size_t pinned;      // rewind() stops here
+    size_t highWater;
+    uint32_t failures;
+    bool ownsBuffer;
+
+    bool ensureBuffer();
+    void* take(size_t size, size_t alignment);
+};
+
+/**
+ * DeviceFramework Scratch Arena Pool
+ * Fixed set of equal arenas that contexts borrow for the duration of a render
+ *
+ * A context given a pool (setScratchPool()) takes an arena the first time a callback asks for one and returns
+ * it, reset, when the render completes, fails or the context is reset. Sized for the renders that run at once
+ * rather than for every open connection, it bounds scratch memory however many contexts exist; a context
+ * that finds the pool empty falls back to its own arena. At most 32 arenas; storage is one allocation.
+ */
+class DeviceFrameworkScratchArenaPool {
+public:
+    DeviceFrameworkScratchArenaPool(uint8_t count, size_t capacity = DFTE_SCRATCH_ARENA_SIZE_DEFAULT);
+    ~DeviceFrameworkScratchArenaPool();
+
+    // Contexts keep a pointer to the pool and its arenas
+    DeviceFrameworkScratchArenaPool(const DeviceFrameworkScratchArenaPool&) = delete;
+    DeviceFrameworkScratchArenaPool& operator=(const DeviceFrameworkScratchArenaPool&) = delete;
+
+    /**
+     * Take a free arena (lock-free, any task)
+     * @return nullptr when all are borrowed or the storage could not be allocated
+     */
+    DeviceFrameworkScratchArena* acquire();
+
+    /**
+     * Reset an arena and return it to the pool
+     */
+    void release(DeviceFrameworkScratchArena* arena);
+
+    uint8_t getCount() const { return count; }
+    uint8_t getAvailable() const;
+    // Highest fill level any arena of the pool has reached
+    size_t getHighWater() const;
+
+private:
+    DeviceFrameworkScratchArena* arenas;
+    uint8_t count;
+    std::atomic<uint32_t> borrowed;   // Bit i set while arenas[i] is lent out
+};
+
+#endif // DEVICEFRAMEWORK_SCRATCH_ARENA_H
@@ -0,0 +1,379 @@
+#ifndef DEVICEFRAMEWORK_STATIC_PLACEHOLDER_REGISTRY_H
+#define DEVICEFRAMEWORK_STATIC_PLACEHOLDER_REGISTRY_H
+
+#include <Arduino.h>
+#include <pgmspace.h>
+#include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkPlaceholderLookup.h"
+#include "DeviceFrameworkPlaceholderRegistry.h"
+
+/**
+ * DeviceFramework Static Placeholder Registry
+ * Read-only registry built at compile time: entries and a perfect hash over their names live in flash
+ *
+ * Usage (namespace or function scope):
+ *   DFTE_STATIC_REGISTRY(kRegistry,
+ *       dfte::progmemData("%CSS%", kSharedCss),
+ *       dfte::progmemTemplate("%HEADER%", kHeaderTemplate),
+ *       dfte::ramData<getPageTitle>("%PAGE_TITLE%"),
+ *       dfte::conditional("%BANNER%", &kBannerDescriptor));
+ *   ctx.setRegistry(&kRegistry);
+ *
+ * Lookup hashes the name once, reads the bucket's seed, rehashes into exactly one slot and compares that
+ * entry's hash and name: O(1) for hits and misses, never a probe sequence. Registrations cost no RAM beyond the
+ * registry object itself (a few pointers); there is no plan cache, so PROGMEM templates are interpreted.
+ *
+ * Names are checked at build time: an empty, overlong or duplicate name fails the build.
+ * PROGMEM data and templates must be passed as arrays so their length is known without reading flash.
+ *
+ * ESP8266 flash only serves aligned 32-bit loads and the renderer reads entries in place (type, flags),
+ * so there the table is emitted as plain const data instead of PROGMEM.
+ */
+#ifndef DFTE_STATIC_REGISTRY_STORAGE
+  #if defined(ESP8266)
+    #define DFTE_STATIC_REGISTRY_STORAGE
+  #else
+    #define DFTE_STATIC_REGISTRY_STORAGE PROGMEM
+  #endif
+#endif
+
+namespace dfte {
+namespace detail {
+
+// Compile-time DeviceFrameworkPlaceholderRegistry::hashName (single-return form so it is a C++11 constant expression)
+constexpr uint32_t staticNameHash(const char* name, uint32_t hash = 2166136261u) {
+    return *name ? staticNameHash(name + 1, (hash ^ static_cast<uint8_t>(*name)) * 16777619u) : hash;
+}
+
+constexpr uint32_t staticXorShift(uint32_t value, unsigned shift) {
+    return value ^ (value >> shift);
+}
+
+// Second-level hash: murmur3 finalizer over the name hash perturbed by the bucket seed
+constexpr uint32_t staticSlotHash(uint32_t hash, uint32_t seed) {
+    return staticXorShift(staticXorShift(staticXorShift(hash ^ (seed * 0x9E3779B9u), 16) * 0x85EBCA6Bu, 13) * 0xC2B2AE35u, 16);
+}
+
+} // namespace detail
+} // namespace dfte
+
+class DeviceFrameworkStaticPlaceholderRegistry : public DeviceFrameworkPlaceholderLookup {
+public:
+    /**
+     * Wrap a table built by DFTE_STATIC_REGISTRY (use the macro rather than calling this directly)
+     * @param entries Slot-ordered entries (empty slots have a null name)
+     * @param seeds Per-bucket seeds of the perfect hash
+     * @param slotMask Slot count - 1 (power of two)
+     * @param bucketMask Bucket count - 1 (power of two)
+     * @param count Number of registered placeholders
+     */
+    constexpr DeviceFrameworkStaticPlaceholderRegistry(const PlaceholderEntry* entries, const uint16_t* seeds,
+                                                       uint32_t slotMask, uint32_t bucketMask, uint16_t count)
+        : entries(entries), seeds(seeds), slotMask(slotMask), bucketMask(bucketMask), count(count) {}
+
+    /**
+     * Find placeholder entry by name (perfect hash, one slot per name)
+     * @return PlaceholderEntry pointer (in flash) or nullptr if not found
+     */
+    const PlaceholderEntry* getPlaceholder(const char* name) const override;
+
+    /**
+     * Get number of registered placeholders
+     */
+    int getCount() const { return count; }
+
+    /**
+     * Get number of table slots (registered placeholders rounded up to a power of two)
+     */
+    uint32_t getSlotCount() const { return slotMask + 1; }
+
+private:
+    const PlaceholderEntry* entries;
+    const uint16_t* seeds;
+    uint32_t slotMask;
+    uint32_t bucketMask;
+    uint16_t count;
+
+    static uint32_t hashName(const char* name);
+};
+
+/**
+ * Compile-time table construction (DFTE_STATIC_REGISTRY)
+ * Requires C++14 constexpr (the builder loops); on older standards DFTE_STATIC_REGISTRY is not defined.
+ */
+#if __cplusplus >= 201402L
+
+namespace dfte {
+
+/**
+ * One DFTE_STATIC_REGISTRY registration; build with the helpers below
+ */
+struct StaticPlaceholder {
+    const char* name;
+    PlaceholderType type;
+    const void* data;
+    PlaceholderLengthGetter getLength;
+    uint32_t cachedLength;
+    bool hasCachedLength;
+    bool memoize;
+};
+
+namespace detail {
+
+// Function pointers cannot become const void* in a constant expression, so RAM getters are stored as a
+// DYNAMIC_DATA descriptor that forwards to them (same output, no userData)
+template <PlaceholderDataGetter Getter>
+struct StaticRamData {
+    static const char* get(void* userData) {
+        (void)userData;
+        return Getter();
+    }
+    static constexpr DynamicDataDescriptor descriptor = {get, nullptr, nullptr};
+};
+
+template <PlaceholderDataGetter Getter>
+constexpr DynamicDataDescriptor StaticRamData<Getter>::descriptor;
+
+} // namespace detail
+
+template <size_t DataSize>
+constexpr StaticPlaceholder progmemData(const char* name, const char (&data)[DataSize]) {
+    return {name, PlaceholderType::PROGMEM_DATA, data, DeviceFrameworkPlaceholderRegistry::getProgmemLength,
+            DataSize - 1, true, false};
+}
+
+template <size_t TemplateSize>
+constexpr StaticPlaceholder progmemTemplate(const char* name, const char (&templateData)[TemplateSize]) {
+    return {name, PlaceholderType::PROGMEM_TEMPLATE, templateData, DeviceFrameworkPlaceholderRegistry::getProgmemLength,
+            TemplateSize - 1, true, false};
+}
+
+template <PlaceholderDataGetter Getter>
+constexpr StaticPlaceholder ramData(const char* name) {
+    return {name, PlaceholderType::DYNAMIC_DATA, &detail::StaticRamData<Getter>::descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder dynamicData(const char* name, const DynamicDataDescriptor* descriptor) {
+    return {name, PlaceholderType::DYNAMIC_DATA, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder sizedData(const char* name, const SizedDataDescriptor* descriptor) {
+    return {name, PlaceholderType::SIZED_DATA, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder writer(const char* name, const WriterDataDescriptor* descriptor) {
+    return {name, PlaceholderType::WRITER_DATA, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder typedValue(const char* name, const TypedValueDescriptor* descriptor) {
+    return {name, PlaceholderType::TYPED_VALUE, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder producer(const char* name, const ProducerDescriptor* descriptor) {
+    return {name, PlaceholderType::PRODUCER_DATA, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder providerField(const char* name, const ProviderFieldDescriptor* descriptor) {
+    return {name, PlaceholderType::PROVIDER_FIELD, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder ringBuffer(const char* name, const RingBufferDescriptor* descriptor) {
+    return {name, PlaceholderType::RING_DATA, descriptor, nullptr, 0, false, false};
+}
+
+/**
+ * Compute a ramData/dynamicData/sizedData value or a conditional branch once per render, e.g.
+ * dfte::memoized(dfte::ramData<getPageTitle>("%PAGE_TITLE%"))
+ */
+constexpr StaticPlaceholder memoized(StaticPlaceholder placeholder) {
+    return {placeholder.name, placeholder.type, placeholder.data, placeholder.getLength, placeholder.cachedLength,
+            placeholder.hasCachedLength, true};
+}
+
+constexpr StaticPlaceholder dynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor) {
+    return {name, PlaceholderType::DYNAMIC_TEMPLATE, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder conditional(const char* name, const ConditionalDescriptor* descriptor) {
+    return {name, PlaceholderType::CONDITIONAL, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder iterator(const char* name, const IteratorDescriptor* descriptor) {
+    return {name, PlaceholderType::ITERATOR, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder staticTemplate(const char* name, const StaticTemplate* descriptor) {
+    return {name, PlaceholderType::STATIC_TEMPLATE, descriptor, DeviceFrameworkPlaceholderRegistry::getStaticTemplateLength,
+            0, false, false};
+}
+
+constexpr StaticPlaceholder compiledTemplate(const char* name, const CompiledTemplate* descriptor) {
+    return {name, PlaceholderType::COMPILED_TEMPLATE, descriptor, nullptr, 0, false, false};
+}
+
+constexpr StaticPlaceholder tokenizedTemplate(const char* name, const TokenizedTemplate* descriptor) {
+    return {name, PlaceholderType::TOKENIZED_TEMPLATE, descriptor,
+            DeviceFrameworkPlaceholderRegistry::getTokenizedTemplateLength, 0, false, false};
+}
+
+namespace detail {
+
+constexpr size_t staticTableSize(size_t count) {
+    size_t size = 1;
+    while (size < count) {
+        size <<= 1;
+    }
+    return size;
+}
+
+template <size_t Count>
+constexpr bool staticNamesFit(const StaticPlaceholder (&placeholders)[Count]) {
+    for (size_t i = 0; i < Count; ++i) {
+        if (placeholders[i].name == nullptr) {
+            return false;
+        }
+        size_t length = 0;
+        while (placeholders[i].name[length] != '\0') {
+            ++length;
+        }
+        if (length == 0 || length >= DFTE_PLACEHOLDER_NAME_SIZE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool staticNamesEqual(const char* left, const char* right) {
+    while (*left != '\0' && *left == *right) {
+        ++left;
+        ++right;
+    }
+    return *left == *right;
+}
+
+template <size_t Count>
+constexpr bool staticNamesUnique(const StaticPlaceholder (&placeholders)[Count]) {
+    for (size_t i = 0; i < Count; ++i) {
+        for (size_t j = i + 1; j < Count; ++j) {
+            if (staticNamesEqual(placeholders[i].name, placeholders[j].name)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Hash-and-displace table: names fall into buckets by their hash, and each bucket gets the first seed
+ * that sends all of its names to free slots. One slot per name, so lookups never probe.
+ */
+template <size_t Count>
+struct StaticRegistryTable {
+    static constexpr size_t SLOT_COUNT = staticTableSize(Count);
+    static constexpr size_t BUCKET_COUNT = staticTableSize((Count + 1) / 2);
+
+    PlaceholderEntry entries[SLOT_COUNT];
+    uint16_t seeds[BUCKET_COUNT];
+    bool complete;  // false when some bucket found no seed (names with identical hashes)
+};
+
+template <size_t Count>
+constexpr StaticRegistryTable<Count> buildStaticRegistry(const StaticPlaceholder (&placeholders)[Count]) {
+    using Table = StaticRegistryTable<Count>;
+    constexpr uint32_t slotMask = Table::SLOT_COUNT - 1;
+    constexpr uint32_t bucketMask = Table::BUCKET_COUNT - 1;
+
+    Table table{};
+    uint32_t hashes[Count] = {};
+    size_t bucketStart[Table::BUCKET_COUNT + 1] = {};
+    for (size_t i = 0; i < Count; ++i) {
+        hashes[i] = staticNameHash(placeholders[i].name);
+        ++bucketStart[(hashes[i] & bucketMask) + 1];
+    }
+
+    // Counting sort of names by bucket, so a seed attempt only touches its own bucket
+    size_t largestBucket = 0;
+    for (size_t bucket = 0; bucket < Table::BUCKET_COUNT; ++bucket) {
+        if (bucketStart[bucket + 1] > largestBucket) {
+            largestBucket = bucketStart[bucket + 1];
+        }
+        bucketStart[bucket + 1] += bucketStart[bucket];
+    }
+    size_t order[Count] = {};
+    size_t fill[Table::BUCKET_COUNT] = {};
+    for (size_t i = 0; i < Count; ++i) {
+        size_t bucket = hashes[i] & bucketMask;
+        order[bucketStart[bucket] + fill[bucket]++] = i;
+    }
+
+    // Largest buckets first, while the table is still mostly empty
+    bool used[Table::SLOT_COUNT] = {};
+    uint32_t slots[Count] = {};
+    for (size_t size = largestBucket; size > 0; --size) {
+        for (size_t bucket = 0; bucket < Table::BUCKET_COUNT; ++bucket) {
+            size_t first = bucketStart[bucket];
+            if (bucketStart[bucket + 1] - first != size) {
+                continue;
+            }
+
+            bool placed = false;
+            for (uint32_t seed = 0; seed <= 0xFFFF && !placed; ++seed) {
+                placed = true;
+                for (size_t k = 0; k < size && placed; ++k) {
+                    uint32_t slot = staticSlotHash(hashes[order[first + k]], seed) & slotMask;
+                    placed = !used[slot];
+                    for (size_t j = 0; j < k && placed; ++j) {
+                        placed = slots[j] != slot;
+                    }
+                    slots[k] = slot;
+                }
+                if (placed) {
+                    table.seeds[bucket] = static_cast<uint16_t>(seed);
+                }
+            }
+            if (!placed) {
+                return table;
+            }
+
+            for (size_t k = 0; k < size; ++k) {
+                const StaticPlaceholder& placeholder = placeholders[order[first + k]];
+                PlaceholderEntry& entry = table.entries[slots[k]];
+                used[slots[k]] = true;
+                entry.name = placeholder.name;
+                entry.nameHash = hashes[order[first + k]];
+                entry.type = placeholder.type;
+                entry.data = placeholder.data;
+                entry.getLength = placeholder.getLength;
+                entry.cachedLength = placeholder.cachedLength;
+                entry.hasCachedLength = placeholder.hasCachedLength;
+                entry.memoize = placeholder.memoize;
+            }
+        }
+    }
+    table.complete = true;
+    return table;
+}
+
+} // namespace detail
+} // namespace dfte
+
+#define DFTE_STATIC_REGISTRY(name, ...)                                                                      \
+    static constexpr ::dfte::StaticPlaceholder name##_dfteDefs[] = {__VA_ARGS__};                           \
+    static_assert(sizeof(name##_dfteDefs) / sizeof(name##_dfteDefs[0]) <= 0xFFFF,                           \
+                  "DFTE_STATIC_REGISTRY " #name ": too many placeholders");                                 \
+    static_assert(::dfte::detail::staticNamesFit(name##_dfteDefs),                                         \
+                  "DFTE_STATIC_REGISTRY " #name ": placeholder name empty or longer than DFTE_PLACEHOLDER_NAME_SIZE - 1"); \
+    static_assert(::dfte::detail::staticNamesUnique(name##_dfteDefs),                                      \
+                  "DFTE_STATIC_REGISTRY " #name ": duplicate placeholder name");                            \
+    static constexpr auto name##_dfteTable DFTE_STATIC_REGISTRY_STORAGE =                                  \
+        ::dfte::detail::buildStaticRegistry(name##_dfteDefs);                                               \
+    static_assert(name##_dfteTable.complete, "DFTE_STATIC_REGISTRY " #name ": no perfect hash (names share a hash)"); \
+    static DeviceFrameworkStaticPlaceholderRegistry name(                                                    \
+        name##_dfteTable.entries, name##_dfteTable.seeds,                                                   \
+        static_cast<uint32_t>(sizeof(name##_dfteTable.entries) / sizeof(PlaceholderEntry) - 1),           \
+        static_cast<uint32_t>(sizeof(name##_dfteTable.seeds) / sizeof(uint16_t) - 1),                       \
+        static_cast<uint16_t>(sizeof(name##_dfteDefs) / sizeof(name##_dfteDefs[0])))
+
+#endif // __cplusplus >= 201402L
+
+#endif // DEVICEFRAMEWORK_STATIC_PLACEHOLDER_REGISTRY_H
@@ -0,0 +1,133 @@
+#ifndef DEVICEFRAMEWORK_STATIC_TEMPLATE_H
+#define DEVICEFRAMEWORK_STATIC_TEMPLATE_H
+
+#include <Arduino.h>
+#include "DeviceFrameworkTemplateTypes.h"
+
+/**
+ * DeviceFramework Static Templates
+ * Splits string-literal templates into literal/token segments at compile time
+ *
+ * Usage (namespace or function scope):
+ *   DFTE_TEMPLATE(kLayoutTemplate, "<html><title>%PAGE_TITLE%</title>%CONTENT%</html>");
+ *   DeviceFrameworkTemplateRenderer::initializeContext(ctx, kLayoutTemplate);
+ *   registry.registerStaticTemplate("%LAYOUT%", &kLayoutTemplate);
+ *
+ * Text and segment table are emitted as one PROGMEM object. Tokens follow the runtime rules, and a token
+ * longer than DFTE_PLACEHOLDER_NAME_SIZE - 1 bytes (or left unterminated) fails the build instead of
+ * being dropped at render time.
+ *
+ * Requires C++14 constexpr (the parser loops); on older standards DFTE_TEMPLATE is not defined.
+ */
+#if __cplusplus >= 201402L
+
+namespace dfte {
+namespace detail {
+
+constexpr size_t STATIC_TOKEN_LIMIT = DFTE_PLACEHOLDER_NAME_SIZE - 1;
+
+// Same walk as DeviceFrameworkPlaceholderRegistry::scanTemplate; writes segments when out != nullptr
+constexpr size_t scanStaticTemplate(const char* text, size_t len, TemplateSegment* out, bool& tokensFit) {
+    size_t count = 0;
+    size_t literalStart = 0;
+    size_t pos = 0;
+    tokensFit = true;
+
+    while (pos < len) {
+        if (text[pos] != '%') {
+            ++pos;
+            continue;
+        }
+
+        if (pos > literalStart) {
+            if (out != nullptr) {
+                out[count].offset = static_cast<uint32_t>(literalStart);
+                out[count].length = static_cast<uint32_t>(pos - literalStart);
+                out[count].entry = nullptr;
+                out[count].kind = TemplateSegmentKind::LITERAL;
+            }
+            ++count;
+        }
+
+        size_t tokenStart = pos++;
+        size_t tokenLen = 1;
+        bool closed = false;
+        while (tokenLen < STATIC_TOKEN_LIMIT && pos < len) {
+            ++tokenLen;
+            if (text[pos++] == '%') {
+                closed = true;
+                break;
+            }
+        }
+
+        if (closed) {
+            if (out != nullptr) {
+                out[count].offset = static_cast<uint32_t>(tokenStart);
+                out[count].length = static_cast<uint32_t>(tokenLen);
+                out[count].entry = nullptr;
+                out[count].kind = TemplateSegmentKind::TOKEN;
+            }
+            ++count;
+        } else {
+            tokensFit = false;
+        }
+        literalStart = pos;
+    }
+
+    if (len > literalStart) {
+        if (out != nullptr) {
+            out[count].offset = static_cast<uint32_t>(literalStart);
+            out[count].length = static_cast<uint32_t>(len - literalStart);
+            out[count].entry = nullptr;
+            out[count].kind = TemplateSegmentKind::LITERAL;
+        }
+        ++count;
+    }
+    return count;
+}
+
+constexpr size_t countStaticSegments(const char* text, size_t len) {
+    bool tokensFit = true;
+    return scanStaticTemplate(text, len, nullptr, tokensFit);
+}
+
+constexpr bool staticTokensFit(const char* text, size_t len) {
+    bool tokensFit = true;
+    scanStaticTemplate(text, len, nullptr, tokensFit);
+    return tokensFit;
+}
+
+template <size_t TextSize, size_t SegmentCount>
+struct StaticTemplateTable {
+    char text[TextSize];
+    TemplateSegment segments[SegmentCount > 0 ? SegmentCount : 1];
+};
+
+template <size_t SegmentCount, size_t TextSize>
+constexpr StaticTemplateTable<TextSize, SegmentCount> compileStaticTemplate(const char (&literal)[TextSize]) {
+    StaticTemplateTable<TextSize, SegmentCount> table{};
+    for (size_t i = 0; i < TextSize; ++i) {
+        table.text[i] = literal[i];
+    }
+    bool tokensFit = true;
+    scanStaticTemplate(literal, TextSize - 1, table.segments, tokensFit);
+    return table;
+}
+
+} // namespace detail
+} // namespace dfte
+
+#define DFTE_TEMPLATE(name, literal)                                                                       \
+    static_assert(::dfte::detail::staticTokensFit(literal, sizeof(literal) - 1),                           \
+                  "DFTE_TEMPLATE " #name ": placeholder exceeds DFTE_PLACEHOLDER_NAME_SIZE or is unterminated"); \
+    static_assert(::dfte::detail::countStaticSegments(literal, sizeof(literal) - 1) <= 0xFFFF,             \
+                  "DFTE_TEMPLATE " #name ": too many segments");                                           \
+    static constexpr auto name##_dfteTable PROGMEM =                                                       \
+        ::dfte::detail::compileStaticTemplate<::dfte::detail::countStaticSegments(literal, sizeof(literal) - 1)>(literal); \
+    static constexpr StaticTemplate name = {                                                               \
+        name##_dfteTable.text, sizeof(literal) - 1, name##_dfteTable.segments,                             \
+        static_cast<uint16_t>(::dfte::detail::countStaticSegments(literal, sizeof(literal) - 1))}
+
+#endif // __cplusplus >= 201402L
+
+#endif // DEVICEFRAMEWORK_STATIC_TEMPLATE_H
@@ -0,0 +1,68 @@
+#ifndef DEVICEFRAMEWORK_TASK_MUTEX_H
+#define DEVICEFRAMEWORK_TASK_MUTEX_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Block on an RTOS mutex (ESP32: FreeRTOS with priority inheritance) instead of spinning; ESP8266 sketches run
+// every render and refresh on the one loop task, where a waiter could only spin until it returns
+#ifndef DFTE_TASK_MUTEX_BLOCKING
+  #if defined(ARDUINO_ARCH_ESP8266)
+    #define DFTE_TASK_MUTEX_BLOCKING 0
+  #else
+    #define DFTE_TASK_MUTEX_BLOCKING 1
+  #endif
+#endif
+
+#if DFTE_TASK_MUTEX_BLOCKING
+  #include <mutex>
+#endif
+
+/**
+ * DeviceFramework Task Mutex
+ * Lock shared by renders and the task refreshing a CachedValue or DataProvider
+ *
+ * Two kinds of section use it: short ones (copying a published value in or out) take lock() and never yield
+ * inside; long ones (a getter or sample callback that may wait on a bus) take tryLock() and skip the work when
+ * another task is already doing it, or awaitLock() when there is nothing to serve until it is done. With
+ * DFTE_TASK_MUTEX_BLOCKING a waiter sleeps on the mutex, so a higher-priority task never starves the holder.
+ * Without it awaitLock() gives up instead of waiting: the holder is the interrupted loop task and cannot
+ * finish before the caller returns.
+ */
+class DeviceFrameworkTaskMutex {
+public:
+    DeviceFrameworkTaskMutex() {
+#if !DFTE_TASK_MUTEX_BLOCKING
+        held.clear();
+#endif
+    }
+
+    DeviceFrameworkTaskMutex(const DeviceFrameworkTaskMutex&) = delete;
+    DeviceFrameworkTaskMutex& operator=(const DeviceFrameworkTaskMutex&) = delete;
+
+#if DFTE_TASK_MUTEX_BLOCKING
+    bool tryLock() { return mutex.try_lock(); }
+    void lock() { mutex.lock(); }
+    bool awaitLock() { mutex.lock(); return true; }
+    void unlock() { mutex.unlock(); }
+#else
+    bool tryLock() { return !held.test_and_set(std::memory_order_acquire); }
+    // Short sections never yield, so with one task this finds the lock free
+    void lock() {
+        while (held.test_and_set(std::memory_order_acquire)) {
+            yield();
+        }
+    }
+    bool awaitLock() { return tryLock(); }
+    void unlock() { held.clear(std::memory_order_release); }
+#endif
+
+private:
+#if DFTE_TASK_MUTEX_BLOCKING
+    std::mutex mutex;
+#else
+    std::atomic_flag held;
+#endif
+};
+
+#endif // DEVICEFRAMEWORK_TASK_MUTEX_H
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "DeviceFrameworkTemplateTypes.h"
+#include "DeviceFrameworkScratchArena.h"
 
 // Fallback defaults when DeviceFrameworkConfig is not available (standalone usage)
 // Always use internal macro names (DFTE_*) to avoid conflicts with DeviceFrameworkConfig extern declarations
@@ -12,6 +13,10 @@
   #define DFTE_MAX_STACK_DEPTH_DEFAULT 16
 #endif
 
+#ifndef DFTE_MAX_TAIL_INCLUDES_DEFAULT
+  #define DFTE_MAX_TAIL_INCLUDES_DEFAULT 64
+#endif
+
 #ifndef DFTE_BUFFER_SIZE_DEFAULT
   #define DFTE_BUFFER_SIZE_DEFAULT 512
 #endif
@@ -30,6 +35,11 @@
   #else
     #define DFTE_MAX_STACK_DEPTH DFTE_MAX_STACK_DEPTH_DEFAULT
   #endif
+  #ifdef CONFIG_templateMaxTailIncludes_default
+    #define DFTE_MAX_TAIL_INCLUDES CONFIG_templateMaxTailIncludes_default
+  #else
+    #define DFTE_MAX_TAIL_INCLUDES DFTE_MAX_TAIL_INCLUDES_DEFAULT
+  #endif
   #ifdef CONFIG_templateBufferSize_default
     #define DFTE_BUFFER_SIZE CONFIG_templateBufferSize_default
   #else
@@ -39,12 +49,36 @@
 #else
   // Standalone usage - use internal defaults
   #define DFTE_MAX_STACK_DEPTH DFTE_MAX_STACK_DEPTH_DEFAULT
+  #define DFTE_MAX_TAIL_INCLUDES DFTE_MAX_TAIL_INCLUDES_DEFAULT
   #define DFTE_BUFFER_SIZE DFTE_BUFFER_SIZE_DEFAULT
   // DFTE_PLACEHOLDER_NAME_SIZE is already defined in DeviceFrameworkTemplateTypes.h
 #endif
 
-// Forward declaration
-class DeviceFrameworkPlaceholderRegistry;
+#ifndef DFTE_RENDER_MEMO_SLOTS_DEFAULT
+  #define DFTE_RENDER_MEMO_SLOTS_DEFAULT 8
+#endif
+
+#ifndef DFTE_RENDER_PROVIDER_SLOTS_DEFAULT
+  #define DFTE_RENDER_PROVIDER_SLOTS_DEFAULT 4
+#endif
+
+#ifndef DFTE_RENDER_CACHE_SLOTS_DEFAULT
+  #define DFTE_RENDER_CACHE_SLOTS_DEFAULT 4
+#endif
+
+// Per-task storage for the context being rendered (ESP8266 sketches render from the single loop task)
+#ifndef DFTE_THREAD_LOCAL
+  #if defined(ARDUINO_ARCH_ESP8266)
+    #define DFTE_THREAD_LOCAL
+  #else
+    #define DFTE_THREAD_LOCAL thread_local
+  #endif
+#endif
+
+// Forward declarations
+class DeviceFrameworkPlaceholderLookup;
+class DeviceFrameworkDataProvider;
+class DeviceFrameworkCachedValue;
 
 /**
  * Template rendering context
@@ -75,15 +109,58 @@ public:
     size_t bufferLen;
     size_t bufferOffset;
     
-    // Placeholder registry (injected, not owned)
-    DeviceFrameworkPlaceholderRegistry* registry;
+    // Placeholder registry (injected, not owned): runtime registry or flash-resident static table
+    DeviceFrameworkPlaceholderLookup* registry;
+
+    // Render-scoped memo for placeholders registered with memoize = true (cleared by reset())
+    struct MemoSlot {
+        const PlaceholderEntry* entry;
+        const char* value;      // Getter result (data placeholders)
+        uint32_t length;        // Value length, or the ConditionalBranchResult for conditionals
+    };
+    static constexpr uint8_t MEMO_SLOTS = DFTE_RENDER_MEMO_SLOTS_DEFAULT;
+    static_assert(MEMO_SLOTS > 0, "DFTE_RENDER_MEMO_SLOTS_DEFAULT must be at least 1");
+    MemoSlot memo[MEMO_SLOTS];
+    uint8_t memoCount;
+
+    // Sample of each data provider this render has read, copied into the scratch arena (cleared by reset())
+    struct ProviderSlot {
+        const DeviceFrameworkDataProvider* provider;
+        const void* sample;     // Copy the remaining fields are formatted from; nullptr if the arena was full
+    };
+    static constexpr uint8_t PROVIDER_SLOTS = DFTE_RENDER_PROVIDER_SLOTS_DEFAULT;
+    static_assert(PROVIDER_SLOTS > 0, "DFTE_RENDER_PROVIDER_SLOTS_DEFAULT must be at least 1");
+    ProviderSlot providerSamples[PROVIDER_SLOTS];
+    uint8_t providerSampleCount;
+
+    // Value of each cached value this render has read, copied into the scratch arena (cleared by reset())
+    struct CacheSlot {
+        const DeviceFrameworkCachedValue* cache;
+        const char* value;      // Copy every later get() of the render returns; nullptr if the arena was full
+        size_t length;
+    };
+    static constexpr uint8_t CACHE_SLOTS = DFTE_RENDER_CACHE_SLOTS_DEFAULT;
+    static_assert(CACHE_SLOTS > 0, "DFTE_RENDER_CACHE_SLOTS_DEFAULT must be at least 1");
+    CacheSlot cachedCopies[CACHE_SLOTS];
+    uint8_t cachedCopyCount;
+
+    // Scratch memory for callbacks of the current render (see DeviceFrameworkScratchArena)
+    DeviceFrameworkScratchArena scratch;                // Owned; its buffer is allocated on first use
+    DeviceFrameworkScratchArenaPool* scratchPool;       // Borrow from here first when set
+    DeviceFrameworkScratchArena* borrowedScratch;       // Arena taken from scratchPool for this render
     
     // Statistics
     size_t totalBytesProcessed;
+    size_t totalSteps;          // Render loop dispatch steps (state handler invocations)
     unsigned long startTime;
     
     DeviceFrameworkTemplateContext();
+    ~DeviceFrameworkTemplateContext();
     void reset();
+
+    // Prevent copying (frames pin shared template plans and own producer and iterator handles)
+    DeviceFrameworkTemplateContext(const DeviceFrameworkTemplateContext&) = delete;
+    DeviceFrameworkTemplateContext& operator=(const DeviceFrameworkTemplateContext&) = delete;
     
     // Unified stack management methods
     bool pushContext(RenderingContextType type, const char* name);
@@ -100,14 +177,62 @@ public:
     String getStackTrace() const;
     
     // Set the registry to use for placeholder lookups
-    void setRegistry(DeviceFrameworkPlaceholderRegistry* reg) { registry = reg; }
+    void setRegistry(DeviceFrameworkPlaceholderLookup* reg) { registry = reg; }
+
+    // Borrow scratch arenas from a shared pool instead of the owned arena (nullptr = owned only)
+    void setScratchPool(DeviceFrameworkScratchArenaPool* pool);
+    // Arena this render allocates from, borrowed from the pool on first use (falls back to the owned arena)
+    DeviceFrameworkScratchArena* getScratchArena();
+    // Free everything allocated by the render and return a borrowed arena (render end and reset())
+    void releaseScratch();
+
+    // Context whose renderNextChunk() is running on this task, nullptr between chunks
+    static DeviceFrameworkTemplateContext* rendering() { return renderingNow; }
+
+    // Marks ctx as rendering for the scope of one renderNextChunk() call (restores the outer one on exit)
+    class RenderScope {
+    public:
+        explicit RenderScope(DeviceFrameworkTemplateContext& ctx) : previous(renderingNow) { renderingNow = &ctx; }
+        ~RenderScope() { renderingNow = previous; }
+        RenderScope(const RenderScope&) = delete;
+        RenderScope& operator=(const RenderScope&) = delete;
+    private:
+        DeviceFrameworkTemplateContext* previous;
+    };
     
     // Unified buffer management
     bool refillBuffer();
     char getNextChar();
+    // Copy literal bytes up to the next delimiter (consumed, not copied) and update the frame once per run
+    size_t readLiteralRun(uint8_t* dest, size_t maxLen, bool& delimiterFound, uint8_t delimiter = '%');
+    // Read the varint token id that follows DFTE_TOKEN_ESCAPE in a tokenized template
+    bool readTokenId(uint32_t& id);
     size_t getAvailableBytes() const;
     bool hasMoreData() const;
     void resetPlaceholder();
+
+    // Memoized result for entry in this render, nullptr if not computed yet
+    const MemoSlot* findMemo(const PlaceholderEntry* entry) const;
+    // Remember a result for the rest of the render, copying values into the pinned scratch arena
+    // false when the table or the arena is full (the value is then recomputed)
+    bool storeMemo(const PlaceholderEntry* entry, const char* value, uint32_t length);
+
+    // Provider sample this render has read, nullptr before its first field
+    const ProviderSlot* findProviderSample(const DeviceFrameworkDataProvider* provider) const;
+    // Remember the sample for the rest of the render; false when the table is full
+    bool storeProviderSample(const DeviceFrameworkDataProvider* provider, const void* sample);
+
+    // Copy of a cached value this render has read, nullptr before its first get()
+    const CacheSlot* findCachedCopy(const DeviceFrameworkCachedValue* cache) const;
+    // Remember the copy for the rest of the render; false when the table is full
+    bool storeCachedCopy(const DeviceFrameworkCachedValue* cache, const char* value, size_t length);
+
+private:
+    // Unpin compiled plans and close producer handles held by frames still on the stack (abandoned renders)
+    void releaseFrames();
+    static void closeProducer(RenderingContext& ctx);
+
+    static DFTE_THREAD_LOCAL DeviceFrameworkTemplateContext* renderingNow;
 };
 
 #endif // DEVICEFRAMEWORK_TEMPLATE_CONTEXT_H
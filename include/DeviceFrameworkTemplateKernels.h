@@ -0,0 +1,88 @@
+#ifndef DEVICEFRAMEWORK_TEMPLATE_KERNELS_H
+#define DEVICEFRAMEWORK_TEMPLATE_KERNELS_H
+
+#include <Arduino.h>
+
+// Backend selection
+// ESP8266/ESP32 (Xtensa) builds use the 32-bit word-at-a-time (SWAR) kernels, fixed at compile time.
+// Host builds pick the widest of SSE2/AVX2/NEON available, AVX2 being detected at startup.
+// Define DFTE_KERNELS_SCALAR_ONLY to force the portable byte loops everywhere.
+#if !defined(DFTE_KERNELS_SCALAR_ONLY)
+  #if defined(__SSE2__) || defined(_M_X64)
+    #define DFTE_KERNELS_HAVE_SSE2 1
+  #endif
+  #if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define DFTE_KERNELS_HAVE_AVX2 1
+  #endif
+  #if defined(__aarch64__) && defined(__ARM_NEON)
+    #define DFTE_KERNELS_HAVE_NEON 1
+  #endif
+#endif
+
+/**
+ * DeviceFramework Template Kernels
+ * Byte-level scan/copy primitives used on the renderer hot paths
+ *
+ * All kernels share the scalar semantics; the vector variants only change throughput.
+ * Kernels operate on RAM only - PROGMEM content must be staged through the context readBuffer first.
+ */
+class DeviceFrameworkTemplateKernels {
+public:
+    // Index of the first `needle` in data[0..len), or len when absent
+    typedef size_t (*FindByteFn)(const uint8_t* data, size_t len, uint8_t needle);
+
+    // Copy src into dest up to (not including) the first `needle`; returns bytes copied
+    typedef size_t (*CopyUntilFn)(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found);
+
+    // Length of the leading run of placeholder-name characters [A-Za-z0-9_]
+    typedef size_t (*NameSpanFn)(const uint8_t* data, size_t len);
+
+    struct KernelSet {
+        const char* name;
+        FindByteFn findByte;
+        CopyUntilFn copyUntil;
+        NameSpanFn nameSpan;
+    };
+
+    static size_t findByte(const uint8_t* data, size_t len, uint8_t needle) {
+        return active().findByte(data, len, needle);
+    }
+
+    static size_t copyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+        return active().copyUntil(dest, src, len, needle, found);
+    }
+
+    static size_t nameSpan(const uint8_t* data, size_t len) {
+        return active().nameSpan(data, len);
+    }
+
+    /**
+     * Kernel set used by the engine (resolved on first use)
+     */
+    static const KernelSet& active() {
+        return activeSet ? *activeSet : resolve();
+    }
+
+    /**
+     * Portable byte-at-a-time reference implementation
+     */
+    static const KernelSet& scalar();
+
+    /**
+     * Kernel sets usable on this CPU, scalar first (for equivalence tests and benchmarks)
+     * @return Number of entries written to sets
+     */
+    static size_t available(const KernelSet** sets, size_t maxSets);
+
+    /**
+     * Override the active kernel set by name ("scalar", "swar", "sse2", "avx2", "neon")
+     * @return false if that set is not available on this CPU
+     */
+    static bool select(const char* name);
+
+private:
+    static const KernelSet& resolve();
+    static const KernelSet* activeSet;
+};
+
+#endif // DEVICEFRAMEWORK_TEMPLATE_KERNELS_H
@@ -73,6 +73,33 @@ public:
      */
     static void initializeContext(DeviceFrameworkTemplateContext& ctx, const char* templateData, bool templateInProgmem);
 
+    /**
+     * Initialize rendering context with a template compiled by DFTE_TEMPLATE
+     * Literal runs and tokens come from the compile-time segment table instead of a runtime scan
+     *
+     * @param ctx Context to initialize
+     * @param staticTemplate Static template (must outlive the render)
+     */
+    static void initializeContext(DeviceFrameworkTemplateContext& ctx, const StaticTemplate& staticTemplate);
+
+    /**
+     * Initialize rendering context with a template generated by tools/dfte_template_compiler.py
+     * The generated emitter writes literal runs directly; only placeholders go through the registry
+     *
+     * @param ctx Context to initialize
+     * @param compiledTemplate Generated template descriptor (must outlive the render)
+     */
+    static void initializeContext(DeviceFrameworkTemplateContext& ctx, const CompiledTemplate& compiledTemplate);
+
+    /**
+     * Initialize rendering context with a template in the tokenized format
+     * Placeholders are varint ids resolved through the registry token index instead of by name
+     *
+     * @param ctx Context to initialize
+     * @param tokenizedTemplate Encoded template descriptor (must outlive the render)
+     */
+    static void initializeContext(DeviceFrameworkTemplateContext& ctx, const TokenizedTemplate& tokenizedTemplate);
+
     /**
      * Check if rendering is complete
      */
@@ -85,6 +112,7 @@ public:
 
     /**
      * Helper constructors for RenderOutcome
+     * Kept for callers that report step results; the render loop itself updates the context in place
      */
     static RenderOutcome makeWritten(size_t bytes, TemplateRenderState state, bool repeat = false);
     static RenderOutcome makeState(TemplateRenderState nextState, bool repeat = true);
@@ -92,16 +120,19 @@ public:
     static RenderOutcome makeError();
 
 private:
-    static RenderOutcome renderChunk(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen);
-    static bool applyStackCommands(DeviceFrameworkTemplateContext& ctx, const RenderOutcome& outcome);
-
-    // Core processing methods
-    static RenderOutcome consumeTemplateText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen);
-    static RenderOutcome buildPlaceholderToken(DeviceFrameworkTemplateContext& ctx);
-    static RenderOutcome resolvePlaceholder(DeviceFrameworkTemplateContext& ctx);
-    static RenderOutcome emitActiveContext(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen);
-    static RenderOutcome streamPlaceholderData(DeviceFrameworkTemplateContext& ctx, RenderingContext* context, uint8_t* buffer, size_t maxLen);
-    static RenderOutcome handleTemplateCompletion(DeviceFrameworkTemplateContext& ctx);
+    // Step handlers: write at buffer, add the bytes to `written` and move ctx.state in place.
+    // They return false when the loop should stop without output (waiting on template data or failed).
+    static bool consumeTemplateText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool consumeTokenizedText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool consumePlannedText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool buildPlaceholderToken(DeviceFrameworkTemplateContext& ctx);
+    static bool resolvePlaceholder(DeviceFrameworkTemplateContext& ctx);
+    static bool dispatchPlaceholder(DeviceFrameworkTemplateContext& ctx, const PlaceholderEntry* entry, bool tailPosition);
+    static bool emitActiveContext(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool emitCompiledTemplate(DeviceFrameworkTemplateContext& ctx, RenderingContext* context, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool streamPlaceholderData(DeviceFrameworkTemplateContext& ctx, RenderingContext* context, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool streamWriterData(DeviceFrameworkTemplateContext& ctx, RenderingContext* context, uint8_t* buffer, size_t maxLen, size_t& written);
+    static bool handleTemplateCompletion(DeviceFrameworkTemplateContext& ctx);
 
     // Constants
     static constexpr size_t MAX_ITERATIONS = DFTE_MAX_ITERATIONS;
@@ -2,6 +2,7 @@
 #define DEVICEFRAMEWORK_TEMPLATE_TYPES_H
 
 #include <Arduino.h>
+#include <atomic>
 
 // Fallback defaults when DeviceFrameworkConfig is not available (standalone usage)
 // Always use internal macro names (DFTE_*) to avoid conflicts with DeviceFrameworkConfig extern declarations
@@ -24,21 +25,48 @@
   #define DFTE_PLACEHOLDER_NAME_SIZE DFTE_PLACEHOLDER_NAME_SIZE_DEFAULT
 #endif
 
+// Hash slots for the per-iterator index of item placeholders (power of two; items with more placeholders
+// than half the slots are scanned instead)
+#ifndef DFTE_ITERATOR_SCOPE_SLOTS
+  #define DFTE_ITERATOR_SCOPE_SLOTS 16
+#endif
+
+// Bytes a writer placeholder may produce past the end of the chunk buffer; they are kept in the frame and
+// written first in the next chunk (covers any formatted number, so short values never need a resume)
+#ifndef DFTE_WRITER_SPILL_SIZE
+  #define DFTE_WRITER_SPILL_SIZE 24
+#endif
+
+// Text of a formatted TYPED_VALUE, kept in its data frame (longest value: "-9223372036854775808")
+#define DFTE_TYPED_TEXT_SIZE 24
+
 /**
  * Placeholder types for template substitution
  */
-enum class PlaceholderType {
+enum class PlaceholderType : uint8_t {
     PROGMEM_DATA,      // Large PROGMEM data (CSS, JS, base64 images)
     PROGMEM_TEMPLATE,  // Nested template in PROGMEM
     RAM_DATA,           // Dynamic RAM data via getter functions
     DYNAMIC_DATA,       // Dynamic RAM data via getter + userData, rendered as raw bytes
     DYNAMIC_TEMPLATE,
     CONDITIONAL,
-    ITERATOR
+    ITERATOR,
+    STATIC_TEMPLATE,    // Nested template compiled with DFTE_TEMPLATE (flash-resident segment table)
+    COMPILED_TEMPLATE,  // Nested template generated by tools/dfte_template_compiler.py (emitter function)
+    TOKENIZED_TEMPLATE, // Nested template in the tokenized binary format (varint placeholder ids)
+    SIZED_DATA,         // RAM data via getter + userData returning pointer and length (binary-safe, no strlen)
+    WRITER_DATA,        // Callback formats the value straight into the chunk buffer through a bounded writer
+    TYPED_VALUE,        // Number, bool, IPv4 address or duration read from a variable or accessor and formatted per render
+    PRODUCER_DATA,      // Content of any size pulled in chunk-sized pieces from a read callback (optional open/close)
+    RING_DATA,          // Circular RAM buffer streamed oldest to newest as two segments, without linearizing it
+    PROVIDER_FIELD      // Typed field of a struct filled by a shared provider callback once per render or TTL
 };
 
 /**
  * Function pointer types for placeholder data access
+ * Data getters run once per rendered occurrence; the returned buffer must stay valid and unchanged until
+ * that value has been streamed (it may span several chunks). Memoized getters follow the same rule: the
+ * render keeps its own copy in the scratch arena for later occurrences.
  */
 typedef const char* (*PlaceholderDataGetter)();
 typedef size_t (*PlaceholderLengthGetter)(const void* data);
@@ -53,6 +81,33 @@ enum class ConditionalBranchResult {
 
 typedef ConditionalBranchResult (*ConditionalEvaluator)(void* userData);
 
+/**
+ * Value with an explicit length (may contain NULs; need not be terminated)
+ */
+struct PlaceholderValue {
+    const char* data;
+    size_t length;
+};
+
+typedef PlaceholderValue (*SizedDataGetter)(void* userData);
+
+class DeviceFrameworkPlaceholderWriter;
+
+/**
+ * Writer callback (WRITER_DATA): format the value into `writer`, which points at the caller's chunk buffer
+ * @return true once the value is complete; false to be called again on the next chunk (resume from writer.cookie())
+ */
+typedef bool (*PlaceholderWriterCallback)(DeviceFrameworkPlaceholderWriter& writer, void* userData);
+
+/**
+ * Producer callbacks (PRODUCER_DATA): content is pulled piece by piece straight into the chunk buffer
+ * read copies up to maxLen bytes starting at `offset` into dest and returns the count; 0 ends the value.
+ * Short reads are fine. `handle` is what open returned, or the descriptor's userData when there is no open.
+ */
+typedef void* (*ProducerOpenHandler)(void* userData);
+typedef size_t (*ProducerReadHandler)(void* handle, size_t offset, uint8_t* dest, size_t maxLen);
+typedef void (*ProducerCloseHandler)(void* handle);
+
 enum class IteratorStepResult {
     ITEM_READY,
     COMPLETE,
@@ -71,6 +126,88 @@ struct DynamicDataDescriptor {
     void* userData;
 };
 
+struct SizedDataDescriptor {
+    SizedDataGetter getter;
+    void* userData;
+};
+
+struct WriterDataDescriptor {
+    PlaceholderWriterCallback write;
+    void* userData;
+};
+
+/**
+ * Circular buffer (RING_DATA): bytes from tail up to head, wrapping at capacity
+ * Indices are positions in [0, capacity). head == tail is an empty ring unless `full` says otherwise,
+ * which lets logs that overwrite their oldest bytes keep tail == head once they have wrapped.
+ * The renderer loads the indices with acquire ordering, so a writer on another task or core stores the
+ * bytes first and then publishes head (and tail, full) with release ordering.
+ */
+struct RingBufferDescriptor {
+    const char* base;                 // Storage, `capacity` bytes
+    size_t capacity;
+    const std::atomic<size_t>* head;  // Next write position
+    const std::atomic<size_t>* tail;  // Oldest byte
+    const std::atomic<bool>* full;    // Optional
+};
+
+/**
+ * Ring contents at one instant: `first` (tail to the end of storage) then `second` (start of storage to head)
+ */
+struct RingBufferSnapshot {
+    const char* first;
+    size_t firstLength;
+    const char* second;
+    size_t secondLength;
+};
+
+struct ProducerDescriptor {
+    ProducerOpenHandler open;    // Optional: called once when the token is reached; nullptr result renders nothing
+    ProducerReadHandler read;    // Required
+    ProducerCloseHandler close;  // Optional: called once for every successful open, also when a render is abandoned
+    void* userData;
+};
+
+/**
+ * Typed values (TYPED_VALUE): the renderer reads the value when it reaches the token and formats it itself
+ */
+enum class TypedValueKind : uint8_t {
+    INT32,
+    UINT32,
+    INT64,
+    FIXED,      // float with `decimals` digits after the point
+    BOOLEAN,    // trueText / falseText
+    IPV4,       // uint32_t as converted from IPAddress (first octet in the low byte)
+    DURATION    // uint32_t seconds as h:mm:ss (hours not wrapped)
+};
+
+typedef int64_t (*TypedIntAccessor)(void* userData);
+typedef float (*TypedFloatAccessor)(void* userData);
+
+struct TypedValueDescriptor {
+    TypedValueKind kind;
+    uint8_t decimals;               // FIXED: digits after the point (0-6)
+    const void* address;            // Variable of the kind's type read at render time, or nullptr to call an accessor
+    TypedIntAccessor readInt;       // All kinds but FIXED
+    TypedFloatAccessor readFloat;   // FIXED
+    void* userData;
+    const char* trueText;           // BOOLEAN texts (RAM strings)
+    const char* falseText;
+};
+
+/**
+ * Grouped providers (PROVIDER_FIELD): one callback fills a struct, several placeholders format its fields
+ * @return false if the sample could not be taken (the previous values are rendered)
+ */
+typedef bool (*DataProviderCallback)(void* sample, void* userData);
+
+class DeviceFrameworkDataProvider;
+
+struct ProviderFieldDescriptor {
+    DeviceFrameworkDataProvider* provider;
+    TypedValueDescriptor field;   // Address form, pointing into the provider's sample struct
+};
+
 struct DynamicTemplateDescriptor {
     DynamicTemplateGetter getter;
     DynamicTemplateLengthGetter getLength;
@@ -86,27 +223,44 @@ struct ConditionalDescriptor {
 
 /**
  * Placeholder definition entry
- * Represents a single registered placeholder in the registry
+ * Represents a single registered placeholder in the registry (24 bytes on 32-bit targets)
+ *
+ * Fields the renderer reads while streaming come first; the name is only touched by lookups.
+ * The name is not copied into the entry: registries point it at their interned name pool, static
+ * registries at the literal, and iterator override arrays can share one literal across all items.
  */
 struct PlaceholderEntry {
-    // Allocated to configured size - matches CONFIG_templatePlaceholderNameSize when DeviceFramework is present
-    char name[DFTE_PLACEHOLDER_NAME_SIZE];
-    PlaceholderType type;
+    // Render fields
     const void* data;
     PlaceholderLengthGetter getLength;
-    size_t cachedLength;
+    uint32_t cachedLength;      // Flash objects and RAM values stay far below 4 GB
+    PlaceholderType type;
     bool hasCachedLength;
+    bool memoize;               // Value or branch is computed once per render and reused (opt-in at registration)
+
+    // Lookup fields
+    uint32_t nameHash;          // FNV-1a of name, set by registries (0 = not hashed, compare by name)
+    const char* name;           // "%NAME%", not owned
     
-    PlaceholderEntry() 
-        : type(PlaceholderType::RAM_DATA), 
-          data(nullptr), 
+    // constexpr so DFTE_STATIC_REGISTRY can build entry tables at compile time
+    constexpr PlaceholderEntry() 
+        : data(nullptr), 
           getLength(nullptr),
           cachedLength(0),
-          hasCachedLength(false) {
-        name[0] = '\0';
+          type(PlaceholderType::RAM_DATA), 
+          hasCachedLength(false),
+          memoize(false),
+          nameHash(0),
+          name(nullptr) {
     }
 };
 
+/**
+ * Iterator item view (filled by IteratorNextHandler for each item)
+ * placeholders are item-scoped entries; they are checked before the registry for tokens in the item template.
+ * Rows that reuse one placeholders array must keep the same names in it: the iterator indexes the names
+ * once and only re-indexes when the array pointer or count changes.
+ */
 struct IteratorItemView {
     const char* templateData;
     size_t templateLength;
@@ -122,16 +276,109 @@ struct IteratorDescriptor {
     void* userData;
 };
 
+class DeviceFrameworkPlaceholderRegistry;
+
+/**
+ * Pre-parsed template segments
+ * LITERAL covers template bytes [offset, offset + length).
+ * PLACEHOLDER and TOKEN cover a whole %NAME% token; PLACEHOLDER carries the registry entry it resolved to,
+ * TOKEN is a name the registry did not know when the plan was built (resolved against iterator overrides).
+ */
+enum class TemplateSegmentKind : uint8_t {
+    LITERAL,
+    PLACEHOLDER,
+    TOKEN
+};
+
+struct TemplateSegment {
+    uint32_t offset;
+    uint32_t length;
+    const PlaceholderEntry* entry;
+    TemplateSegmentKind kind;
+};
+
+/**
+ * Template parsed at compile time (see DFTE_TEMPLATE in DeviceFrameworkStaticTemplate.h)
+ * text and segments live in PROGMEM; segments hold LITERAL and TOKEN entries only.
+ */
+struct StaticTemplate {
+    const char* text;
+    size_t length;
+    const TemplateSegment* segments;
+    uint16_t segmentCount;
+};
+
+/**
+ * Tokenized template format (tools/dfte_template_compiler.py --format tokenized)
+ * Literal bytes, with every %NAME% token replaced by DFTE_TOKEN_ESCAPE followed by the token id as an
+ * unsigned LEB128 varint (7 bits per byte, high bit set on all but the last byte).
+ * Text templates are NUL-terminated, so the escape byte can never appear in literal text.
+ */
+#define DFTE_TOKEN_ESCAPE 0x00
+
+struct TokenTable {
+    const char* const* names;  // PROGMEM table of PROGMEM "%NAME%" strings, indexed by token id
+    uint16_t count;
+};
+
+struct TokenizedTemplate {
+    const char* data;          // PROGMEM encoded body (not NUL-terminated; may contain escape bytes)
+    size_t length;
+    const TokenTable* tokens;  // Table the ids refer to (shared by every template from one converter run)
+};
+
+/**
+ * Template generated ahead of time by tools/dfte_template_compiler.py
+ * The emitter is a switch over cursor.resumePoint: it copies literal runs with memcpy_P and stops at each
+ * placeholder, reporting its id in the placeholders table so the renderer can push it.
+ */
+struct CompiledTemplateCursor {
+    uint16_t resumePoint;  // Generated case label to continue from (DFTE_COMPILED_TEMPLATE_DONE at the end)
+    size_t offset;         // Bytes of the current literal run already emitted
+};
+
+#define DFTE_COMPILED_TEMPLATE_DONE 0xFFFF
+
+/**
+ * Emit literal bytes from the cursor until maxLen is reached, a placeholder is hit or the template ends
+ * @param placeholderIndex Set to the placeholder index when the emitter stopped at one, -1 otherwise
+ * @return Bytes written to buffer
+ */
+typedef size_t (*CompiledTemplateEmitter)(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex);
+
+struct CompiledTemplate {
+    CompiledTemplateEmitter emit;
+    TokenTable placeholders;  // Names the emitter's placeholder ids refer to
+};
+
+/**
+ * Compiled template plan
+ * Built once per (template pointer, registry generation) and shared by every context rendering that template.
+ * The registry plan cache and every frame walking it hold a reference; whoever drops the last one frees it,
+ * so contexts rendering on other tasks can keep a plan the cache has already evicted.
+ */
+struct TemplatePlan {
+    const char* templateData;
+    const DeviceFrameworkPlaceholderRegistry* owner;
+    uint32_t generation;
+    TemplateSegment* segments;  // nullptr when the template is not worth caching (interpret instead)
+    uint16_t segmentCount;
+    std::atomic<uint32_t> refCount;  // Frames pinning the plan, plus one while the cache holds it; freed at 0
+};
+
 /**
  * Rendering context types - what kind of thing are we currently rendering?
  */
 enum class RenderingContextType {
     TEMPLATE,              // Rendering a template (contains placeholders)
-    PLACEHOLDER_DATA,      // Rendering a data placeholder (PROGMEM_DATA, RAM_DATA)
+    PLACEHOLDER_DATA,      // Rendering a data placeholder (PROGMEM_DATA, RAM_DATA, DYNAMIC_DATA, SIZED_DATA, TYPED_VALUE,
+                           // PRODUCER_DATA, RING_DATA, PROVIDER_FIELD)
     PLACEHOLDER_TEMPLATE,   // Rendering a template placeholder (resolved to template)
     PLACEHOLDER_DYNAMIC_TEMPLATE,
     PLACEHOLDER_CONDITIONAL,
-    PLACEHOLDER_ITERATOR
+    PLACEHOLDER_ITERATOR,
+    COMPILED_TEMPLATE,     // Rendering a generated template emitter
+    PLACEHOLDER_WRITER     // Rendering a WRITER_DATA placeholder (callback writes into the chunk buffer)
 };
 
 /**
@@ -142,6 +389,7 @@ enum class RenderingContextType {
 struct RenderingContext {
     RenderingContextType type;
     const char* name;  // Placeholder name or template identifier
+    uint16_t tailDepth;  // Finished caller frames this frame replaced (chained tail-position includes)
     
     // Type-specific data (using union to save memory)
     union {
@@ -156,14 +404,40 @@ struct RenderingContext {
             size_t bufferOffset;       // Offset in template where buffer starts
             const PlaceholderEntry* iteratorPlaceholders;
             size_t iteratorPlaceholderCount;
+            const TemplatePlan* plan;  // Pinned compiled plan (PROGMEM templates), nullptr when interpreting
+            size_t segmentIndex;       // Next plan segment to emit
+            bool planResolved;         // Plan lookup already attempted for this frame
+            const StaticTemplate* compiled;  // Compile-time segment table for this template, if any
+            const TokenTable* tokens;  // Token table when the template is tokenized, nullptr for text
         } templateCtx;
         
         // PLACEHOLDER_DATA context
         struct {
             const PlaceholderEntry* entry;
             size_t offset;  // Current offset in data
+            const char* value;  // RAM_DATA/DYNAMIC_DATA/SIZED_DATA getter result, taken once when the frame is pushed
+            size_t length;      // Bytes to stream, fixed at push so every chunk agrees on the same value
+            union {
+                char text[DFTE_TYPED_TEXT_SIZE];  // TYPED_VALUE / PROVIDER_FIELD formatted at push (value points here)
+                struct {
+                    const char* wrapData;  // RING_DATA second segment; value is the first
+                    size_t split;          // RING_DATA offset where the second segment starts
+                } ring;
+            };
+            void* handle;       // PRODUCER_DATA read handle (open result or userData)
+            bool handleOpen;    // PRODUCER_DATA handle must be closed when the frame goes away
         } data;
         
+        // PLACEHOLDER_WRITER context
+        struct {
+            const WriterDataDescriptor* descriptor;
+            uint32_t cookie;       // Callback resume state, 0 on the first call
+            uint8_t spillPos;      // Spilled bytes already written
+            uint8_t spillLen;      // Bytes the last call wrote past the chunk buffer
+            bool finished;         // Callback reported the value complete; pop once the spill is written
+            char spill[DFTE_WRITER_SPILL_SIZE];
+        } writer;
+
         // PLACEHOLDER_TEMPLATE context
         struct {
             const PlaceholderEntry* entry;
@@ -191,11 +465,21 @@ struct RenderingContext {
             void* handle;
             bool initialized;
             bool handleOpen;
+            uint8_t indexedCount;      // Item placeholders in the scope index (0 = no index, scan instead)
+            uint32_t indexedNames;     // Signature of the name pointers the index was built for, in order
+            uint8_t indexSlots[DFTE_ITERATOR_SCOPE_SLOTS];  // Open addressing by name hash: item index + 1, 0 = empty
+            uint8_t indexTags[DFTE_ITERATOR_SCOPE_SLOTS];   // Top hash byte per slot, rejects most probes without strcmp
         } iterator;
+
+        // COMPILED_TEMPLATE context
+        struct {
+            const CompiledTemplate* compiled;
+            CompiledTemplateCursor cursor;
+        } compiledTemplate;
     } context;
     
     RenderingContext() 
-        : type(RenderingContextType::TEMPLATE), name(nullptr) {
+        : type(RenderingContextType::TEMPLATE), name(nullptr), tailDepth(0) {
         memset(&context, 0, sizeof(context));
     }
 };
@@ -0,0 +1,100 @@
+#ifndef DEVICEFRAMEWORK_TYPED_VALUE_H
+#define DEVICEFRAMEWORK_TYPED_VALUE_H
+
+#include <Arduino.h>
+#include "DeviceFrameworkTemplateTypes.h"
+
+/**
+ * DeviceFramework Typed Value
+ * Descriptor builders and allocation-free formatting for TYPED_VALUE placeholders
+ *
+ * A typed placeholder binds a variable (or an accessor) instead of a string getter. The renderer reads it
+ * when it reaches the token and formats the text into the data frame, replacing getters such as
+ *   const char* getUptime() { buffer = String(millis() / 1000) + "s"; return buffer.c_str(); }
+ * that allocate on every request and share one static buffer between concurrent renders.
+ *
+ * Usage:
+ *   static int32_t rssi;
+ *   static float temperature;
+ *   static const TypedValueDescriptor kRssi = TypedValue::ofInt32(&rssi);
+ *   static const TypedValueDescriptor kTemp = TypedValue::ofFixed(&temperature, 1);
+ *   static const TypedValueDescriptor kUptime = TypedValue::ofDuration(readUptimeSeconds);
+ *   registry.registerTypedValue("%RSSI%", &kRssi);
+ *
+ * The formatters write digits without a terminator and return the length; they are also what
+ * PlaceholderWriter's print helpers use.
+ */
+class DeviceFrameworkTypedValue {
+public:
+    // Longest text any kind formats to (BOOLEAN points at its own strings instead)
+    static constexpr size_t MAX_TEXT = DFTE_TYPED_TEXT_SIZE;
+    static constexpr uint8_t MAX_DECIMALS = 6;
+
+    static constexpr TypedValueDescriptor ofInt32(const int32_t* value) {
+        return {TypedValueKind::INT32, 0, value, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofInt32(TypedIntAccessor read, void* userData = nullptr) {
+        return {TypedValueKind::INT32, 0, nullptr, read, nullptr, userData, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofUint32(const uint32_t* value) {
+        return {TypedValueKind::UINT32, 0, value, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofUint32(TypedIntAccessor read, void* userData = nullptr) {
+        return {TypedValueKind::UINT32, 0, nullptr, read, nullptr, userData, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofInt64(const int64_t* value) {
+        return {TypedValueKind::INT64, 0, value, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofInt64(TypedIntAccessor read, void* userData = nullptr) {
+        return {TypedValueKind::INT64, 0, nullptr, read, nullptr, userData, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofFixed(const float* value, uint8_t decimals) {
+        return {TypedValueKind::FIXED, decimals, value, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofFixed(TypedFloatAccessor read, uint8_t decimals, void* userData = nullptr) {
+        return {TypedValueKind::FIXED, decimals, nullptr, nullptr, read, userData, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofBool(const bool* value, const char* trueText = "true", const char* falseText = "false") {
+        return {TypedValueKind::BOOLEAN, 0, value, nullptr, nullptr, nullptr, trueText, falseText};
+    }
+    static constexpr TypedValueDescriptor ofBool(TypedIntAccessor read, const char* trueText = "true",
+                                                  const char* falseText = "false", void* userData = nullptr) {
+        return {TypedValueKind::BOOLEAN, 0, nullptr, read, nullptr, userData, trueText, falseText};
+    }
+    static constexpr TypedValueDescriptor ofIPv4(const uint32_t* address) {
+        return {TypedValueKind::IPV4, 0, address, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofIPv4(TypedIntAccessor read, void* userData = nullptr) {
+        return {TypedValueKind::IPV4, 0, nullptr, read, nullptr, userData, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofDuration(const uint32_t* seconds) {
+        return {TypedValueKind::DURATION, 0, seconds, nullptr, nullptr, nullptr, nullptr, nullptr};
+    }
+    static constexpr TypedValueDescriptor ofDuration(TypedIntAccessor read, void* userData = nullptr) {
+        return {TypedValueKind::DURATION, 0, nullptr, read, nullptr, userData, nullptr, nullptr};
+    }
+
+    /**
+     * Check a descriptor before it is registered (a value source, decimals in range, BOOLEAN texts set)
+     */
+    static bool isValid(const TypedValueDescriptor* descriptor);
+
+    /**
+     * Read the current value and format it
+     * @param text At least MAX_TEXT bytes; receives the text (not terminated) unless the value is a BOOLEAN
+     * @return The text: `text` itself, or the BOOLEAN string
+     */
+    static PlaceholderValue format(const TypedValueDescriptor& descriptor, char* text);
+
+    // Number formatting; each returns the characters written (no terminator)
+    static size_t formatUnsigned(uint32_t value, char* out);
+    static size_t formatSigned(int32_t value, char* out);
+    static size_t formatUnsigned64(uint64_t value, char* out);
+    static size_t formatSigned64(int64_t value, char* out);
+    // Rounded half away from zero; "nan", "inf", "-inf", and "ovf" past 1e15 after scaling
+    static size_t formatFixed(float value, uint8_t decimals, char* out);
+    static size_t formatIPv4(uint32_t address, char* out);
+    static size_t formatDuration(uint32_t seconds, char* out);
+};
+
+#endif // DEVICEFRAMEWORK_TYPED_VALUE_H
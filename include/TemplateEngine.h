@@ -37,12 +37,34 @@
 #include "DeviceFrameworkTemplateRenderer.h"
 #include "DeviceFrameworkTemplateContext.h"
 #include "DeviceFrameworkPlaceholderRegistry.h"
+#include "DeviceFrameworkStaticPlaceholderRegistry.h"
+#include "DeviceFrameworkPlaceholderOverlay.h"
+#include "DeviceFrameworkConcurrentPlaceholderRegistry.h"
+#include "DeviceFrameworkCachedValue.h"
+#include "DeviceFrameworkPlaceholderWriter.h"
+#include "DeviceFrameworkTypedValue.h"
+#include "DeviceFrameworkDataProvider.h"
+#include "DeviceFrameworkScratchArena.h"
+#include "DeviceFrameworkCallable.h"
 #include "DeviceFrameworkTemplateEngineDebug.h"
+#include "DeviceFrameworkStaticTemplate.h"
+#include "DeviceFrameworkCompiledTemplate.h"
 
 // Type aliases for convenience
 using TemplateRenderer = DeviceFrameworkTemplateRenderer;
 using TemplateContext = DeviceFrameworkTemplateContext;
 using PlaceholderRegistry = DeviceFrameworkPlaceholderRegistry;
+using StaticPlaceholderRegistry = DeviceFrameworkStaticPlaceholderRegistry;
+using PlaceholderOverlay = DeviceFrameworkPlaceholderOverlay;
+using ConcurrentPlaceholderRegistry = DeviceFrameworkConcurrentPlaceholderRegistry;
+using CachedValue = DeviceFrameworkCachedValue;
+using PlaceholderWriter = DeviceFrameworkPlaceholderWriter;
+using TypedValue = DeviceFrameworkTypedValue;
+using DataProvider = DeviceFrameworkDataProvider;
+using ScratchArena = DeviceFrameworkScratchArena;
+using ScratchArenaPool = DeviceFrameworkScratchArenaPool;
+template <typename Signature, size_t Capacity = DFTE_CALLABLE_STORAGE_DEFAULT>
+using Callable = DeviceFrameworkCallable<Signature, Capacity>;
 
 #endif // TEMPLATE_ENGINE_H
 
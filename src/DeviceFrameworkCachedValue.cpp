@@ -0,0 +1,212 @@
+#include "DeviceFrameworkCachedValue.h"
+#include "DeviceFrameworkScratchArena.h"
+#include "DeviceFrameworkTemplateContext.h"
+#include "DeviceFrameworkTemplateEngineDebug.h"
+#include <new>
+
+DeviceFrameworkCachedValue::DeviceFrameworkCachedValue(PlaceholderDataGetter getter, uint32_t ttlMs, uint32_t refreshAheadMs,
+                                                       size_t capacity)
+    : ramGetter(getter), dynamicGetter(nullptr), userData(nullptr), ttlMs(ttlMs), refreshAheadMs(refreshAheadMs),
+      capacity(capacity), buffers(nullptr), lengths{0, 0}, descriptor{getCachedValue, getCachedLength, this},
+      current(NO_VALUE), refreshedAt(0), invalidations(0), hits(0), misses(0), refreshes(0) {
+    allocate();
+}
+
+DeviceFrameworkCachedValue::DeviceFrameworkCachedValue(DynamicTemplateGetter getter, void* userData, uint32_t ttlMs,
+                                                       uint32_t refreshAheadMs, size_t capacity)
+    : ramGetter(nullptr), dynamicGetter(getter), userData(userData), ttlMs(ttlMs), refreshAheadMs(refreshAheadMs),
+      capacity(capacity), buffers(nullptr), lengths{0, 0}, descriptor{getCachedValue, getCachedLength, this},
+      current(NO_VALUE), refreshedAt(0), invalidations(0), hits(0), misses(0), refreshes(0) {
+    allocate();
+}
+
+DeviceFrameworkCachedValue::~DeviceFrameworkCachedValue() {
+    delete[] buffers;
+}
+
+void DeviceFrameworkCachedValue::allocate() {
+    if (ttlMs > 0 && refreshAheadMs >= ttlMs) {
+        // A window as long as the TTL would make every value due as soon as it is stored
+        DFTE_LOG_WARN("Cached value refresh-ahead " + String(refreshAheadMs) + " ms not below its TTL, using " +
+                      String(ttlMs / 2) + " ms");
+        refreshAheadMs = ttlMs / 2;
+    }
+    if (capacity == 0) {
+        DFTE_LOG_ERROR("Cached value capacity must be at least 1");
+        return;
+    }
+    buffers = new (std::nothrow) char[capacity * 2];
+    if (buffers == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate cached value buffers (" + String(static_cast<uint32_t>(capacity * 2)) + " bytes)");
+        return;
+    }
+    buffers[0] = '\0';
+    buffers[capacity] = '\0';
+}
+
+const char* DeviceFrameworkCachedValue::get() {
+    // A render reads one value throughout: later get() calls return its first copy, whatever the TTL says
+    DeviceFrameworkTemplateContext* ctx = DeviceFrameworkTemplateContext::rendering();
+    const DeviceFrameworkTemplateContext::CacheSlot* slot = ctx ? ctx->findCachedCopy(this) : nullptr;
+    if (slot != nullptr && slot->value != nullptr) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return slot->value;
+    }
+
+    if (current.load(std::memory_order_acquire) != NO_VALUE) {
+        // An expired value is still served while another task runs the getter: requests never wait for it
+        if (!isDue(millis(), 0) || !refreshing.tryLock()) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return serve();
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+        if (isDue(millis(), 0)) {
+            refreshLocked();
+        }
+        refreshing.unlock();
+        return serve();
+    }
+
+    // Nothing to serve yet: concurrent first renders wait for the one fill in flight instead of repeating it
+    misses.fetch_add(1, std::memory_order_relaxed);
+    if (!refreshing.awaitLock()) {
+        DFTE_LOG_TRACE("Cached value still being computed, rendering it empty");
+        return "";
+    }
+    if (isDue(millis(), 0)) {
+        refreshLocked();
+    }
+    refreshing.unlock();
+    return serve();
+}
+
+const char* DeviceFrameworkCachedValue::serve() {
+    int8_t index = current.load(std::memory_order_acquire);
+    if (index == NO_VALUE) {
+        return "";
+    }
+    // Outside a render, or once this render failed to copy the value, the buffer itself is served
+    DeviceFrameworkTemplateContext* ctx = DeviceFrameworkTemplateContext::rendering();
+    if (ctx == nullptr || ctx->findCachedCopy(this) != nullptr) {
+        return buffers + index * capacity;
+    }
+    if (ctx->cachedCopyCount >= DeviceFrameworkTemplateContext::CACHE_SLOTS) {
+        DFTE_LOG_WARN("Render cached value table full, cached value read from its buffer");
+        return buffers + index * capacity;
+    }
+
+    // A refresh publishes under the same lock, so the buffer cannot be rewritten mid-copy
+    DeviceFrameworkScratchArena* scratch = ctx->getScratchArena();
+    buffersLock.lock();
+    index = current.load(std::memory_order_relaxed);
+    const char* value = buffers + index * capacity;
+    size_t length = lengths[index];
+    const char* copy = scratch ? scratch->copy(value, length) : nullptr;
+    buffersLock.unlock();
+    if (copy == nullptr) {
+        DFTE_LOG_WARN("Scratch arena full, cached value read from its buffer for the rest of the render");
+    }
+    ctx->storeCachedCopy(this, copy, length);
+    return copy ? copy : value;
+}
+
+bool DeviceFrameworkCachedValue::refresh() {
+    if (!refreshing.awaitLock()) {
+        DFTE_LOG_TRACE("Cached value refresh already in flight");
+        return false;
+    }
+    bool refreshed = refreshLocked();
+    refreshing.unlock();
+    return refreshed;
+}
+
+bool DeviceFrameworkCachedValue::refreshIfDue() {
+    if (!isDue(millis(), refreshAheadMs)) {
+        return false;
+    }
+
+    // A render already refreshing is as good as this call doing it
+    if (!refreshing.tryLock()) {
+        return false;
+    }
+    bool refreshed = isDue(millis(), refreshAheadMs) && refreshLocked();
+    refreshing.unlock();
+    return refreshed;
+}
+
+void DeviceFrameworkCachedValue::invalidate() {
+    // A getter already running may have read the old state: its value is published expired as well
+    buffersLock.lock();
+    invalidations.fetch_add(1, std::memory_order_relaxed);
+    refreshedAt.store(millis() - ttlMs, std::memory_order_relaxed);
+    buffersLock.unlock();
+}
+
+void DeviceFrameworkCachedValue::resetStats() {
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+    refreshes.store(0, std::memory_order_relaxed);
+}
+
+bool DeviceFrameworkCachedValue::isDue(uint32_t now, uint32_t margin) const {
+    if (current.load(std::memory_order_acquire) == NO_VALUE) {
+        return true;
+    }
+    uint32_t age = now - refreshedAt.load(std::memory_order_relaxed);
+    return age + (margin < ttlMs ? margin : ttlMs) >= ttlMs;
+}
+
+bool DeviceFrameworkCachedValue::refreshLocked() {
+    if (buffers == nullptr || (ramGetter == nullptr && dynamicGetter == nullptr)) {
+        return false;
+    }
+
+    // The getter runs outside buffersLock: renders keep copying the current value meanwhile
+    uint32_t invalidated = invalidations.load(std::memory_order_relaxed);
+    const char* value = ramGetter ? ramGetter() : dynamicGetter(userData);
+    refreshes.fetch_add(1, std::memory_order_relaxed);
+
+    // Write the buffer readers are not using, then publish it
+    buffersLock.lock();
+    int8_t index = current.load(std::memory_order_relaxed) == 0 ? 1 : 0;
+    char* target = buffers + index * capacity;
+    size_t length = value ? strlen(value) : 0;
+    if (length >= capacity) {
+        DFTE_LOG_WARN("Cached value truncated from " + String(static_cast<uint32_t>(length)) + " to " +
+                      String(static_cast<uint32_t>(capacity - 1)) + " bytes");
+        length = capacity - 1;
+    }
+    if (length > 0) {
+        memcpy(target, value, length);
+    }
+    target[length] = '\0';
+    lengths[index] = length;
+
+    uint32_t now = millis();
+    bool expired = invalidations.load(std::memory_order_relaxed) != invalidated;
+    refreshedAt.store(expired ? now - ttlMs : now, std::memory_order_relaxed);
+    current.store(index, std::memory_order_release);
+    buffersLock.unlock();
+    return true;
+}
+
+const char* DeviceFrameworkCachedValue::getCachedValue(void* userData) {
+    return static_cast<DeviceFrameworkCachedValue*>(userData)->get();
+}
+
+size_t DeviceFrameworkCachedValue::getCachedLength(const char* data, void* userData) {
+    // The length was measured on refresh; data is the render's copy or one of the two buffers
+    const DeviceFrameworkCachedValue* cache = static_cast<const DeviceFrameworkCachedValue*>(userData);
+    DeviceFrameworkTemplateContext* ctx = DeviceFrameworkTemplateContext::rendering();
+    const DeviceFrameworkTemplateContext::CacheSlot* slot = ctx ? ctx->findCachedCopy(cache) : nullptr;
+    if (slot != nullptr && data == slot->value) {
+        return slot->length;
+    }
+    if (data == cache->buffers) {
+        return cache->lengths[0];
+    }
+    if (data == cache->buffers + cache->capacity) {
+        return cache->lengths[1];
+    }
+    return strlen(data);
+}
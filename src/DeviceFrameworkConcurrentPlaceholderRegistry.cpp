@@ -0,0 +1,387 @@
+#include "DeviceFrameworkConcurrentPlaceholderRegistry.h"
+#include "DeviceFrameworkTemplateEngineDebug.h"
+#include <new>
+
+// One allocation: this header, then the entries, the name index and the names they point at
+struct DeviceFrameworkConcurrentPlaceholderRegistry::Snapshot {
+    const PlaceholderEntry* entries;
+    const uint16_t* index;           // Open addressing over entries: entry index + 1, 0 = empty
+    uint32_t indexMask;
+    uint16_t count;
+    uint32_t version;
+    size_t bytes;
+    Snapshot* retiredNext;           // Writer-owned once replaced
+    uint32_t retireEpoch;            // First epoch whose readers cannot see this snapshot
+
+    const PlaceholderEntry* find(const char* name, uint32_t hash) const {
+        for (uint32_t slot = hash & indexMask;; slot = (slot + 1) & indexMask) {
+            uint16_t ref = index[slot];
+            if (ref == 0) {
+                return nullptr;
+            }
+            const PlaceholderEntry& entry = entries[ref - 1];
+            if (entry.nameHash == hash && strcmp(entry.name, name) == 0) {
+                return &entry;
+            }
+        }
+    }
+};
+
+DeviceFrameworkConcurrentPlaceholderRegistry::Reader::Reader(const DeviceFrameworkConcurrentPlaceholderRegistry& registry)
+    : registry(registry), snapshot(nullptr), slot(NO_SLOT) {
+    pin();
+}
+
+DeviceFrameworkConcurrentPlaceholderRegistry::Reader::~Reader() {
+    unpin();
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::Reader::refresh() {
+    unpin();
+    pin();
+    return isPinned();
+}
+
+uint32_t DeviceFrameworkConcurrentPlaceholderRegistry::Reader::getVersion() const {
+    return snapshot ? snapshot->version : 0;
+}
+
+const PlaceholderEntry* DeviceFrameworkConcurrentPlaceholderRegistry::Reader::getPlaceholder(const char* name) const {
+    if (name == nullptr || snapshot == nullptr || snapshot->count == 0) {
+        return nullptr;
+    }
+    return snapshot->find(name, hashName(name));
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::Reader::pin() {
+    // Announce the epoch before loading the pointer: a writer that swaps after this load sees the slot and
+    // keeps the snapshot; one that swapped before it means the load already returns the new snapshot
+    for (size_t i = 0; i < READER_SLOTS; ++i) {
+        uint32_t expected = 0;
+        uint32_t pinnedEpoch = registry.epoch.load();
+        if (registry.readerEpochs[i].compare_exchange_strong(expected, pinnedEpoch)) {
+            slot = static_cast<uint8_t>(i);
+            snapshot = registry.current.load();
+            return;
+        }
+    }
+    DFTE_LOG_ERROR("All concurrent registry reader slots are in use");
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::Reader::unpin() {
+    if (slot == NO_SLOT) {
+        return;
+    }
+    snapshot = nullptr;
+    registry.readerEpochs[slot].store(0);
+    slot = NO_SLOT;
+}
+
+DeviceFrameworkConcurrentPlaceholderRegistry::DeviceFrameworkConcurrentPlaceholderRegistry(uint16_t maxPlaceholders)
+    : staging(stagingCapacity(maxPlaceholders)), current(nullptr), epoch(1), retired(nullptr), version(0),
+      maxPlaceholders(maxPlaceholders) {
+    writerLock.clear();
+    for (size_t i = 0; i < READER_SLOTS; ++i) {
+        readerEpochs[i].store(0);
+    }
+
+    // Readers always find a snapshot, even before the first registration
+    lockWriters();
+    publishLocked();
+    unlockWriters();
+}
+
+DeviceFrameworkConcurrentPlaceholderRegistry::~DeviceFrameworkConcurrentPlaceholderRegistry() {
+    freeSnapshot(current.load());
+    while (retired != nullptr) {
+        Snapshot* next = retired->retiredNext;
+        freeSnapshot(retired);
+        retired = next;
+    }
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerProgmemData(const char* name, const char* progmemData) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerProgmemData(name, progmemData); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerProgmemTemplate(const char* name, const char* progmemTemplate) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerProgmemTemplate(name, progmemTemplate); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerRamData(name, getter, memoize); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerDynamicData(name, descriptor, memoize); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerSizedData(name, descriptor, memoize); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerWriter(const char* name, const WriterDataDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerWriter(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerTypedValue(const char* name, const TypedValueDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerTypedValue(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerProducer(const char* name, const ProducerDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerProducer(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerRingBuffer(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerDynamicTemplate(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerConditional(name, descriptor, memoize); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerIterator(const char* name, const IteratorDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerIterator(name, descriptor); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerStaticTemplate(const char* name, const StaticTemplate* staticTemplate) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerStaticTemplate(name, staticTemplate); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerCompiledTemplate(const char* name, const CompiledTemplate* compiledTemplate) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerCompiledTemplate(name, compiledTemplate); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerTokenizedTemplate(const char* name, const TokenizedTemplate* tokenizedTemplate) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerTokenizedTemplate(name, tokenizedTemplate); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerCachedData(const char* name, DeviceFrameworkCachedValue* cache) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerCachedData(name, cache); });
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor) {
+    return update([&](DeviceFrameworkPlaceholderRegistry& registry) { return registry.registerProviderField(name, descriptor); });
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::clear() {
+    update([](DeviceFrameworkPlaceholderRegistry& registry) {
+        registry.clear();
+        return true;
+    });
+}
+
+uint32_t DeviceFrameworkConcurrentPlaceholderRegistry::getVersion() const {
+    // The writer lock keeps the published snapshot from being replaced and freed while it is read
+    lockWriters();
+    const Snapshot* snapshot = current.load();
+    uint32_t result = snapshot ? snapshot->version : 0;
+    unlockWriters();
+    return result;
+}
+
+int DeviceFrameworkConcurrentPlaceholderRegistry::getCount() const {
+    lockWriters();
+    const Snapshot* snapshot = current.load();
+    int result = snapshot ? snapshot->count : 0;
+    unlockWriters();
+    return result;
+}
+
+size_t DeviceFrameworkConcurrentPlaceholderRegistry::getRetiredCount() const {
+    lockWriters();
+    size_t result = 0;
+    for (const Snapshot* snapshot = retired; snapshot != nullptr; snapshot = snapshot->retiredNext) {
+        result++;
+    }
+    unlockWriters();
+    return result;
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::reclaim() {
+    lockWriters();
+    reclaimLocked();
+    unlockWriters();
+}
+
+size_t DeviceFrameworkConcurrentPlaceholderRegistry::getMemoryUsage() const {
+    lockWriters();
+    size_t bytes = staging.getMemoryUsage();
+    const Snapshot* snapshot = current.load();
+    if (snapshot) {
+        bytes += snapshot->bytes;
+    }
+    for (const Snapshot* old = retired; old != nullptr; old = old->retiredNext) {
+        bytes += old->bytes;
+    }
+    unlockWriters();
+    return bytes;
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::lockWriters() const {
+    while (writerLock.test_and_set(std::memory_order_acquire)) {
+        yield();
+    }
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::unlockWriters() const {
+    writerLock.clear(std::memory_order_release);
+}
+
+bool DeviceFrameworkConcurrentPlaceholderRegistry::publishLocked() {
+    Snapshot* fresh = buildSnapshot();
+    if (fresh == nullptr) {
+        return false;
+    }
+    fresh->version = ++version;
+
+    // Readers pinned from here on load the new snapshot; the old one waits for readers of earlier epochs
+    const Snapshot* previous = current.exchange(fresh);
+    uint32_t retireEpoch = epoch.fetch_add(1) + 1;
+    if (previous) {
+        Snapshot* old = const_cast<Snapshot*>(previous);
+        old->retireEpoch = retireEpoch;
+        old->retiredNext = retired;
+        retired = old;
+    }
+
+    // Re-registrations leave superseded entries in staging; drop them so they do not use up capacity
+    if (fresh->count < staging.count) {
+        compactStaging(fresh);
+    }
+
+    reclaimLocked();
+    return true;
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::reclaimLocked() {
+    uint32_t oldestPinned = UINT32_MAX;
+    for (size_t i = 0; i < READER_SLOTS; ++i) {
+        uint32_t pinned = readerEpochs[i].load();
+        if (pinned != 0 && pinned < oldestPinned) {
+            oldestPinned = pinned;
+        }
+    }
+
+    // A reader that pinned at epoch E can hold any snapshot retired after E
+    Snapshot** link = &retired;
+    while (*link != nullptr) {
+        Snapshot* old = *link;
+        if (old->retireEpoch <= oldestPinned) {
+            *link = old->retiredNext;
+            freeSnapshot(old);
+        } else {
+            link = &old->retiredNext;
+        }
+    }
+}
+
+DeviceFrameworkConcurrentPlaceholderRegistry::Snapshot* DeviceFrameworkConcurrentPlaceholderRegistry::buildSnapshot() {
+    // Only the entry each name resolves to is live (re-registrations append)
+    size_t live = 0;
+    size_t nameBytes = 0;
+    for (int i = 0; i < staging.count; ++i) {
+        const PlaceholderEntry& entry = staging.placeholders[i];
+        if (staging.findEntry(entry.name, entry.nameHash) == &entry) {
+            live++;
+            nameBytes += strlen(entry.name) + 1;
+        }
+    }
+
+    if (live > maxPlaceholders) {
+        DFTE_LOG_ERROR("Concurrent registry full, cannot publish " + String(static_cast<uint32_t>(live)) +
+                       " placeholders (max: " + String(maxPlaceholders) + ")");
+        return nullptr;
+    }
+
+    uint32_t slots = 4;
+    while (slots < live * 2) {
+        slots <<= 1;
+    }
+
+    size_t entriesOffset = (sizeof(Snapshot) + alignof(PlaceholderEntry) - 1) & ~(alignof(PlaceholderEntry) - 1);
+    size_t indexOffset = entriesOffset + live * sizeof(PlaceholderEntry);
+    size_t namesOffset = indexOffset + slots * sizeof(uint16_t);
+    size_t bytes = namesOffset + nameBytes;
+
+    uint8_t* block = new (std::nothrow) uint8_t[bytes];
+    if (block == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate concurrent registry snapshot");
+        return nullptr;
+    }
+
+    PlaceholderEntry* entries = reinterpret_cast<PlaceholderEntry*>(block + entriesOffset);
+    uint16_t* index = reinterpret_cast<uint16_t*>(block + indexOffset);
+    char* names = reinterpret_cast<char*>(block + namesOffset);
+    memset(index, 0, slots * sizeof(uint16_t));
+
+    uint16_t count = 0;
+    for (int i = 0; i < staging.count; ++i) {
+        const PlaceholderEntry& source = staging.placeholders[i];
+        if (staging.findEntry(source.name, source.nameHash) != &source) {
+            continue;
+        }
+
+        size_t nameSize = strlen(source.name) + 1;
+        memcpy(names, source.name, nameSize);
+        PlaceholderEntry* entry = new (&entries[count]) PlaceholderEntry(source);
+        entry->name = names;
+        names += nameSize;
+
+        uint32_t slot = entry->nameHash & (slots - 1);
+        while (index[slot] != 0) {
+            slot = (slot + 1) & (slots - 1);
+        }
+        index[slot] = static_cast<uint16_t>(count + 1);
+        count++;
+    }
+
+    Snapshot* snapshot = new (block) Snapshot();
+    snapshot->entries = entries;
+    snapshot->index = index;
+    snapshot->indexMask = slots - 1;
+    snapshot->count = count;
+    snapshot->version = 0;
+    snapshot->bytes = bytes;
+    snapshot->retiredNext = nullptr;
+    snapshot->retireEpoch = 0;
+    return snapshot;
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::rollbackLocked() {
+    // Staging goes back to exactly what readers see, so a failed update leaves nothing behind
+    compactStaging(current.load());
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::compactStaging(const Snapshot* snapshot) {
+    staging.clear();
+    for (uint16_t i = 0; i < snapshot->count; ++i) {
+        PlaceholderEntry& entry = staging.placeholders[staging.count];
+        entry = snapshot->entries[i];
+        if (!staging.assignName(entry, snapshot->entries[i].name)) {
+            DFTE_LOG_ERROR("Failed to compact concurrent registry staging entries");
+            return;
+        }
+        staging.commitEntry();
+    }
+}
+
+void DeviceFrameworkConcurrentPlaceholderRegistry::freeSnapshot(const Snapshot* snapshot) {
+    if (snapshot) {
+        delete[] reinterpret_cast<const uint8_t*>(snapshot);
+    }
+}
+
+uint16_t DeviceFrameworkConcurrentPlaceholderRegistry::stagingCapacity(uint16_t maxPlaceholders) {
+    // Room for an update to re-register every published name once before staging is compacted
+    uint32_t capacity = static_cast<uint32_t>(maxPlaceholders) * 2;
+    return static_cast<uint16_t>(capacity > 0xFFFF ? 0xFFFF : capacity);
+}
+
+uint32_t DeviceFrameworkConcurrentPlaceholderRegistry::hashName(const char* name) {
+    return DeviceFrameworkPlaceholderRegistry::hashName(name);
+}
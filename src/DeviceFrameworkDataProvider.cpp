@@ -0,0 +1,158 @@
+#include "DeviceFrameworkDataProvider.h"
+#include "DeviceFrameworkTypedValue.h"
+#include "DeviceFrameworkTemplateContext.h"
+#include "DeviceFrameworkTemplateEngineDebug.h"
+#include <new>
+
+DeviceFrameworkDataProvider::DeviceFrameworkDataProvider(DataProviderCallback fill, void* sample, size_t sampleSize,
+                                                         uint32_t ttlMs, uint32_t refreshAheadMs, void* userData)
+    : fill(fill), sample(sample), sampleSize(sample ? sampleSize : 0), userData(userData), ttlMs(ttlMs),
+      refreshAheadMs(refreshAheadMs), staging(nullptr), sampledAt(0), valid(false), invalidations(0), hits(0), samples(0) {
+    if (this->sampleSize == 0) {
+        return;
+    }
+    staging = new (std::nothrow) uint8_t[this->sampleSize];
+    if (staging == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate data provider staging sample (" + String(static_cast<uint32_t>(this->sampleSize)) +
+                       " bytes)");
+    }
+}
+
+DeviceFrameworkDataProvider::~DeviceFrameworkDataProvider() {
+    delete[] staging;
+}
+
+bool DeviceFrameworkDataProvider::isValidField(const ProviderFieldDescriptor* descriptor) {
+    // Fields are re-pointed into per-render copies, so they must be addresses inside the sample
+    return descriptor != nullptr && descriptor->provider != nullptr && DeviceFrameworkTypedValue::isValid(&descriptor->field) &&
+           descriptor->provider->contains(descriptor->field.address);
+}
+
+PlaceholderValue DeviceFrameworkDataProvider::format(const TypedValueDescriptor& field, char* text, DeviceFrameworkTemplateContext* ctx) {
+    const DeviceFrameworkTemplateContext::ProviderSlot* slot = ctx ? ctx->findProviderSample(this) : nullptr;
+    if (slot != nullptr && slot->sample != nullptr) {
+        // The render's own copy: no lock, and nothing another task samples can reach it
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return formatFrom(field, slot->sample, text);
+    }
+
+    bool sampled = false;
+    if (slot == nullptr && isDue(millis(), 0)) {
+        // A valid sample is rendered as is while another task takes the next one; only the first one is waited for
+        bool owner = valid.load(std::memory_order_acquire) ? sampling.tryLock() : sampling.awaitLock();
+        if (owner) {
+            sampled = isDue(millis(), 0) && sampleLocked();
+            sampling.unlock();
+        }
+    }
+    if (!sampled) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (slot == nullptr && ctx != nullptr) {
+        // First field of this render: keep the sample it saw for the rest of the render
+        DeviceFrameworkScratchArena* scratch = ctx->getScratchArena();
+        void* copy = scratch ? scratch->allocate(sampleSize) : nullptr;
+        if (copy != nullptr) {
+            busy.lock();
+            memcpy(copy, sample, sampleSize);
+            busy.unlock();
+        } else {
+            DFTE_LOG_WARN("Scratch arena full, data provider fields read live for the rest of the render");
+        }
+        ctx->storeProviderSample(this, copy);
+        if (copy != nullptr) {
+            return formatFrom(field, copy, text);
+        }
+    }
+    // Formatted under the lock so a sample being published cannot change the field mid-read
+    busy.lock();
+    PlaceholderValue value = DeviceFrameworkTypedValue::format(field, text);
+    busy.unlock();
+    return value;
+}
+
+bool DeviceFrameworkDataProvider::refresh() {
+    if (!sampling.awaitLock()) {
+        DFTE_LOG_TRACE("Data provider sample already in flight");
+        return false;
+    }
+    bool sampled = sampleLocked();
+    sampling.unlock();
+    return sampled;
+}
+
+bool DeviceFrameworkDataProvider::refreshIfDue() {
+    // Only TTL samples outlive a render; per-render providers have nothing to take ahead of time
+    if (ttlMs == 0 || !isDue(millis(), refreshAheadMs)) {
+        return false;
+    }
+    // A render already sampling is as good as this call doing it
+    if (!sampling.tryLock()) {
+        return false;
+    }
+    bool sampled = isDue(millis(), refreshAheadMs) && sampleLocked();
+    sampling.unlock();
+    return sampled;
+}
+
+void DeviceFrameworkDataProvider::invalidate() {
+    // A callback already running may have read the old state: its sample is published invalid as well
+    busy.lock();
+    invalidations.fetch_add(1, std::memory_order_relaxed);
+    valid.store(false, std::memory_order_release);
+    busy.unlock();
+}
+
+void DeviceFrameworkDataProvider::resetStats() {
+    hits.store(0, std::memory_order_relaxed);
+    samples.store(0, std::memory_order_relaxed);
+}
+
+bool DeviceFrameworkDataProvider::isDue(uint32_t now, uint32_t margin) const {
+    if (!valid.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (ttlMs == 0) {
+        return true;
+    }
+    uint32_t age = now - sampledAt.load(std::memory_order_relaxed);
+    return age + (margin < ttlMs ? margin : ttlMs) >= ttlMs;
+}
+
+bool DeviceFrameworkDataProvider::sampleLocked() {
+    if (fill == nullptr || sample == nullptr || staging == nullptr) {
+        return false;
+    }
+
+    samples.fetch_add(1, std::memory_order_relaxed);
+    // The callback fills a private copy outside busy, so renders keep copying the published sample meanwhile.
+    // Only the sampling owner writes the sample, so it can be read here without busy.
+    uint32_t invalidated = invalidations.load(std::memory_order_relaxed);
+    memcpy(staging, sample, sampleSize);
+    if (!fill(staging, userData)) {
+        // The published sample is left whole: renders keep showing the previous values
+        DFTE_LOG_WARN("Data provider sample failed; rendering previous values");
+        return false;
+    }
+
+    busy.lock();
+    memcpy(sample, staging, sampleSize);
+    sampledAt.store(millis(), std::memory_order_relaxed);
+    valid.store(invalidations.load(std::memory_order_relaxed) == invalidated, std::memory_order_release);
+    busy.unlock();
+    return true;
+}
+
+bool DeviceFrameworkDataProvider::contains(const void* address) const {
+    const uint8_t* start = static_cast<const uint8_t*>(sample);
+    const uint8_t* field = static_cast<const uint8_t*>(address);
+    return start != nullptr && field >= start && field < start + sampleSize;
+}
+
+PlaceholderValue DeviceFrameworkDataProvider::formatFrom(const TypedValueDescriptor& field, const void* copy, char* text) const {
+    TypedValueDescriptor rebased = field;
+    rebased.address = static_cast<const uint8_t*>(copy) +
+                      (static_cast<const uint8_t*>(field.address) - static_cast<const uint8_t*>(sample));
+    return DeviceFrameworkTypedValue::format(rebased, text);
+}
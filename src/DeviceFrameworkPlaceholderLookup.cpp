@@ -0,0 +1,14 @@
+#include "DeviceFrameworkPlaceholderLookup.h"
+#include <pgmspace.h>
+
+const PlaceholderEntry* DeviceFrameworkPlaceholderLookup::getPlaceholderByToken(const TokenTable* table, uint32_t id) const {
+    if (table == nullptr || id >= table->count) {
+        return nullptr;
+    }
+
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+    const char* tokenName = static_cast<const char*>(pgm_read_ptr(&table->names[id]));
+    strncpy_P(name, tokenName, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    return getPlaceholder(name);
+}
@@ -0,0 +1,237 @@
+#include "DeviceFrameworkPlaceholderOverlay.h"
+#include "DeviceFrameworkPlaceholderRegistry.h"
+#include "DeviceFrameworkTypedValue.h"
+#include "DeviceFrameworkDataProvider.h"
+#include "DeviceFrameworkTemplateEngineDebug.h"
+#include <pgmspace.h>
+
+DeviceFrameworkPlaceholderOverlay::DeviceFrameworkPlaceholderOverlay(DeviceFrameworkPlaceholderLookup* base)
+    : base(base), count(0), shadowsBase(false) {
+    for (uint8_t i = 0; i < CAPACITY; ++i) {
+        strings[i] = DynamicDataDescriptor{getStringValue, nullptr, nullptr};
+    }
+}
+
+void DeviceFrameworkPlaceholderOverlay::setBase(DeviceFrameworkPlaceholderLookup* lookup) {
+    base = lookup;
+    refreshShadowing();
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerString(const char* name, const char* value) {
+    if (value == nullptr) {
+        DFTE_LOG_ERROR("Cannot bind null string to overlay placeholder: " + String(name ? name : "(null)"));
+        return false;
+    }
+
+    PlaceholderEntry* entry = bind(name);
+    if (!entry) {
+        return false;
+    }
+    DynamicDataDescriptor& descriptor = strings[entry - entries];
+    descriptor.userData = const_cast<char*>(value);
+    entry->type = PlaceholderType::DYNAMIC_DATA;
+    entry->data = &descriptor;
+    return true;
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerProgmemData(const char* name, const char* progmemData) {
+    return addEntry(name, PlaceholderType::PROGMEM_DATA, progmemData, true, "PROGMEM data", false,
+                    DeviceFrameworkPlaceholderRegistry::getProgmemLength);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerProgmemTemplate(const char* name, const char* progmemTemplate) {
+    return addEntry(name, PlaceholderType::PROGMEM_TEMPLATE, progmemTemplate, true, "PROGMEM template", false,
+                    DeviceFrameworkPlaceholderRegistry::getProgmemLength);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize) {
+    return addEntry(name, PlaceholderType::RAM_DATA, (const void*)getter, getter != nullptr, "RAM data", memoize,
+                    DeviceFrameworkPlaceholderRegistry::getRamLength);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::DYNAMIC_DATA, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "dynamic data", memoize);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::SIZED_DATA, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "sized data", memoize);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerWriter(const char* name, const WriterDataDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::WRITER_DATA, descriptor, descriptor != nullptr && descriptor->write != nullptr,
+                    "writer");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerTypedValue(const char* name, const TypedValueDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::TYPED_VALUE, descriptor, DeviceFrameworkTypedValue::isValid(descriptor),
+                    "typed value");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerProducer(const char* name, const ProducerDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::PRODUCER_DATA, descriptor, descriptor != nullptr && descriptor->read != nullptr,
+                    "producer");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::RING_DATA, descriptor, DeviceFrameworkPlaceholderRegistry::isValidRing(descriptor),
+                    "ring buffer");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::PROVIDER_FIELD, descriptor, DeviceFrameworkDataProvider::isValidField(descriptor),
+                    "provider field");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::DYNAMIC_TEMPLATE, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "dynamic template");
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::CONDITIONAL, descriptor, descriptor != nullptr && descriptor->evaluate != nullptr,
+                    "conditional", memoize);
+}
+
+bool DeviceFrameworkPlaceholderOverlay::registerIterator(const char* name, const IteratorDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::ITERATOR, descriptor, descriptor != nullptr && descriptor->next != nullptr,
+                    "iterator");
+}
+
+void DeviceFrameworkPlaceholderOverlay::clear() {
+    for (uint8_t i = 0; i < count; ++i) {
+        entries[i] = PlaceholderEntry();
+        strings[i].userData = nullptr;
+    }
+    count = 0;
+    shadowsBase = false;
+}
+
+const PlaceholderEntry* DeviceFrameworkPlaceholderOverlay::getPlaceholder(const char* name) const {
+    if (name == nullptr) {
+        return nullptr;
+    }
+
+    if (count > 0) {
+        const PlaceholderEntry* entry = findEntry(name, hashName(name));
+        if (entry) {
+            return entry;
+        }
+    }
+    return base ? base->getPlaceholder(name) : nullptr;
+}
+
+const PlaceholderEntry* DeviceFrameworkPlaceholderOverlay::getPlaceholderByToken(const TokenTable* table, uint32_t id) const {
+    if (count == 0) {
+        return base ? base->getPlaceholderByToken(table, id) : nullptr;
+    }
+
+    if (table == nullptr || id >= table->count) {
+        return nullptr;
+    }
+
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+    const char* tokenName = static_cast<const char*>(pgm_read_ptr(&table->names[id]));
+    strncpy_P(name, tokenName, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+
+    const PlaceholderEntry* entry = findEntry(name, hashName(name));
+    if (entry) {
+        return entry;
+    }
+    return base ? base->getPlaceholderByToken(table, id) : nullptr;
+}
+
+const TemplatePlan* DeviceFrameworkPlaceholderOverlay::acquirePlan(const char* progmemTemplate, size_t templateLen,
+                                                                   const StaticTemplate* compiled) {
+    // The base may have gained a shadowed name since the last check; this runs once per template frame
+    if (base == nullptr || refreshShadowing()) {
+        return nullptr;
+    }
+    return base->acquirePlan(progmemTemplate, templateLen, compiled);
+}
+
+PlaceholderEntry* DeviceFrameworkPlaceholderOverlay::bind(const char* name) {
+    if (name == nullptr || name[0] == '\0') {
+        DFTE_LOG_ERROR("Overlay placeholder name is null or empty");
+        return nullptr;
+    }
+    if (strlen(name) >= DFTE_PLACEHOLDER_NAME_SIZE) {
+        DFTE_LOG_ERROR("Placeholder name too long: " + String(name) + " (max: " + String(DFTE_PLACEHOLDER_NAME_SIZE) + ")");
+        return nullptr;
+    }
+
+    uint32_t hash = hashName(name);
+    PlaceholderEntry* entry = const_cast<PlaceholderEntry*>(findEntry(name, hash));
+    if (!entry) {
+        if (count >= CAPACITY) {
+            DFTE_LOG_ERROR("Placeholder overlay full, cannot bind: " + String(name));
+            return nullptr;
+        }
+        entry = &entries[count++];
+    }
+
+    // Rebinding replaces the whole entry; the caller fills in type and data
+    *entry = PlaceholderEntry();
+    entry->name = name;
+    entry->nameHash = hash;
+    if (base && base->getPlaceholder(name) != nullptr) {
+        shadowsBase = true;
+    }
+    return entry;
+}
+
+bool DeviceFrameworkPlaceholderOverlay::addEntry(const char* name, PlaceholderType type, const void* data, bool valid,
+                                                 const char* kind, bool memoize, PlaceholderLengthGetter getLength) {
+    if (!valid) {
+        DFTE_LOG_ERROR("Invalid " + String(kind) + " descriptor for placeholder: " + String(name ? name : "(null)"));
+        return false;
+    }
+
+    PlaceholderEntry* entry = bind(name);
+    if (!entry) {
+        return false;
+    }
+    entry->type = type;
+    entry->data = data;
+    entry->getLength = getLength;
+    // Same rule as the registry: only RAM getters have a length that changes between renders
+    entry->hasCachedLength = getLength != nullptr && type != PlaceholderType::RAM_DATA;
+    entry->cachedLength = entry->hasCachedLength ? static_cast<uint32_t>(getLength(data)) : 0;
+    entry->memoize = memoize;
+    return true;
+}
+
+const PlaceholderEntry* DeviceFrameworkPlaceholderOverlay::findEntry(const char* name, uint32_t hash) const {
+    // A handful of entries: a linear hash compare beats probing and keeps the overlay a flat array
+    for (uint8_t i = 0; i < count; ++i) {
+        const PlaceholderEntry& entry = entries[i];
+        if (entry.nameHash == hash && strcmp(entry.name, name) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool DeviceFrameworkPlaceholderOverlay::refreshShadowing() {
+    shadowsBase = false;
+    if (base == nullptr) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        if (base->getPlaceholder(entries[i].name) != nullptr) {
+            shadowsBase = true;
+            break;
+        }
+    }
+    return shadowsBase;
+}
+
+uint32_t DeviceFrameworkPlaceholderOverlay::hashName(const char* name) {
+    return DeviceFrameworkPlaceholderRegistry::hashName(name);
+}
+
+const char* DeviceFrameworkPlaceholderOverlay::getStringValue(void* userData) {
+    return static_cast<const char*>(userData);
+}
@@ -1,10 +1,24 @@
 #include "DeviceFrameworkPlaceholderRegistry.h"
+#include "DeviceFrameworkCachedValue.h"
+#include "DeviceFrameworkTypedValue.h"
+#include "DeviceFrameworkDataProvider.h"
 #include "DeviceFrameworkTemplateEngineDebug.h"
+#include "DeviceFrameworkTemplateKernels.h"
 #include <pgmspace.h>
 #include <new>
 
 DeviceFrameworkPlaceholderRegistry::DeviceFrameworkPlaceholderRegistry(uint16_t maxPlaceholders) 
-    : placeholders(nullptr), maxPlaceholders(maxPlaceholders), count(0) {
+    : placeholders(nullptr), maxPlaceholders(maxPlaceholders), count(0), generation(0),
+      nameIndex(nullptr), nameIndexMask(0), namePool(nullptr), namePoolUsed(0), namePoolSize(0), namePoolBytes(0),
+      planCacheNext(0), tokenBindingCount(0) {
+    planLock.clear();
+    for (size_t i = 0; i < PLAN_CACHE_SIZE + 1; ++i) {
+        planCache[i] = nullptr;
+    }
+    for (size_t i = 0; i < TOKEN_BINDING_SLOTS + 1; ++i) {
+        tokenBindings[i] = TokenBinding{nullptr, nullptr};
+    }
+
     if (maxPlaceholders == 0) {
         DFTE_LOG_ERROR("Placeholder registry size cannot be zero");
         this->maxPlaceholders = 0;
@@ -21,9 +35,37 @@ DeviceFrameworkPlaceholderRegistry::DeviceFrameworkPlaceholderRegistry(uint16_t
     for (uint16_t i = 0; i < maxPlaceholders; ++i) {
         placeholders[i] = PlaceholderEntry();
     }
+
+    // Open-addressing name index at <= 50% load, so probes stay short and always reach an empty slot
+    uint32_t slots = 4;
+    while (slots < static_cast<uint32_t>(maxPlaceholders) * 2) {
+        slots <<= 1;
+    }
+    nameIndex = new (std::nothrow) uint16_t[slots];
+    if (nameIndex == nullptr) {
+        DFTE_LOG_WARN("Failed to allocate placeholder name index, lookups fall back to a linear scan");
+        return;
+    }
+    nameIndexMask = slots - 1;
+    memset(nameIndex, 0, slots * sizeof(uint16_t));
 }
 
 DeviceFrameworkPlaceholderRegistry::~DeviceFrameworkPlaceholderRegistry() {
+    // Frames of contexts that outlive the registry keep their plans until they release them
+    for (size_t i = 0; i < PLAN_CACHE_SIZE; ++i) {
+        releasePlan(planCache[i]);
+        planCache[i] = nullptr;
+    }
+
+    for (size_t i = 0; i < tokenBindingCount; ++i) {
+        delete[] tokenBindings[i].entries;
+        tokenBindings[i].entries = nullptr;
+    }
+
+    delete[] nameIndex;
+    nameIndex = nullptr;
+    releaseNamePool();
+
     if (placeholders) {
         delete[] placeholders;
         placeholders = nullptr;
@@ -31,141 +73,114 @@ DeviceFrameworkPlaceholderRegistry::~DeviceFrameworkPlaceholderRegistry() {
 }
 
 bool DeviceFrameworkPlaceholderRegistry::registerProgmemData(const char* name, const char* progmemData) {
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
-        return false;
-    }
-
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
-        return false;
-    }
-    
-    if (!validatePlaceholderName(name)) {
-        return false;
-    }
-    
-    // Check for duplicates
-    if (getPlaceholder(name) != nullptr) {
+    if (name != nullptr && getPlaceholder(name) != nullptr) {
         DFTE_LOG_WARN("Placeholder already registered: " + String(name));
         // Continue anyway - last registration wins
     }
-    
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::PROGMEM_DATA;
-    entry.data = progmemData;
-    entry.getLength = getProgmemLength;
-    entry.cachedLength = getProgmemLength(progmemData);
-    entry.hasCachedLength = true;
-    
-    count++;
-    return true;
+    return addEntry(name, PlaceholderType::PROGMEM_DATA, progmemData, true, "PROGMEM data", false, getProgmemLength);
 }
 
 bool DeviceFrameworkPlaceholderRegistry::registerProgmemTemplate(const char* name, const char* progmemTemplate) {
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
-        return false;
-    }
+    return addEntry(name, PlaceholderType::PROGMEM_TEMPLATE, progmemTemplate, true, "PROGMEM template", false,
+                    getProgmemLength);
+}
 
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
-        return false;
-    }
-    
-    if (!validatePlaceholderName(name)) {
+bool DeviceFrameworkPlaceholderRegistry::registerStaticTemplate(const char* name, const StaticTemplate* staticTemplate) {
+    return addEntry(name, PlaceholderType::STATIC_TEMPLATE, staticTemplate,
+                    staticTemplate != nullptr && staticTemplate->text != nullptr, "static template", false,
+                    getStaticTemplateLength);
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerCompiledTemplate(const char* name, const CompiledTemplate* compiledTemplate) {
+    if (!addEntry(name, PlaceholderType::COMPILED_TEMPLATE, compiledTemplate,
+                  compiledTemplate != nullptr && compiledTemplate->emit != nullptr, "compiled template")) {
         return false;
     }
-    
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::PROGMEM_TEMPLATE;
-    entry.data = progmemTemplate;
-    entry.getLength = getProgmemLength;
-    entry.cachedLength = getProgmemLength(progmemTemplate);
-    entry.hasCachedLength = true;
-    
-    count++;
+    bindTokenTable(&compiledTemplate->placeholders);
     return true;
 }
 
-bool DeviceFrameworkPlaceholderRegistry::registerRamData(const char* name, PlaceholderDataGetter getter) {
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
+bool DeviceFrameworkPlaceholderRegistry::registerTokenizedTemplate(const char* name, const TokenizedTemplate* tokenizedTemplate) {
+    if (!addEntry(name, PlaceholderType::TOKENIZED_TEMPLATE, tokenizedTemplate,
+                  tokenizedTemplate != nullptr && tokenizedTemplate->data != nullptr && tokenizedTemplate->tokens != nullptr,
+                  "tokenized template", false, getTokenizedTemplateLength)) {
         return false;
     }
+    bindTokenTable(tokenizedTemplate->tokens);
+    return true;
+}
 
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
-        return false;
-    }
-    
-    if (!validatePlaceholderName(name)) {
-        return false;
-    }
+bool DeviceFrameworkPlaceholderRegistry::registerRamData(const char* name, PlaceholderDataGetter getter, bool memoize) {
+    return addEntry(name, PlaceholderType::RAM_DATA, (const void*)getter, getter != nullptr, "RAM data", memoize,
+                    getRamLength);
+}
 
-    if (getter == nullptr) {
-        DFTE_LOG_ERROR("Cannot register RAM_DATA placeholder with null getter: " + String(name));
-        return false;
-    }
-    
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::RAM_DATA;
-    entry.data = (const void*)getter;
-    entry.getLength = getRamLength;
-    entry.cachedLength = 0;
-    entry.hasCachedLength = false;
-    
-    count++;
-    return true;
+bool DeviceFrameworkPlaceholderRegistry::registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::DYNAMIC_DATA, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "dynamic data", memoize);
 }
 
-bool DeviceFrameworkPlaceholderRegistry::registerDynamicData(const char* name, const DynamicDataDescriptor* descriptor) {
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
-        return false;
-    }
+bool DeviceFrameworkPlaceholderRegistry::registerSizedData(const char* name, const SizedDataDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::SIZED_DATA, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "sized data", memoize);
+}
 
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
-        return false;
-    }
+bool DeviceFrameworkPlaceholderRegistry::registerWriter(const char* name, const WriterDataDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::WRITER_DATA, descriptor, descriptor != nullptr && descriptor->write != nullptr,
+                    "writer");
+}
 
-    if (!validatePlaceholderName(name)) {
-        return false;
-    }
+bool DeviceFrameworkPlaceholderRegistry::registerProducer(const char* name, const ProducerDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::PRODUCER_DATA, descriptor, descriptor != nullptr && descriptor->read != nullptr,
+                    "producer");
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerRingBuffer(const char* name, const RingBufferDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::RING_DATA, descriptor, isValidRing(descriptor), "ring buffer");
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerTypedValue(const char* name, const TypedValueDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::TYPED_VALUE, descriptor, DeviceFrameworkTypedValue::isValid(descriptor),
+                    "typed value");
+}
 
-    if (descriptor == nullptr || descriptor->getter == nullptr) {
-        DFTE_LOG_ERROR("Invalid dynamic data descriptor for placeholder: " + String(name));
+bool DeviceFrameworkPlaceholderRegistry::registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::DYNAMIC_TEMPLATE, descriptor, descriptor != nullptr && descriptor->getter != nullptr,
+                    "dynamic template");
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerConditional(const char* name, const ConditionalDescriptor* descriptor, bool memoize) {
+    return addEntry(name, PlaceholderType::CONDITIONAL, descriptor, descriptor != nullptr && descriptor->evaluate != nullptr,
+                    "conditional", memoize);
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerIterator(const char* name, const IteratorDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::ITERATOR, descriptor, descriptor != nullptr && descriptor->next != nullptr,
+                    "iterator");
+}
+
+bool DeviceFrameworkPlaceholderRegistry::registerCachedData(const char* name, DeviceFrameworkCachedValue* cache) {
+    if (cache == nullptr) {
+        DFTE_LOG_ERROR("Cannot register cached placeholder without a cache: " + String(name ? name : "(null)"));
         return false;
     }
+    return registerDynamicData(name, cache->getDescriptor());
+}
 
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::DYNAMIC_DATA;
-    entry.data = descriptor;
-    entry.getLength = nullptr;
-    entry.cachedLength = 0;
-    entry.hasCachedLength = false;
-
-    count++;
-    return true;
+bool DeviceFrameworkPlaceholderRegistry::registerProviderField(const char* name, const ProviderFieldDescriptor* descriptor) {
+    return addEntry(name, PlaceholderType::PROVIDER_FIELD, descriptor, DeviceFrameworkDataProvider::isValidField(descriptor),
+                    "provider field");
 }
 
-bool DeviceFrameworkPlaceholderRegistry::registerDynamicTemplate(const char* name, const DynamicTemplateDescriptor* descriptor) {
+bool DeviceFrameworkPlaceholderRegistry::addEntry(const char* name, PlaceholderType type, const void* data, bool valid,
+                                                  const char* kind, bool memoize, PlaceholderLengthGetter getLength) {
     if (placeholders == nullptr || maxPlaceholders == 0) {
         DFTE_LOG_ERROR("Placeholder registry not initialized");
         return false;
     }
 
     if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
+        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name ? name : "(null)"));
         return false;
     }
 
@@ -173,99 +188,133 @@ bool DeviceFrameworkPlaceholderRegistry::registerDynamicTemplate(const char* nam
         return false;
     }
 
-    if (descriptor == nullptr || descriptor->getter == nullptr) {
-        DFTE_LOG_ERROR("Invalid dynamic template descriptor for placeholder: " + String(name));
+    if (!valid) {
+        DFTE_LOG_ERROR("Invalid " + String(kind) + " descriptor for placeholder: " + String(name));
         return false;
     }
 
     PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::DYNAMIC_TEMPLATE;
-    entry.data = descriptor;
-    entry.getLength = nullptr;
-    entry.cachedLength = 0;
-    entry.hasCachedLength = false;
+    if (!assignName(entry, name)) {
+        return false;
+    }
+    entry.type = type;
+    entry.data = data;
+    entry.getLength = getLength;
+    // Every length getter but the RAM one reads a size fixed at registration
+    entry.hasCachedLength = getLength != nullptr && type != PlaceholderType::RAM_DATA;
+    entry.cachedLength = entry.hasCachedLength ? static_cast<uint32_t>(getLength(data)) : 0;
+    entry.memoize = memoize;
 
-    count++;
+    commitEntry();
     return true;
 }
 
-bool DeviceFrameworkPlaceholderRegistry::registerConditional(const char* name, const ConditionalDescriptor* descriptor) {
+void DeviceFrameworkPlaceholderRegistry::clear() {
+    count = 0;
+    generation++;
     if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
-        return false;
+        return;
     }
 
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
-        return false;
+    for (uint16_t i = 0; i < maxPlaceholders; ++i) {
+        placeholders[i] = PlaceholderEntry();
     }
-
-    if (!validatePlaceholderName(name)) {
-        return false;
+    if (nameIndex) {
+        memset(nameIndex, 0, (nameIndexMask + 1) * sizeof(uint16_t));
     }
-
-    if (descriptor == nullptr || descriptor->evaluate == nullptr) {
-        DFTE_LOG_ERROR("Invalid conditional descriptor for placeholder: " + String(name));
-        return false;
+    // Tables stay bound; their tokens resolve again as names are registered
+    for (size_t i = 0; i < tokenBindingCount; ++i) {
+        for (uint16_t id = 0; id < tokenBindings[i].table->count; ++id) {
+            tokenBindings[i].entries[id] = nullptr;
+        }
     }
+    releaseNamePool();
+}
 
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::CONDITIONAL;
-    entry.data = descriptor;
-    entry.getLength = nullptr;
-    entry.cachedLength = 0;
-    entry.hasCachedLength = false;
+void DeviceFrameworkPlaceholderRegistry::commitEntry() {
+    if (nameIndex) {
+        // A re-registered name takes over the existing slot, so the latest entry wins
+        const PlaceholderEntry& entry = placeholders[count];
+        for (uint32_t slot = entry.nameHash & nameIndexMask;; slot = (slot + 1) & nameIndexMask) {
+            uint16_t ref = nameIndex[slot];
+            if (ref == 0 || placeholders[ref - 1].name == entry.name) {
+                nameIndex[slot] = static_cast<uint16_t>(count + 1);
+                break;
+            }
+        }
+    }
 
+    rebindToken(placeholders[count]);
     count++;
-    return true;
+    generation++;
 }
 
-bool DeviceFrameworkPlaceholderRegistry::registerIterator(const char* name, const IteratorDescriptor* descriptor) {
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        DFTE_LOG_ERROR("Placeholder registry not initialized");
-        return false;
-    }
+bool DeviceFrameworkPlaceholderRegistry::assignName(PlaceholderEntry& entry, const char* name) {
+    uint32_t hash = hashName(name);
 
-    if (count >= maxPlaceholders) {
-        DFTE_LOG_ERROR("Placeholder registry full, cannot register: " + String(name));
+    // Re-registrations share the interned copy (commitEntry relies on this to find the old slot)
+    const PlaceholderEntry* existing = findEntry(name, hash);
+    const char* interned = existing ? existing->name : internName(name);
+    if (interned == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate placeholder name: " + String(name));
         return false;
     }
 
-    if (!validatePlaceholderName(name)) {
-        return false;
-    }
+    entry.name = interned;
+    entry.nameHash = hash;
+    return true;
+}
 
-    if (descriptor == nullptr || descriptor->next == nullptr) {
-        DFTE_LOG_ERROR("Invalid iterator descriptor for placeholder: " + String(name));
-        return false;
+const char* DeviceFrameworkPlaceholderRegistry::internName(const char* name) {
+    size_t size = strlen(name) + 1;
+    if (namePool == nullptr || namePoolSize - namePoolUsed < size) {
+        // New block; its first bytes link to the previous one so releaseNamePool() can walk them
+        size_t blockSize = NAME_POOL_HEADER + (size > NAME_POOL_BLOCK_SIZE ? size : NAME_POOL_BLOCK_SIZE);
+        char* block = new (std::nothrow) char[blockSize];
+        if (block == nullptr) {
+            return nullptr;
+        }
+        memcpy(block, &namePool, NAME_POOL_HEADER);
+        namePool = block;
+        namePoolUsed = NAME_POOL_HEADER;
+        namePoolSize = blockSize;
+        namePoolBytes += blockSize;
     }
 
-    PlaceholderEntry& entry = placeholders[count];
-    strncpy(entry.name, name, sizeof(entry.name) - 1);
-    entry.name[sizeof(entry.name) - 1] = '\0';
-    entry.type = PlaceholderType::ITERATOR;
-    entry.data = descriptor;
-    entry.getLength = nullptr;
-    entry.cachedLength = 0;
-    entry.hasCachedLength = false;
+    char* interned = namePool + namePoolUsed;
+    memcpy(interned, name, size);
+    namePoolUsed += size;
+    return interned;
+}
 
-    count++;
-    return true;
+void DeviceFrameworkPlaceholderRegistry::releaseNamePool() {
+    while (namePool != nullptr) {
+        char* previous;
+        memcpy(&previous, namePool, NAME_POOL_HEADER);
+        delete[] namePool;
+        namePool = previous;
+    }
+    namePoolUsed = 0;
+    namePoolSize = 0;
+    namePoolBytes = 0;
 }
 
-void DeviceFrameworkPlaceholderRegistry::clear() {
-    count = 0;
-    if (placeholders == nullptr || maxPlaceholders == 0) {
-        return;
+size_t DeviceFrameworkPlaceholderRegistry::getMemoryUsage() const {
+    size_t bytes = static_cast<size_t>(maxPlaceholders) * sizeof(PlaceholderEntry) + namePoolBytes;
+    if (nameIndex) {
+        bytes += (nameIndexMask + 1) * sizeof(uint16_t);
     }
+    return bytes;
+}
 
-    for (uint16_t i = 0; i < maxPlaceholders; ++i) {
-        placeholders[i] = PlaceholderEntry();
+// FNV-1a; names are short, so one pass is cheaper than anything wider
+uint32_t DeviceFrameworkPlaceholderRegistry::hashName(const char* name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= static_cast<uint8_t>(*name++);
+        hash *= 16777619u;
     }
+    return hash;
 }
 
 bool DeviceFrameworkPlaceholderRegistry::validatePlaceholderName(const char* name) const {
@@ -280,10 +329,15 @@ bool DeviceFrameworkPlaceholderRegistry::validatePlaceholderName(const char* nam
         return false;
     }
     
-    if (nameLen >= sizeof(PlaceholderEntry::name)) {
-        // This shouldn't happen if MAX_PLACEHOLDER_NAME_SIZE is <= sizeof(PlaceholderEntry::name)
-        DFTE_LOG_ERROR("Placeholder name exceeds entry buffer size");
-        return false;
+    // Names are matched verbatim, but only [A-Za-z0-9_] between the delimiters is conventional
+    const uint8_t* inner = reinterpret_cast<const uint8_t*>(name);
+    size_t innerLen = nameLen;
+    if (innerLen >= 2 && name[0] == '%' && name[innerLen - 1] == '%') {
+        inner++;
+        innerLen -= 2;
+    }
+    if (DeviceFrameworkTemplateKernels::nameSpan(inner, innerLen) != innerLen) {
+        DFTE_LOG_WARN("Placeholder name has characters outside [A-Za-z0-9_]: " + String(name));
     }
     
     return true;
@@ -291,30 +345,111 @@ bool DeviceFrameworkPlaceholderRegistry::validatePlaceholderName(const char* nam
 
 const PlaceholderEntry* DeviceFrameworkPlaceholderRegistry::getPlaceholder(const char* name) const {
     if (name == nullptr || placeholders == nullptr || count <= 0) return nullptr;
-    
+    return findEntry(name, hashName(name));
+}
+
+const PlaceholderEntry* DeviceFrameworkPlaceholderRegistry::findEntry(const char* name, uint32_t hash) const {
+    if (placeholders == nullptr || count <= 0) return nullptr;
+
+    // Hashes are compared first, so a probe only reads the name (in the pool) on a likely match
+    if (nameIndex) {
+        for (uint32_t slot = hash & nameIndexMask;; slot = (slot + 1) & nameIndexMask) {
+            uint16_t ref = nameIndex[slot];
+            if (ref == 0) {
+                return nullptr;
+            }
+            const PlaceholderEntry& entry = placeholders[ref - 1];
+            if (entry.nameHash == hash && strcmp(entry.name, name) == 0) {
+                return &entry;
+            }
+        }
+    }
+
+    // No index (allocation failed): newest entry first so the last registration wins
     for (int i = count - 1; i >= 0; i--) {
-        if (strcmp(placeholders[i].name, name) == 0) {
+        if (placeholders[i].nameHash == hash && strcmp(placeholders[i].name, name) == 0) {
             return &placeholders[i];
         }
     }
     return nullptr;
 }
 
+const PlaceholderEntry* DeviceFrameworkPlaceholderRegistry::getPlaceholderByToken(const TokenTable* table, uint32_t id) const {
+    if (table == nullptr || id >= table->count) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < tokenBindingCount; ++i) {
+        if (tokenBindings[i].table == table) {
+            return tokenBindings[i].entries[id];
+        }
+    }
+    return DeviceFrameworkPlaceholderLookup::getPlaceholderByToken(table, id);
+}
+
+bool DeviceFrameworkPlaceholderRegistry::bindTokenTable(const TokenTable* table) {
+    if (table == nullptr) {
+        return false;
+    }
+    for (size_t i = 0; i < tokenBindingCount; ++i) {
+        if (tokenBindings[i].table == table) {
+            return true;
+        }
+    }
+    if (tokenBindingCount >= TOKEN_BINDING_SLOTS) {
+        DFTE_LOG_WARN("Token binding slots full, tokens of this table are looked up by name");
+        return false;
+    }
+
+    const PlaceholderEntry** entries = new (std::nothrow) const PlaceholderEntry*[table->count > 0 ? table->count : 1];
+    if (entries == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate token index table");
+        return false;
+    }
+
+    // One name lookup per token; commitEntry() and clear() keep the table current from here on
+    char name[MAX_PLACEHOLDER_NAME_SIZE];
+    for (uint16_t i = 0; i < table->count; ++i) {
+        const char* tokenName = static_cast<const char*>(pgm_read_ptr(&table->names[i]));
+        strncpy_P(name, tokenName, sizeof(name) - 1);
+        name[sizeof(name) - 1] = '\0';
+        entries[i] = getPlaceholder(name);
+    }
+    tokenBindings[tokenBindingCount++] = TokenBinding{table, entries};
+    return true;
+}
+
+void DeviceFrameworkPlaceholderRegistry::rebindToken(const PlaceholderEntry& entry) {
+    // The new entry wins for its name, as in the name index
+    for (size_t i = 0; i < tokenBindingCount; ++i) {
+        const TokenTable* table = tokenBindings[i].table;
+        for (uint16_t id = 0; id < table->count; ++id) {
+            const char* tokenName = static_cast<const char*>(pgm_read_ptr(&table->names[id]));
+            if (strncmp_P(entry.name, tokenName, MAX_PLACEHOLDER_NAME_SIZE - 1) == 0) {
+                tokenBindings[i].entries[id] = &entry;
+            }
+        }
+    }
+}
+
 size_t DeviceFrameworkPlaceholderRegistry::renderPlaceholder(const PlaceholderEntry* entry, size_t offset, 
-                                             uint8_t* buffer, size_t maxLen) const {
+                                             uint8_t* buffer, size_t maxLen) {
     if (entry == nullptr || buffer == nullptr || maxLen == 0) {
         return 0;
     }
     
     switch (entry->type) {
         case PlaceholderType::PROGMEM_DATA:
-        case PlaceholderType::PROGMEM_TEMPLATE: {
-            const char* data = static_cast<const char*>(entry->data);
+        case PlaceholderType::PROGMEM_TEMPLATE:
+        case PlaceholderType::STATIC_TEMPLATE: {
+            const char* data = entry->type == PlaceholderType::STATIC_TEMPLATE
+                ? static_cast<const StaticTemplate*>(entry->data)->text
+                : static_cast<const char*>(entry->data);
             if (data == nullptr) {
                 return 0;
             }
 
-            size_t dataLen = entry->hasCachedLength ? entry->cachedLength : getProgmemLength(entry->data);
+            size_t dataLen = entry->hasCachedLength ? entry->cachedLength : getProgmemLength(data);
             if (offset >= dataLen) {
                 return 0;
             }
@@ -332,10 +467,34 @@ size_t DeviceFrameworkPlaceholderRegistry::renderPlaceholder(const PlaceholderEn
         case PlaceholderType::DYNAMIC_DATA:
             return copyDynamicData(static_cast<const DynamicDataDescriptor*>(entry->data), offset, buffer, maxLen);
 
+        case PlaceholderType::SIZED_DATA:
+            return copySizedData(static_cast<const SizedDataDescriptor*>(entry->data), offset, buffer, maxLen);
+
+        case PlaceholderType::TYPED_VALUE:
+            return copyTypedValue(static_cast<const TypedValueDescriptor*>(entry->data), offset, buffer, maxLen);
+
+        case PlaceholderType::PROVIDER_FIELD:
+            return copyProviderField(static_cast<const ProviderFieldDescriptor*>(entry->data), offset, buffer, maxLen);
+
+        case PlaceholderType::RING_DATA:
+            return copyRingData(static_cast<const RingBufferDescriptor*>(entry->data), offset, buffer, maxLen);
+
+        case PlaceholderType::PRODUCER_DATA: {
+            // Without an open hook the read handle is userData, so the pull can be served here too
+            const auto* descriptor = static_cast<const ProducerDescriptor*>(entry->data);
+            if (descriptor == nullptr || descriptor->read == nullptr || descriptor->open != nullptr) {
+                return 0;
+            }
+            return min(descriptor->read(descriptor->userData, offset, buffer, maxLen), maxLen);
+        }
+
         case PlaceholderType::DYNAMIC_TEMPLATE:
         case PlaceholderType::CONDITIONAL:
         case PlaceholderType::ITERATOR:
-            // Dynamic template, conditional, and iterator content are handled directly by the renderer
+        case PlaceholderType::COMPILED_TEMPLATE:
+        case PlaceholderType::TOKENIZED_TEMPLATE:
+        case PlaceholderType::WRITER_DATA:
+            // Dynamic template, conditional, iterator, compiled and tokenized template and writer content are handled directly by the renderer
             return 0;
             
         default:
@@ -348,6 +507,16 @@ size_t DeviceFrameworkPlaceholderRegistry::getProgmemLength(const void* data) {
     return strlen_P((const char*)data);
 }
 
+size_t DeviceFrameworkPlaceholderRegistry::getTokenizedTemplateLength(const void* data) {
+    if (data == nullptr) return 0;
+    return static_cast<const TokenizedTemplate*>(data)->length;
+}
+
+size_t DeviceFrameworkPlaceholderRegistry::getStaticTemplateLength(const void* data) {
+    if (data == nullptr) return 0;
+    return static_cast<const StaticTemplate*>(data)->length;
+}
+
 size_t DeviceFrameworkPlaceholderRegistry::getRamLength(const void* data) {
     if (data == nullptr) return 0;
     
@@ -371,6 +540,59 @@ size_t DeviceFrameworkPlaceholderRegistry::getDynamicDataLength(const DynamicDat
     return strlen(data);
 }
 
+bool DeviceFrameworkPlaceholderRegistry::isValidRing(const RingBufferDescriptor* descriptor) {
+    return descriptor != nullptr && descriptor->base != nullptr && descriptor->capacity > 0 &&
+           descriptor->head != nullptr && descriptor->tail != nullptr;
+}
+
+RingBufferSnapshot DeviceFrameworkPlaceholderRegistry::snapshotRing(const RingBufferDescriptor* descriptor) {
+    RingBufferSnapshot snapshot = {nullptr, 0, nullptr, 0};
+    if (!isValidRing(descriptor)) {
+        return snapshot;
+    }
+
+    // The writer may run on another task or core and moves head and tail separately: take the pair again
+    // until head is unchanged across the read, so the segments describe one moment of the log. Acquire
+    // loads pair with the writer's release stores, so every byte before head is visible here.
+    size_t head = descriptor->head->load(std::memory_order_acquire);
+    size_t tail;
+    bool full;
+    for (uint8_t attempt = 0;; ++attempt) {
+        tail = descriptor->tail->load(std::memory_order_acquire);
+        full = descriptor->full != nullptr && descriptor->full->load(std::memory_order_acquire);
+        size_t again = descriptor->head->load(std::memory_order_acquire);
+        if (again == head) {
+            break;
+        }
+        if (attempt == RING_SNAPSHOT_RETRIES) {
+            // Keep the head read just before this tail: the pair the loop would have accepted one pass earlier
+            DFTE_LOG_WARN("Ring buffer head kept moving across " + String(RING_SNAPSHOT_RETRIES + 1) +
+                          " reads; rendering up to the head read before the last tail");
+            break;
+        }
+        head = again;
+    }
+
+    size_t capacity = descriptor->capacity;
+    if (head >= capacity || tail >= capacity) {
+        DFTE_LOG_WARN("Ring buffer index out of range; rendering nothing");
+        return snapshot;
+    }
+    if (head == tail && !full) {
+        return snapshot;
+    }
+
+    snapshot.first = descriptor->base + tail;
+    if (head > tail) {
+        snapshot.firstLength = head - tail;
+    } else {
+        snapshot.firstLength = capacity - tail;
+        snapshot.second = descriptor->base;
+        snapshot.secondLength = head;
+    }
+    return snapshot;
+}
+
 size_t DeviceFrameworkPlaceholderRegistry::getDynamicTemplateLength(const DynamicTemplateDescriptor* descriptor, const char* templateData) {
     if (descriptor == nullptr || templateData == nullptr) {
         return 0;
@@ -440,3 +662,274 @@ size_t DeviceFrameworkPlaceholderRegistry::copyDynamicData(const DynamicDataDesc
     return chunkSize;
 }
 
+size_t DeviceFrameworkPlaceholderRegistry::copySizedData(const SizedDataDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen) {
+    if (descriptor == nullptr || descriptor->getter == nullptr || maxLen == 0) return 0;
+
+    PlaceholderValue value = descriptor->getter(descriptor->userData);
+    if (value.data == nullptr || offset >= value.length) {
+        return 0;
+    }
+
+    size_t remaining = value.length - offset;
+    constexpr size_t MAX_CHUNK = DFTE_RAM_CHUNK_SIZE;
+    size_t chunkSize = min(min(maxLen, remaining), MAX_CHUNK);
+
+    memcpy(dest, value.data + offset, chunkSize);
+    return chunkSize;
+}
+
+size_t DeviceFrameworkPlaceholderRegistry::copyTypedValue(const TypedValueDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen) {
+    if (descriptor == nullptr || maxLen == 0) return 0;
+
+    // Formatted again per call, like the other getters on this path; the renderer formats once per occurrence
+    char text[DFTE_TYPED_TEXT_SIZE];
+    PlaceholderValue value = DeviceFrameworkTypedValue::format(*descriptor, text);
+    if (value.data == nullptr || offset >= value.length) {
+        return 0;
+    }
+
+    size_t chunkSize = min(maxLen, value.length - offset);
+    memcpy(dest, value.data + offset, chunkSize);
+    return chunkSize;
+}
+
+size_t DeviceFrameworkPlaceholderRegistry::copyProviderField(const ProviderFieldDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen) {
+    if (descriptor == nullptr || descriptor->provider == nullptr || maxLen == 0) return 0;
+
+    // Outside a render there is no render id: a TTL sample is reused, otherwise every call samples
+    char text[DFTE_TYPED_TEXT_SIZE];
+    PlaceholderValue value = descriptor->provider->format(descriptor->field, text, nullptr);
+    if (value.data == nullptr || offset >= value.length) {
+        return 0;
+    }
+
+    size_t chunkSize = min(maxLen, value.length - offset);
+    memcpy(dest, value.data + offset, chunkSize);
+    return chunkSize;
+}
+
+size_t DeviceFrameworkPlaceholderRegistry::copyRingData(const RingBufferDescriptor* descriptor, size_t offset, uint8_t* dest, size_t maxLen) {
+    // Indices are read again per call, like the getters on this path; the renderer snapshots once per occurrence
+    RingBufferSnapshot ring = snapshotRing(descriptor);
+    const char* source;
+    size_t available;
+    if (offset < ring.firstLength) {
+        source = ring.first + offset;
+        available = ring.firstLength - offset;
+    } else if (offset - ring.firstLength < ring.secondLength) {
+        source = ring.second + (offset - ring.firstLength);
+        available = ring.secondLength - (offset - ring.firstLength);
+    } else {
+        return 0;
+    }
+
+    size_t chunkSize = min(min(maxLen, available), static_cast<size_t>(DFTE_RAM_CHUNK_SIZE));
+    memcpy(dest, source, chunkSize);
+    return chunkSize;
+}
+
+const TemplatePlan* DeviceFrameworkPlaceholderRegistry::acquirePlan(const char* progmemTemplate, size_t templateLen,
+                                                                    const StaticTemplate* compiled) {
+    if (PLAN_CACHE_SIZE == 0 || progmemTemplate == nullptr || templateLen == 0) {
+        return nullptr;
+    }
+
+    size_t slot;
+    lockPlans();
+    TemplatePlan* cached = findCachedPlan(progmemTemplate, slot);
+    if (cached != nullptr && cached->generation == generation) {
+        const TemplatePlan* pinned = pinPlan(cached);
+        unlockPlans();
+        return pinned;
+    }
+    unlockPlans();
+
+    // Built outside the lock, so scanning a long template does not stall contexts rendering on other tasks
+    TemplatePlan* plan = buildPlan(progmemTemplate, templateLen, compiled);
+    if (plan == nullptr) {
+        return nullptr;
+    }
+
+    lockPlans();
+    cached = findCachedPlan(progmemTemplate, slot);
+    if (cached != nullptr && cached->generation == plan->generation) {
+        // Another context cached the same plan meanwhile: use that one
+        const TemplatePlan* pinned = pinPlan(cached);
+        unlockPlans();
+        releasePlan(plan);
+        return pinned;
+    }
+    if (slot == PLAN_CACHE_SIZE) {
+        slot = planCacheNext;
+        planCacheNext = (planCacheNext + 1 < PLAN_CACHE_SIZE) ? planCacheNext + 1 : 0;
+    }
+    TemplatePlan* evicted = planCache[slot];
+    planCache[slot] = plan;
+    const TemplatePlan* pinned = pinPlan(plan);
+    unlockPlans();
+
+    // Frames still walking the evicted plan keep it alive until they release it
+    releasePlan(evicted);
+    return pinned;
+}
+
+TemplatePlan* DeviceFrameworkPlaceholderRegistry::findCachedPlan(const char* progmemTemplate, size_t& slot) const {
+    // slot: where this template's plan lives, else the first free slot, else PLAN_CACHE_SIZE (evict round-robin)
+    slot = PLAN_CACHE_SIZE;
+    for (size_t i = 0; i < PLAN_CACHE_SIZE; ++i) {
+        TemplatePlan* cached = planCache[i];
+        if (cached == nullptr) {
+            if (slot == PLAN_CACHE_SIZE) {
+                slot = i;
+            }
+        } else if (cached->templateData == progmemTemplate) {
+            slot = i;
+            return cached;
+        }
+    }
+    return nullptr;
+}
+
+const TemplatePlan* DeviceFrameworkPlaceholderRegistry::pinPlan(TemplatePlan* plan) {
+    // Plans without segments are cached only to remember that the template is interpreted
+    if (plan->segments == nullptr) {
+        return nullptr;
+    }
+    plan->refCount.fetch_add(1, std::memory_order_relaxed);
+    return plan;
+}
+
+void DeviceFrameworkPlaceholderRegistry::releasePlan(const TemplatePlan* plan) {
+    if (plan == nullptr) {
+        return;
+    }
+    TemplatePlan* mutablePlan = const_cast<TemplatePlan*>(plan);
+    if (mutablePlan->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete[] mutablePlan->segments;
+        delete mutablePlan;
+    }
+}
+
+void DeviceFrameworkPlaceholderRegistry::lockPlans() {
+    while (planLock.test_and_set(std::memory_order_acquire)) {
+        yield();
+    }
+}
+
+void DeviceFrameworkPlaceholderRegistry::unlockPlans() {
+    planLock.clear(std::memory_order_release);
+}
+
+TemplatePlan* DeviceFrameworkPlaceholderRegistry::buildPlan(const char* progmemTemplate, size_t templateLen,
+                                                            const StaticTemplate* compiled) const {
+    TemplatePlan* plan = new (std::nothrow) TemplatePlan();
+    if (plan == nullptr) {
+        DFTE_LOG_WARN("Failed to allocate template plan");
+        return nullptr;
+    }
+    plan->templateData = progmemTemplate;
+    plan->owner = this;
+    plan->generation = generation;
+    plan->segments = nullptr;
+    plan->segmentCount = 0;
+    plan->refCount.store(1, std::memory_order_relaxed);  // The cache's reference
+
+    if (compiled != nullptr && compiled->text != progmemTemplate) {
+        compiled = nullptr;
+    }
+
+    // First pass sizes the segment table; oversized plans are cached empty so the template is interpreted
+    size_t segmentCount = compiled ? compiled->segmentCount : scanTemplate(progmemTemplate, templateLen, nullptr, 0);
+    if (segmentCount == 0 || segmentCount > PLAN_MAX_SEGMENTS) {
+        DFTE_LOG_DEBUG("Template not compiled (" + String(segmentCount) + " segments)");
+        return plan;
+    }
+
+    plan->segments = new (std::nothrow) TemplateSegment[segmentCount];
+    if (plan->segments == nullptr) {
+        DFTE_LOG_WARN("Failed to allocate template plan segments");
+        delete plan;
+        return nullptr;
+    }
+    if (compiled == nullptr) {
+        plan->segmentCount = static_cast<uint16_t>(scanTemplate(progmemTemplate, templateLen, plan->segments, segmentCount));
+        return plan;
+    }
+
+    // Compile-time table: copy it out of flash and resolve its tokens against the current entries
+    char name[MAX_PLACEHOLDER_NAME_SIZE];
+    for (size_t i = 0; i < segmentCount; ++i) {
+        TemplateSegment& segment = plan->segments[i];
+        memcpy_P(&segment, compiled->segments + i, sizeof(TemplateSegment));
+        if (segment.kind != TemplateSegmentKind::TOKEN || segment.length >= sizeof(name)) {
+            continue;
+        }
+        memcpy_P(name, progmemTemplate + segment.offset, segment.length);
+        name[segment.length] = '\0';
+        segment.entry = getPlaceholder(name);
+        if (segment.entry) {
+            segment.kind = TemplateSegmentKind::PLACEHOLDER;
+        }
+    }
+    plan->segmentCount = static_cast<uint16_t>(segmentCount);
+    return plan;
+}
+
+size_t DeviceFrameworkPlaceholderRegistry::scanTemplate(const char* progmemTemplate, size_t templateLen,
+                                                        TemplateSegment* segments, size_t maxSegments) const {
+    // Mirrors the interpreter: a token is '%' plus up to MAX_PLACEHOLDER_NAME_SIZE - 2 bytes ending in '%';
+    // longer or unterminated tokens are dropped and scanning resumes after the bytes they consumed
+    size_t segmentCount = 0;
+    size_t literalStart = 0;
+    size_t pos = 0;
+    char name[MAX_PLACEHOLDER_NAME_SIZE];
+
+    auto emit = [&](TemplateSegmentKind kind, size_t offset, size_t length, const PlaceholderEntry* entry) {
+        if (segments != nullptr && segmentCount < maxSegments) {
+            TemplateSegment& segment = segments[segmentCount];
+            segment.kind = kind;
+            segment.offset = static_cast<uint32_t>(offset);
+            segment.length = static_cast<uint32_t>(length);
+            segment.entry = entry;
+        }
+        segmentCount++;
+    };
+
+    while (pos < templateLen) {
+        if (pgm_read_byte(progmemTemplate + pos) != '%') {
+            pos++;
+            continue;
+        }
+
+        if (pos > literalStart) {
+            emit(TemplateSegmentKind::LITERAL, literalStart, pos - literalStart, nullptr);
+        }
+
+        size_t tokenStart = pos++;
+        size_t nameLen = 1;
+        bool closed = false;
+        while (nameLen < MAX_PLACEHOLDER_NAME_SIZE - 1 && pos < templateLen) {
+            nameLen++;
+            if (pgm_read_byte(progmemTemplate + pos++) == '%') {
+                closed = true;
+                break;
+            }
+        }
+
+        if (closed) {
+            const PlaceholderEntry* entry = nullptr;
+            if (segments != nullptr) {
+                memcpy_P(name, progmemTemplate + tokenStart, nameLen);
+                name[nameLen] = '\0';
+                entry = getPlaceholder(name);
+            }
+            emit(entry ? TemplateSegmentKind::PLACEHOLDER : TemplateSegmentKind::TOKEN, tokenStart, nameLen, entry);
+        }
+        literalStart = pos;
+    }
+
+    if (templateLen > literalStart) {
+        emit(TemplateSegmentKind::LITERAL, literalStart, templateLen - literalStart, nullptr);
+    }
+    return segmentCount;
+}
@@ -0,0 +1,71 @@
+#include "DeviceFrameworkPlaceholderWriter.h"
+#include "DeviceFrameworkTypedValue.h"
+#include <pgmspace.h>
+#include <cstring>
+
+size_t DeviceFrameworkPlaceholderWriter::write(const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    size_t accepted = 0;
+
+    size_t toBuffer = min(length, capacity - bufferUsed);
+    if (toBuffer > 0) {
+        memcpy(buffer + bufferUsed, bytes, toBuffer);
+        bufferUsed += toBuffer;
+        accepted = toBuffer;
+    }
+
+    size_t toSpill = min(length - accepted, spillCapacity - spillUsed);
+    if (toSpill > 0) {
+        memcpy(spill + spillUsed, bytes + accepted, toSpill);
+        spillUsed += toSpill;
+        accepted += toSpill;
+    }
+
+    if (accepted < length) {
+        overflowed = true;
+    }
+    return accepted;
+}
+
+bool DeviceFrameworkPlaceholderWriter::print(const char* text) {
+    if (text == nullptr) {
+        return true;
+    }
+    size_t length = strlen(text);
+    return write(text, length) == length;
+}
+
+bool DeviceFrameworkPlaceholderWriter::printProgmem(const char* text) {
+    if (text == nullptr) {
+        return true;
+    }
+    // Copy through a small stack buffer; flash cannot be memcpy'd directly on ESP8266
+    char piece[16];
+    size_t length = strlen_P(text);
+    for (size_t offset = 0; offset < length; offset += sizeof(piece)) {
+        size_t count = min(sizeof(piece), length - offset);
+        memcpy_P(piece, text + offset, count);
+        if (write(piece, count) != count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DeviceFrameworkPlaceholderWriter::printUnsigned(uint32_t value) {
+    char text[DeviceFrameworkTypedValue::MAX_TEXT];
+    size_t length = DeviceFrameworkTypedValue::formatUnsigned(value, text);
+    return write(text, length) == length;
+}
+
+bool DeviceFrameworkPlaceholderWriter::printSigned(int32_t value) {
+    char text[DeviceFrameworkTypedValue::MAX_TEXT];
+    size_t length = DeviceFrameworkTypedValue::formatSigned(value, text);
+    return write(text, length) == length;
+}
+
+bool DeviceFrameworkPlaceholderWriter::printFixed(float value, uint8_t decimals) {
+    char text[DeviceFrameworkTypedValue::MAX_TEXT];
+    size_t length = DeviceFrameworkTypedValue::formatFixed(value, decimals, text);
+    return write(text, length) == length;
+}
@@ -0,0 +1,212 @@
+#include "DeviceFrameworkScratchArena.h"
+#include "DeviceFrameworkTemplateContext.h"
+#include "DeviceFrameworkTemplateEngineDebug.h"
+#include <new>
+#include <stdarg.h>
+
+DeviceFrameworkScratchArena::DeviceFrameworkScratchArena(size_t capacity)
+    : base(nullptr), capacity(capacity), used(0), pinned(0), highWater(0), failures(0), ownsBuffer(true) {}
+
+DeviceFrameworkScratchArena::DeviceFrameworkScratchArena(uint8_t* storage, size_t capacity)
+    : base(storage), capacity(storage ? capacity : 0), used(0), pinned(0), highWater(0), failures(0), ownsBuffer(false) {}
+
+DeviceFrameworkScratchArena::~DeviceFrameworkScratchArena() {
+    if (ownsBuffer) {
+        delete[] base;
+    }
+}
+
+DeviceFrameworkScratchArena* DeviceFrameworkScratchArena::current() {
+    DeviceFrameworkTemplateContext* ctx = DeviceFrameworkTemplateContext::rendering();
+    return ctx ? ctx->getScratchArena() : nullptr;
+}
+
+bool DeviceFrameworkScratchArena::ensureBuffer() {
+    if (base != nullptr || !ownsBuffer || capacity == 0) {
+        return base != nullptr;
+    }
+    base = new (std::nothrow) uint8_t[capacity];
+    if (base == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate scratch arena (" + String(static_cast<uint32_t>(capacity)) + " bytes)");
+        capacity = 0;
+        return false;
+    }
+    return true;
+}
+
+void* DeviceFrameworkScratchArena::take(size_t size, size_t alignment) {
+    if (!ensureBuffer()) {
+        failures++;
+        return nullptr;
+    }
+    // Align the address, not the offset: caller storage need not be aligned itself
+    uintptr_t start = reinterpret_cast<uintptr_t>(base) + used;
+    size_t padding = static_cast<size_t>((alignment - (start & (alignment - 1))) & (alignment - 1));
+    if (padding > capacity - used || size > capacity - used - padding) {
+        failures++;
+        DFTE_LOG_TRACE("Scratch arena full: " + String(static_cast<uint32_t>(size)) + " bytes requested, " +
+                       String(static_cast<uint32_t>(capacity - used)) + " left");
+        return nullptr;
+    }
+    used += padding;
+    void* block = base + used;
+    used += size;
+    if (used > highWater) {
+        highWater = used;
+    }
+    return block;
+}
+
+void* DeviceFrameworkScratchArena::allocate(size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        DFTE_LOG_ERROR("Scratch arena alignment must be a power of two");
+        failures++;
+        return nullptr;
+    }
+    return take(size, alignment);
+}
+
+char* DeviceFrameworkScratchArena::allocateText(size_t length) {
+    if (length == SIZE_MAX) {
+        failures++;
+        return nullptr;
+    }
+    char* text = static_cast<char*>(take(length + 1, 1));
+    if (text) {
+        text[0] = '\0';
+    }
+    return text;
+}
+
+const char* DeviceFrameworkScratchArena::copy(const char* text, size_t length) {
+    if (text == nullptr) {
+        return nullptr;
+    }
+    char* target = allocateText(length);
+    if (target) {
+        memcpy(target, text, length);
+        target[length] = '\0';
+    }
+    return target;
+}
+
+const char* DeviceFrameworkScratchArena::copy(const char* text) {
+    return text ? copy(text, strlen(text)) : nullptr;
+}
+
+const char* DeviceFrameworkScratchArena::format(const char* pattern, ...) {
+    if (pattern == nullptr || !ensureBuffer()) {
+        failures++;
+        return nullptr;
+    }
+    // Print straight into the free tail and keep only what the result used
+    char* target = reinterpret_cast<char*>(base + used);
+    size_t room = capacity - used;
+    va_list args;
+    va_start(args, pattern);
+    int length = vsnprintf(target, room, pattern, args);
+    va_end(args);
+    if (length < 0 || static_cast<size_t>(length) >= room) {
+        failures++;
+        if (room > 0) {
+            target[0] = '\0';
+        }
+        return nullptr;
+    }
+    used += static_cast<size_t>(length) + 1;
+    if (used > highWater) {
+        highWater = used;
+    }
+    return target;
+}
+
+void DeviceFrameworkScratchArena::rewind(size_t position) {
+    if (position < pinned) {
+        position = pinned;
+    }
+    if (position < used) {
+        used = position;
+    }
+}
+
+void DeviceFrameworkScratchArena::resetStats() {
+    highWater = used;
+    failures = 0;
+}
+
+DeviceFrameworkScratchArenaPool::DeviceFrameworkScratchArenaPool(uint8_t count, size_t capacity)
+    : arenas(nullptr), count(0), borrowed(0) {
+    if (count == 0 || count > 32) {
+        DFTE_LOG_ERROR("Scratch arena pool holds 1 to 32 arenas, got " + String(count));
+        return;
+    }
+    // Arena objects first, then their buffers, in one allocation
+    size_t headerBytes = (count * sizeof(DeviceFrameworkScratchArena) + alignof(std::max_align_t) - 1) &
+                         ~(alignof(std::max_align_t) - 1);
+    uint8_t* block = new (std::nothrow) uint8_t[headerBytes + count * capacity];
+    if (block == nullptr) {
+        DFTE_LOG_ERROR("Failed to allocate scratch arena pool (" + String(static_cast<uint32_t>(count * capacity)) + " bytes)");
+        return;
+    }
+    arenas = reinterpret_cast<DeviceFrameworkScratchArena*>(block);
+    for (uint8_t i = 0; i < count; ++i) {
+        new (&arenas[i]) DeviceFrameworkScratchArena(block + headerBytes + i * capacity, capacity);
+    }
+    this->count = count;
+}
+
+DeviceFrameworkScratchArenaPool::~DeviceFrameworkScratchArenaPool() {
+    if (borrowed.load(std::memory_order_relaxed) != 0) {
+        DFTE_LOG_WARN("Scratch arena pool destroyed while arenas are borrowed");
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        arenas[i].~DeviceFrameworkScratchArena();
+    }
+    delete[] reinterpret_cast<uint8_t*>(arenas);
+}
+
+DeviceFrameworkScratchArena* DeviceFrameworkScratchArenaPool::acquire() {
+    uint32_t all = count == 32 ? 0xFFFFFFFFu : ((1u << count) - 1);
+    uint32_t taken = borrowed.load(std::memory_order_relaxed);
+    while ((taken & all) != all) {
+        uint8_t index = 0;
+        while (taken & (1u << index)) {
+            index++;
+        }
+        if (borrowed.compare_exchange_weak(taken, taken | (1u << index), std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+            return &arenas[index];
+        }
+    }
+    return nullptr;
+}
+
+void DeviceFrameworkScratchArenaPool::release(DeviceFrameworkScratchArena* arena) {
+    if (arena == nullptr || count == 0 || arena < arenas || arena >= arenas + count) {
+        return;
+    }
+    arena->reset();
+    uint32_t bit = 1u << static_cast<uint8_t>(arena - arenas);
+    borrowed.fetch_and(~bit, std::memory_order_release);
+}
+
+uint8_t DeviceFrameworkScratchArenaPool::getAvailable() const {
+    uint32_t taken = borrowed.load(std::memory_order_relaxed);
+    uint8_t available = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        if ((taken & (1u << i)) == 0) {
+            available++;
+        }
+    }
+    return available;
+}
+
+size_t DeviceFrameworkScratchArenaPool::getHighWater() const {
+    size_t highest = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (arenas[i].getHighWater() > highest) {
+            highest = arenas[i].getHighWater();
+        }
+    }
+    return highest;
+}
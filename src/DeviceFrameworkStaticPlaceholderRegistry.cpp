@@ -0,0 +1,23 @@
+#include "DeviceFrameworkStaticPlaceholderRegistry.h"
+#include <pgmspace.h>
+
+const PlaceholderEntry* DeviceFrameworkStaticPlaceholderRegistry::getPlaceholder(const char* name) const {
+    if (name == nullptr || entries == nullptr || count == 0) {
+        return nullptr;
+    }
+
+    uint32_t hash = hashName(name);
+    uint16_t seed = pgm_read_word(&seeds[hash & bucketMask]);
+    const PlaceholderEntry* entry = &entries[dfte::detail::staticSlotHash(hash, seed) & slotMask];
+
+    // A name can only live in this slot; empty slots have no name and never match
+    if (entry->name == nullptr || entry->nameHash != hash || strcmp(entry->name, name) != 0) {
+        return nullptr;
+    }
+    return entry;
+}
+
+// Runtime form of dfte::detail::staticNameHash (the constexpr one recurses per byte)
+uint32_t DeviceFrameworkStaticPlaceholderRegistry::hashName(const char* name) {
+    return DeviceFrameworkPlaceholderRegistry::hashName(name);
+}
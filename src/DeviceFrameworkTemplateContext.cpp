@@ -1,18 +1,81 @@
 #include "DeviceFrameworkTemplateContext.h"
 #include "DeviceFrameworkTemplateEngineDebug.h"
+#include "DeviceFrameworkTemplateKernels.h"
+#include "DeviceFrameworkPlaceholderRegistry.h"
+
+DFTE_THREAD_LOCAL DeviceFrameworkTemplateContext* DeviceFrameworkTemplateContext::renderingNow = nullptr;
 
 DeviceFrameworkTemplateContext::DeviceFrameworkTemplateContext() 
     : state(TemplateRenderState::TEXT), renderingDepth(0), placeholderPos(0),
       bufferPos(0), bufferLen(0), bufferOffset(0),
-      registry(nullptr),
-      totalBytesProcessed(0), startTime(0) {
+      registry(nullptr), memoCount(0), providerSampleCount(0), cachedCopyCount(0), scratchPool(nullptr), borrowedScratch(nullptr),
+      totalBytesProcessed(0), totalSteps(0), startTime(0) {
     memset(placeholderName, 0, sizeof(placeholderName));
     for (int i = 0; i < MAX_RENDERING_DEPTH; ++i) {
         renderingStack[i] = RenderingContext();
     }
 }
 
+DeviceFrameworkTemplateContext::~DeviceFrameworkTemplateContext() {
+    releaseFrames();
+    releaseScratch();
+}
+
+void DeviceFrameworkTemplateContext::setScratchPool(DeviceFrameworkScratchArenaPool* pool) {
+    releaseScratch();
+    scratchPool = pool;
+}
+
+DeviceFrameworkScratchArena* DeviceFrameworkTemplateContext::getScratchArena() {
+    if (borrowedScratch) {
+        return borrowedScratch;
+    }
+    if (scratchPool) {
+        borrowedScratch = scratchPool->acquire();
+        if (borrowedScratch == nullptr) {
+            // Stay on the owned arena for the rest of the render so its values do not move between arenas
+            DFTE_LOG_TRACE("Scratch arena pool empty, using the context's own arena");
+            borrowedScratch = &scratch;
+        }
+        return borrowedScratch;
+    }
+    return &scratch;
+}
+
+void DeviceFrameworkTemplateContext::releaseScratch() {
+    // Provider samples and cached value copies live in the arena
+    providerSampleCount = 0;
+    cachedCopyCount = 0;
+    scratch.reset();
+    if (borrowedScratch && borrowedScratch != &scratch) {
+        scratchPool->release(borrowedScratch);
+    }
+    borrowedScratch = nullptr;
+}
+
+void DeviceFrameworkTemplateContext::releaseFrames() {
+    for (int i = 0; i < renderingDepth; ++i) {
+        RenderingContext& ctx = renderingStack[i];
+        if (ctx.type == RenderingContextType::TEMPLATE && ctx.context.templateCtx.plan) {
+            DeviceFrameworkPlaceholderRegistry::releasePlan(ctx.context.templateCtx.plan);
+            ctx.context.templateCtx.plan = nullptr;
+        } else if (ctx.type == RenderingContextType::PLACEHOLDER_DATA) {
+            closeProducer(ctx);
+        }
+    }
+}
+
+void DeviceFrameworkTemplateContext::closeProducer(RenderingContext& ctx) {
+    auto& dataCtx = ctx.context.data;
+    if (dataCtx.handleOpen && dataCtx.entry && dataCtx.entry->type == PlaceholderType::PRODUCER_DATA) {
+        dataCtx.handleOpen = false;
+        static_cast<const ProducerDescriptor*>(dataCtx.entry->data)->close(dataCtx.handle);
+    }
+}
+
 void DeviceFrameworkTemplateContext::reset() {
+    releaseFrames();
+    releaseScratch();
     state = TemplateRenderState::TEXT;
     renderingDepth = 0;
     placeholderPos = 0;
@@ -20,6 +83,10 @@ void DeviceFrameworkTemplateContext::reset() {
     bufferLen = 0;
     bufferOffset = 0;
     totalBytesProcessed = 0;
+    totalSteps = 0;
+    memoCount = 0;
+    providerSampleCount = 0;
+    cachedCopyCount = 0;
     startTime = millis();
     memset(placeholderName, 0, sizeof(placeholderName));
     for (int i = 0; i < MAX_RENDERING_DEPTH; ++i) {
@@ -49,6 +116,7 @@ bool DeviceFrameworkTemplateContext::pushContext(RenderingContextType type, cons
     RenderingContext& ctx = renderingStack[renderingDepth];
     ctx.type = type;
     ctx.name = name;
+    ctx.tailDepth = 0;
     
     // Initialize buffer state for new template context
     if (type == RenderingContextType::TEMPLATE) {
@@ -57,6 +125,11 @@ bool DeviceFrameworkTemplateContext::pushContext(RenderingContextType type, cons
         ctx.context.templateCtx.bufferOffset = 0;
         ctx.context.templateCtx.iteratorPlaceholders = nullptr;
         ctx.context.templateCtx.iteratorPlaceholderCount = 0;
+        ctx.context.templateCtx.plan = nullptr;
+        ctx.context.templateCtx.segmentIndex = 0;
+        ctx.context.templateCtx.planResolved = false;
+        ctx.context.templateCtx.compiled = nullptr;
+        ctx.context.templateCtx.tokens = nullptr;
         bufferPos = 0;
         bufferLen = 0;
         bufferOffset = 0;
@@ -81,6 +154,10 @@ void DeviceFrameworkTemplateContext::popContext() {
         if (descriptor && descriptor->close && ctx.context.iterator.handleOpen) {
             descriptor->close(ctx.context.iterator.handle);
         }
+    } else if (ctx.type == RenderingContextType::TEMPLATE && ctx.context.templateCtx.plan) {
+        DeviceFrameworkPlaceholderRegistry::releasePlan(ctx.context.templateCtx.plan);
+    } else if (ctx.type == RenderingContextType::PLACEHOLDER_DATA) {
+        closeProducer(ctx);
     }
     
     // Restore buffer state from parent template context if it exists
@@ -109,9 +186,8 @@ void DeviceFrameworkTemplateContext::popContext() {
         bufferLen = 0;
         bufferOffset = 0;
     }
-    
-    // Clear the popped context
-    ctx = RenderingContext();
+
+    // No need to clear the popped frame: pushContext and its callers initialize every field a frame type reads
 }
 
 RenderingContext* DeviceFrameworkTemplateContext::getCurrentContext() {
@@ -133,6 +209,7 @@ bool DeviceFrameworkTemplateContext::isRenderingPlaceholder() const {
     if (renderingDepth == 0) return false;
     RenderingContextType type = renderingStack[renderingDepth - 1].type;
     return type == RenderingContextType::PLACEHOLDER_DATA || 
+           type == RenderingContextType::PLACEHOLDER_WRITER ||
            type == RenderingContextType::PLACEHOLDER_TEMPLATE;
 }
 
@@ -169,6 +246,8 @@ String DeviceFrameworkTemplateContext::getStackTrace() const {
             case RenderingContextType::TEMPLATE: typeStr = "TEMPLATE"; break;
             case RenderingContextType::PLACEHOLDER_DATA: typeStr = "PLACEHOLDER_DATA"; break;
             case RenderingContextType::PLACEHOLDER_TEMPLATE: typeStr = "PLACEHOLDER_TEMPLATE"; break;
+            case RenderingContextType::COMPILED_TEMPLATE: typeStr = "COMPILED_TEMPLATE"; break;
+            case RenderingContextType::PLACEHOLDER_WRITER: typeStr = "PLACEHOLDER_WRITER"; break;
             default: typeStr = "UNKNOWN"; break;
         }
         trace += "  [" + String(i) + "] " + String(ctx.name) + " (type=" + typeStr + ")";
@@ -176,6 +255,8 @@ String DeviceFrameworkTemplateContext::getStackTrace() const {
             trace += " at pos " + String(ctx.context.templateCtx.position);
         } else if (ctx.type == RenderingContextType::PLACEHOLDER_DATA) {
             trace += " at offset " + String(ctx.context.data.offset);
+        } else if (ctx.type == RenderingContextType::COMPILED_TEMPLATE) {
+            trace += " at resume point " + String(ctx.context.compiledTemplate.cursor.resumePoint);
         }
         trace += "\n";
     }
@@ -220,8 +301,16 @@ char DeviceFrameworkTemplateContext::getNextChar() {
         return '\0';
     }
     
-    // Restore buffer state from template context if needed
     auto& templateCtx = currentCtx->context.templateCtx;
+    if (!templateCtx.isProgmem) {
+        // RAM templates are read in place; readBuffer only stages PROGMEM
+        if (templateCtx.position >= templateCtx.templateLen) {
+            return '\0';
+        }
+        return templateCtx.templateData[templateCtx.position++];
+    }
+
+    // Restore buffer state from template context if needed
     if (bufferPos == 0 && bufferLen == 0 && templateCtx.bufferLen > 0) {
         // Buffer state might be stale, restore from context
         bufferPos = templateCtx.bufferPos;
@@ -244,6 +333,65 @@ char DeviceFrameworkTemplateContext::getNextChar() {
     return c;
 }
 
+size_t DeviceFrameworkTemplateContext::readLiteralRun(uint8_t* dest, size_t maxLen, bool& delimiterFound, uint8_t delimiter) {
+    delimiterFound = false;
+    RenderingContext* currentCtx = getCurrentContext();
+    if (!currentCtx || currentCtx->type != RenderingContextType::TEMPLATE || maxLen == 0) {
+        return 0;
+    }
+
+    auto& templateCtx = currentCtx->context.templateCtx;
+    if (!templateCtx.isProgmem) {
+        // RAM templates are emitted straight from the source pointer
+        if (templateCtx.position >= templateCtx.templateLen) {
+            return 0;
+        }
+        const uint8_t* src = reinterpret_cast<const uint8_t*>(templateCtx.templateData) + templateCtx.position;
+        size_t window = min(maxLen, templateCtx.templateLen - templateCtx.position);
+        size_t run = DeviceFrameworkTemplateKernels::copyUntil(dest, src, window, delimiter, delimiterFound);
+        templateCtx.position += run + (delimiterFound ? 1 : 0);
+        return run;
+    }
+
+    if (bufferPos == 0 && bufferLen == 0 && templateCtx.bufferLen > 0) {
+        bufferPos = templateCtx.bufferPos;
+        bufferLen = templateCtx.bufferLen;
+        bufferOffset = templateCtx.bufferOffset;
+    }
+
+    if (bufferPos >= bufferLen) {
+        if (!refillBuffer()) {
+            return 0;
+        }
+    }
+
+    size_t window = min(maxLen, bufferLen - bufferPos);
+    size_t run = DeviceFrameworkTemplateKernels::copyUntil(dest, readBuffer + bufferPos, window, delimiter, delimiterFound);
+    bufferPos += run + (delimiterFound ? 1 : 0);
+
+    // Write frame state back once for the whole run
+    templateCtx.position = bufferOffset + bufferPos;
+    templateCtx.bufferPos = bufferPos;
+    templateCtx.bufferLen = bufferLen;
+    templateCtx.bufferOffset = bufferOffset;
+    return run;
+}
+
+bool DeviceFrameworkTemplateContext::readTokenId(uint32_t& id) {
+    id = 0;
+    for (uint8_t shift = 0; shift < 32; shift += 7) {
+        if (!hasMoreData()) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(getNextChar());
+        id |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 size_t DeviceFrameworkTemplateContext::getAvailableBytes() const {
     return bufferLen - bufferPos;
 }
@@ -262,3 +410,80 @@ void DeviceFrameworkTemplateContext::resetPlaceholder() {
     memset(placeholderName, 0, sizeof(placeholderName));
 }
 
+const DeviceFrameworkTemplateContext::MemoSlot* DeviceFrameworkTemplateContext::findMemo(const PlaceholderEntry* entry) const {
+    // A page memoizes a handful of placeholders: a pointer compare per slot beats any index
+    for (uint8_t i = 0; i < memoCount; ++i) {
+        if (memo[i].entry == entry) {
+            return &memo[i];
+        }
+    }
+    return nullptr;
+}
+
+bool DeviceFrameworkTemplateContext::storeMemo(const PlaceholderEntry* entry, const char* value, uint32_t length) {
+    if (memoCount >= MEMO_SLOTS) {
+        DFTE_LOG_TRACE("Render memo full, not caching: " + String(entry->name));
+        return false;
+    }
+    if (value != nullptr && length > 0) {
+        // Getters only promise their buffer until it has been streamed: later occurrences read a copy
+        DeviceFrameworkScratchArena* arena = getScratchArena();
+        if (arena == nullptr) {
+            return false;
+        }
+        if (!arena->contains(value)) {
+            value = arena->copy(value, length);
+            if (value == nullptr) {
+                DFTE_LOG_TRACE("Scratch arena full, not caching: " + String(entry->name));
+                return false;
+            }
+        }
+        arena->pin();
+    }
+    memo[memoCount++] = MemoSlot{entry, value, length};
+    return true;
+}
+
+const DeviceFrameworkTemplateContext::ProviderSlot* DeviceFrameworkTemplateContext::findProviderSample(
+    const DeviceFrameworkDataProvider* provider) const {
+    for (uint8_t i = 0; i < providerSampleCount; ++i) {
+        if (providerSamples[i].provider == provider) {
+            return &providerSamples[i];
+        }
+    }
+    return nullptr;
+}
+
+bool DeviceFrameworkTemplateContext::storeProviderSample(const DeviceFrameworkDataProvider* provider, const void* sample) {
+    if (providerSampleCount >= PROVIDER_SLOTS) {
+        DFTE_LOG_WARN("Render provider table full, fields of further providers are read live");
+        return false;
+    }
+    if (sample != nullptr) {
+        getScratchArena()->pin();
+    }
+    providerSamples[providerSampleCount++] = ProviderSlot{provider, sample};
+    return true;
+}
+
+const DeviceFrameworkTemplateContext::CacheSlot* DeviceFrameworkTemplateContext::findCachedCopy(
+    const DeviceFrameworkCachedValue* cache) const {
+    for (uint8_t i = 0; i < cachedCopyCount; ++i) {
+        if (cachedCopies[i].cache == cache) {
+            return &cachedCopies[i];
+        }
+    }
+    return nullptr;
+}
+
+bool DeviceFrameworkTemplateContext::storeCachedCopy(const DeviceFrameworkCachedValue* cache, const char* value, size_t length) {
+    if (cachedCopyCount >= CACHE_SLOTS) {
+        DFTE_LOG_WARN("Render cached value table full, further cached values are read from their buffers");
+        return false;
+    }
+    if (value != nullptr) {
+        getScratchArena()->pin();
+    }
+    cachedCopies[cachedCopyCount++] = CacheSlot{cache, value, length};
+    return true;
+}
@@ -0,0 +1,402 @@
+#include "DeviceFrameworkTemplateKernels.h"
+#include <string.h>
+
+#if defined(DFTE_KERNELS_HAVE_SSE2) || defined(DFTE_KERNELS_HAVE_AVX2)
+  #include <immintrin.h>
+#endif
+#if defined(DFTE_KERNELS_HAVE_NEON)
+  #include <arm_neon.h>
+#endif
+
+namespace {
+
+inline bool isNameChar(uint8_t c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Index of the lowest set bit; callers guarantee mask != 0
+inline unsigned lowestBit(uint32_t mask) {
+    return static_cast<unsigned>(__builtin_ctz(mask));
+}
+
+// ---------------------------------------------------------------------------
+// Scalar reference
+// ---------------------------------------------------------------------------
+
+size_t scalarFindByte(const uint8_t* data, size_t len, uint8_t needle) {
+    for (size_t i = 0; i < len; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return len;
+}
+
+size_t scalarCopyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+    for (size_t i = 0; i < len; ++i) {
+        if (src[i] == needle) {
+            found = true;
+            return i;
+        }
+        dest[i] = src[i];
+    }
+    found = false;
+    return len;
+}
+
+size_t scalarNameSpan(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (!isNameChar(data[i])) {
+            return i;
+        }
+    }
+    return len;
+}
+
+// ---------------------------------------------------------------------------
+// SWAR: 32-bit word at a time, used on the Xtensa targets
+// Every mask below is exact per byte (no borrow between lanes), so the lowest
+// flagged byte is the answer.
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t kOnes = 0x01010101u;
+constexpr uint32_t kHigh = 0x80808080u;
+constexpr uint32_t kLow7 = 0x7F7F7F7Fu;
+
+inline uint32_t load32(const uint8_t* p) {
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+// High bit set in every byte of w that is zero
+inline uint32_t zeroBytes(uint32_t w) {
+    return ~(((w & kLow7) + kLow7) | w) & kHigh;
+}
+
+// High bit set in every byte lo <= x <= hi; x must have its high bits cleared
+inline uint32_t rangeBytes(uint32_t x, uint8_t lo, uint8_t hi) {
+    uint32_t ge = x + kOnes * static_cast<uint32_t>(0x80 - lo);
+    uint32_t gt = x + kOnes * static_cast<uint32_t>(0x7F - hi);
+    return ge & ~gt & kHigh;
+}
+
+// Byte index of the first flagged lane in memory order
+inline unsigned firstLane(uint32_t mask) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return static_cast<unsigned>(__builtin_clz(mask)) >> 3;
+#else
+    return lowestBit(mask) >> 3;
+#endif
+}
+
+size_t swarFindByte(const uint8_t* data, size_t len, uint8_t needle) {
+    const uint32_t pattern = kOnes * needle;
+    size_t i = 0;
+    while (i < len && (reinterpret_cast<uintptr_t>(data + i) & 3u) != 0) {
+        if (data[i] == needle) return i;
+        ++i;
+    }
+    for (; i + 4 <= len; i += 4) {
+        uint32_t hits = zeroBytes(load32(data + i) ^ pattern);
+        if (hits) return i + firstLane(hits);
+    }
+    for (; i < len; ++i) {
+        if (data[i] == needle) return i;
+    }
+    return len;
+}
+
+size_t swarCopyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+    const uint32_t pattern = kOnes * needle;
+    found = false;
+    size_t i = 0;
+    while (i < len && (reinterpret_cast<uintptr_t>(src + i) & 3u) != 0) {
+        if (src[i] == needle) {
+            found = true;
+            return i;
+        }
+        dest[i] = src[i];
+        ++i;
+    }
+    for (; i + 4 <= len; i += 4) {
+        uint32_t w = load32(src + i);
+        uint32_t hits = zeroBytes(w ^ pattern);
+        if (hits) {
+            size_t lane = firstLane(hits);
+            memcpy(dest + i, src + i, lane);
+            found = true;
+            return i + lane;
+        }
+        memcpy(dest + i, &w, sizeof(w));
+    }
+    for (; i < len; ++i) {
+        if (src[i] == needle) {
+            found = true;
+            return i;
+        }
+        dest[i] = src[i];
+    }
+    return len;
+}
+
+size_t swarNameSpan(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        uint32_t w = load32(data + i);
+        uint32_t x = w & kLow7;
+        uint32_t valid = rangeBytes(x | (kOnes * 0x20u), 'a', 'z') |
+                         rangeBytes(x, '0', '9') |
+                         zeroBytes(x ^ (kOnes * static_cast<uint32_t>('_')));
+        uint32_t invalid = ~(valid & ~w) & kHigh;
+        if (invalid) return i + firstLane(invalid);
+    }
+    for (; i < len; ++i) {
+        if (!isNameChar(data[i])) return i;
+    }
+    return len;
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 (16 bytes per step)
+// ---------------------------------------------------------------------------
+
+#if defined(DFTE_KERNELS_HAVE_SSE2)
+size_t sse2FindByte(const uint8_t* data, size_t len, uint8_t needle) {
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(needle));
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, pattern)));
+        if (hits) return i + lowestBit(hits);
+    }
+    return i + scalarFindByte(data + i, len - i, needle);
+}
+
+size_t sse2CopyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(needle));
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, pattern)));
+        if (hits) {
+            size_t lane = lowestBit(hits);
+            memcpy(dest + i, src + i, lane);
+            found = true;
+            return i + lane;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), v);
+    }
+    return i + scalarCopyUntil(dest + i, src + i, len - i, needle, found);
+}
+
+// Signed compares: bytes >= 0x80 are negative and fall outside every range
+size_t sse2NameSpan(const uint8_t* data, size_t len) {
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i lowerMin = _mm_set1_epi8('a' - 1);
+    const __m128i lowerMax = _mm_set1_epi8('z' + 1);
+    const __m128i digitMin = _mm_set1_epi8('0' - 1);
+    const __m128i digitMax = _mm_set1_epi8('9' + 1);
+    const __m128i underscore = _mm_set1_epi8('_');
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i folded = _mm_or_si128(v, caseBit);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, lowerMin), _mm_cmplt_epi8(folded, lowerMax));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, digitMin), _mm_cmplt_epi8(v, digitMax));
+        __m128i valid = _mm_or_si128(_mm_or_si128(letter, digit), _mm_cmpeq_epi8(v, underscore));
+        uint32_t invalid = ~static_cast<uint32_t>(_mm_movemask_epi8(valid)) & 0xFFFFu;
+        if (invalid) return i + lowestBit(invalid);
+    }
+    return i + scalarNameSpan(data + i, len - i);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// AVX2 (32 bytes per step), compiled per function and enabled after a CPUID check
+// ---------------------------------------------------------------------------
+
+#if defined(DFTE_KERNELS_HAVE_AVX2)
+#define DFTE_AVX2_TARGET __attribute__((target("avx2")))
+
+DFTE_AVX2_TARGET size_t avx2FindByte(const uint8_t* data, size_t len, uint8_t needle) {
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(needle));
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, pattern)));
+        if (hits) return i + lowestBit(hits);
+    }
+    return i + scalarFindByte(data + i, len - i, needle);
+}
+
+DFTE_AVX2_TARGET size_t avx2CopyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+    const __m256i pattern = _mm256_set1_epi8(static_cast<char>(needle));
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, pattern)));
+        if (hits) {
+            size_t lane = lowestBit(hits);
+            memcpy(dest + i, src + i, lane);
+            found = true;
+            return i + lane;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), v);
+    }
+    return i + scalarCopyUntil(dest + i, src + i, len - i, needle, found);
+}
+
+DFTE_AVX2_TARGET size_t avx2NameSpan(const uint8_t* data, size_t len) {
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    const __m256i lowerMin = _mm256_set1_epi8('a' - 1);
+    const __m256i lowerMax = _mm256_set1_epi8('z' + 1);
+    const __m256i digitMin = _mm256_set1_epi8('0' - 1);
+    const __m256i digitMax = _mm256_set1_epi8('9' + 1);
+    const __m256i underscore = _mm256_set1_epi8('_');
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i folded = _mm256_or_si256(v, caseBit);
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(folded, lowerMin), _mm256_cmpgt_epi8(lowerMax, folded));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, digitMin), _mm256_cmpgt_epi8(digitMax, v));
+        __m256i valid = _mm256_or_si256(_mm256_or_si256(letter, digit), _mm256_cmpeq_epi8(v, underscore));
+        uint32_t invalid = ~static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+        if (invalid) return i + lowestBit(invalid);
+    }
+    return i + scalarNameSpan(data + i, len - i);
+}
+
+#undef DFTE_AVX2_TARGET
+#endif
+
+// ---------------------------------------------------------------------------
+// NEON (AArch64 hosts, 16 bytes per step)
+// ---------------------------------------------------------------------------
+
+#if defined(DFTE_KERNELS_HAVE_NEON)
+// Narrow a byte mask to 4 bits per lane so the first hit is ctz / 4
+inline uint64_t neonLaneBits(uint8x16_t mask) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+size_t neonFindByte(const uint8_t* data, size_t len, uint8_t needle) {
+    const uint8x16_t pattern = vdupq_n_u8(needle);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint64_t hits = neonLaneBits(vceqq_u8(vld1q_u8(data + i), pattern));
+        if (hits) return i + (static_cast<size_t>(__builtin_ctzll(hits)) >> 2);
+    }
+    return i + scalarFindByte(data + i, len - i, needle);
+}
+
+size_t neonCopyUntil(uint8_t* dest, const uint8_t* src, size_t len, uint8_t needle, bool& found) {
+    const uint8x16_t pattern = vdupq_n_u8(needle);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        uint64_t hits = neonLaneBits(vceqq_u8(v, pattern));
+        if (hits) {
+            size_t lane = static_cast<size_t>(__builtin_ctzll(hits)) >> 2;
+            memcpy(dest + i, src + i, lane);
+            found = true;
+            return i + lane;
+        }
+        vst1q_u8(dest + i, v);
+    }
+    return i + scalarCopyUntil(dest + i, src + i, len - i, needle, found);
+}
+
+size_t neonNameSpan(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8(data + i);
+        uint8x16_t folded = vorrq_u8(v, vdupq_n_u8(0x20));
+        uint8x16_t letter = vandq_u8(vcgeq_u8(folded, vdupq_n_u8('a')), vcleq_u8(folded, vdupq_n_u8('z')));
+        uint8x16_t digit = vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')), vcleq_u8(v, vdupq_n_u8('9')));
+        uint8x16_t valid = vorrq_u8(vorrq_u8(letter, digit), vceqq_u8(v, vdupq_n_u8('_')));
+        uint64_t invalid = neonLaneBits(vmvnq_u8(valid));
+        if (invalid) return i + (static_cast<size_t>(__builtin_ctzll(invalid)) >> 2);
+    }
+    return i + scalarNameSpan(data + i, len - i);
+}
+#endif
+
+const DeviceFrameworkTemplateKernels::KernelSet kScalarSet = {"scalar", scalarFindByte, scalarCopyUntil, scalarNameSpan};
+const DeviceFrameworkTemplateKernels::KernelSet kSwarSet = {"swar", swarFindByte, swarCopyUntil, swarNameSpan};
+#if defined(DFTE_KERNELS_HAVE_SSE2)
+const DeviceFrameworkTemplateKernels::KernelSet kSse2Set = {"sse2", sse2FindByte, sse2CopyUntil, sse2NameSpan};
+#endif
+#if defined(DFTE_KERNELS_HAVE_AVX2)
+const DeviceFrameworkTemplateKernels::KernelSet kAvx2Set = {"avx2", avx2FindByte, avx2CopyUntil, avx2NameSpan};
+#endif
+#if defined(DFTE_KERNELS_HAVE_NEON)
+const DeviceFrameworkTemplateKernels::KernelSet kNeonSet = {"neon", neonFindByte, neonCopyUntil, neonNameSpan};
+#endif
+
+bool cpuHasAvx2() {
+#if defined(DFTE_KERNELS_HAVE_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+const DeviceFrameworkTemplateKernels::KernelSet* DeviceFrameworkTemplateKernels::activeSet = nullptr;
+
+const DeviceFrameworkTemplateKernels::KernelSet& DeviceFrameworkTemplateKernels::scalar() {
+    return kScalarSet;
+}
+
+size_t DeviceFrameworkTemplateKernels::available(const KernelSet** sets, size_t maxSets) {
+    const KernelSet* candidates[5];
+    size_t count = 0;
+    candidates[count++] = &kScalarSet;
+#if !defined(DFTE_KERNELS_SCALAR_ONLY)
+    candidates[count++] = &kSwarSet;
+#endif
+#if defined(DFTE_KERNELS_HAVE_SSE2)
+    candidates[count++] = &kSse2Set;
+#endif
+#if defined(DFTE_KERNELS_HAVE_AVX2)
+    if (cpuHasAvx2()) {
+        candidates[count++] = &kAvx2Set;
+    }
+#endif
+#if defined(DFTE_KERNELS_HAVE_NEON)
+    candidates[count++] = &kNeonSet;
+#endif
+
+    size_t written = 0;
+    for (size_t i = 0; i < count && written < maxSets; ++i) {
+        sets[written++] = candidates[i];
+    }
+    return written;
+}
+
+bool DeviceFrameworkTemplateKernels::select(const char* name) {
+    if (name == nullptr) {
+        return false;
+    }
+    const KernelSet* sets[5];
+    size_t count = available(sets, 5);
+    for (size_t i = 0; i < count; ++i) {
+        if (strcmp(sets[i]->name, name) == 0) {
+            activeSet = sets[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+const DeviceFrameworkTemplateKernels::KernelSet& DeviceFrameworkTemplateKernels::resolve() {
+    // The last available set is the widest one; a racing first use resolves to the same answer
+    const KernelSet* sets[5];
+    size_t count = available(sets, 5);
+    activeSet = sets[count - 1];
+    return *activeSet;
+}
@@ -1,10 +1,83 @@
 #include "DeviceFrameworkTemplateRenderer.h"
 #include "DeviceFrameworkTemplateEngineDebug.h"
+#include "DeviceFrameworkPlaceholderWriter.h"
+#include "DeviceFrameworkTypedValue.h"
+#include "DeviceFrameworkDataProvider.h"
 #include <pgmspace.h>
 #include <cstring>
 
 namespace {
 
+static bool pushTemplateFrame(DeviceFrameworkTemplateContext& ctx, const char* name, const char* templateData, size_t templateLen, bool isProgmem) {
+    if (!ctx.pushContext(RenderingContextType::TEMPLATE, name)) {
+        return false;
+    }
+    RenderingContext* templateCtx = ctx.getCurrentContext();
+    templateCtx->context.templateCtx.templateData = templateData;
+    templateCtx->context.templateCtx.templateLen = templateLen;
+    templateCtx->context.templateCtx.isProgmem = isProgmem;
+    templateCtx->context.templateCtx.position = 0;
+    return true;
+}
+
+// Follow conditional delegates to the placeholder that actually renders; nullptr renders nothing
+static const PlaceholderEntry* resolveConditional(DeviceFrameworkTemplateContext& ctx, const PlaceholderEntry* entry, const char*& name) {
+    for (int hops = 0; hops < DeviceFrameworkTemplateContext::MAX_RENDERING_DEPTH; ++hops) {
+        if (entry->type != PlaceholderType::CONDITIONAL) {
+            return entry;
+        }
+
+        const ConditionalDescriptor* descriptor = static_cast<const ConditionalDescriptor*>(entry->data);
+        if (descriptor == nullptr || descriptor->evaluate == nullptr) {
+            DFTE_LOG_ERROR("Conditional placeholder missing descriptor: " + String(name));
+            return nullptr;
+        }
+        if (!ctx.registry) {
+            return nullptr;
+        }
+
+        ConditionalBranchResult branch;
+        const DeviceFrameworkTemplateContext::MemoSlot* memo = entry->memoize ? ctx.findMemo(entry) : nullptr;
+        if (memo) {
+            branch = static_cast<ConditionalBranchResult>(memo->length);
+        } else {
+            branch = descriptor->evaluate(descriptor->userData);
+            if (entry->memoize) {
+                ctx.storeMemo(entry, nullptr, static_cast<uint32_t>(branch));
+            }
+        }
+
+        const char* delegateName = nullptr;
+        switch (branch) {
+            case ConditionalBranchResult::TRUE_BRANCH:
+                delegateName = descriptor->truePlaceholder;
+                break;
+            case ConditionalBranchResult::FALSE_BRANCH:
+                delegateName = descriptor->falsePlaceholder;
+                break;
+            case ConditionalBranchResult::SKIP:
+            default:
+                break;
+        }
+        if (delegateName == nullptr) {
+            return nullptr;
+        }
+
+        const PlaceholderEntry* delegateEntry = ctx.registry->getPlaceholder(delegateName);
+        if (!delegateEntry) {
+            DFTE_LOG_WARN("Conditional placeholder '" + String(name) + "' referenced unknown placeholder: " + String(delegateName));
+            return nullptr;
+        }
+        entry = delegateEntry;
+        name = delegateName;
+    }
+
+    DFTE_LOG_ERROR("Conditional placeholder delegates too deeply (cycle?): " + String(name));
+    return nullptr;
+}
+
+// Push the frame that renders `entry`. Every placeholder takes exactly one frame; conditionals take none
+// (the branch is chosen here and its delegate pushed in their place). Returns false on failure.
 static bool pushPlaceholderEntry(DeviceFrameworkTemplateContext& ctx, const PlaceholderEntry* entry, const char* nameOverride = nullptr) {
     if (entry == nullptr) {
         DFTE_LOG_ERROR("Attempted to push null placeholder entry");
@@ -15,60 +88,138 @@ static bool pushPlaceholderEntry(DeviceFrameworkTemplateContext& ctx, const Plac
 
     switch (entry->type) {
         case PlaceholderType::PROGMEM_DATA:
-        case PlaceholderType::RAM_DATA: {
+        case PlaceholderType::RAM_DATA:
+        case PlaceholderType::DYNAMIC_DATA:
+        case PlaceholderType::SIZED_DATA:
+        case PlaceholderType::TYPED_VALUE:
+        case PlaceholderType::PRODUCER_DATA:
+        case PlaceholderType::RING_DATA:
+        case PlaceholderType::PROVIDER_FIELD: {
             if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_DATA, name)) {
                 return false;
             }
-            RenderingContext* dataCtx = ctx.getCurrentContext();
-            dataCtx->context.data.entry = entry;
-            dataCtx->context.data.offset = 0;
+            auto& dataCtx = ctx.getCurrentContext()->context.data;
+            dataCtx.entry = entry;
+            dataCtx.offset = 0;
+            dataCtx.value = nullptr;
+            dataCtx.handleOpen = false;
+
+            // Getters run once per occurrence: the value and its length are streamed from the frame, so an
+            // expensive getter is not re-run for every chunk and a value cannot change mid-output.
+            // Memoized entries go further and reuse a copy of the first occurrence's value for the rest of the render.
+            // Only getter results are memoized: typed values and provider fields are formatted into this frame,
+            // which does not outlive the occurrence, producers hold no value and rings are live storage
+            bool memoize = entry->memoize && (entry->type == PlaceholderType::PROGMEM_DATA || entry->type == PlaceholderType::RAM_DATA ||
+                                              entry->type == PlaceholderType::DYNAMIC_DATA || entry->type == PlaceholderType::SIZED_DATA);
+            const DeviceFrameworkTemplateContext::MemoSlot* memo = memoize ? ctx.findMemo(entry) : nullptr;
+            if (memo) {
+                dataCtx.value = memo->value;
+                dataCtx.length = memo->length;
+            } else if (entry->type == PlaceholderType::RAM_DATA) {
+                PlaceholderDataGetter getter = (PlaceholderDataGetter)entry->data;
+                dataCtx.value = getter ? getter() : nullptr;
+                dataCtx.length = dataCtx.value ? strlen(dataCtx.value) : 0;
+            } else if (entry->type == PlaceholderType::DYNAMIC_DATA) {
+                const auto* descriptor = static_cast<const DynamicDataDescriptor*>(entry->data);
+                dataCtx.value = (descriptor && descriptor->getter) ? descriptor->getter(descriptor->userData) : nullptr;
+                dataCtx.length = DeviceFrameworkPlaceholderRegistry::getDynamicDataLength(descriptor, dataCtx.value);
+            } else if (entry->type == PlaceholderType::SIZED_DATA) {
+                const auto* descriptor = static_cast<const SizedDataDescriptor*>(entry->data);
+                PlaceholderValue value = (descriptor && descriptor->getter) ? descriptor->getter(descriptor->userData)
+                                                                            : PlaceholderValue{nullptr, 0};
+                dataCtx.value = value.data;
+                dataCtx.length = value.data ? value.length : 0;
+            } else if (entry->type == PlaceholderType::TYPED_VALUE) {
+                PlaceholderValue value = DeviceFrameworkTypedValue::format(*static_cast<const TypedValueDescriptor*>(entry->data), dataCtx.text);
+                dataCtx.value = value.data;
+                dataCtx.length = value.data ? value.length : 0;
+            } else if (entry->type == PlaceholderType::PROVIDER_FIELD) {
+                // Every field after the render's first is formatted from the copy of the sample it saw
+                const auto* descriptor = static_cast<const ProviderFieldDescriptor*>(entry->data);
+                PlaceholderValue value = descriptor->provider->format(descriptor->field, dataCtx.text, &ctx);
+                dataCtx.value = value.data;
+                dataCtx.length = value.data ? value.length : 0;
+            } else if (entry->type == PlaceholderType::RING_DATA) {
+                // Indices are read once here; later chunks resume by offset into the same two segments
+                RingBufferSnapshot ring = DeviceFrameworkPlaceholderRegistry::snapshotRing(static_cast<const RingBufferDescriptor*>(entry->data));
+                dataCtx.value = ring.first;
+                dataCtx.ring.wrapData = ring.second;
+                dataCtx.ring.split = ring.firstLength;
+                dataCtx.length = ring.firstLength + ring.secondLength;
+            } else if (entry->type == PlaceholderType::PRODUCER_DATA) {
+                // Opened once per occurrence; the length is unknown until read reports the end
+                const auto* descriptor = static_cast<const ProducerDescriptor*>(entry->data);
+                if (descriptor == nullptr || descriptor->read == nullptr) {
+                    DFTE_LOG_ERROR("Producer placeholder missing descriptor: " + String(name));
+                    ctx.popContext();
+                    return false;
+                }
+                dataCtx.handle = descriptor->open ? descriptor->open(descriptor->userData) : descriptor->userData;
+                dataCtx.handleOpen = descriptor->open != nullptr && descriptor->close != nullptr && dataCtx.handle != nullptr;
+                dataCtx.length = (descriptor->open && dataCtx.handle == nullptr) ? 0 : SIZE_MAX;
+            } else if (entry->hasCachedLength) {
+                dataCtx.length = entry->cachedLength;
+            } else if (entry->getLength != nullptr) {
+                dataCtx.length = entry->getLength(entry->data);
+            } else {
+                DFTE_LOG_ERROR("Placeholder '" + String(name) + "' missing length getter");
+                ctx.popContext();
+                return false;
+            }
+            if (memoize && !memo) {
+                ctx.storeMemo(entry, dataCtx.value, static_cast<uint32_t>(dataCtx.length));
+            }
             return true;
         }
-        case PlaceholderType::DYNAMIC_DATA: {
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_DATA, name)) {
+        case PlaceholderType::WRITER_DATA: {
+            const WriterDataDescriptor* descriptor = static_cast<const WriterDataDescriptor*>(entry->data);
+            if (descriptor == nullptr || descriptor->write == nullptr) {
+                DFTE_LOG_ERROR("Writer placeholder missing descriptor: " + String(name));
                 return false;
             }
-            RenderingContext* dataCtx = ctx.getCurrentContext();
-            dataCtx->context.data.entry = entry;
-            dataCtx->context.data.offset = 0;
+            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_WRITER, name)) {
+                return false;
+            }
+            auto& writerCtx = ctx.getCurrentContext()->context.writer;
+            writerCtx.descriptor = descriptor;
+            writerCtx.cookie = 0;
+            writerCtx.spillPos = 0;
+            writerCtx.spillLen = 0;
+            writerCtx.finished = false;
             return true;
         }
-        case PlaceholderType::PROGMEM_TEMPLATE: {
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_TEMPLATE, name)) {
+        case PlaceholderType::PROGMEM_TEMPLATE:
+            return pushTemplateFrame(ctx, name, static_cast<const char*>(entry->data), entry->getLength(entry->data), true);
+        case PlaceholderType::STATIC_TEMPLATE: {
+            const StaticTemplate* staticTemplate = static_cast<const StaticTemplate*>(entry->data);
+            if (!pushTemplateFrame(ctx, name, staticTemplate->text, staticTemplate->length, true)) {
                 return false;
             }
-            RenderingContext* placeholderCtx = ctx.getCurrentContext();
-            placeholderCtx->context.templatePlaceholder.entry = entry;
-
-            if (!ctx.pushContext(RenderingContextType::TEMPLATE, name)) {
-                ctx.popContext();
+            ctx.getCurrentContext()->context.templateCtx.compiled = staticTemplate;
+            return true;
+        }
+        case PlaceholderType::TOKENIZED_TEMPLATE: {
+            const TokenizedTemplate* tokenizedTemplate = static_cast<const TokenizedTemplate*>(entry->data);
+            if (!pushTemplateFrame(ctx, name, tokenizedTemplate->data, tokenizedTemplate->length, true)) {
                 return false;
             }
-
-            RenderingContext* templateCtx = ctx.getCurrentContext();
-            templateCtx->context.templateCtx.templateData = static_cast<const char*>(entry->data);
-            templateCtx->context.templateCtx.templateLen = entry->getLength(entry->data);
-            templateCtx->context.templateCtx.isProgmem = true;
-            templateCtx->context.templateCtx.position = 0;
-            templateCtx->context.templateCtx.iteratorPlaceholders = nullptr;
-            templateCtx->context.templateCtx.iteratorPlaceholderCount = 0;
+            ctx.getCurrentContext()->context.templateCtx.tokens = tokenizedTemplate->tokens;
             return true;
         }
-        case PlaceholderType::DYNAMIC_TEMPLATE: {
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE, name)) {
+        case PlaceholderType::COMPILED_TEMPLATE: {
+            if (!ctx.pushContext(RenderingContextType::COMPILED_TEMPLATE, name)) {
                 return false;
             }
-
-            RenderingContext* dynamicCtx = ctx.getCurrentContext();
-            dynamicCtx->context.dynamicTemplate.entry = entry;
-            dynamicCtx->context.dynamicTemplate.offset = 0;
-            dynamicCtx->context.dynamicTemplate.templateData = nullptr;
-            dynamicCtx->context.dynamicTemplate.templateLength = 0;
-
+            RenderingContext* compiledCtx = ctx.getCurrentContext();
+            compiledCtx->context.compiledTemplate.compiled = static_cast<const CompiledTemplate*>(entry->data);
+            compiledCtx->context.compiledTemplate.cursor.resumePoint = 0;
+            compiledCtx->context.compiledTemplate.cursor.offset = 0;
+            return true;
+        }
+        case PlaceholderType::DYNAMIC_TEMPLATE: {
             const DynamicTemplateDescriptor* descriptor = static_cast<const DynamicTemplateDescriptor*>(entry->data);
             if (descriptor == nullptr || descriptor->getter == nullptr) {
                 DFTE_LOG_ERROR("Dynamic template placeholder missing descriptor: " + String(name));
-                ctx.popContext();
                 return false;
             }
 
@@ -79,119 +230,235 @@ static bool pushPlaceholderEntry(DeviceFrameworkTemplateContext& ctx, const Plac
             }
 
             size_t templateLen = DeviceFrameworkPlaceholderRegistry::getDynamicTemplateLength(descriptor, templateData);
-            dynamicCtx->context.dynamicTemplate.templateData = templateData;
-            dynamicCtx->context.dynamicTemplate.templateLength = templateLen;
-
-            if (!ctx.pushContext(RenderingContextType::TEMPLATE, name)) {
-                ctx.popContext();
-                return false;
-            }
-
-            RenderingContext* templateCtx = ctx.getCurrentContext();
-            templateCtx->context.templateCtx.templateData = templateData;
-            templateCtx->context.templateCtx.templateLen = templateLen;
-            templateCtx->context.templateCtx.isProgmem = false;
-            templateCtx->context.templateCtx.position = 0;
-            templateCtx->context.templateCtx.iteratorPlaceholders = nullptr;
-            templateCtx->context.templateCtx.iteratorPlaceholderCount = 0;
-            return true;
+            return pushTemplateFrame(ctx, name, templateData, templateLen, false);
         }
         case PlaceholderType::CONDITIONAL: {
-            const ConditionalDescriptor* descriptor = static_cast<const ConditionalDescriptor*>(entry->data);
-            if (descriptor == nullptr || descriptor->evaluate == nullptr) {
-                DFTE_LOG_ERROR("Conditional placeholder missing descriptor: " + String(name));
+            const PlaceholderEntry* delegateEntry = resolveConditional(ctx, entry, name);
+            if (!delegateEntry) {
+                // Nothing to render; a broken descriptor is still an error
+                const ConditionalDescriptor* descriptor = static_cast<const ConditionalDescriptor*>(entry->data);
+                return descriptor != nullptr && descriptor->evaluate != nullptr;
+            }
+            return pushPlaceholderEntry(ctx, delegateEntry, name);
+        }
+        case PlaceholderType::ITERATOR: {
+            const IteratorDescriptor* descriptor = static_cast<const IteratorDescriptor*>(entry->data);
+            if (!descriptor || !descriptor->next) {
+                DFTE_LOG_ERROR("Iterator placeholder missing descriptor: " + String(name));
                 return false;
             }
 
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_CONDITIONAL, name)) {
+            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_ITERATOR, name)) {
                 return false;
             }
 
-            RenderingContext* conditionalCtx = ctx.getCurrentContext();
-            conditionalCtx->context.conditional.entry = entry;
-            conditionalCtx->context.conditional.descriptor = descriptor;
-            conditionalCtx->context.conditional.branchResolved = false;
-            conditionalCtx->context.conditional.delegateName = nullptr;
-            conditionalCtx->context.conditional.delegateEntry = nullptr;
-
-            if (!ctx.registry) {
-                conditionalCtx->context.conditional.branchResolved = true;
-                return true;
-            }
+            RenderingContext* iteratorCtx = ctx.getCurrentContext();
+            iteratorCtx->context.iterator.entry = entry;
+            iteratorCtx->context.iterator.descriptor = descriptor;
+            iteratorCtx->context.iterator.handle = nullptr;
+            iteratorCtx->context.iterator.initialized = false;
+            iteratorCtx->context.iterator.handleOpen = false;
+            iteratorCtx->context.iterator.indexedNames = 0;
+            iteratorCtx->context.iterator.indexedCount = 0;
+            return true;
+        }
+        default:
+            DFTE_LOG_WARN("pushPlaceholderEntry does not support placeholder type for: " + String(name));
+            return false;
+    }
+}
 
-            ConditionalBranchResult branch = descriptor->evaluate(descriptor->userData);
-            const char* delegateName = nullptr;
-            switch (branch) {
-                case ConditionalBranchResult::TRUE_BRANCH:
-                    delegateName = descriptor->truePlaceholder;
-                    break;
-                case ConditionalBranchResult::FALSE_BRANCH:
-                    delegateName = descriptor->falsePlaceholder;
-                    break;
-                case ConditionalBranchResult::SKIP:
-                default:
-                    delegateName = nullptr;
-                    break;
-            }
+// Signature of an item's name pointers in order; names are compared by pointer, not by content
+static uint32_t scopeNamesSignature(const PlaceholderEntry* placeholders, size_t count) {
+    uint32_t signature = 2166136261u;
+    for (size_t i = 0; i < count; ++i) {
+        uintptr_t name = reinterpret_cast<uintptr_t>(placeholders[i].name);
+        signature = (signature ^ static_cast<uint32_t>(name ^ (name >> 16))) * 16777619u;
+    }
+    return signature;
+}
 
-            conditionalCtx->context.conditional.branchResolved = true;
-            conditionalCtx->context.conditional.delegateName = delegateName;
+// Index an item's placeholders in the iterator frame. The index maps names to positions, so rows whose
+// arrays hold the same name pointers in the same order keep it even when each row passes its own array
+static void indexIteratorScope(RenderingContext* iteratorCtx, const PlaceholderEntry* placeholders, size_t count) {
+    auto& iteratorState = iteratorCtx->context.iterator;
+    constexpr uint32_t mask = DFTE_ITERATOR_SCOPE_SLOTS - 1;
+    static_assert((DFTE_ITERATOR_SCOPE_SLOTS & mask) == 0 && DFTE_ITERATOR_SCOPE_SLOTS <= 256,
+                  "DFTE_ITERATOR_SCOPE_SLOTS must be a power of two no larger than 256");
+    if (placeholders == nullptr || count == 0 || count > DFTE_ITERATOR_SCOPE_SLOTS / 2) {
+        // Scanned instead; the slots are left as they are
+        iteratorState.indexedCount = 0;
+        return;
+    }
 
-            if (delegateName == nullptr) {
-                return true;
-            }
+    uint32_t names = scopeNamesSignature(placeholders, count);
+    if (count == iteratorState.indexedCount && names == iteratorState.indexedNames) {
+        return;
+    }
 
-            const PlaceholderEntry* delegateEntry = ctx.registry->getPlaceholder(delegateName);
-            if (!delegateEntry) {
-                DFTE_LOG_WARN("Conditional placeholder '" + String(name) + "' referenced unknown placeholder: " + String(delegateName));
-                return true;
+    iteratorState.indexedNames = names;
+    iteratorState.indexedCount = 0;
+    memset(iteratorState.indexSlots, 0, sizeof(iteratorState.indexSlots));
+    for (size_t i = 0; i < count; ++i) {
+        const char* name = placeholders[i].name;
+        if (name == nullptr) {
+            continue;
+        }
+        uint32_t hash = DeviceFrameworkPlaceholderRegistry::hashName(name);
+        uint32_t slot = hash & mask;
+        bool duplicate = false;
+        while (iteratorState.indexSlots[slot] != 0) {
+            // The scan returns the first entry with a name, so later duplicates stay out of the index
+            if (strcmp(placeholders[iteratorState.indexSlots[slot] - 1].name, name) == 0) {
+                duplicate = true;
+                break;
             }
+            slot = (slot + 1) & mask;
+        }
+        if (!duplicate) {
+            iteratorState.indexSlots[slot] = static_cast<uint8_t>(i + 1);
+            iteratorState.indexTags[slot] = static_cast<uint8_t>(hash >> 24);
+        }
+    }
+    iteratorState.indexedCount = static_cast<uint8_t>(count);
+}
 
-            conditionalCtx->context.conditional.delegateEntry = delegateEntry;
+// Item placeholders of the iterator row rendered by templateFrame (checked before the registry)
+static const PlaceholderEntry* findIteratorOverride(DeviceFrameworkTemplateContext& ctx, RenderingContext* templateFrame, const char* name) {
+    if (!templateFrame || templateFrame->type != RenderingContextType::TEMPLATE) {
+        return nullptr;
+    }
+    const PlaceholderEntry* overrides = templateFrame->context.templateCtx.iteratorPlaceholders;
+    size_t overrideCount = templateFrame->context.templateCtx.iteratorPlaceholderCount;
+    if (overrideCount == 0) {
+        return nullptr;
+    }
 
-            if (!pushPlaceholderEntry(ctx, delegateEntry, delegateName)) {
-                ctx.popContext();
-                return false;
+    // Item frames sit directly above their iterator frame, which indexed this row's names when it was pushed
+    const RenderingContext* iteratorCtx = templateFrame > ctx.renderingStack ? templateFrame - 1 : nullptr;
+    if (iteratorCtx && iteratorCtx->type == RenderingContextType::PLACEHOLDER_ITERATOR &&
+        iteratorCtx->context.iterator.indexedCount == overrideCount) {
+        const auto& iteratorState = iteratorCtx->context.iterator;
+        constexpr uint32_t mask = DFTE_ITERATOR_SCOPE_SLOTS - 1;
+        uint32_t hash = DeviceFrameworkPlaceholderRegistry::hashName(name);
+        uint8_t tag = static_cast<uint8_t>(hash >> 24);
+        for (uint32_t slot = hash & mask; iteratorState.indexSlots[slot] != 0; slot = (slot + 1) & mask) {
+            const PlaceholderEntry* entry = &overrides[iteratorState.indexSlots[slot] - 1];
+            if (iteratorState.indexTags[slot] == tag && strcmp(entry->name, name) == 0) {
+                return entry;
             }
+        }
+        return nullptr;
+    }
 
-            return true;
+    for (size_t i = 0; i < overrideCount; ++i) {
+        if (overrides[i].name != nullptr && strcmp(overrides[i].name, name) == 0) {
+            return &overrides[i];
         }
-        case PlaceholderType::ITERATOR: {
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_ITERATOR, name)) {
-                return false;
-            }
+    }
+    return nullptr;
+}
 
-            RenderingContext* iteratorCtx = ctx.getCurrentContext();
-            iteratorCtx->context.iterator.entry = entry;
-            iteratorCtx->context.iterator.descriptor = static_cast<const IteratorDescriptor*>(entry->data);
-            iteratorCtx->context.iterator.handle = nullptr;
-            iteratorCtx->context.iterator.initialized = false;
-            iteratorCtx->context.iterator.handleOpen = false;
+// Stage a token's "%NAME%" in ctx.placeholderName (for iterator overrides and diagnostics)
+static bool copyTokenName(DeviceFrameworkTemplateContext& ctx, const TokenTable* tokens, uint32_t id) {
+    if (!tokens || id >= tokens->count) {
+        return false;
+    }
+    const char* name = static_cast<const char*>(pgm_read_ptr(&tokens->names[id]));
+    strncpy_P(ctx.placeholderName, name, sizeof(ctx.placeholderName) - 1);
+    ctx.placeholderName[sizeof(ctx.placeholderName) - 1] = '\0';
+    return true;
+}
 
-            const IteratorDescriptor* descriptor = iteratorCtx->context.iterator.descriptor;
-            if (!descriptor || !descriptor->next) {
-                DFTE_LOG_ERROR("Iterator placeholder missing descriptor: " + String(name));
-                ctx.popContext();
-                return false;
-            }
+} // namespace
 
-            return true;
+// Helper function to log state transitions with stack state
+static void logStateTransition(DeviceFrameworkTemplateContext& ctx, const char* fromState, const char* toState, const char* reason = nullptr) {
+#if !defined(DFTE_ENABLE_TRACE)
+    (void)ctx;
+    (void)fromState;
+    (void)toState;
+    (void)reason;
+#else
+    auto getContextTypeString = [](RenderingContextType type) -> const char* {
+        switch (type) {
+            case RenderingContextType::TEMPLATE: return "TEMPLATE";
+            case RenderingContextType::PLACEHOLDER_DATA: return "PLACEHOLDER_DATA";
+            case RenderingContextType::PLACEHOLDER_TEMPLATE: return "PLACEHOLDER_TEMPLATE";
+            case RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE: return "PLACEHOLDER_DYNAMIC_TEMPLATE";
+            case RenderingContextType::PLACEHOLDER_CONDITIONAL: return "PLACEHOLDER_CONDITIONAL";
+            case RenderingContextType::PLACEHOLDER_ITERATOR: return "PLACEHOLDER_ITERATOR";
+            case RenderingContextType::COMPILED_TEMPLATE: return "COMPILED_TEMPLATE";
+            case RenderingContextType::PLACEHOLDER_WRITER: return "PLACEHOLDER_WRITER";
+            default: return "UNKNOWN";
         }
-        default:
-            DFTE_LOG_WARN("pushPlaceholderEntry does not support placeholder type for: " + String(name));
-            return false;
+    };
+
+    if (!deviceFrameworkTemplateEngineLogger) {
+        return;
+    }
+
+    String msg = String("State: ") + fromState + " -> " + toState;
+    if (reason) {
+        msg += String(" (") + reason + ")";
     }
+    msg += " | Stack depth: " + String(ctx.renderingDepth);
+    if (ctx.renderingDepth > 0) {
+        RenderingContext* currentCtx = ctx.getCurrentContext();
+        msg += " | Current: " + String(currentCtx->name) + " (type=" + getContextTypeString(currentCtx->type) + ")";
+    }
+    deviceFrameworkTemplateEngineLogger->debug(msg);
+#endif
 }
 
-static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(DeviceFrameworkTemplateContext& ctx, RenderingContext* iteratorCtx) {
-    if (!iteratorCtx) {
-        return DeviceFrameworkTemplateRenderer::makeError();
+#if defined(DFTE_ENABLE_TRACE)
+static const char* getStateName(TemplateRenderState state) {
+    switch (state) {
+        case TemplateRenderState::TEXT: return "TEXT";
+        case TemplateRenderState::BUILDING_PLACEHOLDER: return "BUILDING_PLACEHOLDER";
+        case TemplateRenderState::RENDERING_CONTEXT: return "RENDERING_CONTEXT";
+        case TemplateRenderState::COMPLETE: return "COMPLETE";
+        case TemplateRenderState::ERROR: return "ERROR";
+        default: return "UNKNOWN";
     }
+}
+#endif
 
+namespace {
+
+// Step handlers change ctx.state in place; transitions are only logged in trace builds
+inline void setState(DeviceFrameworkTemplateContext& ctx, TemplateRenderState next) {
+#if defined(DFTE_ENABLE_TRACE)
+    if (next != ctx.state) {
+        logStateTransition(ctx, getStateName(ctx.state), getStateName(next));
+    }
+#endif
+    ctx.state = next;
+}
+
+inline bool failRender(DeviceFrameworkTemplateContext& ctx) {
+    setState(ctx, TemplateRenderState::ERROR);
+    return false;
+}
+
+// Continue with whatever frame is now on top of the stack
+inline bool resumeTopFrame(DeviceFrameworkTemplateContext& ctx) {
+    RenderingContext* top = ctx.getCurrentContext();
+    if (!top) {
+        setState(ctx, TemplateRenderState::COMPLETE);
+    } else if (top->type == RenderingContextType::TEMPLATE) {
+        setState(ctx, TemplateRenderState::TEXT);
+    } else {
+        setState(ctx, TemplateRenderState::RENDERING_CONTEXT);
+    }
+    return true;
+}
+
+bool processIteratorContext(DeviceFrameworkTemplateContext& ctx, RenderingContext* iteratorCtx) {
     const IteratorDescriptor* descriptor = iteratorCtx->context.iterator.descriptor;
     if (!descriptor || !descriptor->next) {
         DFTE_LOG_ERROR("Iterator placeholder missing descriptor or next handler");
-        return DeviceFrameworkTemplateRenderer::makeError();
+        return failRender(ctx);
     }
 
     auto& iteratorState = iteratorCtx->context.iterator;
@@ -207,13 +474,9 @@ static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(Dev
 
     switch (step) {
         case IteratorStepResult::ITEM_READY: {
-            if (!view.templateData && view.templateLength == 0) {
-                return DeviceFrameworkTemplateRenderer::makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-            }
-
             const char* templatePtr = view.templateData;
             if (!templatePtr) {
-                return DeviceFrameworkTemplateRenderer::makeState(TemplateRenderState::RENDERING_CONTEXT, true);
+                return true;
             }
 
             size_t templateLen = view.templateLength;
@@ -222,9 +485,11 @@ static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(Dev
             }
 
             if (!ctx.pushContext(RenderingContextType::TEMPLATE, iteratorCtx->name)) {
-                return DeviceFrameworkTemplateRenderer::makeError();
+                return failRender(ctx);
             }
 
+            indexIteratorScope(iteratorCtx, view.placeholders, view.placeholderCount);
+
             RenderingContext* templateCtx = ctx.getCurrentContext();
             templateCtx->context.templateCtx.templateData = templatePtr;
             templateCtx->context.templateCtx.templateLen = templateLen;
@@ -233,7 +498,8 @@ static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(Dev
             templateCtx->context.templateCtx.iteratorPlaceholders = view.placeholders;
             templateCtx->context.templateCtx.iteratorPlaceholderCount = view.placeholderCount;
 
-            return DeviceFrameworkTemplateRenderer::makeState(TemplateRenderState::TEXT, true);
+            setState(ctx, TemplateRenderState::TEXT);
+            return true;
         }
         case IteratorStepResult::COMPLETE: {
             if (iteratorState.handleOpen && descriptor->close) {
@@ -242,19 +508,8 @@ static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(Dev
             }
             iteratorState.handle = nullptr;
 
-            auto outcome = DeviceFrameworkTemplateRenderer::makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-            outcome.popCount = 1;
-
-            RenderingContext* parent = (ctx.renderingDepth > 1) ? ctx.getContext(ctx.renderingDepth - 2) : nullptr;
-            if (!parent) {
-                outcome.nextState = TemplateRenderState::COMPLETE;
-                outcome.repeat = false;
-                outcome.finished = true;
-            } else if (parent->type == RenderingContextType::TEMPLATE) {
-                outcome.nextState = TemplateRenderState::TEXT;
-            }
-
-            return outcome;
+            ctx.popContext();
+            return resumeTopFrame(ctx);
         }
         case IteratorStepResult::ERROR:
         default:
@@ -264,58 +519,12 @@ static DeviceFrameworkTemplateRenderer::RenderOutcome processIteratorContext(Dev
             }
             iteratorState.handleOpen = false;
             iteratorState.handle = nullptr;
-            return DeviceFrameworkTemplateRenderer::makeError();
+            return failRender(ctx);
     }
 }
 
 } // namespace
 
-// Helper function to log state transitions with stack state
-static void logStateTransition(DeviceFrameworkTemplateContext& ctx, const String& fromState, const String& toState, const String& reason = "") {
-#if !defined(DFTE_ENABLE_TRACE)
-    (void)ctx;
-    (void)fromState;
-    (void)toState;
-    (void)reason;
-    return;
-#else
-    auto getContextTypeString = [](RenderingContextType type) -> String {
-        switch (type) {
-            case RenderingContextType::TEMPLATE: return "TEMPLATE";
-            case RenderingContextType::PLACEHOLDER_DATA: return "PLACEHOLDER_DATA";
-            case RenderingContextType::PLACEHOLDER_TEMPLATE: return "PLACEHOLDER_TEMPLATE";
-            default: return "UNKNOWN";
-        }
-    };
-
-    if (!deviceFrameworkTemplateEngineLogger) {
-        return;
-    }
-
-    String msg = "State: " + fromState + " -> " + toState;
-    if (reason.length() > 0) {
-        msg += " (" + reason + ")";
-    }
-    msg += " | Stack depth: " + String(ctx.renderingDepth);
-    if (ctx.renderingDepth > 0) {
-        RenderingContext* currentCtx = ctx.getCurrentContext();
-        msg += " | Current: " + String(currentCtx->name) + " (type=" + getContextTypeString(currentCtx->type) + ")";
-    }
-    deviceFrameworkTemplateEngineLogger->debug(msg);
-#endif
-}
-
-static String getStateName(TemplateRenderState state) {
-    switch (state) {
-        case TemplateRenderState::TEXT: return "TEXT";
-        case TemplateRenderState::BUILDING_PLACEHOLDER: return "BUILDING_PLACEHOLDER";
-        case TemplateRenderState::RENDERING_CONTEXT: return "RENDERING_CONTEXT";
-        case TemplateRenderState::COMPLETE: return "COMPLETE";
-        case TemplateRenderState::ERROR: return "ERROR";
-        default: return "UNKNOWN";
-    }
-}
-
 DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::makeWritten(size_t bytes, TemplateRenderState state, bool repeat) {
     return {bytes, state, repeat, false, false, 0, {false, RenderingContextType::TEMPLATE, nullptr}};
 }
@@ -332,273 +541,194 @@ DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::
     return {0, TemplateRenderState::ERROR, false, false, true, 0, {false, RenderingContextType::TEMPLATE, nullptr}};
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::renderChunk(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen) {
-    RenderOutcome outcome = makeState(ctx.state, false);
+bool DeviceFrameworkTemplateRenderer::handleTemplateCompletion(DeviceFrameworkTemplateContext& ctx) {
+    ctx.popContext();
+    return resumeTopFrame(ctx);
+}
 
-    switch (ctx.state) {
-        case TemplateRenderState::TEXT:
-            outcome = consumeTemplateText(ctx, buffer, maxLen);
-            break;
-        case TemplateRenderState::BUILDING_PLACEHOLDER:
-            outcome = buildPlaceholderToken(ctx);
-            break;
-        case TemplateRenderState::RENDERING_CONTEXT:
-            outcome = emitActiveContext(ctx, buffer, maxLen);
-            break;
-        case TemplateRenderState::COMPLETE:
-            return makeComplete();
-        case TemplateRenderState::ERROR:
-        default:
-            return makeError();
+bool DeviceFrameworkTemplateRenderer::consumeTemplateText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written) {
+    RenderingContext* currentCtx = ctx.getCurrentContext();
+    if (!currentCtx || currentCtx->type != RenderingContextType::TEMPLATE) {
+        DFTE_LOG_ERROR("consumeTemplateText called without TEMPLATE context");
+        return failRender(ctx);
     }
 
-    if (!applyStackCommands(ctx, outcome)) {
-        ctx.state = TemplateRenderState::ERROR;
-        return makeError();
+    auto& templateCtx = currentCtx->context.templateCtx;
+
+    // Empty template completes immediately
+    if (templateCtx.templateLen == 0) {
+        return handleTemplateCompletion(ctx);
     }
 
-    TemplateRenderState previousState = ctx.state;
-    if (outcome.nextState != previousState) {
-        String fromState = getStateName(previousState);
-        ctx.state = outcome.nextState;
-        String toState = getStateName(ctx.state);
-        logStateTransition(ctx, fromState, toState);
-    } else {
-        ctx.state = outcome.nextState;
+    if (templateCtx.tokens) {
+        return consumeTokenizedText(ctx, buffer, maxLen, written);
     }
 
-    outcome.finished = (ctx.state == TemplateRenderState::COMPLETE);
-    outcome.errored = (ctx.state == TemplateRenderState::ERROR);
+    // PROGMEM templates are immutable, so their parse can be shared through the registry plan cache
+    if (!templateCtx.planResolved) {
+        templateCtx.planResolved = true;
+        if (templateCtx.isProgmem && templateCtx.position == 0 && ctx.registry) {
+            templateCtx.plan = ctx.registry->acquirePlan(templateCtx.templateData, templateCtx.templateLen, templateCtx.compiled);
+            templateCtx.segmentIndex = 0;
+        }
+    }
+    if (templateCtx.plan) {
+        return consumePlannedText(ctx, buffer, maxLen, written);
+    }
 
-    return outcome;
-}
+    while (written < maxLen && templateCtx.position < templateCtx.templateLen) {
+        bool delimiterFound = false;
+        size_t run = ctx.readLiteralRun(buffer + written, maxLen - written, delimiterFound);
+        written += run;
 
-bool DeviceFrameworkTemplateRenderer::applyStackCommands(DeviceFrameworkTemplateContext& ctx, const RenderOutcome& outcome) {
-    for (uint8_t i = 0; i < outcome.popCount; ++i) {
-        if (ctx.renderingDepth == 0) {
-            DFTE_LOG_ERROR("Rendering stack underflow during pop");
-            return false;
+        if (delimiterFound) {
+            ctx.placeholderPos = 0;
+            ctx.placeholderName[ctx.placeholderPos++] = '%';
+            setState(ctx, TemplateRenderState::BUILDING_PLACEHOLDER);
+            return true;
+        }
+
+        if (run == 0) {
+            break;
         }
-        ctx.popContext();
     }
 
-    if (!outcome.pushContext.active) {
+    // Finish in the same step as the last literal run instead of coming back for an empty read
+    if (templateCtx.position >= templateCtx.templateLen) {
+        return handleTemplateCompletion(ctx);
+    }
+    if (written > 0) {
         return true;
     }
-
-    const PlaceholderEntry* entry = outcome.pushContext.entry;
-    if (entry == nullptr) {
-        DFTE_LOG_ERROR("Missing placeholder entry for pushContext");
-        return false;
+    if (!ctx.hasMoreData()) {
+        return handleTemplateCompletion(ctx);
     }
 
-    const char* name = entry->name;
-
-    switch (outcome.pushContext.type) {
-        case RenderingContextType::PLACEHOLDER_DATA: {
-            if (!pushPlaceholderEntry(ctx, entry, name)) {
-                return false;
-            }
-            return true;
-        }
-        case RenderingContextType::PLACEHOLDER_TEMPLATE: {
-            if (!pushPlaceholderEntry(ctx, entry, name)) {
-                return false;
-            }
-            return true;
-        }
-        case RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE: {
-            if (!pushPlaceholderEntry(ctx, entry, name)) {
-                return false;
-            }
-            return true;
-        }
-        case RenderingContextType::PLACEHOLDER_CONDITIONAL: {
-            const ConditionalDescriptor* descriptor = static_cast<const ConditionalDescriptor*>(entry->data);
-            if (descriptor == nullptr || descriptor->evaluate == nullptr) {
-                DFTE_LOG_ERROR("Conditional placeholder missing descriptor: " + String(name));
-                return false;
-            }
+    // Need more data
+    return false;
+}
 
-            ConditionalBranchResult branch = descriptor->evaluate(descriptor->userData);
-            const char* delegateName = nullptr;
-            switch (branch) {
-                case ConditionalBranchResult::TRUE_BRANCH:
-                    delegateName = descriptor->truePlaceholder;
-                    break;
-                case ConditionalBranchResult::FALSE_BRANCH:
-                    delegateName = descriptor->falsePlaceholder;
-                    break;
-                case ConditionalBranchResult::SKIP:
-                default:
-                    delegateName = nullptr;
-                    break;
-            }
+bool DeviceFrameworkTemplateRenderer::consumePlannedText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written) {
+    RenderingContext* currentCtx = ctx.getCurrentContext();
+    auto& templateCtx = currentCtx->context.templateCtx;
+    const TemplatePlan* plan = templateCtx.plan;
 
-            if (delegateName == nullptr) {
-                return true; // Nothing to render
-            }
+    while (templateCtx.segmentIndex < plan->segmentCount) {
+        const TemplateSegment& segment = plan->segments[templateCtx.segmentIndex];
 
-            const PlaceholderEntry* delegateEntry = ctx.registry ? ctx.registry->getPlaceholder(delegateName) : nullptr;
-            if (!delegateEntry) {
-                DFTE_LOG_WARN("Conditional placeholder '" + String(name) + "' referenced unknown placeholder: " + String(delegateName));
+        if (segment.kind == TemplateSegmentKind::LITERAL) {
+            if (written >= maxLen) {
                 return true;
             }
-
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_CONDITIONAL, name)) {
-                return false;
-            }
-
-            RenderingContext* conditionalCtx = ctx.getCurrentContext();
-            conditionalCtx->context.conditional.entry = entry;
-            conditionalCtx->context.conditional.descriptor = descriptor;
-            conditionalCtx->context.conditional.branchResolved = true;
-            conditionalCtx->context.conditional.delegateName = delegateName;
-            conditionalCtx->context.conditional.delegateEntry = delegateEntry;
-
-            if (!pushPlaceholderEntry(ctx, delegateEntry, delegateName)) {
-                ctx.popContext();
-                return false;
+            size_t segmentEnd = segment.offset + segment.length;
+            size_t run = min(segmentEnd - templateCtx.position, maxLen - written);
+            memcpy_P(buffer + written, templateCtx.templateData + templateCtx.position, run);
+            written += run;
+            templateCtx.position += run;
+            if (templateCtx.position >= segmentEnd) {
+                templateCtx.segmentIndex++;
             }
+            continue;
+        }
 
+        if (!ctx.registry || !ctx.registry->isPlanCurrent(plan)) {
+            // Placeholders changed since the plan was built: interpret the rest from this token
+            DFTE_LOG_DEBUG("Template plan is stale, switching to interpreter");
+            DeviceFrameworkPlaceholderRegistry::releasePlan(plan);
+            templateCtx.plan = nullptr;
+            templateCtx.position = segment.offset;
+            templateCtx.bufferPos = 0;
+            templateCtx.bufferLen = 0;
+            templateCtx.bufferOffset = segment.offset;
+            ctx.bufferPos = 0;
+            ctx.bufferLen = 0;
+            ctx.bufferOffset = segment.offset;
             return true;
         }
-        case RenderingContextType::PLACEHOLDER_ITERATOR: {
-            if (!ctx.pushContext(RenderingContextType::PLACEHOLDER_ITERATOR, name)) {
-                return false;
-            }
 
-            RenderingContext* iteratorCtx = ctx.getCurrentContext();
-            iteratorCtx->context.iterator.entry = entry;
-            iteratorCtx->context.iterator.descriptor = static_cast<const IteratorDescriptor*>(entry->data);
-            iteratorCtx->context.iterator.handle = nullptr;
-            iteratorCtx->context.iterator.initialized = false;
-            iteratorCtx->context.iterator.handleOpen = false;
+        templateCtx.segmentIndex++;
+        templateCtx.position = segment.offset + segment.length;
 
-            if (!iteratorCtx->context.iterator.descriptor || !iteratorCtx->context.iterator.descriptor->next) {
-                DFTE_LOG_ERROR("Iterator placeholder missing next handler: " + String(name));
-                ctx.popContext();
-                return false;
+        const PlaceholderEntry* entry = segment.entry;
+        if (segment.kind == TemplateSegmentKind::PLACEHOLDER && templateCtx.iteratorPlaceholderCount > 0) {
+            // Item placeholders shadow registry names inside an iterator row
+            const PlaceholderEntry* itemEntry = findIteratorOverride(ctx, currentCtx, entry->name);
+            if (itemEntry) {
+                entry = itemEntry;
             }
-
-            return true;
-        }
-        case RenderingContextType::TEMPLATE: {
-            if (!ctx.pushContext(RenderingContextType::TEMPLATE, name)) {
-                return false;
+        } else if (segment.kind == TemplateSegmentKind::TOKEN) {
+            // Unknown to the base registry at build time; iterator items or an overlay may still provide it
+            memcpy_P(ctx.placeholderName, templateCtx.templateData + segment.offset, segment.length);
+            ctx.placeholderName[segment.length] = '\0';
+            entry = findIteratorOverride(ctx, currentCtx, ctx.placeholderName);
+            if (!entry) {
+                entry = ctx.registry->getPlaceholder(ctx.placeholderName);
+            }
+            if (!entry) {
+                DFTE_LOG_WARN("Unknown placeholder: " + String(ctx.placeholderName));
+            }
+            ctx.resetPlaceholder();
+            if (!entry) {
+                continue;
             }
-            RenderingContext* templateCtx = ctx.getCurrentContext();
-            templateCtx->context.templateCtx.templateData = static_cast<const char*>(entry->data);
-            templateCtx->context.templateCtx.templateLen = entry->getLength(entry->data);
-            templateCtx->context.templateCtx.isProgmem = true;
-            templateCtx->context.templateCtx.position = 0;
-            templateCtx->context.templateCtx.iteratorPlaceholders = nullptr;
-            templateCtx->context.templateCtx.iteratorPlaceholderCount = 0;
-            return true;
-        }
-        default:
-            return true;
-    }
-}
-
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::handleTemplateCompletion(DeviceFrameworkTemplateContext& ctx) {
-    RenderOutcome outcome = makeState(TemplateRenderState::TEXT, true);
-    outcome.popCount = 1;
-
-    if (ctx.renderingDepth <= 1) {
-        outcome.nextState = TemplateRenderState::COMPLETE;
-        outcome.repeat = false;
-        outcome.finished = true;
-        return outcome;
-    }
-
-    RenderingContext* parentCtx = ctx.getContext(ctx.renderingDepth - 2);
-    if (parentCtx && (parentCtx->type == RenderingContextType::PLACEHOLDER_TEMPLATE ||
-                      parentCtx->type == RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE ||
-                      parentCtx->type == RenderingContextType::PLACEHOLDER_CONDITIONAL)) {
-        outcome.popCount += 1;
-        if (ctx.renderingDepth > 2) {
-            parentCtx = ctx.getContext(ctx.renderingDepth - 3);
-        } else {
-            parentCtx = nullptr;
         }
-    }
-
-    if (!parentCtx) {
-        outcome.nextState = TemplateRenderState::COMPLETE;
-        outcome.repeat = false;
-        outcome.finished = true;
-        return outcome;
-    }
 
-    if (parentCtx->type == RenderingContextType::TEMPLATE) {
-        outcome.nextState = TemplateRenderState::TEXT;
-    } else {
-        outcome.nextState = TemplateRenderState::RENDERING_CONTEXT;
+        return dispatchPlaceholder(ctx, entry, templateCtx.segmentIndex >= plan->segmentCount);
     }
 
-    outcome.repeat = true;
-    return outcome;
+    return handleTemplateCompletion(ctx);
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::consumeTemplateText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen) {
+bool DeviceFrameworkTemplateRenderer::consumeTokenizedText(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written) {
     RenderingContext* currentCtx = ctx.getCurrentContext();
-    if (!currentCtx || currentCtx->type != RenderingContextType::TEMPLATE) {
-        DFTE_LOG_ERROR("consumeTemplateText called without TEMPLATE context");
-        return makeError();
-    }
-
-    auto& templateCtx = currentCtx->context.templateCtx;
+    const TokenTable* tokens = currentCtx->context.templateCtx.tokens;
+
+    while (written < maxLen && ctx.hasMoreData()) {
+        bool escapeFound = false;
+        size_t run = ctx.readLiteralRun(buffer + written, maxLen - written, escapeFound, DFTE_TOKEN_ESCAPE);
+        written += run;
+
+        if (escapeFound) {
+            uint32_t id = 0;
+            if (!ctx.readTokenId(id)) {
+                DFTE_LOG_WARN("Truncated token id at end of tokenized template");
+                break;
+            }
 
-    // Empty template completes immediately
-    if (templateCtx.templateLen == 0) {
-        return handleTemplateCompletion(ctx);
-    }
+            const PlaceholderEntry* entry = ctx.registry ? ctx.registry->getPlaceholderByToken(tokens, id) : nullptr;
+            if (!entry && copyTokenName(ctx, tokens, id)) {
+                entry = findIteratorOverride(ctx, currentCtx, ctx.placeholderName);
+                if (!entry) {
+                    DFTE_LOG_WARN("Unknown placeholder: " + String(ctx.placeholderName));
+                }
+                ctx.resetPlaceholder();
+            } else if (!entry) {
+                DFTE_LOG_WARN("Token id outside token table: " + String(id));
+            }
+            if (!entry) {
+                continue;
+            }
 
-    size_t written = 0;
-    while (written < maxLen) {
-        if (templateCtx.position >= templateCtx.templateLen) {
-            break;
+            return dispatchPlaceholder(ctx, entry, !ctx.hasMoreData());
         }
 
-        char c = ctx.getNextChar();
-        if (c == '\0') {
+        if (run == 0) {
             break;
         }
-
-        if (c == '%') {
-            ctx.placeholderPos = 0;
-            ctx.placeholderName[ctx.placeholderPos++] = '%';
-            RenderOutcome outcome = makeState(TemplateRenderState::BUILDING_PLACEHOLDER, true);
-            outcome.bytesWritten = written;
-            return outcome;
-        }
-
-        buffer[written++] = c;
     }
 
-    if (written > 0) {
-        RenderOutcome outcome = makeWritten(written, TemplateRenderState::TEXT, written < maxLen);
-        if (written < maxLen) {
-            outcome.repeat = true;
-        }
-        return outcome;
-    }
-
-    // No bytes written, check if template finished
-    if (templateCtx.position >= templateCtx.templateLen || !ctx.hasMoreData()) {
+    if (!ctx.hasMoreData()) {
         return handleTemplateCompletion(ctx);
     }
 
-    // Need more data
-    return makeState(TemplateRenderState::TEXT, false);
+    return written > 0;
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::buildPlaceholderToken(DeviceFrameworkTemplateContext& ctx) {
+bool DeviceFrameworkTemplateRenderer::buildPlaceholderToken(DeviceFrameworkTemplateContext& ctx) {
     RenderingContext* currentCtx = ctx.getCurrentContext();
     if (!currentCtx || currentCtx->type != RenderingContextType::TEMPLATE) {
         DFTE_LOG_ERROR("buildPlaceholderToken called without TEMPLATE context");
-        return makeError();
+        return failRender(ctx);
     }
 
     bool madeProgress = false;
@@ -607,24 +737,29 @@ DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::
             break;
         }
 
-        char c = ctx.getNextChar();
-        if (c == '\0') {
-            break;
-        }
-
-        madeProgress = true;
-        ctx.placeholderName[ctx.placeholderPos++] = c;
+        // Scan for the closing '%' a span at a time, bounded by the remaining name space
+        bool delimiterFound = false;
+        size_t remaining = sizeof(ctx.placeholderName) - 1 - ctx.placeholderPos;
+        size_t run = ctx.readLiteralRun(reinterpret_cast<uint8_t*>(ctx.placeholderName + ctx.placeholderPos),
+                                        remaining, delimiterFound);
+        ctx.placeholderPos += run;
 
-        if (c == '%') {
+        if (delimiterFound) {
+            ctx.placeholderName[ctx.placeholderPos++] = '%';
             ctx.placeholderName[ctx.placeholderPos] = '\0';
             return resolvePlaceholder(ctx);
         }
+        if (run == 0) {
+            break;
+        }
+        madeProgress = true;
     }
 
     if (ctx.placeholderPos >= sizeof(ctx.placeholderName) - 1) {
         DFTE_LOG_WARN("Placeholder name too long: " + String(ctx.placeholderName));
         ctx.resetPlaceholder();
-        return makeState(TemplateRenderState::TEXT, true);
+        setState(ctx, TemplateRenderState::TEXT);
+        return true;
     }
 
     if (!ctx.hasMoreData()) {
@@ -634,240 +769,304 @@ DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::
     }
 
     // We consumed data but did not finish; stay in BUILDING_PLACEHOLDER
-    RenderOutcome outcome = makeState(TemplateRenderState::BUILDING_PLACEHOLDER, false);
-    outcome.repeat = madeProgress;
-    return outcome;
+    return madeProgress;
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::resolvePlaceholder(DeviceFrameworkTemplateContext& ctx) {
-    const PlaceholderEntry* entry = ctx.registry ? ctx.registry->getPlaceholder(ctx.placeholderName) : nullptr;
+bool DeviceFrameworkTemplateRenderer::resolvePlaceholder(DeviceFrameworkTemplateContext& ctx) {
+    // Iterator item scope first: row tokens resolve from the item index without touching the registry
+    const PlaceholderEntry* entry = findIteratorOverride(ctx, ctx.getCurrentContext(), ctx.placeholderName);
 
-    if (!entry) {
-        RenderingContext* currentCtx = ctx.getCurrentContext();
-        if (currentCtx && currentCtx->type == RenderingContextType::TEMPLATE) {
-            const PlaceholderEntry* overrides = currentCtx->context.templateCtx.iteratorPlaceholders;
-            size_t overrideCount = currentCtx->context.templateCtx.iteratorPlaceholderCount;
-            for (size_t i = 0; i < overrideCount; ++i) {
-                if (strcmp(overrides[i].name, ctx.placeholderName) == 0) {
-                    entry = &overrides[i];
-                    break;
-                }
-            }
-        }
+    if (!entry && ctx.registry) {
+        entry = ctx.registry->getPlaceholder(ctx.placeholderName);
     }
 
     if (!entry) {
         DFTE_LOG_WARN("Unknown placeholder: " + String(ctx.placeholderName));
         ctx.resetPlaceholder();
-        return makeState(TemplateRenderState::TEXT, true);
+        setState(ctx, TemplateRenderState::TEXT);
+        return true;
     }
 
-    RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-    outcome.pushContext.active = true;
+    ctx.resetPlaceholder();
+    return dispatchPlaceholder(ctx, entry, !ctx.hasMoreData());
+}
 
+bool DeviceFrameworkTemplateRenderer::dispatchPlaceholder(DeviceFrameworkTemplateContext& ctx, const PlaceholderEntry* entry, bool tailPosition) {
     switch (entry->type) {
         case PlaceholderType::PROGMEM_DATA:
         case PlaceholderType::RAM_DATA:
         case PlaceholderType::DYNAMIC_DATA:
-            outcome.pushContext.type = RenderingContextType::PLACEHOLDER_DATA;
-            outcome.pushContext.entry = entry;
-            break;
+        case PlaceholderType::SIZED_DATA:
+        case PlaceholderType::WRITER_DATA:
+        case PlaceholderType::TYPED_VALUE:
+        case PlaceholderType::PRODUCER_DATA:
+        case PlaceholderType::RING_DATA:
+        case PlaceholderType::PROVIDER_FIELD:
         case PlaceholderType::PROGMEM_TEMPLATE:
-            outcome.pushContext.type = RenderingContextType::PLACEHOLDER_TEMPLATE;
-            outcome.pushContext.entry = entry;
-            outcome.nextState = TemplateRenderState::TEXT;
-            break;
+        case PlaceholderType::STATIC_TEMPLATE:
+        case PlaceholderType::TOKENIZED_TEMPLATE:
+        case PlaceholderType::COMPILED_TEMPLATE:
         case PlaceholderType::DYNAMIC_TEMPLATE:
-            outcome.pushContext.type = RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE;
-            outcome.pushContext.entry = entry;
-            outcome.nextState = TemplateRenderState::TEXT;
-            break;
         case PlaceholderType::CONDITIONAL:
-            outcome.pushContext.type = RenderingContextType::PLACEHOLDER_CONDITIONAL;
-            outcome.pushContext.entry = entry;
-            outcome.nextState = TemplateRenderState::RENDERING_CONTEXT;
-            break;
         case PlaceholderType::ITERATOR:
-            outcome.pushContext.type = RenderingContextType::PLACEHOLDER_ITERATOR;
-            outcome.pushContext.entry = entry;
-            outcome.nextState = TemplateRenderState::RENDERING_CONTEXT;
             break;
         default:
             DFTE_LOG_WARN("Unsupported placeholder type");
-            ctx.resetPlaceholder();
-            return makeState(TemplateRenderState::TEXT, true);
+            return resumeTopFrame(ctx);
     }
 
-    ctx.resetPlaceholder();
-    return outcome;
+    // Nothing follows the token, so the calling template is finished: its frame is reused for the
+    // placeholder instead of staying on the stack until the placeholder completes
+    uint16_t tailDepth = 0;
+    if (tailPosition) {
+        tailDepth = ctx.getCurrentContext()->tailDepth + 1;
+        if (tailDepth > DFTE_MAX_TAIL_INCLUDES) {
+            DFTE_LOG_ERROR("Too many chained tail includes (recursive template?): " + String(entry->name));
+            return failRender(ctx);
+        }
+        ctx.popContext();
+    }
+
+    int frameIndex = ctx.renderingDepth;
+    if (!pushPlaceholderEntry(ctx, entry, entry->name)) {
+        return failRender(ctx);
+    }
+    if (ctx.renderingDepth > frameIndex) {
+        ctx.renderingStack[frameIndex].tailDepth = tailDepth;
+    }
+
+    // The new top frame (or the caller's parent when nothing was pushed) decides the next state
+    return resumeTopFrame(ctx);
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::emitActiveContext(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen) {
+bool DeviceFrameworkTemplateRenderer::emitActiveContext(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen, size_t& written) {
     RenderingContext* currentCtx = ctx.getCurrentContext();
     if (!currentCtx) {
-        return makeComplete();
+        setState(ctx, TemplateRenderState::COMPLETE);
+        return false;
     }
 
     switch (currentCtx->type) {
         case RenderingContextType::TEMPLATE:
-            return consumeTemplateText(ctx, buffer, maxLen);
+            setState(ctx, TemplateRenderState::TEXT);
+            return consumeTemplateText(ctx, buffer, maxLen, written);
 
         case RenderingContextType::PLACEHOLDER_DATA:
-            return streamPlaceholderData(ctx, currentCtx, buffer, maxLen);
+            return streamPlaceholderData(ctx, currentCtx, buffer, maxLen, written);
 
-        case RenderingContextType::PLACEHOLDER_TEMPLATE:
-            return makeState(TemplateRenderState::TEXT, true);
+        case RenderingContextType::PLACEHOLDER_WRITER:
+            return streamWriterData(ctx, currentCtx, buffer, maxLen, written);
 
+        case RenderingContextType::PLACEHOLDER_TEMPLATE:
         case RenderingContextType::PLACEHOLDER_DYNAMIC_TEMPLATE:
-            return makeState(TemplateRenderState::TEXT, true);
-
-        case RenderingContextType::PLACEHOLDER_CONDITIONAL: {
-            RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-            outcome.popCount = 1;
-
-            RenderingContext* parent = (ctx.renderingDepth > 1) ? ctx.getContext(ctx.renderingDepth - 2) : nullptr;
-            if (!parent) {
-                outcome.nextState = TemplateRenderState::COMPLETE;
-                outcome.repeat = false;
-                outcome.finished = true;
-            } else if (parent->type == RenderingContextType::TEMPLATE) {
-                outcome.nextState = TemplateRenderState::TEXT;
-            }
-
-            return outcome;
-        }
+        case RenderingContextType::PLACEHOLDER_CONDITIONAL:
+            // Wrapper frames are only pushed by callers driving the stack directly; nothing left to render
+            ctx.popContext();
+            return resumeTopFrame(ctx);
 
         case RenderingContextType::PLACEHOLDER_ITERATOR:
             return processIteratorContext(ctx, currentCtx);
 
+        case RenderingContextType::COMPILED_TEMPLATE:
+            return emitCompiledTemplate(ctx, currentCtx, buffer, maxLen, written);
+
         default:
             DFTE_LOG_ERROR("emitActiveContext encountered unknown context type");
-            return makeError();
+            return failRender(ctx);
     }
 }
 
-DeviceFrameworkTemplateRenderer::RenderOutcome DeviceFrameworkTemplateRenderer::streamPlaceholderData(DeviceFrameworkTemplateContext& ctx,
-                                                                                                     RenderingContext* context,
-                                                                                                     uint8_t* buffer,
-                                                                                                     size_t maxLen) {
+bool DeviceFrameworkTemplateRenderer::emitCompiledTemplate(DeviceFrameworkTemplateContext& ctx,
+                                                           RenderingContext* context,
+                                                           uint8_t* buffer,
+                                                           size_t maxLen,
+                                                           size_t& written) {
+    auto& compiledCtx = context->context.compiledTemplate;
+    const CompiledTemplate* compiled = compiledCtx.compiled;
+    if (!compiled || !compiled->emit) {
+        DFTE_LOG_ERROR("Compiled template context missing emitter");
+        return failRender(ctx);
+    }
+
+    if (compiledCtx.cursor.resumePoint == DFTE_COMPILED_TEMPLATE_DONE) {
+        return handleTemplateCompletion(ctx);
+    }
+
+    int placeholderIndex = -1;
+    written += compiled->emit(compiledCtx.cursor, buffer, maxLen, placeholderIndex);
+
+    if (placeholderIndex < 0) {
+        if (compiledCtx.cursor.resumePoint == DFTE_COMPILED_TEMPLATE_DONE) {
+            return handleTemplateCompletion(ctx);
+        }
+        return true;
+    }
+
+    const TokenTable* placeholders = &compiled->placeholders;
+    if (static_cast<uint32_t>(placeholderIndex) >= placeholders->count) {
+        DFTE_LOG_ERROR("Compiled template emitted unknown placeholder index: " + String(placeholderIndex));
+        return failRender(ctx);
+    }
+
+    const PlaceholderEntry* entry = ctx.registry ? ctx.registry->getPlaceholderByToken(placeholders, placeholderIndex) : nullptr;
+    if (!entry) {
+        copyTokenName(ctx, placeholders, placeholderIndex);
+        DFTE_LOG_WARN("Unknown placeholder: " + String(ctx.placeholderName));
+        ctx.resetPlaceholder();
+        return true;
+    }
+
+    return dispatchPlaceholder(ctx, entry, compiledCtx.cursor.resumePoint == DFTE_COMPILED_TEMPLATE_DONE);
+}
+
+bool DeviceFrameworkTemplateRenderer::streamPlaceholderData(DeviceFrameworkTemplateContext& ctx,
+                                                            RenderingContext* context,
+                                                            uint8_t* buffer,
+                                                            size_t maxLen,
+                                                            size_t& written) {
     auto& dataCtx = context->context.data;
     const PlaceholderEntry* entry = dataCtx.entry;
 
     if (!entry) {
         DFTE_LOG_ERROR("Placeholder data context missing entry");
-        RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-        outcome.popCount = 1;
-        return outcome;
+        ctx.popContext();
+        return resumeTopFrame(ctx);
     }
 
     if (ctx.registry == nullptr) {
         DFTE_LOG_ERROR("Placeholder registry not set; cannot render placeholder: " + String(entry->name));
-        RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-        outcome.popCount = 1;
-
-        RenderingContext* parent = (ctx.renderingDepth > 1) ? ctx.getContext(ctx.renderingDepth - 2) : nullptr;
-        if (!parent) {
-            outcome.nextState = TemplateRenderState::COMPLETE;
-            outcome.repeat = false;
-            outcome.finished = true;
-        } else if (parent->type == RenderingContextType::TEMPLATE) {
-            outcome.nextState = TemplateRenderState::TEXT;
-        }
-
-        return outcome;
-    }
-
-    size_t totalLength = 0;
-    if (entry->type == PlaceholderType::DYNAMIC_DATA) {
-        const auto* descriptor = static_cast<const DynamicDataDescriptor*>(entry->data);
-        const char* data = (descriptor && descriptor->getter) ? descriptor->getter(descriptor->userData) : nullptr;
-        totalLength = DeviceFrameworkPlaceholderRegistry::getDynamicDataLength(descriptor, data);
-    } else if (entry->hasCachedLength) {
-        totalLength = entry->cachedLength;
-    } else if (entry->getLength != nullptr) {
-        totalLength = entry->getLength(entry->data);
-    } else {
-        DFTE_LOG_ERROR("Placeholder '" + String(entry->name) + "' missing length getter");
-        return makeError();
+        ctx.popContext();
+        return resumeTopFrame(ctx);
     }
 
-    if (dataCtx.offset >= totalLength) {
-        RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-        outcome.popCount = 1;
-
-        RenderingContext* parent = (ctx.renderingDepth > 1) ? ctx.getContext(ctx.renderingDepth - 2) : nullptr;
-        if (parent && parent->type == RenderingContextType::PLACEHOLDER_CONDITIONAL) {
-            outcome.popCount += 1;
-            parent = (ctx.renderingDepth > 2) ? ctx.getContext(ctx.renderingDepth - 3) : nullptr;
+    if (dataCtx.offset < dataCtx.length) {
+        size_t count;
+        if (entry->type == PlaceholderType::RING_DATA) {
+            // Tail to the end of storage, then the start of storage up to head, each copied in place
+            bool wrapped = dataCtx.offset >= dataCtx.ring.split;
+            const char* source = wrapped ? dataCtx.ring.wrapData + (dataCtx.offset - dataCtx.ring.split)
+                                         : dataCtx.value + dataCtx.offset;
+            size_t available = (wrapped ? dataCtx.length : dataCtx.ring.split) - dataCtx.offset;
+            count = min(min(maxLen, available), static_cast<size_t>(DFTE_RAM_CHUNK_SIZE));
+            memcpy(buffer, source, count);
+        } else if (dataCtx.value != nullptr) {
+            // Snapshotted RAM value: the getter is not called again
+            count = min(min(maxLen, dataCtx.length - dataCtx.offset), static_cast<size_t>(DFTE_RAM_CHUNK_SIZE));
+            memcpy(buffer, dataCtx.value + dataCtx.offset, count);
+        } else if (entry->type == PlaceholderType::PRODUCER_DATA) {
+            // Pulled straight into the caller's buffer: nothing of the value is held in RAM between chunks
+            const auto* descriptor = static_cast<const ProducerDescriptor*>(entry->data);
+            count = descriptor->read(dataCtx.handle, dataCtx.offset, buffer, maxLen);
+            if (count > maxLen) {
+                DFTE_LOG_ERROR("Producer placeholder read past the chunk: " + String(entry->name));
+                return failRender(ctx);
+            }
+        } else {
+            count = DeviceFrameworkPlaceholderRegistry::renderPlaceholder(entry, dataCtx.offset, buffer, maxLen);
         }
-        if (!parent) {
-            outcome.nextState = TemplateRenderState::COMPLETE;
-            outcome.repeat = false;
-            outcome.finished = true;
-        } else if (parent->type == RenderingContextType::TEMPLATE) {
-            outcome.nextState = TemplateRenderState::TEXT;
+        written += count;
+        dataCtx.offset += count;
+        if (count > 0 && dataCtx.offset < dataCtx.length) {
+            return true;
         }
-        return outcome;
     }
 
-    size_t written = ctx.registry->renderPlaceholder(entry, dataCtx.offset, buffer, maxLen);
-    if (written > 0) {
-        dataCtx.offset += written;
-        return makeWritten(written, TemplateRenderState::RENDERING_CONTEXT, written < maxLen);
+    // Value fully written (or nothing left to write): pop in the same step
+    ctx.popContext();
+    return resumeTopFrame(ctx);
+}
+
+bool DeviceFrameworkTemplateRenderer::streamWriterData(DeviceFrameworkTemplateContext& ctx,
+                                                       RenderingContext* context,
+                                                       uint8_t* buffer,
+                                                       size_t maxLen,
+                                                       size_t& written) {
+    auto& writerCtx = context->context.writer;
+
+    // Bytes the previous call wrote past its chunk go out first
+    size_t count = 0;
+    if (writerCtx.spillPos < writerCtx.spillLen) {
+        count = min(maxLen, static_cast<size_t>(writerCtx.spillLen - writerCtx.spillPos));
+        memcpy(buffer, writerCtx.spill + writerCtx.spillPos, count);
+        writerCtx.spillPos += count;
+        written += count;
+        if (writerCtx.spillPos < writerCtx.spillLen) {
+            return true;
+        }
     }
 
-    // No bytes written; treat as completion and pop context
-    RenderOutcome outcome = makeState(TemplateRenderState::RENDERING_CONTEXT, true);
-    outcome.popCount = 1;
+    if (!writerCtx.finished) {
+        if (count == maxLen) {
+            return true;
+        }
 
-    RenderingContext* parent = (ctx.renderingDepth > 1) ? ctx.getContext(ctx.renderingDepth - 2) : nullptr;
-    if (parent && parent->type == RenderingContextType::PLACEHOLDER_CONDITIONAL) {
-        outcome.popCount += 1;
-        parent = (ctx.renderingDepth > 2) ? ctx.getContext(ctx.renderingDepth - 3) : nullptr;
-    }
-    if (!parent) {
-        outcome.nextState = TemplateRenderState::COMPLETE;
-        outcome.repeat = false;
-        outcome.finished = true;
-    } else if (parent->type == RenderingContextType::TEMPLATE) {
-        outcome.nextState = TemplateRenderState::TEXT;
+        DeviceFrameworkPlaceholderWriter writer(buffer + count, maxLen - count, writerCtx.spill, sizeof(writerCtx.spill),
+                                                writerCtx.cookie);
+        writerCtx.finished = writerCtx.descriptor->write(writer, writerCtx.descriptor->userData);
+        if (writer.hasOverflowed()) {
+            DFTE_LOG_WARN("Writer placeholder output truncated (write pieces no larger than remaining()): " +
+                          String(context->name));
+        }
+        if (!writerCtx.finished && writer.getWritten() == 0) {
+            DFTE_LOG_ERROR("Writer placeholder made no progress: " + String(context->name));
+            return failRender(ctx);
+        }
+
+        written += writer.getWritten() - writer.getSpilled();
+        writerCtx.spillPos = 0;
+        writerCtx.spillLen = static_cast<uint8_t>(writer.getSpilled());
+        if (!writerCtx.finished || writerCtx.spillLen > 0) {
+            return true;
+        }
     }
 
-    return outcome;
+    // Value fully written: pop in the same step
+    ctx.popContext();
+    return resumeTopFrame(ctx);
 }
-size_t DeviceFrameworkTemplateRenderer::renderNextChunk(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen) {
-    if (ctx.isComplete() || ctx.hasError()) {
-        return 0;
-    }
 
+size_t DeviceFrameworkTemplateRenderer::renderNextChunk(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t maxLen) {
+    // Callbacks reach this context's scratch arena through DeviceFrameworkScratchArena::current()
+    DeviceFrameworkTemplateContext::RenderScope scope(ctx);
     size_t written = 0;
     size_t iterations = 0;
     size_t consecutiveNoProgressIterations = 0;
-    uint8_t* writePtr = buffer;
-    size_t remaining = maxLen;
-
-    while (remaining > 0 && !ctx.isComplete() && !ctx.hasError() && iterations < MAX_ITERATIONS) {
-        RenderOutcome outcome = renderChunk(ctx, writePtr, remaining);
 
-        bool noProgressIteration = (outcome.bytesWritten == 0 && outcome.repeat && !outcome.finished && !outcome.errored);
-        if (noProgressIteration) {
-            consecutiveNoProgressIterations++;
-        } else {
-            consecutiveNoProgressIterations = 0;
+    while (written < maxLen && iterations < MAX_ITERATIONS) {
+        size_t stepBytes = 0;
+        bool repeat;
+
+        switch (ctx.state) {
+            case TemplateRenderState::TEXT:
+                repeat = consumeTemplateText(ctx, buffer + written, maxLen - written, stepBytes);
+                break;
+            case TemplateRenderState::BUILDING_PLACEHOLDER:
+                repeat = buildPlaceholderToken(ctx);
+                break;
+            case TemplateRenderState::RENDERING_CONTEXT:
+                repeat = emitActiveContext(ctx, buffer + written, maxLen - written, stepBytes);
+                break;
+            case TemplateRenderState::COMPLETE:
+            case TemplateRenderState::ERROR:
+            default:
+                return written;
         }
 
-        written += outcome.bytesWritten;
-        ctx.totalBytesProcessed += outcome.bytesWritten;
-        writePtr += outcome.bytesWritten;
-        remaining -= outcome.bytesWritten;
+        written += stepBytes;
         iterations++;
+        ctx.totalBytesProcessed += stepBytes;
+        ctx.totalSteps++;
 
-        if (outcome.finished || outcome.errored) {
+        if (ctx.state == TemplateRenderState::COMPLETE || ctx.state == TemplateRenderState::ERROR) {
             break;
         }
 
-        if (!outcome.repeat && outcome.bytesWritten == 0) {
-            break;
+        if (stepBytes > 0) {
+            consecutiveNoProgressIterations = 0;
+        } else if (repeat) {
+            consecutiveNoProgressIterations++;
+        } else {
+            break; // Waiting on template data
         }
     }
 
@@ -878,6 +1077,10 @@ size_t DeviceFrameworkTemplateRenderer::renderNextChunk(DeviceFrameworkTemplateC
         }
     }
 
+    if (ctx.isComplete()) {
+        // Every value the callbacks returned has been written out
+        ctx.releaseScratch();
+    }
     return written;
 }
 
@@ -912,6 +1115,62 @@ void DeviceFrameworkTemplateRenderer::initializeContext(DeviceFrameworkTemplateC
                    String(templateInProgmem ? 1 : 0));
 }
 
+void DeviceFrameworkTemplateRenderer::initializeContext(DeviceFrameworkTemplateContext& ctx, const StaticTemplate& staticTemplate) {
+    initializeContext(ctx, staticTemplate.text, true);
+    if (ctx.hasError()) {
+        return;
+    }
+    ctx.getCurrentContext()->context.templateCtx.compiled = &staticTemplate;
+}
+
+void DeviceFrameworkTemplateRenderer::initializeContext(DeviceFrameworkTemplateContext& ctx, const CompiledTemplate& compiledTemplate) {
+    ctx.reset();
+
+    if (compiledTemplate.emit == nullptr) {
+        DFTE_LOG_ERROR("initializeContext called with compiled template missing emitter");
+        ctx.state = TemplateRenderState::ERROR;
+        return;
+    }
+
+    if (!ctx.pushContext(RenderingContextType::COMPILED_TEMPLATE, "ROOT")) {
+        ctx.state = TemplateRenderState::ERROR;
+        return;
+    }
+
+    RenderingContext* rootCtx = ctx.getCurrentContext();
+    rootCtx->context.compiledTemplate.compiled = &compiledTemplate;
+    rootCtx->context.compiledTemplate.cursor.resumePoint = 0;
+    rootCtx->context.compiledTemplate.cursor.offset = 0;
+
+    ctx.state = TemplateRenderState::RENDERING_CONTEXT;
+    logStateTransition(ctx, "INIT", "RENDERING_CONTEXT", "Initialized compiled template context");
+}
+
+void DeviceFrameworkTemplateRenderer::initializeContext(DeviceFrameworkTemplateContext& ctx, const TokenizedTemplate& tokenizedTemplate) {
+    ctx.reset();
+
+    if (tokenizedTemplate.data == nullptr || tokenizedTemplate.tokens == nullptr) {
+        DFTE_LOG_ERROR("initializeContext called with tokenized template missing data or token table");
+        ctx.state = TemplateRenderState::ERROR;
+        return;
+    }
+
+    if (!ctx.pushContext(RenderingContextType::TEMPLATE, "ROOT")) {
+        ctx.state = TemplateRenderState::ERROR;
+        return;
+    }
+
+    RenderingContext* rootCtx = ctx.getCurrentContext();
+    rootCtx->context.templateCtx.templateData = tokenizedTemplate.data;
+    rootCtx->context.templateCtx.templateLen = tokenizedTemplate.length;
+    rootCtx->context.templateCtx.isProgmem = true;
+    rootCtx->context.templateCtx.position = 0;
+    rootCtx->context.templateCtx.tokens = tokenizedTemplate.tokens;
+
+    ctx.state = TemplateRenderState::TEXT;
+    logStateTransition(ctx, "INIT", "TEXT", "Initialized tokenized template context");
+}
+
 bool DeviceFrameworkTemplateRenderer::isComplete(const DeviceFrameworkTemplateContext& ctx) {
     return ctx.isComplete();
 }
@@ -0,0 +1,184 @@
+#include "DeviceFrameworkTypedValue.h"
+#include <cstring>
+
+namespace {
+
+const uint32_t POWERS_OF_TEN[10] = {1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u};
+
+size_t countDigits(uint32_t value) {
+    size_t digits = 1;
+    while (digits < 10 && value >= POWERS_OF_TEN[digits]) {
+        digits++;
+    }
+    return digits;
+}
+
+// Write exactly `digits` digits of value (zero-padded) backwards from out + digits, two per division
+void writeDigits(uint32_t value, char* out, size_t digits) {
+    char* p = out + digits;
+    while (digits >= 2) {
+        uint32_t quotient = value / 100;
+        uint32_t pair = value - quotient * 100;
+        *--p = static_cast<char>('0' + pair % 10);
+        *--p = static_cast<char>('0' + pair / 10);
+        value = quotient;
+        digits -= 2;
+    }
+    if (digits) {
+        *--p = static_cast<char>('0' + value % 10);
+    }
+}
+
+size_t copyText(const char* text, size_t length, char* out) {
+    memcpy(out, text, length);
+    return length;
+}
+
+} // namespace
+
+bool DeviceFrameworkTypedValue::isValid(const TypedValueDescriptor* descriptor) {
+    if (descriptor == nullptr) {
+        return false;
+    }
+    if (descriptor->kind == TypedValueKind::FIXED) {
+        return (descriptor->address != nullptr || descriptor->readFloat != nullptr) && descriptor->decimals <= MAX_DECIMALS;
+    }
+    if (descriptor->address == nullptr && descriptor->readInt == nullptr) {
+        return false;
+    }
+    if (descriptor->kind == TypedValueKind::BOOLEAN) {
+        return descriptor->trueText != nullptr && descriptor->falseText != nullptr;
+    }
+    return descriptor->kind <= TypedValueKind::DURATION;
+}
+
+PlaceholderValue DeviceFrameworkTypedValue::format(const TypedValueDescriptor& descriptor, char* text) {
+    const void* address = descriptor.address;
+
+    if (descriptor.kind == TypedValueKind::FIXED) {
+        float value = address ? *static_cast<const float*>(address)
+                              : (descriptor.readFloat ? descriptor.readFloat(descriptor.userData) : 0.0f);
+        return PlaceholderValue{text, formatFixed(value, descriptor.decimals, text)};
+    }
+
+    int64_t raw = (address == nullptr && descriptor.readInt) ? descriptor.readInt(descriptor.userData) : 0;
+    switch (descriptor.kind) {
+        case TypedValueKind::INT32:
+            return PlaceholderValue{text, formatSigned(address ? *static_cast<const int32_t*>(address) : static_cast<int32_t>(raw), text)};
+        case TypedValueKind::UINT32:
+            return PlaceholderValue{text, formatUnsigned(address ? *static_cast<const uint32_t*>(address) : static_cast<uint32_t>(raw), text)};
+        case TypedValueKind::INT64:
+            return PlaceholderValue{text, formatSigned64(address ? *static_cast<const int64_t*>(address) : raw, text)};
+        case TypedValueKind::BOOLEAN: {
+            bool value = address ? *static_cast<const bool*>(address) : raw != 0;
+            const char* chosen = value ? descriptor.trueText : descriptor.falseText;
+            return PlaceholderValue{chosen, chosen ? strlen(chosen) : 0};
+        }
+        case TypedValueKind::IPV4:
+            return PlaceholderValue{text, formatIPv4(address ? *static_cast<const uint32_t*>(address) : static_cast<uint32_t>(raw), text)};
+        case TypedValueKind::DURATION:
+            return PlaceholderValue{text, formatDuration(address ? *static_cast<const uint32_t*>(address) : static_cast<uint32_t>(raw), text)};
+        default:
+            return PlaceholderValue{text, 0};
+    }
+}
+
+size_t DeviceFrameworkTypedValue::formatUnsigned(uint32_t value, char* out) {
+    size_t digits = countDigits(value);
+    writeDigits(value, out, digits);
+    return digits;
+}
+
+size_t DeviceFrameworkTypedValue::formatSigned(int32_t value, char* out) {
+    if (value >= 0) {
+        return formatUnsigned(static_cast<uint32_t>(value), out);
+    }
+    // Negate in unsigned arithmetic so INT32_MIN does not overflow
+    out[0] = '-';
+    return 1 + formatUnsigned(0u - static_cast<uint32_t>(value), out + 1);
+}
+
+size_t DeviceFrameworkTypedValue::formatUnsigned64(uint64_t value, char* out) {
+    if (value <= 0xFFFFFFFFu) {
+        return formatUnsigned(static_cast<uint32_t>(value), out);
+    }
+    // One 64-bit division per nine digits; the rest is 32-bit arithmetic (cheap on Xtensa)
+    uint64_t high = value / 1000000000u;
+    uint32_t low = static_cast<uint32_t>(value - high * 1000000000u);
+    size_t length = formatUnsigned64(high, out);
+    writeDigits(low, out + length, 9);
+    return length + 9;
+}
+
+size_t DeviceFrameworkTypedValue::formatSigned64(int64_t value, char* out) {
+    if (value >= 0) {
+        return formatUnsigned64(static_cast<uint64_t>(value), out);
+    }
+    out[0] = '-';
+    return 1 + formatUnsigned64(0u - static_cast<uint64_t>(value), out + 1);
+}
+
+size_t DeviceFrameworkTypedValue::formatFixed(float value, uint8_t decimals, char* out) {
+    if (value != value) {
+        return copyText("nan", 3, out);
+    }
+    if (decimals > MAX_DECIMALS) {
+        decimals = MAX_DECIMALS;
+    }
+
+    size_t length = 0;
+    double magnitude = value;
+    if (magnitude < 0) {
+        out[length++] = '-';
+        magnitude = -magnitude;
+    }
+    double scaled = magnitude * POWERS_OF_TEN[decimals] + 0.5;
+    if (scaled >= 1e15) {
+        // Also catches infinity; keeps every result within MAX_TEXT
+        return length + (magnitude > 3.5e38 ? copyText("inf", 3, out + length) : copyText("ovf", 3, out + length));
+    }
+
+    uint64_t units = static_cast<uint64_t>(scaled);
+    if (units == 0) {
+        length = 0;  // No "-0.00"
+    }
+    uint32_t scale = POWERS_OF_TEN[decimals];
+    uint64_t whole = units / scale;
+    uint32_t fraction = static_cast<uint32_t>(units - whole * scale);
+    length += formatUnsigned64(whole, out + length);
+    if (decimals > 0) {
+        out[length++] = '.';
+        writeDigits(fraction, out + length, decimals);
+        length += decimals;
+    }
+    return length;
+}
+
+size_t DeviceFrameworkTypedValue::formatIPv4(uint32_t address, char* out) {
+    // IPAddress converts to uint32_t with the first octet in the low byte
+    size_t length = 0;
+    for (int octet = 0; octet < 4; ++octet) {
+        if (octet > 0) {
+            out[length++] = '.';
+        }
+        length += formatUnsigned((address >> (octet * 8)) & 0xFFu, out + length);
+    }
+    return length;
+}
+
+size_t DeviceFrameworkTypedValue::formatDuration(uint32_t seconds, char* out) {
+    uint32_t hours = seconds / 3600;
+    uint32_t rest = seconds - hours * 3600;
+    uint32_t minutes = rest / 60;
+    size_t length = 0;
+    if (hours < 10) {
+        out[length++] = '0';
+    }
+    length += formatUnsigned(hours, out + length);
+    out[length++] = ':';
+    writeDigits(minutes, out + length, 2);
+    length += 2;
+    out[length++] = ':';
+    writeDigits(rest - minutes * 60, out + length, 2);
+    return length + 2;
+}
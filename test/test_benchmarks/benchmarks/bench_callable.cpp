@@ -0,0 +1,93 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <functional>
+#include "../utils/bench_utils.h"
+
+static const size_t CALLABLE_BENCH_CALLS = 200000;
+static const size_t CALLABLE_BENCH_RENDERS = 5000;
+
+struct CallableBenchSensor {
+    const char* labels[4] = {"kitchen", "cellar", "attic", "garage"};
+    size_t calls = 0;
+};
+
+static CallableBenchSensor callableBenchSensor;
+
+// What handlers look like today: a plain function reaching its state through userData
+static const char* callableBenchPlainGetter(void* userData) {
+    CallableBenchSensor* sensor = static_cast<CallableBenchSensor*>(userData);
+    return sensor->labels[sensor->calls++ & 3];
+}
+
+// Called through the descriptor like the renderer does, so the compiler cannot see the target
+static unsigned long runCallableBench(const DynamicDataDescriptor* volatile* slot, size_t& bytes) {
+    unsigned long start = micros();
+    for (size_t i = 0; i < CALLABLE_BENCH_CALLS; ++i) {
+        const DynamicDataDescriptor* descriptor = *slot;
+        bytes += static_cast<size_t>(descriptor->getter(descriptor->userData)[0]);
+    }
+    return benchElapsedMicros(start);
+}
+
+static const char PROGMEM callableBenchTemplate[] =
+    "<tr><td>%A%</td><td>%B%</td></tr><tr><td>%C%</td><td>%D%</td></tr>";
+
+static unsigned long renderCallableBench(const DynamicDataDescriptor* descriptor, size_t& bytes) {
+    PlaceholderRegistry registry(4);
+    registry.registerDynamicData("%A%", descriptor);
+    registry.registerDynamicData("%B%", descriptor);
+    registry.registerDynamicData("%C%", descriptor);
+    registry.registerDynamicData("%D%", descriptor);
+    TemplateContext* ctx = new TemplateContext();
+    ctx->setRegistry(&registry);
+    uint8_t buffer[128];
+    unsigned long start = micros();
+    for (size_t i = 0; i < CALLABLE_BENCH_RENDERS; ++i) {
+        TemplateRenderer::initializeContext(*ctx, callableBenchTemplate);
+        bytes += benchRenderToEnd(*ctx, buffer, sizeof(buffer));
+    }
+    unsigned long elapsed = benchElapsedMicros(start);
+    delete ctx;
+    return elapsed;
+}
+
+void bench_callable_calls() {
+    CallableBenchSensor* sensor = &callableBenchSensor;
+    Callable<const char*()> label{[sensor] { return sensor->labels[sensor->calls++ & 3]; }};
+    std::function<const char*()> heapLabel = [sensor] { return sensor->labels[sensor->calls++ & 3]; };
+
+    const DynamicDataDescriptor plain = {callableBenchPlainGetter, nullptr, sensor};
+    const DynamicDataDescriptor callable = {label.function(), nullptr, label.context()};
+    // std::function has no function pointer to hand out, so it needs a forwarding getter of its own
+    const DynamicDataDescriptor forwarded = {[](void* userData) -> const char* {
+        return (*static_cast<std::function<const char*()>*>(userData))();
+    }, nullptr, &heapLabel};
+
+    struct Variant {
+        const char* name;
+        const DynamicDataDescriptor* descriptor;
+    };
+    const Variant variants[] = {
+        {"function pointer", &plain},
+        {"Callable", &callable},
+        {"std::function", &forwarded},
+    };
+
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        const DynamicDataDescriptor* volatile slot = variants[v].descriptor;
+        size_t bytes = 0;
+        benchReportOps("callable/getter call", variants[v].name, CALLABLE_BENCH_CALLS, runCallableBench(&slot, bytes));
+        TEST_ASSERT_TRUE(bytes > 0);
+        yield();
+    }
+
+    for (size_t v = 0; v < 2; ++v) {
+        size_t bytes = 0;
+        unsigned long elapsed = renderCallableBench(variants[v].descriptor, bytes);
+        TEST_ASSERT_TRUE(bytes > CALLABLE_BENCH_RENDERS * (sizeof(callableBenchTemplate) - 1 - 12));
+        benchReportRate("callable/render 4 getters", variants[v].name, CALLABLE_BENCH_RENDERS, "renders", elapsed);
+        yield();
+    }
+    TEST_ASSERT_TRUE(sensor->calls >= 3 * CALLABLE_BENCH_CALLS);
+}
@@ -0,0 +1,209 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <atomic>
+#include "../utils/bench_utils.h"
+
+#if !defined(ESP8266)
+  #include <thread>
+#endif
+
+static const uint16_t CONCURRENT_BENCH_NAMES = 64;
+static const size_t CONCURRENT_BENCH_LOOKUPS = 200000;
+#if defined(ESP8266)
+static const size_t CONCURRENT_BENCH_THREADS[] = {1};
+#else
+static const size_t CONCURRENT_BENCH_THREADS[] = {1, 2, 4};
+#endif
+
+static const char PROGMEM concurrentBenchValue[] = "value";
+static char concurrentBenchNames[CONCURRENT_BENCH_NAMES][DFTE_PLACEHOLDER_NAME_SIZE];
+
+// The alternative to snapshots: one registry behind a lock that readers and writers share
+struct LockedBenchRegistry {
+    PlaceholderRegistry registry;
+    std::atomic_flag lock;
+
+    LockedBenchRegistry() : registry(CONCURRENT_BENCH_NAMES) { lock.clear(); }
+
+    const PlaceholderEntry* getPlaceholder(const char* name) {
+        while (lock.test_and_set(std::memory_order_acquire)) {
+            yield();
+        }
+        const PlaceholderEntry* entry = registry.getPlaceholder(name);
+        lock.clear(std::memory_order_release);
+        return entry;
+    }
+};
+
+static size_t lookupLocked(LockedBenchRegistry& locked, size_t offset) {
+    size_t found = 0;
+    for (size_t i = 0; i < CONCURRENT_BENCH_LOOKUPS; ++i) {
+        found += locked.getPlaceholder(concurrentBenchNames[(i * 7 + offset) % CONCURRENT_BENCH_NAMES]) != nullptr;
+    }
+    return found;
+}
+
+static size_t lookupSnapshot(ConcurrentPlaceholderRegistry& registry, size_t offset) {
+    // One pin per "render" of 64 lookups, as a context would hold a reader for a page
+    size_t found = 0;
+    for (size_t i = 0; i < CONCURRENT_BENCH_LOOKUPS; i += CONCURRENT_BENCH_NAMES) {
+        ConcurrentPlaceholderRegistry::Reader reader(registry);
+        for (size_t j = i; j < i + CONCURRENT_BENCH_NAMES && j < CONCURRENT_BENCH_LOOKUPS; ++j) {
+            found += reader.getPlaceholder(concurrentBenchNames[(j * 7 + offset) % CONCURRENT_BENCH_NAMES]) != nullptr;
+        }
+    }
+    return found;
+}
+
+// Run `lookups` on `threads` threads at once; returns the wall time for all of them
+template <typename Lookups>
+static unsigned long runConcurrentBench(size_t threads, std::atomic<size_t>& found, Lookups lookups) {
+    unsigned long start = micros();
+#if defined(ESP8266)
+    found += lookups(0);
+#else
+    std::thread workers[4];
+    for (size_t t = 0; t < threads; ++t) {
+        workers[t] = std::thread([&found, &lookups, t]() { found += lookups(t); });
+    }
+    for (size_t t = 0; t < threads; ++t) {
+        workers[t].join();
+    }
+#endif
+    return benchElapsedMicros(start);
+}
+
+void bench_concurrent_registry_reads() {
+    LockedBenchRegistry locked;
+    ConcurrentPlaceholderRegistry registry(CONCURRENT_BENCH_NAMES);
+    for (uint16_t i = 0; i < CONCURRENT_BENCH_NAMES; ++i) {
+        snprintf(concurrentBenchNames[i], DFTE_PLACEHOLDER_NAME_SIZE, "%%SENSOR_%u%%", static_cast<unsigned>(i));
+        TEST_ASSERT_TRUE(locked.registry.registerProgmemData(concurrentBenchNames[i], concurrentBenchValue));
+    }
+    TEST_ASSERT_TRUE(registry.update([](PlaceholderRegistry& staging) {
+        for (uint16_t i = 0; i < CONCURRENT_BENCH_NAMES; ++i) {
+            if (!staging.registerProgmemData(concurrentBenchNames[i], concurrentBenchValue)) {
+                return false;
+            }
+        }
+        return true;
+    }));
+
+    for (size_t n = 0; n < sizeof(CONCURRENT_BENCH_THREADS) / sizeof(CONCURRENT_BENCH_THREADS[0]); ++n) {
+        size_t threads = CONCURRENT_BENCH_THREADS[n];
+        size_t expected = threads * CONCURRENT_BENCH_LOOKUPS;
+        String group = String("registry/concurrent reads threads=") + static_cast<unsigned>(threads);
+
+        std::atomic<size_t> found(0);
+        unsigned long elapsed = runConcurrentBench(threads, found, [&locked](size_t t) { return lookupLocked(locked, t); });
+        TEST_ASSERT_EQUAL(expected, found.load());
+        benchReportRate(group.c_str(), "locked registry", expected, "lookups", elapsed);
+        yield();
+
+        found = 0;
+        elapsed = runConcurrentBench(threads, found, [&registry](size_t t) { return lookupSnapshot(registry, t); });
+        TEST_ASSERT_EQUAL(expected, found.load());
+        benchReportRate(group.c_str(), "snapshot reader", expected, "lookups", elapsed);
+        yield();
+
+#if !defined(ESP8266)
+        // Same reads while a writer republishes every name as fast as it can
+        std::atomic<bool> reading(true);
+        size_t publishes = 0;
+        std::thread writer([&registry, &reading, &publishes]() {
+            while (reading) {
+                registry.registerProgmemData(concurrentBenchNames[publishes++ % CONCURRENT_BENCH_NAMES], concurrentBenchValue);
+                yield();
+            }
+        });
+        found = 0;
+        elapsed = runConcurrentBench(threads, found, [&registry](size_t t) { return lookupSnapshot(registry, t); });
+        reading = false;
+        writer.join();
+        TEST_ASSERT_EQUAL(expected, found.load());
+        benchReportRate(group.c_str(), "snapshot reader + writer", expected, "lookups", elapsed);
+#endif
+    }
+
+    registry.reclaim();
+    TEST_ASSERT_EQUAL(0, registry.getRetiredCount());
+}
+
+static const uint32_t CACHED_BENCH_GETTER_MICROS = 200;
+static const size_t CACHED_BENCH_RENDERS = 200;
+static const char PROGMEM cachedBenchTemplate[] =
+    "<tr><td>Stations</td><td>%BENCH_STATIONS%</td></tr><tr><td>Uptime</td><td>%BENCH_UPTIME%</td></tr>";
+static const char PROGMEM cachedBenchUptime[] = "3d 04:12:55";
+
+// Stands in for an I2C read or WiFi.softAPgetStationNum(): a fixed, blocking cost per call
+static const char* getSlowBenchStations() {
+    unsigned long start = micros();
+    while (micros() - start < CACHED_BENCH_GETTER_MICROS) {
+    }
+    return "3";
+}
+
+// Each thread has its own registry (registries are single-task); the cache is what the threads share
+static size_t renderCachedBench(CachedValue* cache, size_t renders) {
+    PlaceholderRegistry registry(4);
+    registry.registerProgmemData("%BENCH_UPTIME%", cachedBenchUptime);
+    if (cache) {
+        registry.registerCachedData("%BENCH_STATIONS%", cache);
+    } else {
+        registry.registerRamData("%BENCH_STATIONS%", getSlowBenchStations);
+    }
+
+    uint8_t buffer[128];
+    size_t bytes = 0;
+    for (size_t i = 0; i < renders; ++i) {
+        TemplateContext* ctx = new TemplateContext();
+        ctx->setRegistry(&registry);
+        TemplateRenderer::initializeContext(*ctx, cachedBenchTemplate);
+        bytes += benchRenderToEnd(*ctx, buffer, sizeof(buffer));
+        delete ctx;
+    }
+    return bytes;
+}
+
+void bench_cached_value_renders() {
+    static const size_t RENDER_BYTES = sizeof(cachedBenchTemplate) - 1 - strlen("%BENCH_STATIONS%%BENCH_UPTIME%") + 1 +
+                                       sizeof(cachedBenchUptime) - 1;
+    CachedValue cached(getSlowBenchStations, 1000);
+    CachedValue refreshedAhead(getSlowBenchStations, 1000, 500);
+
+    struct Variant {
+        const char* name;
+        CachedValue* cache;
+    };
+    const Variant variants[] = {{"uncached getter", nullptr}, {"ttl cache", &cached}, {"ttl cache + refresh-ahead", &refreshedAhead}};
+
+    for (size_t n = 0; n < sizeof(CONCURRENT_BENCH_THREADS) / sizeof(CONCURRENT_BENCH_THREADS[0]); ++n) {
+        size_t threads = CONCURRENT_BENCH_THREADS[n];
+        String group = String("render/cached getter threads=") + static_cast<unsigned>(threads);
+
+        for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+            CachedValue* cache = variants[v].cache;
+            if (cache) {
+                cache->invalidate();
+                cache->resetStats();
+            }
+            if (cache == &refreshedAhead) {
+                // loop() would do this between requests
+                refreshedAhead.refreshIfDue();
+            }
+
+            std::atomic<size_t> bytes(0);
+            unsigned long elapsed = runConcurrentBench(threads, bytes, [cache](size_t) {
+                return renderCachedBench(cache, CACHED_BENCH_RENDERS);
+            });
+            TEST_ASSERT_EQUAL(threads * CACHED_BENCH_RENDERS * RENDER_BYTES, bytes.load());
+            benchReportRate(group.c_str(), variants[v].name, threads * CACHED_BENCH_RENDERS, "renders", elapsed);
+            if (cache) {
+                Serial.println(String("[BENCH] ") + group + " " + variants[v].name + ": " + String(cache->getHits()) +
+                               " hits, " + String(cache->getMisses()) + " misses");
+            }
+            yield();
+        }
+    }
+}
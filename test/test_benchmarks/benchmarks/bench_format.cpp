@@ -0,0 +1,187 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "../utils/bench_utils.h"
+
+static const size_t FORMAT_BENCH_VALUES = 256;
+static const size_t FORMAT_BENCH_PASSES = 200;
+static const size_t TYPED_BENCH_RENDERS = 5000;
+
+static int32_t formatBenchInts[FORMAT_BENCH_VALUES];
+static float formatBenchFloats[FORMAT_BENCH_VALUES];
+
+static void fillFormatBenchValues() {
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < FORMAT_BENCH_VALUES; ++i) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        // Telemetry-sized numbers: RSSI, heap, counters, a few large ones
+        formatBenchInts[i] = static_cast<int32_t>(seed >> (i % 28)) * ((i & 1) ? -1 : 1);
+        formatBenchFloats[i] = static_cast<float>(static_cast<int32_t>(seed % 200000) - 100000) / 100.0f;
+    }
+}
+
+// Checksum so the compiler cannot drop the formatting
+static size_t formatBenchSink = 0;
+
+template <typename Format>
+static unsigned long runFormatBench(Format format) {
+    unsigned long start = micros();
+    for (size_t pass = 0; pass < FORMAT_BENCH_PASSES; ++pass) {
+        for (size_t i = 0; i < FORMAT_BENCH_VALUES; ++i) {
+            formatBenchSink += format(i);
+        }
+    }
+    return benchElapsedMicros(start);
+}
+
+void bench_format_numbers() {
+    fillFormatBenchValues();
+    const size_t ops = FORMAT_BENCH_PASSES * FORMAT_BENCH_VALUES;
+    char text[32];
+
+    benchReportOps("format/int32", "snprintf", ops, runFormatBench([&text](size_t i) {
+        return static_cast<size_t>(snprintf(text, sizeof(text), "%ld", static_cast<long>(formatBenchInts[i])));
+    }));
+    benchReportOps("format/int32", "String", ops, runFormatBench([](size_t i) {
+        return static_cast<size_t>(String(static_cast<long>(formatBenchInts[i])).length());
+    }));
+    benchReportOps("format/int32", "TypedValue", ops, runFormatBench([&text](size_t i) {
+        return TypedValue::formatSigned(formatBenchInts[i], text);
+    }));
+    yield();
+
+    benchReportOps("format/fixed 2dp", "snprintf", ops, runFormatBench([&text](size_t i) {
+        return static_cast<size_t>(snprintf(text, sizeof(text), "%.2f", static_cast<double>(formatBenchFloats[i])));
+    }));
+    benchReportOps("format/fixed 2dp", "String", ops, runFormatBench([](size_t i) {
+        return static_cast<size_t>(String(formatBenchFloats[i], 2).length());
+    }));
+    benchReportOps("format/fixed 2dp", "TypedValue", ops, runFormatBench([&text](size_t i) {
+        return TypedValue::formatFixed(formatBenchFloats[i], 2, text);
+    }));
+    yield();
+
+    benchReportOps("format/duration", "snprintf", ops, runFormatBench([&text](size_t i) {
+        uint32_t seconds = static_cast<uint32_t>(formatBenchInts[i]) % 864000u;
+        return static_cast<size_t>(snprintf(text, sizeof(text), "%02lu:%02lu:%02lu", static_cast<unsigned long>(seconds / 3600),
+                                            static_cast<unsigned long>(seconds / 60 % 60), static_cast<unsigned long>(seconds % 60)));
+    }));
+    benchReportOps("format/duration", "String", ops, runFormatBench([](size_t i) {
+        uint32_t seconds = static_cast<uint32_t>(formatBenchInts[i]) % 864000u;
+        return static_cast<size_t>((String(seconds) + "s").length());
+    }));
+    benchReportOps("format/duration", "TypedValue", ops, runFormatBench([&text](size_t i) {
+        return TypedValue::formatDuration(static_cast<uint32_t>(formatBenchInts[i]) % 864000u, text);
+    }));
+
+    TEST_ASSERT_TRUE(formatBenchSink > 0);
+}
+
+static const char PROGMEM typedBenchTemplate[] =
+    "<tr><td>Signal</td><td>%RSSI% dBm</td></tr><tr><td>Free heap</td><td>%HEAP% bytes</td></tr>"
+    "<tr><td>Temperature</td><td>%TEMP% &deg;C</td></tr><tr><td>Uptime</td><td>%UPTIME%</td></tr>";
+
+static int32_t typedBenchRssi = -61;
+static uint32_t typedBenchHeap = 38112;
+static float typedBenchTemp = 23.46f;
+static uint32_t typedBenchUptime = 93784;
+
+// What the examples did before typed values: a String per value, rebuilt on every request
+static String typedBenchRssiBuffer;
+static String typedBenchHeapBuffer;
+static String typedBenchTempBuffer;
+static String typedBenchUptimeBuffer;
+
+static void registerStringGetters(PlaceholderRegistry& registry) {
+    registry.registerRamData("%RSSI%", []() -> const char* {
+        typedBenchRssiBuffer = String(static_cast<long>(typedBenchRssi));
+        return typedBenchRssiBuffer.c_str();
+    });
+    registry.registerRamData("%HEAP%", []() -> const char* {
+        typedBenchHeapBuffer = String(static_cast<unsigned long>(typedBenchHeap));
+        return typedBenchHeapBuffer.c_str();
+    });
+    registry.registerRamData("%TEMP%", []() -> const char* {
+        typedBenchTempBuffer = String(typedBenchTemp, 1);
+        return typedBenchTempBuffer.c_str();
+    });
+    registry.registerRamData("%UPTIME%", []() -> const char* {
+        typedBenchUptimeBuffer = String(static_cast<unsigned long>(typedBenchUptime)) + "s";
+        return typedBenchUptimeBuffer.c_str();
+    });
+}
+
+static char typedBenchRssiText[12];
+static char typedBenchHeapText[12];
+static char typedBenchTempText[16];
+static char typedBenchUptimeText[16];
+
+static void registerSnprintfGetters(PlaceholderRegistry& registry) {
+    registry.registerRamData("%RSSI%", []() -> const char* {
+        snprintf(typedBenchRssiText, sizeof(typedBenchRssiText), "%ld", static_cast<long>(typedBenchRssi));
+        return typedBenchRssiText;
+    });
+    registry.registerRamData("%HEAP%", []() -> const char* {
+        snprintf(typedBenchHeapText, sizeof(typedBenchHeapText), "%lu", static_cast<unsigned long>(typedBenchHeap));
+        return typedBenchHeapText;
+    });
+    registry.registerRamData("%TEMP%", []() -> const char* {
+        snprintf(typedBenchTempText, sizeof(typedBenchTempText), "%.1f", static_cast<double>(typedBenchTemp));
+        return typedBenchTempText;
+    });
+    registry.registerRamData("%UPTIME%", []() -> const char* {
+        snprintf(typedBenchUptimeText, sizeof(typedBenchUptimeText), "%lus", static_cast<unsigned long>(typedBenchUptime));
+        return typedBenchUptimeText;
+    });
+}
+
+static const TypedValueDescriptor typedBenchRssiValue = TypedValue::ofInt32(&typedBenchRssi);
+static const TypedValueDescriptor typedBenchHeapValue = TypedValue::ofUint32(&typedBenchHeap);
+static const TypedValueDescriptor typedBenchTempValue = TypedValue::ofFixed(&typedBenchTemp, 1);
+static const TypedValueDescriptor typedBenchUptimeValue = TypedValue::ofDuration(&typedBenchUptime);
+
+static void registerTypedValues(PlaceholderRegistry& registry) {
+    registry.registerTypedValue("%RSSI%", &typedBenchRssiValue);
+    registry.registerTypedValue("%HEAP%", &typedBenchHeapValue);
+    registry.registerTypedValue("%TEMP%", &typedBenchTempValue);
+    registry.registerTypedValue("%UPTIME%", &typedBenchUptimeValue);
+}
+
+static unsigned long renderTypedBench(PlaceholderRegistry& registry, size_t& bytes) {
+    TemplateContext* ctx = new TemplateContext();
+    ctx->setRegistry(&registry);
+    uint8_t buffer[256];
+    bytes = 0;
+    unsigned long start = micros();
+    for (size_t i = 0; i < TYPED_BENCH_RENDERS; ++i) {
+        TemplateRenderer::initializeContext(*ctx, typedBenchTemplate);
+        bytes += benchRenderToEnd(*ctx, buffer, sizeof(buffer));
+    }
+    unsigned long elapsed = benchElapsedMicros(start);
+    delete ctx;
+    return elapsed;
+}
+
+void bench_typed_value_renders() {
+    struct Variant {
+        const char* name;
+        void (*registerPlaceholders)(PlaceholderRegistry&);
+    };
+    const Variant variants[] = {
+        {"String getters", registerStringGetters},
+        {"snprintf getters", registerSnprintfGetters},
+        {"typed values", registerTypedValues},
+    };
+
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        PlaceholderRegistry registry(4);
+        variants[v].registerPlaceholders(registry);
+        size_t bytes = 0;
+        unsigned long elapsed = renderTypedBench(registry, bytes);
+        TEST_ASSERT_TRUE(bytes > TYPED_BENCH_RENDERS * (sizeof(typedBenchTemplate) - 1 - 24));
+        benchReportRate("render/telemetry values", variants[v].name, TYPED_BENCH_RENDERS, "renders", elapsed);
+        yield();
+    }
+}
@@ -0,0 +1,120 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "../utils/bench_utils.h"
+
+// Rows rendered per size; small tables repeat so every size renders about as many rows in total
+static const size_t ITERATOR_BENCH_TOTAL_ROWS = 20000;
+static const size_t ITERATOR_BENCH_COLUMNS = 8;
+
+// Device table: every cell is an item placeholder, the page shell uses registry placeholders
+static const char PROGMEM iteratorRowTemplate[] =
+    "<tr><td>%DEV_ID%</td><td>%DEV_NAME%</td><td>%DEV_KIND%</td><td>%DEV_ROOM%</td>"
+    "<td>%DEV_STATE%</td><td>%DEV_VALUE%</td><td>%DEV_UNIT%</td><td>%DEV_SEEN%</td></tr>\n";
+static const char PROGMEM iteratorPage[] = "<html><head><style>%CSS%</style><title>%TITLE%</title></head>"
+                                           "<body><table>%DEVICES%</table>%FOOTER%</body></html>";
+static const char PROGMEM iteratorCss[] = "td{padding:2px}";
+
+static const char* const iteratorColumnNames[ITERATOR_BENCH_COLUMNS] = {
+    "%DEV_ID%", "%DEV_NAME%", "%DEV_KIND%", "%DEV_ROOM%", "%DEV_STATE%", "%DEV_VALUE%", "%DEV_UNIT%", "%DEV_SEEN%"
+};
+static const char PROGMEM iteratorColumnValues[ITERATOR_BENCH_COLUMNS][8] = {
+    "17", "lamp", "light", "hall", "on", "42", "%", "3s"
+};
+
+struct DeviceIteratorState {
+    size_t index;
+    size_t rows;
+    bool progmemRow;
+    char ramRow[sizeof(iteratorRowTemplate)];
+    PlaceholderEntry columns[ITERATOR_BENCH_COLUMNS];
+};
+
+static DeviceIteratorState deviceIteratorState;
+
+static void* openDeviceIterator(void* userData) {
+    DeviceIteratorState* state = static_cast<DeviceIteratorState*>(userData);
+    state->index = 0;
+    return state;
+}
+
+static IteratorStepResult nextDevice(void* handle, IteratorItemView& view) {
+    DeviceIteratorState* state = static_cast<DeviceIteratorState*>(handle);
+    if (state->index >= state->rows) {
+        return IteratorStepResult::COMPLETE;
+    }
+    state->index++;
+    view.templateData = state->progmemRow ? iteratorRowTemplate : state->ramRow;
+    view.templateLength = sizeof(iteratorRowTemplate) - 1;
+    view.templateIsProgmem = state->progmemRow;
+    view.placeholders = state->columns;
+    view.placeholderCount = ITERATOR_BENCH_COLUMNS;
+    return IteratorStepResult::ITEM_READY;
+}
+
+static const IteratorDescriptor deviceIterator = {openDeviceIterator, nextDevice, nullptr, &deviceIteratorState};
+
+static void benchDeviceRows(DeviceFrameworkPlaceholderRegistry& registry, size_t rows, bool progmemRow) {
+    uint8_t buffer[512];
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    deviceIteratorState.rows = rows;
+    deviceIteratorState.progmemRow = progmemRow;
+
+    size_t passes = ITERATOR_BENCH_TOTAL_ROWS / rows;
+    size_t bytes = 0;
+    unsigned long start = micros();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        TemplateRenderer::initializeContext(ctx, iteratorPage);
+        bytes += benchRenderToEnd(ctx, buffer, sizeof(buffer));
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Iterator benchmark should not error");
+        yield();
+    }
+    unsigned long elapsed = benchElapsedMicros(start);
+
+    String group = String("iterator/rows ") + (progmemRow ? "progmem" : "ram");
+    String variant = String("rows=") + String(static_cast<unsigned long>(rows));
+    benchReportRate(group.c_str(), variant.c_str(), passes * rows, "rows", elapsed);
+    benchReportThroughput(group.c_str(), variant.c_str(), bytes, elapsed);
+}
+
+void bench_iterator_rows() {
+    for (size_t column = 0; column < ITERATOR_BENCH_COLUMNS; ++column) {
+        PlaceholderEntry& entry = deviceIteratorState.columns[column];
+        entry.name = iteratorColumnNames[column];
+        entry.type = PlaceholderType::PROGMEM_DATA;
+        entry.data = iteratorColumnValues[column];
+        entry.getLength = DeviceFrameworkPlaceholderRegistry::getProgmemLength;
+    }
+    strcpy_P(deviceIteratorState.ramRow, iteratorRowTemplate);
+
+    // A populated shared registry, so registry misses are not artificially cheap
+    PlaceholderRegistry registry(32);
+    registry.registerProgmemData("%CSS%", iteratorCss);
+    registry.registerRamData("%TITLE%", []() -> const char* { return "Devices"; });
+    registry.registerRamData("%FOOTER%", []() -> const char* { return "<p>ok</p>"; });
+    registry.registerIterator("%DEVICES%", &deviceIterator);
+    static const char* const fillerNames[] = {
+        "%WIFI_SSID%", "%WIFI_RSSI%", "%IP_ADDR%", "%MAC_ADDR%", "%UPTIME%", "%HEAP_FREE%", "%FW_VERSION%",
+        "%HOSTNAME%", "%MQTT_HOST%", "%MQTT_STATE%", "%NTP_TIME%", "%TZ%", "%LANG%", "%THEME%"
+    };
+    for (const char* name : fillerNames) {
+        registry.registerRamData(name, []() -> const char* { return "x"; });
+    }
+
+    // Correctness guard: every cell resolves from the item scope
+    deviceIteratorState.rows = 1;
+    deviceIteratorState.progmemRow = false;
+    TemplateContext check;
+    check.setRegistry(&registry);
+    TemplateRenderer::initializeContext(check, iteratorPage);
+    String output = benchRenderToString(check, 256);
+    TEST_ASSERT_TRUE_MESSAGE(output.indexOf("<td>17</td><td>lamp</td>") >= 0, "Item placeholders should render");
+    TEST_ASSERT_TRUE_MESSAGE(output.indexOf("<td>3s</td></tr>") >= 0, "Last item placeholder should render");
+
+    const size_t sizes[] = {10, 100, 1000};
+    for (size_t rows : sizes) {
+        benchDeviceRows(registry, rows, false);
+        benchDeviceRows(registry, rows, true);
+    }
+}
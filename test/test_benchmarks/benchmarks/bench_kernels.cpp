@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "DeviceFrameworkTemplateKernels.h"
+#include "../utils/bench_utils.h"
+
+using Kernels = DeviceFrameworkTemplateKernels;
+
+static const size_t KERNEL_BENCH_BYTES = 4096;
+static const size_t KERNEL_BENCH_PASSES = 64;
+
+static uint8_t kernelBenchInput[KERNEL_BENCH_BYTES];
+static uint8_t kernelBenchOutput[KERNEL_BENCH_BYTES];
+
+// Walk the input the way the renderer does: one call per run between delimiters
+static size_t runFindByte(const Kernels::KernelSet& set) {
+    size_t hits = 0;
+    for (size_t pass = 0; pass < KERNEL_BENCH_PASSES; ++pass) {
+        size_t pos = 0;
+        while (pos < KERNEL_BENCH_BYTES) {
+            pos += set.findByte(kernelBenchInput + pos, KERNEL_BENCH_BYTES - pos, '%') + 1;
+            hits++;
+        }
+        yield();
+    }
+    return hits;
+}
+
+static size_t runCopyUntil(const Kernels::KernelSet& set) {
+    size_t copied = 0;
+    for (size_t pass = 0; pass < KERNEL_BENCH_PASSES; ++pass) {
+        size_t pos = 0;
+        while (pos < KERNEL_BENCH_BYTES) {
+            bool found = false;
+            size_t run = set.copyUntil(kernelBenchOutput + pos, kernelBenchInput + pos, KERNEL_BENCH_BYTES - pos, '%', found);
+            copied += run;
+            pos += run + (found ? 1 : 0);
+        }
+        yield();
+    }
+    return copied;
+}
+
+static size_t runNameSpan(const Kernels::KernelSet& set) {
+    size_t total = 0;
+    for (size_t pass = 0; pass < KERNEL_BENCH_PASSES; ++pass) {
+        total += set.nameSpan(kernelBenchInput, KERNEL_BENCH_BYTES);
+        yield();
+    }
+    return total;
+}
+
+typedef size_t (*KernelBenchRunner)(const Kernels::KernelSet& set);
+
+static void benchKernel(const char* group, KernelBenchRunner runner, size_t spacing) {
+    const Kernels::KernelSet* sets[8];
+    size_t count = Kernels::available(sets, 8);
+    benchFillTemplateText(kernelBenchInput, KERNEL_BENCH_BYTES, spacing);
+
+    size_t reference = runner(Kernels::scalar());
+    for (size_t s = 0; s < count; ++s) {
+        unsigned long start = micros();
+        size_t result = runner(*sets[s]);
+        unsigned long elapsed = benchElapsedMicros(start);
+        TEST_ASSERT_EQUAL_MESSAGE(reference, result, "Kernel variants should agree with scalar");
+        benchReportThroughput(group, sets[s]->name, KERNEL_BENCH_BYTES * KERNEL_BENCH_PASSES, elapsed);
+    }
+}
+
+// Long literal runs: one placeholder every 512 bytes (large PROGMEM layouts)
+void bench_kernels_find_byte() {
+    benchKernel("kernels/findByte(sparse)", runFindByte, 512);
+    benchKernel("kernels/findByte(dense)", runFindByte, 24);
+}
+
+void bench_kernels_copy_until() {
+    benchKernel("kernels/copyUntil(sparse)", runCopyUntil, 512);
+    benchKernel("kernels/copyUntil(dense)", runCopyUntil, 24);
+}
+
+// Worst case for nameSpan: the whole input is valid name characters
+void bench_kernels_name_span() {
+    const Kernels::KernelSet* sets[8];
+    size_t count = Kernels::available(sets, 8);
+    for (size_t i = 0; i < KERNEL_BENCH_BYTES; ++i) {
+        kernelBenchInput[i] = static_cast<uint8_t>("ABCDEFGHIJ_0123456789"[i % 21]);
+    }
+    for (size_t s = 0; s < count; ++s) {
+        unsigned long start = micros();
+        size_t result = runNameSpan(*sets[s]);
+        unsigned long elapsed = benchElapsedMicros(start);
+        TEST_ASSERT_EQUAL_MESSAGE(KERNEL_BENCH_BYTES * KERNEL_BENCH_PASSES, result, "Whole input should be a name span");
+        benchReportThroughput("kernels/nameSpan", sets[s]->name, KERNEL_BENCH_BYTES * KERNEL_BENCH_PASSES, elapsed);
+    }
+}
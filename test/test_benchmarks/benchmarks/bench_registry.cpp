@@ -0,0 +1,110 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "../utils/bench_utils.h"
+
+static const size_t REGISTRY_BENCH_LOOKUPS = 8192;
+static const uint16_t REGISTRY_BENCH_SIZES[] = {16, 64, 256, 1024, 4096};
+
+static const char PROGMEM registryBenchValue[] = "value";
+
+static void makeRegistryBenchName(char* name, size_t size, const char* prefix, size_t i) {
+    snprintf(name, size, "%%%s_%u%%", prefix, static_cast<unsigned>(i));
+}
+
+// The pre-index lookup: newest entry first, strcmp each name
+static const PlaceholderEntry* scanRegistryBench(const PlaceholderEntry* entries, int count, const char* name) {
+    for (int i = count - 1; i >= 0; i--) {
+        if (strcmp(entries[i].name, name) == 0) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+void bench_registry_lookup() {
+    for (size_t s = 0; s < sizeof(REGISTRY_BENCH_SIZES) / sizeof(REGISTRY_BENCH_SIZES[0]); ++s) {
+        uint16_t size = REGISTRY_BENCH_SIZES[s];
+        PlaceholderRegistry registry(size);
+        PlaceholderEntry* scanEntries = new PlaceholderEntry[size];
+        char (*hitNames)[DFTE_PLACEHOLDER_NAME_SIZE] = new char[size][DFTE_PLACEHOLDER_NAME_SIZE];
+        char (*missNames)[DFTE_PLACEHOLDER_NAME_SIZE] = new char[size][DFTE_PLACEHOLDER_NAME_SIZE];
+
+        for (uint16_t i = 0; i < size; ++i) {
+            makeRegistryBenchName(hitNames[i], DFTE_PLACEHOLDER_NAME_SIZE, "SENSOR", i);
+            makeRegistryBenchName(missNames[i], DFTE_PLACEHOLDER_NAME_SIZE, "SENSOX", i);
+            TEST_ASSERT_TRUE(registry.registerProgmemData(hitNames[i], registryBenchValue));
+            scanEntries[i].name = hitNames[i];
+        }
+
+        for (int miss = 0; miss < 2; ++miss) {
+            char (*names)[DFTE_PLACEHOLDER_NAME_SIZE] = miss ? missNames : hitNames;
+            size_t found = 0;
+
+            // Stride through the names so consecutive lookups do not share cache lines
+            unsigned long start = micros();
+            for (size_t i = 0; i < REGISTRY_BENCH_LOOKUPS; ++i) {
+                found += registry.getPlaceholder(names[(i * 7) % size]) != nullptr;
+            }
+            unsigned long indexed = benchElapsedMicros(start);
+            yield();
+
+            size_t scanFound = 0;
+            start = micros();
+            for (size_t i = 0; i < REGISTRY_BENCH_LOOKUPS; ++i) {
+                scanFound += scanRegistryBench(scanEntries, size, names[(i * 7) % size]) != nullptr;
+            }
+            unsigned long scanned = benchElapsedMicros(start);
+            yield();
+
+            TEST_ASSERT_EQUAL_MESSAGE(scanFound, found, "Index and scan should agree");
+            TEST_ASSERT_EQUAL_MESSAGE(miss ? 0 : REGISTRY_BENCH_LOOKUPS, found, "Hits should resolve and misses should not");
+
+            String group = String("registry/lookup n=") + size + (miss ? " miss" : " hit");
+            benchReportOps(group.c_str(), "index", REGISTRY_BENCH_LOOKUPS, indexed);
+            benchReportOps(group.c_str(), "scan", REGISTRY_BENCH_LOOKUPS, scanned);
+        }
+
+        delete[] missNames;
+        delete[] hitNames;
+        delete[] scanEntries;
+    }
+}
+
+// The entry layout before names moved out of line: 24-byte inline name, int-sized type, size_t length
+struct InlineNamePlaceholderEntry {
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+    int type;
+    const void* data;
+    PlaceholderLengthGetter getLength;
+    size_t cachedLength;
+    bool hasCachedLength;
+};
+
+void bench_registry_memory() {
+    static const uint16_t PLACEHOLDERS = 100;
+    static const char* const PREFIXES[] = {"SENSOR", "PAGE_TITLE", "WIFI_SIGNAL_DBM"};
+
+    for (size_t p = 0; p < sizeof(PREFIXES) / sizeof(PREFIXES[0]); ++p) {
+        PlaceholderRegistry registry(PLACEHOLDERS);
+        size_t empty = registry.getMemoryUsage();
+        size_t nameBytes = 0;
+        char name[DFTE_PLACEHOLDER_NAME_SIZE];
+        for (uint16_t i = 0; i < PLACEHOLDERS; ++i) {
+            makeRegistryBenchName(name, sizeof(name), PREFIXES[p], i);
+            nameBytes += strlen(name) + 1;
+            TEST_ASSERT_TRUE(registry.registerProgmemData(name, registryBenchValue));
+        }
+        TEST_ASSERT_TRUE_MESSAGE(registry.getMemoryUsage() >= empty + nameBytes, "Interned names should be accounted for");
+
+        // Same index in both layouts, so it is left out of the comparison
+        size_t indexBytes = empty - PLACEHOLDERS * sizeof(PlaceholderEntry);
+        String group = String("registry/memory n=100 avg name=") + (nameBytes / PLACEHOLDERS - 1) + "B";
+        benchReportBytes(group.c_str(), "inline names", PLACEHOLDERS * sizeof(InlineNamePlaceholderEntry));
+        benchReportBytes(group.c_str(), "interned names", registry.getMemoryUsage() - indexBytes);
+    }
+
+    // Iterator override rows share their name literals instead of copying them per item
+    benchReportBytes("iterator/override entry", "inline names", sizeof(InlineNamePlaceholderEntry));
+    benchReportBytes("iterator/override entry", "shared names", sizeof(PlaceholderEntry));
+}
@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "../templates/bench_templates.h"
+#include "../templates/bench_tokenized.h"
+#include "../utils/bench_utils.h"
+
+static const size_t RENDER_BENCH_PASSES = 2000;
+static const size_t RENDER_BENCH_CHUNK = 256;
+
+// Same bytes as templates/dashboard.html, for the interpreted variants
+static const char PROGMEM benchDashboardSource[] = R"DFTE(<!DOCTYPE html><html><head><meta charset="utf-8"><title>%TITLE% - Dashboard</title>
+<meta name="viewport" content="width=device-width, initial-scale=1"><link rel="stylesheet" href="/style.css"></head>
+<body class="%THEME%"><header><h1>%TITLE%</h1><nav><a href="/">Home</a> | <a href="/wifi">WiFi</a> | <a href="/mqtt">MQTT</a> | <a href="/system">System</a></nav></header>
+<main><section class="card"><h2>Network</h2><table><tr><td>SSID</td><td>%SSID%</td></tr><tr><td>IP address</td><td>%IP%</td></tr>
+<tr><td>Signal</td><td>%RSSI% dBm</td></tr><tr><td>MAC</td><td>%MAC%</td></tr></table></section>
+<section class="card"><h2>System</h2><table><tr><td>Uptime</td><td>%UPTIME%</td></tr><tr><td>Free heap</td><td>%HEAP% bytes</td></tr>
+<tr><td>Firmware</td><td>%VERSION%</td></tr><tr><td>Chip</td><td>%CHIP%</td></tr></table></section>
+<section class="card"><h2>Sensors</h2><p>Temperature: <b>%TEMP%</b> &deg;C</p><p>Humidity: <b>%HUMIDITY%</b> &#37;</p>
+<p>Last update: %UPTIME%</p></section></main>
+<footer><p>%FOOTER%</p><p>Rendered by DeviceFramework Template Engine. Refresh the page to update the values shown above.</p></footer>
+</body></html>
+)DFTE";
+
+static void registerDashboardPlaceholders(PlaceholderRegistry& registry) {
+    registry.registerRamData("%TITLE%", []() -> const char* { return "Greenhouse Node"; });
+    registry.registerRamData("%THEME%", []() -> const char* { return "dark"; });
+    registry.registerRamData("%SSID%", []() -> const char* { return "FarmNet"; });
+    registry.registerRamData("%IP%", []() -> const char* { return "192.168.1.42"; });
+    registry.registerRamData("%RSSI%", []() -> const char* { return "-61"; });
+    registry.registerRamData("%MAC%", []() -> const char* { return "A4:CF:12:9B:03:7E"; });
+    registry.registerRamData("%UPTIME%", []() -> const char* { return "3d 04:12:55"; });
+    registry.registerRamData("%HEAP%", []() -> const char* { return "38112"; });
+    registry.registerRamData("%VERSION%", []() -> const char* { return "1.4.2"; });
+    registry.registerRamData("%CHIP%", []() -> const char* { return "ESP8266EX"; });
+    registry.registerRamData("%TEMP%", []() -> const char* { return "23.5"; });
+    registry.registerRamData("%HUMIDITY%", []() -> const char* { return "61"; });
+    registry.registerRamData("%FOOTER%", []() -> const char* { return "DeviceFramework"; });
+}
+
+enum class DashboardVariant {
+    INTERPRETED,
+    PLANNED,
+    COMPILED,
+    TOKENIZED
+};
+
+static void initializeDashboard(TemplateContext& ctx, DashboardVariant variant, const char* ramCopy) {
+    switch (variant) {
+        case DashboardVariant::INTERPRETED:
+            TemplateRenderer::initializeContext(ctx, ramCopy, false);
+            break;
+        case DashboardVariant::PLANNED:
+            TemplateRenderer::initializeContext(ctx, benchDashboardSource);
+            break;
+        case DashboardVariant::COMPILED:
+            TemplateRenderer::initializeContext(ctx, dfte_bench_dashboard);
+            break;
+        case DashboardVariant::TOKENIZED:
+            TemplateRenderer::initializeContext(ctx, dfte_bench_tok_dashboard);
+            break;
+    }
+}
+
+// Interpreter (RAM copy, no plan), plan cache (PROGMEM), generated emitter and tokenized blob on the same page
+void bench_render_compiled_template() {
+    static const struct {
+        const char* name;
+        DashboardVariant variant;
+    } variants[] = {
+        {"interpreted", DashboardVariant::INTERPRETED},
+        {"planned", DashboardVariant::PLANNED},
+        {"compiled", DashboardVariant::COMPILED},
+        {"tokenized", DashboardVariant::TOKENIZED},
+    };
+
+    PlaceholderRegistry registry(16);
+    registerDashboardPlaceholders(registry);
+    // Root templates are never registered, so their token tables are bound explicitly
+    registry.bindTokenTable(&dfte_bench_dashboard.placeholders);
+    registry.bindTokenTable(dfte_bench_tok_dashboard.tokens);
+
+    char* ramCopy = new char[sizeof(benchDashboardSource)];
+    strcpy_P(ramCopy, benchDashboardSource);
+    uint8_t buffer[RENDER_BENCH_CHUNK];
+
+    String reference;
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+
+        // One checked pass so every variant is known to produce the same page
+        initializeDashboard(ctx, variants[v].variant, ramCopy);
+        String page = benchRenderToString(ctx, sizeof(buffer));
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Dashboard render should not error");
+        if (v == 0) {
+            reference = page;
+        }
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(reference.c_str(), page.c_str(), "Variants should render the same page");
+
+        size_t bytes = 0;
+        unsigned long start = micros();
+        for (size_t pass = 0; pass < RENDER_BENCH_PASSES; ++pass) {
+            initializeDashboard(ctx, variants[v].variant, ramCopy);
+            bytes += benchRenderToEnd(ctx, buffer, sizeof(buffer));
+            yield();
+        }
+        unsigned long elapsed = benchElapsedMicros(start);
+        TEST_ASSERT_EQUAL_MESSAGE(page.length() * RENDER_BENCH_PASSES, bytes, "Every pass should render the whole page");
+        benchReportThroughput("render/dashboard", variants[v].name, bytes, elapsed);
+    }
+
+    delete[] ramCopy;
+
+    Serial.println(String("[BENCH] render/dashboard flash: text ") + String(static_cast<unsigned long>(sizeof(benchDashboardSource) - 1)) +
+                   " bytes, tokenized " + String(static_cast<unsigned long>(dfte_bench_tok_dashboard.length)) + " bytes");
+}
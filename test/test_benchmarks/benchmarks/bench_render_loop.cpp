@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "../utils/bench_utils.h"
+
+static const size_t LOOP_BENCH_PASSES = 2000;
+static const size_t LOOP_BENCH_ROWS = 40;
+static const size_t LOOP_BENCH_ITEMS = 16;
+
+// Placeholder-dense page: short values, a nested template per row and an iterator, so the cost is
+// dominated by state-machine steps rather than byte copies
+static const char PROGMEM loopRowTemplate[] = "<tr><td>%NAME%</td><td>%VALUE%</td><td>%BADGE%</td></tr>\n";
+static const char PROGMEM loopBadgeTemplate[] = "<i class=\"%UNIT%\">%VALUE%</i>";
+static const char PROGMEM loopItemTemplate[] = "<li>%ITEM_LABEL%=%VALUE%</li>";
+static const char PROGMEM loopItemLabel[] = "sensor";
+
+struct LoopIteratorState {
+    size_t index;
+    PlaceholderEntry label;
+};
+
+static LoopIteratorState loopIteratorState;
+
+static void* openLoopIterator(void* userData) {
+    LoopIteratorState* state = static_cast<LoopIteratorState*>(userData);
+    state->index = 0;
+    return state;
+}
+
+static IteratorStepResult nextLoopItem(void* handle, IteratorItemView& view) {
+    LoopIteratorState* state = static_cast<LoopIteratorState*>(handle);
+    if (state->index >= LOOP_BENCH_ITEMS) {
+        return IteratorStepResult::COMPLETE;
+    }
+    state->index++;
+    view.templateData = loopItemTemplate;
+    view.templateLength = sizeof(loopItemTemplate) - 1;
+    view.templateIsProgmem = true;
+    view.placeholders = &state->label;
+    view.placeholderCount = 1;
+    return IteratorStepResult::ITEM_READY;
+}
+
+static const IteratorDescriptor loopIterator = {openLoopIterator, nextLoopItem, nullptr, &loopIteratorState};
+
+static String buildLoopPage() {
+    String page = "<table>\n";
+    for (size_t i = 0; i < LOOP_BENCH_ROWS; ++i) {
+        page += "%ROW%";
+    }
+    page += "</table><ul>%ITEMS%</ul>";
+    return page;
+}
+
+static void benchLoop(const char* variant, DeviceFrameworkPlaceholderRegistry& registry, const char* page, size_t chunkSize) {
+    uint8_t buffer[512];
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+
+    size_t bytes = 0;
+    size_t steps = 0;
+    unsigned long start = micros();
+    for (size_t pass = 0; pass < LOOP_BENCH_PASSES; ++pass) {
+        TemplateRenderer::initializeContext(ctx, page, false);
+        bytes += benchRenderToEnd(ctx, buffer, chunkSize);
+        steps += ctx.totalSteps;
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Render loop benchmark should not error");
+        yield();
+    }
+    unsigned long elapsed = benchElapsedMicros(start);
+
+    String group = String("render/loop ") + variant;
+    benchReportOps(group.c_str(), "steps", steps, elapsed);
+    benchReportThroughput(group.c_str(), "bytes", bytes, elapsed);
+}
+
+void bench_render_loop() {
+    PlaceholderEntry& label = loopIteratorState.label;
+    label.name = "%ITEM_LABEL%";
+    label.type = PlaceholderType::PROGMEM_DATA;
+    label.data = loopItemLabel;
+    label.getLength = DeviceFrameworkPlaceholderRegistry::getProgmemLength;
+
+    PlaceholderRegistry registry(8);
+    registry.registerRamData("%NAME%", []() -> const char* { return "temp"; });
+    registry.registerRamData("%VALUE%", []() -> const char* { return "21.5"; });
+    registry.registerRamData("%UNIT%", []() -> const char* { return "c"; });
+    registry.registerProgmemTemplate("%ROW%", loopRowTemplate);
+    registry.registerProgmemTemplate("%BADGE%", loopBadgeTemplate);
+    registry.registerIterator("%ITEMS%", &loopIterator);
+
+    String page = buildLoopPage();
+    benchLoop("chunk=64", registry, page.c_str(), 64);
+    benchLoop("chunk=512", registry, page.c_str(), 512);
+}
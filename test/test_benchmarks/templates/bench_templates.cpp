@@ -0,0 +1,173 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#include "bench_templates.h"
+
+// dashboard.html
+static const char dfte_bench_dashboard_text[] PROGMEM =
+    "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title> - Dashboard</title>\n"
+    "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\"><link rel=\"stylesheet\" hre"
+    "f=\"/style.css\"></head>\n"
+    "<body class=\"\"><header><h1></h1><nav><a href=\"/\">Home</a> | <a href=\"/wifi\">WiFi</a> | <a href"
+    "=\"/mqtt\">MQTT</a> | <a href=\"/system\">System</a></nav></header>\n"
+    "<main><section class=\"card\"><h2>Network</h2><table><tr><td>SSID</td><td></td></tr><tr><td>IP addre"
+    "ss</td><td></td></tr>\n"
+    "<tr><td>Signal</td><td> dBm</td></tr><tr><td>MAC</td><td></td></tr></table></section>\n"
+    "<section class=\"card\"><h2>System</h2><table><tr><td>Uptime</td><td></td></tr><tr><td>Free heap</td"
+    "><td> bytes</td></tr>\n"
+    "<tr><td>Firmware</td><td></td></tr><tr><td>Chip</td><td></td></tr></table></section>\n"
+    "<section class=\"card\"><h2>Sensors</h2><p>Temperature: <b></b> &deg;C</p><p>Humidity: <b></b> &#37;"
+    "</p>\n"
+    "<p>Last update: </p></section></main>\n"
+    "<footer><p></p><p>Rendered by DeviceFramework Template Engine. Refresh the page to update the values"
+    " shown above.</p></footer>\n"
+    "</body></html>\n";
+static const char dfte_bench_dashboard_name0[] PROGMEM = "%TITLE%";
+static const char dfte_bench_dashboard_name1[] PROGMEM = "%THEME%";
+static const char dfte_bench_dashboard_name2[] PROGMEM = "%SSID%";
+static const char dfte_bench_dashboard_name3[] PROGMEM = "%IP%";
+static const char dfte_bench_dashboard_name4[] PROGMEM = "%RSSI%";
+static const char dfte_bench_dashboard_name5[] PROGMEM = "%MAC%";
+static const char dfte_bench_dashboard_name6[] PROGMEM = "%UPTIME%";
+static const char dfte_bench_dashboard_name7[] PROGMEM = "%HEAP%";
+static const char dfte_bench_dashboard_name8[] PROGMEM = "%VERSION%";
+static const char dfte_bench_dashboard_name9[] PROGMEM = "%CHIP%";
+static const char dfte_bench_dashboard_name10[] PROGMEM = "%TEMP%";
+static const char dfte_bench_dashboard_name11[] PROGMEM = "%HUMIDITY%";
+static const char dfte_bench_dashboard_name12[] PROGMEM = "%FOOTER%";
+static const char* const dfte_bench_dashboard_names[] PROGMEM = {
+    dfte_bench_dashboard_name0,
+    dfte_bench_dashboard_name1,
+    dfte_bench_dashboard_name2,
+    dfte_bench_dashboard_name3,
+    dfte_bench_dashboard_name4,
+    dfte_bench_dashboard_name5,
+    dfte_bench_dashboard_name6,
+    dfte_bench_dashboard_name7,
+    dfte_bench_dashboard_name8,
+    dfte_bench_dashboard_name9,
+    dfte_bench_dashboard_name10,
+    dfte_bench_dashboard_name11,
+    dfte_bench_dashboard_name12,
+};
+
+static size_t dfte_bench_dashboard_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {
+    size_t written = 0;
+    placeholderIndex = -1;
+    switch (cursor.resumePoint) {
+        case 0:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 0, 56, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 1;
+            placeholderIndex = 0;  // %TITLE%
+            return written;
+        case 1:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 56, 151, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 2;
+            placeholderIndex = 1;  // %THEME%
+            return written;
+        case 2:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 207, 14, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 3;
+            placeholderIndex = 0;  // %TITLE%
+            return written;
+        case 3:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 221, 203, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 4;
+            placeholderIndex = 2;  // %SSID%
+            return written;
+        case 4:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 424, 37, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 5;
+            placeholderIndex = 3;  // %IP%
+            return written;
+        case 5:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 461, 34, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 6;
+            placeholderIndex = 4;  // %RSSI%
+            return written;
+        case 6:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 495, 34, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 7;
+            placeholderIndex = 5;  // %MAC%
+            return written;
+        case 7:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 529, 96, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 8;
+            placeholderIndex = 6;  // %UPTIME%
+            return written;
+        case 8:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 625, 36, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 9;
+            placeholderIndex = 7;  // %HEAP%
+            return written;
+        case 9:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 661, 42, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 10;
+            placeholderIndex = 8;  // %VERSION%
+            return written;
+        case 10:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 703, 31, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 11;
+            placeholderIndex = 9;  // %CHIP%
+            return written;
+        case 11:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 734, 86, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 12;
+            placeholderIndex = 10;  // %TEMP%
+            return written;
+        case 12:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 820, 31, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 13;
+            placeholderIndex = 11;  // %HUMIDITY%
+            return written;
+        case 13:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 851, 31, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 14;
+            placeholderIndex = 6;  // %UPTIME%
+            return written;
+        case 14:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 882, 33, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 15;
+            placeholderIndex = 12;  // %FOOTER%
+            return written;
+        case 15:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_bench_dashboard_text + 915, 131, buffer, maxLen, written)) {
+                return written;
+            }
+            break;
+        default:
+            break;
+    }
+    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+    return written;
+}
+
+const CompiledTemplate dfte_bench_dashboard = {dfte_bench_dashboard_emit, {dfte_bench_dashboard_names, 13}};
@@ -0,0 +1,9 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#ifndef BENCH_TEMPLATES_H
+#define BENCH_TEMPLATES_H
+
+#include <TemplateEngine.h>
+
+extern const CompiledTemplate dfte_bench_dashboard;
+
+#endif // BENCH_TEMPLATES_H
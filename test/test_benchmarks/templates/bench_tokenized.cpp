@@ -0,0 +1,54 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#include "bench_tokenized.h"
+
+static const char dfte_bench_tok_tokens_name0[] PROGMEM = "%TITLE%";
+static const char dfte_bench_tok_tokens_name1[] PROGMEM = "%THEME%";
+static const char dfte_bench_tok_tokens_name2[] PROGMEM = "%SSID%";
+static const char dfte_bench_tok_tokens_name3[] PROGMEM = "%IP%";
+static const char dfte_bench_tok_tokens_name4[] PROGMEM = "%RSSI%";
+static const char dfte_bench_tok_tokens_name5[] PROGMEM = "%MAC%";
+static const char dfte_bench_tok_tokens_name6[] PROGMEM = "%UPTIME%";
+static const char dfte_bench_tok_tokens_name7[] PROGMEM = "%HEAP%";
+static const char dfte_bench_tok_tokens_name8[] PROGMEM = "%VERSION%";
+static const char dfte_bench_tok_tokens_name9[] PROGMEM = "%CHIP%";
+static const char dfte_bench_tok_tokens_name10[] PROGMEM = "%TEMP%";
+static const char dfte_bench_tok_tokens_name11[] PROGMEM = "%HUMIDITY%";
+static const char dfte_bench_tok_tokens_name12[] PROGMEM = "%FOOTER%";
+static const char* const dfte_bench_tok_tokens_names[] PROGMEM = {
+    dfte_bench_tok_tokens_name0,
+    dfte_bench_tok_tokens_name1,
+    dfte_bench_tok_tokens_name2,
+    dfte_bench_tok_tokens_name3,
+    dfte_bench_tok_tokens_name4,
+    dfte_bench_tok_tokens_name5,
+    dfte_bench_tok_tokens_name6,
+    dfte_bench_tok_tokens_name7,
+    dfte_bench_tok_tokens_name8,
+    dfte_bench_tok_tokens_name9,
+    dfte_bench_tok_tokens_name10,
+    dfte_bench_tok_tokens_name11,
+    dfte_bench_tok_tokens_name12,
+};
+const TokenTable dfte_bench_tok_tokens = {dfte_bench_tok_tokens_names, 13};
+
+// dashboard.html
+static const char dfte_bench_tok_dashboard_data[] PROGMEM =
+    "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>\000\000 - Dashboard</title>\n"
+    "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\"><link rel=\"stylesheet\" hre"
+    "f=\"/style.css\"></head>\n"
+    "<body class=\"\000\001\"><header><h1>\000\000</h1><nav><a href=\"/\">Home</a> | <a href=\"/wifi\">Wi"
+    "Fi</a> | <a href=\"/mqtt\">MQTT</a> | <a href=\"/system\">System</a></nav></header>\n"
+    "<main><section class=\"card\"><h2>Network</h2><table><tr><td>SSID</td><td>\000\002</td></tr><tr><td>"
+    "IP address</td><td>\000\003</td></tr>\n"
+    "<tr><td>Signal</td><td>\000\004 dBm</td></tr><tr><td>MAC</td><td>\000\005</td></tr></table></section"
+    ">\n"
+    "<section class=\"card\"><h2>System</h2><table><tr><td>Uptime</td><td>\000\006</td></tr><tr><td>Free "
+    "heap</td><td>\000\007 bytes</td></tr>\n"
+    "<tr><td>Firmware</td><td>\000\010</td></tr><tr><td>Chip</td><td>\000\t</td></tr></table></section>\n"
+    "<section class=\"card\"><h2>Sensors</h2><p>Temperature: <b>\000\n"
+    "</b> &deg;C</p><p>Humidity: <b>\000\013</b> &#37;</p>\n"
+    "<p>Last update: \000\006</p></section></main>\n"
+    "<footer><p>\000\014</p><p>Rendered by DeviceFramework Template Engine. Refresh the page to update th"
+    "e values shown above.</p></footer>\n"
+    "</body></html>\n";
+const TokenizedTemplate dfte_bench_tok_dashboard = {dfte_bench_tok_dashboard_data, 1076, &dfte_bench_tok_tokens};
@@ -0,0 +1,10 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#ifndef BENCH_TOKENIZED_H
+#define BENCH_TOKENIZED_H
+
+#include <TemplateEngine.h>
+
+extern const TokenTable dfte_bench_tok_tokens;
+extern const TokenizedTemplate dfte_bench_tok_dashboard;
+
+#endif // BENCH_TOKENIZED_H
@@ -0,0 +1,73 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "test_main.h"
+#include "utils/bench_utils.h"
+
+// Benchmark case array
+// Results are printed as "[BENCH] ..." lines; assertions only guard correctness
+BenchCase benches[] = {
+    // Group 1: Kernel Benchmarks
+    BENCH_ENTRY(bench_kernels_find_byte),
+    BENCH_ENTRY(bench_kernels_copy_until),
+    BENCH_ENTRY(bench_kernels_name_span),
+
+    // Group 2: Render Benchmarks
+    BENCH_ENTRY(bench_render_compiled_template),
+    BENCH_ENTRY(bench_render_loop),
+    BENCH_ENTRY(bench_iterator_rows),
+    BENCH_ENTRY(bench_format_numbers),
+    BENCH_ENTRY(bench_typed_value_renders),
+    BENCH_ENTRY(bench_callable_calls),
+
+    // Group 3: Registry Benchmarks
+    BENCH_ENTRY(bench_registry_lookup),
+    BENCH_ENTRY(bench_registry_memory),
+    BENCH_ENTRY(bench_concurrent_registry_reads),
+    BENCH_ENTRY(bench_cached_value_renders),
+};
+
+const size_t BENCH_COUNT = sizeof(benches) / sizeof(BenchCase);
+
+// Benchmark state variables
+size_t next_index = 0;
+bool begun = false;
+
+void setUp(void) {
+    // No per-benchmark setup needed
+}
+
+void tearDown(void) {
+    // No per-benchmark teardown needed
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000); // Give time for serial to initialize
+
+    Serial.println("\n[BENCH] =============================================");
+    Serial.println("[BENCH] === DeviceFrameworkTemplateEngine Benchmarks ===");
+    Serial.println("[BENCH] =============================================");
+
+    UNITY_BEGIN();
+    begun = true;
+}
+
+void loop() {
+    // Run one benchmark per loop so the watchdog gets serviced in between
+    if (begun && next_index < BENCH_COUNT) {
+        BenchCase& b = benches[next_index];
+        Serial.print("\n[BENCH] ==== Running benchmark: ");
+        Serial.print(b.name);
+        Serial.println(" ====");
+        UnityDefaultTestRun(b.fn, b.name, b.line);
+        next_index++;
+        return;
+    }
+
+    if (begun && next_index >= BENCH_COUNT) {
+        Serial.println("\n[BENCH] === All benchmarks completed ===");
+        UNITY_END();
+        begun = false;
+    }
+}
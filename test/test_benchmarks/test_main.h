@@ -0,0 +1,27 @@
+#ifndef BENCH_MAIN_H
+#define BENCH_MAIN_H
+
+#include <Arduino.h>
+#include "utils/bench_utils.h"
+
+// Benchmark function declarations
+// Group 1: Kernel Benchmarks
+void bench_kernels_find_byte();
+void bench_kernels_copy_until();
+void bench_kernels_name_span();
+
+// Group 2: Render Benchmarks
+void bench_render_compiled_template();
+void bench_render_loop();
+void bench_iterator_rows();
+void bench_format_numbers();
+void bench_typed_value_renders();
+void bench_callable_calls();
+
+// Group 3: Registry Benchmarks
+void bench_registry_lookup();
+void bench_registry_memory();
+void bench_concurrent_registry_reads();
+void bench_cached_value_renders();
+
+#endif // BENCH_MAIN_H
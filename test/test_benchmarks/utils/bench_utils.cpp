@@ -0,0 +1,57 @@
+#include "bench_utils.h"
+
+void benchReportThroughput(const char* group, const char* variant, size_t bytes, unsigned long elapsedMicros) {
+    unsigned long micros = elapsedMicros ? elapsedMicros : 1;
+    float mbPerSec = static_cast<float>(bytes) / static_cast<float>(micros);
+    Serial.println(String("[BENCH] ") + group + " " + variant + ": " + String(static_cast<unsigned long>(bytes)) +
+                   " bytes in " + String(elapsedMicros) + " us (" + String(mbPerSec, 2) + " MB/s)");
+}
+
+void benchReportOps(const char* group, const char* variant, size_t ops, unsigned long elapsedMicros) {
+    float nsPerOp = ops ? (static_cast<float>(elapsedMicros) * 1000.0f) / static_cast<float>(ops) : 0.0f;
+    Serial.println(String("[BENCH] ") + group + " " + variant + ": " + String(static_cast<unsigned long>(ops)) +
+                   " ops in " + String(elapsedMicros) + " us (" + String(nsPerOp, 1) + " ns/op)");
+}
+
+void benchReportRate(const char* group, const char* variant, size_t count, const char* unit, unsigned long elapsedMicros) {
+    unsigned long micros = elapsedMicros ? elapsedMicros : 1;
+    float perSec = static_cast<float>(count) * 1000000.0f / static_cast<float>(micros);
+    Serial.println(String("[BENCH] ") + group + " " + variant + ": " + String(static_cast<unsigned long>(count)) + " " + unit +
+                   " in " + String(elapsedMicros) + " us (" + String(perSec, 0) + " " + unit + "/s)");
+}
+
+void benchReportBytes(const char* group, const char* variant, size_t bytes) {
+    Serial.println(String("[BENCH] ") + group + " " + variant + ": " + String(static_cast<unsigned long>(bytes)) + " bytes");
+}
+
+void benchFillTemplateText(uint8_t* data, size_t len, size_t spacing) {
+    static const char filler[] = "<div class=\"card\"><span>Sensor</span><b>value</b></div>\n";
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = static_cast<uint8_t>(filler[i % (sizeof(filler) - 1)]);
+        if (spacing && i % spacing == spacing - 1) {
+            data[i] = '%';
+        }
+    }
+}
+
+size_t benchRenderToEnd(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t chunkSize) {
+    size_t total = 0;
+    while (!DeviceFrameworkTemplateRenderer::isComplete(ctx)) {
+        total += DeviceFrameworkTemplateRenderer::renderNextChunk(ctx, buffer, chunkSize);
+    }
+    return total;
+}
+
+String benchRenderToString(DeviceFrameworkTemplateContext& ctx, size_t chunkSize) {
+    String output;
+    uint8_t buffer[257];
+    if (chunkSize > sizeof(buffer) - 1) {
+        chunkSize = sizeof(buffer) - 1;
+    }
+    while (!DeviceFrameworkTemplateRenderer::isComplete(ctx)) {
+        size_t written = DeviceFrameworkTemplateRenderer::renderNextChunk(ctx, buffer, chunkSize);
+        buffer[written] = '\0';
+        output += reinterpret_cast<const char*>(buffer);
+    }
+    return output;
+}
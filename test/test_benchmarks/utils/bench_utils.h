@@ -0,0 +1,44 @@
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+#include <Arduino.h>
+#include <TemplateEngine.h>
+
+// Benchmark structure and state management (mirrors the template engine test runner)
+using BenchFn = void(*)();
+
+struct BenchCase {
+    const char* name;
+    BenchFn fn;
+    uint16_t line;
+};
+
+#define BENCH_ENTRY(fn) { #fn, fn, __LINE__ }
+
+// Elapsed time helper that tolerates micros() wrap-around
+inline unsigned long benchElapsedMicros(unsigned long start) {
+    return micros() - start;
+}
+
+// Print one result line: "[BENCH] <group> <variant>: <bytes> bytes in <us> us (<MB/s>)"
+void benchReportThroughput(const char* group, const char* variant, size_t bytes, unsigned long elapsedMicros);
+
+// Print one result line: "[BENCH] <group> <variant>: <ops> ops in <us> us (<ns/op>)"
+void benchReportOps(const char* group, const char* variant, size_t ops, unsigned long elapsedMicros);
+
+// Print one result line: "[BENCH] <group> <variant>: <count> <unit> in <us> us (<count/s> <unit>/s)"
+void benchReportRate(const char* group, const char* variant, size_t count, const char* unit, unsigned long elapsedMicros);
+
+// Print one result line: "[BENCH] <group> <variant>: <bytes> bytes"
+void benchReportBytes(const char* group, const char* variant, size_t bytes);
+
+// Fill a buffer with HTML-like filler and a '%' roughly every `spacing` bytes (0 = none)
+void benchFillTemplateText(uint8_t* data, size_t len, size_t spacing);
+
+// Render an initialized context to completion in chunkSize pieces; returns total bytes
+size_t benchRenderToEnd(DeviceFrameworkTemplateContext& ctx, uint8_t* buffer, size_t chunkSize);
+
+// Render an initialized context to completion and collect the output (for correctness checks)
+String benchRenderToString(DeviceFrameworkTemplateContext& ctx, size_t chunkSize);
+
+#endif // BENCH_UTILS_H
@@ -0,0 +1,156 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#include "compiled_templates.h"
+
+// compiled_card.html
+static const char dfte_test_compiled_card_text[] PROGMEM =
+    "<div class=\"card\"></div>";
+static const char dfte_test_compiled_card_name0[] PROGMEM = "%CONTENT%";
+static const char* const dfte_test_compiled_card_names[] PROGMEM = {
+    dfte_test_compiled_card_name0,
+};
+
+static size_t dfte_test_compiled_card_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {
+    size_t written = 0;
+    placeholderIndex = -1;
+    switch (cursor.resumePoint) {
+        case 0:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_card_text + 0, 18, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 1;
+            placeholderIndex = 0;  // %CONTENT%
+            return written;
+        case 1:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_card_text + 18, 6, buffer, maxLen, written)) {
+                return written;
+            }
+            break;
+        default:
+            break;
+    }
+    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+    return written;
+}
+
+const CompiledTemplate dfte_test_compiled_card = {dfte_test_compiled_card_emit, {dfte_test_compiled_card_names, 1}};
+
+// compiled_empty.html
+static const char dfte_test_compiled_empty_text[] PROGMEM =
+    "";
+
+static size_t dfte_test_compiled_empty_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {
+    size_t written = 0;
+    placeholderIndex = -1;
+    (void)buffer;
+    (void)maxLen;
+    switch (cursor.resumePoint) {
+        default:
+            break;
+    }
+    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+    return written;
+}
+
+const CompiledTemplate dfte_test_compiled_empty = {dfte_test_compiled_empty_emit, {nullptr, 0}};
+
+// compiled_footer.html
+static const char dfte_test_compiled_footer_text[] PROGMEM =
+    "<footer>";
+static const char dfte_test_compiled_footer_name0[] PROGMEM = "%CARD%";
+static const char* const dfte_test_compiled_footer_names[] PROGMEM = {
+    dfte_test_compiled_footer_name0,
+};
+
+static size_t dfte_test_compiled_footer_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {
+    size_t written = 0;
+    placeholderIndex = -1;
+    switch (cursor.resumePoint) {
+        case 0:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_footer_text + 0, 8, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+            placeholderIndex = 0;  // %CARD%
+            return written;
+        default:
+            break;
+    }
+    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+    return written;
+}
+
+const CompiledTemplate dfte_test_compiled_footer = {dfte_test_compiled_footer_emit, {dfte_test_compiled_footer_names, 1}};
+
+// compiled_layout.html
+static const char dfte_test_compiled_layout_text[] PROGMEM =
+    "<html><head><title></title></head>\n"
+    "<body class=\"main\"> 100 done\?\? <p></p></body></html>\n";
+static const char dfte_test_compiled_layout_name0[] PROGMEM = "%TITLE%";
+static const char dfte_test_compiled_layout_name1[] PROGMEM = "%CONTENT%";
+static const char dfte_test_compiled_layout_name2[] PROGMEM = "%%";
+static const char dfte_test_compiled_layout_name3[] PROGMEM = "%CARD%";
+static const char dfte_test_compiled_layout_name4[] PROGMEM = "%MISSING%";
+static const char* const dfte_test_compiled_layout_names[] PROGMEM = {
+    dfte_test_compiled_layout_name0,
+    dfte_test_compiled_layout_name1,
+    dfte_test_compiled_layout_name2,
+    dfte_test_compiled_layout_name3,
+    dfte_test_compiled_layout_name4,
+};
+
+static size_t dfte_test_compiled_layout_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {
+    size_t written = 0;
+    placeholderIndex = -1;
+    switch (cursor.resumePoint) {
+        case 0:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 0, 19, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 1;
+            placeholderIndex = 0;  // %TITLE%
+            return written;
+        case 1:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 19, 35, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 2;
+            placeholderIndex = 1;  // %CONTENT%
+            return written;
+        case 2:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 54, 4, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 3;
+            placeholderIndex = 2;  // %%
+            return written;
+        case 3:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 58, 8, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 4;
+            placeholderIndex = 3;  // %CARD%
+            return written;
+        case 4:
+            cursor.resumePoint = 5;
+            placeholderIndex = 0;  // %TITLE%
+            return written;
+        case 5:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 66, 3, buffer, maxLen, written)) {
+                return written;
+            }
+            cursor.resumePoint = 6;
+            placeholderIndex = 4;  // %MISSING%
+            return written;
+        case 6:
+            if (!dfte::emitCompiledLiteral(cursor, dfte_test_compiled_layout_text + 69, 19, buffer, maxLen, written)) {
+                return written;
+            }
+            break;
+        default:
+            break;
+    }
+    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;
+    return written;
+}
+
+const CompiledTemplate dfte_test_compiled_layout = {dfte_test_compiled_layout_emit, {dfte_test_compiled_layout_names, 5}};
@@ -0,0 +1,12 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#ifndef COMPILED_TEMPLATES_H
+#define COMPILED_TEMPLATES_H
+
+#include <TemplateEngine.h>
+
+extern const CompiledTemplate dfte_test_compiled_card;
+extern const CompiledTemplate dfte_test_compiled_empty;
+extern const CompiledTemplate dfte_test_compiled_footer;
+extern const CompiledTemplate dfte_test_compiled_layout;
+
+#endif // COMPILED_TEMPLATES_H
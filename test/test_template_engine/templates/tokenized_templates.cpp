@@ -0,0 +1,32 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#include "tokenized_templates.h"
+
+static const char dfte_test_tok_tokens_name0[] PROGMEM = "%CONTENT%";
+static const char dfte_test_tok_tokens_name1[] PROGMEM = "%TITLE%";
+static const char dfte_test_tok_tokens_name2[] PROGMEM = "%%";
+static const char dfte_test_tok_tokens_name3[] PROGMEM = "%CARD%";
+static const char dfte_test_tok_tokens_name4[] PROGMEM = "%MISSING%";
+static const char* const dfte_test_tok_tokens_names[] PROGMEM = {
+    dfte_test_tok_tokens_name0,
+    dfte_test_tok_tokens_name1,
+    dfte_test_tok_tokens_name2,
+    dfte_test_tok_tokens_name3,
+    dfte_test_tok_tokens_name4,
+};
+const TokenTable dfte_test_tok_tokens = {dfte_test_tok_tokens_names, 5};
+
+// compiled_card.html
+static const char dfte_test_tok_compiled_card_data[] PROGMEM =
+    "<div class=\"card\">\000\000</div>";
+const TokenizedTemplate dfte_test_tok_compiled_card = {dfte_test_tok_compiled_card_data, 26, &dfte_test_tok_tokens};
+
+// compiled_empty.html
+static const char dfte_test_tok_compiled_empty_data[] PROGMEM =
+    "";
+const TokenizedTemplate dfte_test_tok_compiled_empty = {dfte_test_tok_compiled_empty_data, 0, &dfte_test_tok_tokens};
+
+// compiled_layout.html
+static const char dfte_test_tok_compiled_layout_data[] PROGMEM =
+    "<html><head><title>\000\001</title></head>\n"
+    "<body class=\"main\">\000\000 100\000\002 done\?\? \000\003\000\001<p>\000\004</p></body></html>\n";
+const TokenizedTemplate dfte_test_tok_compiled_layout = {dfte_test_tok_compiled_layout_data, 100, &dfte_test_tok_tokens};
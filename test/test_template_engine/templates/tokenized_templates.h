@@ -0,0 +1,12 @@
+// Generated by tools/dfte_template_compiler.py - do not edit
+#ifndef TOKENIZED_TEMPLATES_H
+#define TOKENIZED_TEMPLATES_H
+
+#include <TemplateEngine.h>
+
+extern const TokenTable dfte_test_tok_tokens;
+extern const TokenizedTemplate dfte_test_tok_compiled_card;
+extern const TokenizedTemplate dfte_test_tok_compiled_empty;
+extern const TokenizedTemplate dfte_test_tok_compiled_layout;
+
+#endif // TOKENIZED_TEMPLATES_H
@@ -39,12 +39,28 @@ TestCase tests[] = {
     TEST_ENTRY(test_placeholder_registry_lookup),
     TEST_ENTRY(test_placeholder_registry_rendering),
     TEST_ENTRY(test_placeholder_registry_edge_cases),
+    TEST_ENTRY(test_placeholder_registry_hash_index),
+    TEST_ENTRY(test_placeholder_registry_interned_names),
+    TEST_ENTRY(test_placeholder_registry_static_table),
+    TEST_ENTRY(test_placeholder_registry_overlay),
+    TEST_ENTRY(test_placeholder_registry_token_bindings),
+    TEST_ENTRY(test_concurrent_registry_snapshots),
+    TEST_ENTRY(test_concurrent_registry_stress),
+    TEST_ENTRY(test_cached_value_ttl),
+    TEST_ENTRY(test_cached_value_held_by_render),
+    TEST_ENTRY(test_cached_value_concurrent),
+    TEST_ENTRY(test_data_provider_per_render),
+    TEST_ENTRY(test_data_provider_ttl),
+    TEST_ENTRY(test_data_provider_mid_render),
     
     // Group 2: TemplateContext Tests
     TEST_ENTRY(test_template_context_initialization),
     TEST_ENTRY(test_template_context_stack),
     TEST_ENTRY(test_template_context_buffer),
     TEST_ENTRY(test_template_context_state),
+    TEST_ENTRY(test_template_context_literal_runs),
+    TEST_ENTRY(test_scratch_arena_allocation),
+    TEST_ENTRY(test_scratch_arena_render),
     
     // Group 3: TemplateRenderer Tests
     TEST_ENTRY(test_template_renderer_basic),
@@ -74,6 +90,25 @@ TestCase tests[] = {
     TEST_ENTRY(test_template_renderer_iterator_dynamic_items),
     TEST_ENTRY(test_template_renderer_iterator_error_cleanup),
     TEST_ENTRY(test_template_renderer_iterator_stall_guard),
+    TEST_ENTRY(test_template_renderer_plan_cache_reuse),
+    TEST_ENTRY(test_template_renderer_plan_cache_invalidation),
+    TEST_ENTRY(test_template_renderer_plan_cache_concurrent),
+    TEST_ENTRY(test_template_renderer_static_template),
+    TEST_ENTRY(test_template_renderer_compiled_template),
+    TEST_ENTRY(test_template_renderer_compiled_template_nested),
+    TEST_ENTRY(test_template_renderer_tokenized_template),
+    TEST_ENTRY(test_template_renderer_tokenized_varint_ids),
+    TEST_ENTRY(test_template_renderer_single_frame_nesting),
+    TEST_ENTRY(test_template_renderer_tail_include_elision),
+    TEST_ENTRY(test_template_renderer_static_registry),
+    TEST_ENTRY(test_template_renderer_overlay),
+    TEST_ENTRY(test_template_renderer_iterator_scope),
+    TEST_ENTRY(test_template_renderer_data_snapshot),
+    TEST_ENTRY(test_template_renderer_render_memo),
+    TEST_ENTRY(test_template_renderer_sized_data),
+    TEST_ENTRY(test_template_renderer_writer),
+    TEST_ENTRY(test_template_renderer_producer),
+    TEST_ENTRY(test_template_renderer_ring_buffer),
     
     // Group 4: Integration Tests
     TEST_ENTRY(test_integration_full_rendering),
@@ -84,6 +119,18 @@ TestCase tests[] = {
     TEST_ENTRY(test_edge_cases_error_handling),
     TEST_ENTRY(test_edge_cases_boundary_conditions),
     TEST_ENTRY(test_edge_cases_stress),
+    
+    // Group 6: Kernel Tests
+    TEST_ENTRY(test_template_kernels_find_byte),
+    TEST_ENTRY(test_template_kernels_copy_until),
+    TEST_ENTRY(test_template_kernels_name_span),
+
+    // Group 7: Typed Value Tests
+    TEST_ENTRY(test_typed_value_format),
+    TEST_ENTRY(test_typed_value_render),
+
+    // Group 8: Callable Tests
+    TEST_ENTRY(test_callable_render),
 };
 
 const size_t TEST_COUNT = sizeof(tests) / sizeof(TestCase);
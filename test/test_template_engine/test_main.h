@@ -10,12 +10,28 @@ void test_placeholder_registry_registration();
 void test_placeholder_registry_lookup();
 void test_placeholder_registry_rendering();
 void test_placeholder_registry_edge_cases();
+void test_placeholder_registry_hash_index();
+void test_placeholder_registry_interned_names();
+void test_placeholder_registry_static_table();
+void test_placeholder_registry_overlay();
+void test_placeholder_registry_token_bindings();
+void test_concurrent_registry_snapshots();
+void test_concurrent_registry_stress();
+void test_cached_value_ttl();
+void test_cached_value_held_by_render();
+void test_cached_value_concurrent();
+void test_data_provider_per_render();
+void test_data_provider_ttl();
+void test_data_provider_mid_render();
 
 // Group 2: TemplateContext Tests
 void test_template_context_initialization();
 void test_template_context_stack();
 void test_template_context_buffer();
 void test_template_context_state();
+void test_template_context_literal_runs();
+void test_scratch_arena_allocation();
+void test_scratch_arena_render();
 
 // Group 3: TemplateRenderer Tests
 void test_template_renderer_basic();
@@ -45,6 +61,25 @@ void test_template_renderer_iterator_empty();
 void test_template_renderer_iterator_dynamic_items();
 void test_template_renderer_iterator_error_cleanup();
 void test_template_renderer_iterator_stall_guard();
+void test_template_renderer_plan_cache_reuse();
+void test_template_renderer_plan_cache_invalidation();
+void test_template_renderer_plan_cache_concurrent();
+void test_template_renderer_static_template();
+void test_template_renderer_compiled_template();
+void test_template_renderer_compiled_template_nested();
+void test_template_renderer_tokenized_template();
+void test_template_renderer_tokenized_varint_ids();
+void test_template_renderer_single_frame_nesting();
+void test_template_renderer_tail_include_elision();
+void test_template_renderer_static_registry();
+void test_template_renderer_overlay();
+void test_template_renderer_iterator_scope();
+void test_template_renderer_data_snapshot();
+void test_template_renderer_render_memo();
+void test_template_renderer_sized_data();
+void test_template_renderer_writer();
+void test_template_renderer_producer();
+void test_template_renderer_ring_buffer();
 
 // Group 4: Integration Tests
 void test_integration_full_rendering();
@@ -56,5 +91,17 @@ void test_edge_cases_error_handling();
 void test_edge_cases_boundary_conditions();
 void test_edge_cases_stress();
 
+// Group 6: Kernel Tests
+void test_template_kernels_find_byte();
+void test_template_kernels_copy_until();
+void test_template_kernels_name_span();
+
+// Group 7: Typed Value Tests
+void test_typed_value_format();
+void test_typed_value_render();
+
+// Group 8: Callable Tests
+void test_callable_render();
+
 #endif // TEST_MAIN_H
 
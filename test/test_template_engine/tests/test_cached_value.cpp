@@ -0,0 +1,295 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <pgmspace.h>
+#include "../utils/test_utils.h"
+
+#if !defined(ESP8266)
+  #include <atomic>
+  #include <thread>
+#endif
+
+static int cachedGetterCalls = 0;
+static char cachedGetterValue[48];
+
+static const char* getCachedReading() {
+    cachedGetterCalls++;
+    snprintf(cachedGetterValue, sizeof(cachedGetterValue), "reading-%d", cachedGetterCalls);
+    return cachedGetterValue;
+}
+
+static const char* getCachedLongReading(void* userData) {
+    (void)userData;
+    return "a value far longer than the sixteen byte cache";
+}
+
+static void waitCachedMillis(uint32_t ms) {
+    unsigned long start = millis();
+    while (millis() - start < ms) {
+        yield();
+    }
+}
+
+// Test TTL expiry, hit/miss counters, refresh-ahead and sharing across contexts
+void test_cached_value_ttl() {
+    Serial.println("[TEST]   Testing CachedValue TTL and refresh-ahead...");
+
+    cachedGetterCalls = 0;
+    CachedValue cache(getCachedReading, 200, 100);
+    TEST_ASSERT_EQUAL(200, cache.getTtl());
+
+    TEST_ASSERT_EQUAL_STRING("reading-1", cache.get());
+    TEST_ASSERT_EQUAL_STRING("reading-1", cache.get());
+    TEST_ASSERT_EQUAL_STRING("reading-1", cache.get());
+    TEST_ASSERT_EQUAL(1, cachedGetterCalls);
+    TEST_ASSERT_EQUAL(2, cache.getHits());
+    TEST_ASSERT_EQUAL(1, cache.getMisses());
+    TEST_ASSERT_EQUAL(1, cache.getRefreshes());
+
+    // Two contexts rendering the placeholder share the one cached value
+    static const char PROGMEM cachedTemplate[] = "<%CACHED%>";
+    PlaceholderRegistry registry(2);
+    TEST_ASSERT_TRUE(registry.registerCachedData("%CACHED%", &cache));
+    TEST_ASSERT_FALSE(registry.registerCachedData("%NO_CACHE%", nullptr));
+    TemplateContext first;
+    TemplateContext second;
+    first.setRegistry(&registry);
+    second.setRegistry(&registry);
+    TemplateRenderer::initializeContext(first, cachedTemplate);
+    TemplateRenderer::initializeContext(second, cachedTemplate);
+    TEST_ASSERT_EQUAL_STRING("<reading-1>", captureRenderedOutput(first, 3).c_str());
+    TEST_ASSERT_EQUAL_STRING("<reading-1>", captureRenderedOutput(second, 64).c_str());
+    TEST_ASSERT_EQUAL(1, cachedGetterCalls);
+
+    // Within the refresh-ahead window loop() recomputes it; before the window nothing happens
+    const char* before = cache.get();
+    TEST_ASSERT_FALSE(cache.refreshIfDue());
+    waitCachedMillis(110);
+    TEST_ASSERT_TRUE(cache.refreshIfDue());
+    TEST_ASSERT_EQUAL_STRING("reading-2", cache.get());
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("reading-1", before, "The previous buffer stays intact for renders still streaming it");
+
+    // Expired with nobody refreshing ahead: the next get() pays for the getter
+    cache.resetStats();
+    waitCachedMillis(210);
+    TEST_ASSERT_EQUAL_STRING("reading-3", cache.get());
+    TEST_ASSERT_EQUAL(1, cache.getMisses());
+    TEST_ASSERT_EQUAL(0, cache.getHits());
+
+    cache.invalidate();
+    TEST_ASSERT_TRUE(cache.refreshIfDue());
+    TEST_ASSERT_EQUAL_STRING("reading-4", cache.get());
+    TEST_ASSERT_TRUE(cache.refresh());
+    TEST_ASSERT_EQUAL(5, cachedGetterCalls);
+
+    // Values longer than the capacity are truncated, and userData getters are supported
+    CachedValue small(getCachedLongReading, nullptr, 1000, 0, 16);
+    TEST_ASSERT_EQUAL_STRING("a value far lon", small.get());
+    TEST_ASSERT_EQUAL(15, small.getDescriptor()->getLength(small.get(), small.getDescriptor()->userData));
+
+    // A refresh-ahead window as long as the TTL is clamped, or every value would be due at once
+    cachedGetterCalls = 0;
+    CachedValue eager(getCachedReading, 1000, 1000);
+    TEST_ASSERT_EQUAL_STRING("reading-1", eager.get());
+    TEST_ASSERT_FALSE_MESSAGE(eager.refreshIfDue(), "A fresh value should not be due");
+    TEST_ASSERT_EQUAL(1, cachedGetterCalls);
+
+    Serial.println("[TEST]   CachedValue TTL tests completed successfully");
+}
+
+static size_t cachedRowsLeft = 0;
+
+static void* openCachedRows(void* userData) {
+    cachedRowsLeft = *static_cast<size_t*>(userData);
+    return &cachedRowsLeft;
+}
+
+static IteratorStepResult nextCachedRow(void* handle, IteratorItemView& view) {
+    size_t* left = static_cast<size_t*>(handle);
+    if (*left == 0) {
+        return IteratorStepResult::COMPLETE;
+    }
+    (*left)--;
+    view.templateData = "<%HELD%>";
+    view.templateLength = strlen(view.templateData);
+    view.templateIsProgmem = false;
+    return IteratorStepResult::ITEM_READY;
+}
+
+// Test that a render keeps streaming the value it started with while the cache moves on
+void test_cached_value_held_by_render() {
+    Serial.println("[TEST]   Testing CachedValue values held by a render...");
+
+    cachedGetterCalls = 0;
+    CachedValue cache(getCachedReading, 60000, 0);
+    static const char PROGMEM heldTemplate[] = "[%HELD%]";
+    PlaceholderRegistry registry(1);
+    TEST_ASSERT_TRUE(registry.registerCachedData("%HELD%", &cache));
+
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, heldTemplate);
+    char output[32] = {};
+    size_t length = TemplateRenderer::renderNextChunk(ctx, reinterpret_cast<uint8_t*>(output), 3);
+    TEST_ASSERT_EQUAL_STRING("[re", output);
+
+    // Both buffers are rewritten, and an invalidated value recomputed, before the render resumes
+    TEST_ASSERT_TRUE(cache.refresh());
+    TEST_ASSERT_TRUE(cache.refresh());
+    cache.invalidate();
+    TEST_ASSERT_EQUAL_STRING("reading-4", cache.get());
+    while (!TemplateRenderer::isComplete(ctx)) {
+        length += TemplateRenderer::renderNextChunk(ctx, reinterpret_cast<uint8_t*>(output) + length, 2);
+        TEST_ASSERT_TRUE(length < sizeof(output));
+    }
+    TEST_ASSERT_FALSE(ctx.hasError());
+    TEST_ASSERT_EQUAL_STRING("[reading-1]", output);
+    TEST_ASSERT_EQUAL_MESSAGE(sizeof("reading-1"), ctx.getScratchArena()->getHighWater(), "The render should stream its own copy");
+
+    // The next render sees the latest value
+    TemplateRenderer::initializeContext(ctx, heldTemplate);
+    TEST_ASSERT_EQUAL_STRING("[reading-4]", captureRenderedOutput(ctx, 2).c_str());
+
+    // Every row of the render reads its one copy: the arena holds a single value however many rows there are
+    static size_t rowCount = 40;
+    static const IteratorDescriptor rowIterator = {openCachedRows, nextCachedRow, nullptr, &rowCount};
+    static const char PROGMEM rowsTemplate[] = "%HELD_ROWS%";
+    PlaceholderOverlay overlay(&registry);
+    TEST_ASSERT_TRUE(overlay.registerIterator("%HELD_ROWS%", &rowIterator));
+    TemplateContext rowsCtx;
+    rowsCtx.setRegistry(&overlay);
+    TemplateRenderer::initializeContext(rowsCtx, rowsTemplate);
+    char rows[512] = {};
+    size_t rowsLength = 0;
+    while (!TemplateRenderer::isComplete(rowsCtx)) {
+        rowsLength += TemplateRenderer::renderNextChunk(rowsCtx, reinterpret_cast<uint8_t*>(rows) + rowsLength, 16);
+        TEST_ASSERT_TRUE(rowsLength < sizeof(rows));
+        cache.refresh();
+    }
+    String expectedRows;
+    for (size_t i = 0; i < rowCount; ++i) {
+        expectedRows += "<reading-4>";
+    }
+    TEST_ASSERT_FALSE(rowsCtx.hasError());
+    TEST_ASSERT_EQUAL_STRING(expectedRows.c_str(), rows);
+    TEST_ASSERT_EQUAL_MESSAGE(sizeof("reading-4"), rowsCtx.getScratchArena()->getHighWater(), "Each cache should be copied once per render");
+    TEST_ASSERT_EQUAL(0, rowsCtx.getScratchArena()->getFailures());
+
+#if !defined(ESP8266)
+    // Renders on several tasks while another keeps replacing the value: every page shows one whole value
+    static const size_t RENDERERS = 3;
+    std::atomic<size_t> torn(0);
+    std::thread renderers[RENDERERS];
+    for (size_t t = 0; t < RENDERERS; ++t) {
+        renderers[t] = std::thread([&registry, &torn]() {
+            TemplateContext local;
+            local.setRegistry(&registry);
+            for (int i = 0; i < 500; ++i) {
+                TemplateRenderer::initializeContext(local, heldTemplate);
+                String page = captureRenderedOutput(local, 1 + i % 4);
+                size_t digits = 0;
+                while (page.length() > 9 + digits && isdigit(static_cast<unsigned char>(page[9 + digits]))) {
+                    digits++;
+                }
+                if (!page.startsWith("[reading-") || digits == 0 || page.length() != 10 + digits || !page.endsWith("]")) {
+                    torn++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        cache.refresh();
+    }
+    for (size_t t = 0; t < RENDERERS; ++t) {
+        renderers[t].join();
+    }
+    TEST_ASSERT_EQUAL(0, torn.load());
+#endif
+
+    Serial.println("[TEST]   CachedValue render hold tests completed successfully");
+}
+
+#if !defined(ESP8266)
+static std::atomic<int> slowCachedGetterCalls(0);
+
+static const char* getSlowCachedReading() {
+    slowCachedGetterCalls++;
+    waitCachedMillis(5);
+    return "slow";
+}
+
+static std::atomic<int> gatedCachedGetterCalls(0);
+static std::atomic<bool> gatedCachedGetterOpen(false);
+static char gatedCachedValue[16];
+
+// Every call after the first holds until the test opens the gate (or two seconds pass)
+static const char* getGatedCachedReading() {
+    int call = ++gatedCachedGetterCalls;
+    unsigned long start = millis();
+    while (call > 1 && !gatedCachedGetterOpen.load() && millis() - start < 2000) {
+        std::this_thread::yield();
+    }
+    snprintf(gatedCachedValue, sizeof(gatedCachedValue), "gated-%d", call);
+    return gatedCachedValue;
+}
+#endif
+
+// Test that concurrent misses share one getter call, and that expired values are served during a refresh
+void test_cached_value_concurrent() {
+    Serial.println("[TEST]   Testing CachedValue under concurrent readers...");
+
+#if defined(ESP8266)
+    TEST_IGNORE_MESSAGE("No threads on ESP8266");
+#else
+    slowCachedGetterCalls = 0;
+    CachedValue cache(getSlowCachedReading, 1000, 0);
+
+    static const size_t READERS = 4;
+    std::atomic<size_t> wrong(0);
+    std::thread readers[READERS];
+    for (size_t t = 0; t < READERS; ++t) {
+        readers[t] = std::thread([&cache, &wrong]() {
+            for (int i = 0; i < 2000; ++i) {
+                if (strcmp(cache.get(), "slow") != 0) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (size_t t = 0; t < READERS; ++t) {
+        readers[t].join();
+    }
+
+    TEST_ASSERT_EQUAL(0, wrong.load());
+    TEST_ASSERT_EQUAL_MESSAGE(1, slowCachedGetterCalls.load(), "Concurrent misses should wait for the refresh in flight");
+    TEST_ASSERT_EQUAL(READERS * 2000, cache.getHits() + cache.getMisses());
+    TEST_ASSERT_EQUAL(1, cache.getRefreshes());
+
+    // Once a value exists, a render finding it expired while another task runs the getter serves it as is
+    gatedCachedGetterCalls = 0;
+    gatedCachedGetterOpen = false;
+    CachedValue gated(getGatedCachedReading, 100, 0);
+    String first = gated.get();
+    TEST_ASSERT_EQUAL_STRING("gated-1", first.c_str());
+    waitCachedMillis(110);
+    std::thread refresher([&gated]() { gated.refresh(); });
+    while (gatedCachedGetterCalls.load() < 2) {
+        std::this_thread::yield();
+    }
+    gated.resetStats();
+    unsigned long start = millis();
+    String stale = gated.get();
+    unsigned long waited = millis() - start;
+    gatedCachedGetterOpen = true;
+    refresher.join();
+    TEST_ASSERT_EQUAL_STRING("gated-1", stale.c_str());
+    TEST_ASSERT_TRUE_MESSAGE(waited < 1000, "An expired value should not wait for the refresh in flight");
+    TEST_ASSERT_EQUAL(1, gated.getHits());
+    TEST_ASSERT_EQUAL(0, gated.getMisses());
+    String fresh = gated.get();
+    TEST_ASSERT_EQUAL_STRING("gated-2", fresh.c_str());
+    TEST_ASSERT_EQUAL(2, gatedCachedGetterCalls.load());
+#endif
+
+    Serial.println("[TEST]   CachedValue concurrency tests completed successfully");
+}
@@ -0,0 +1,116 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <pgmspace.h>
+#include "../utils/test_utils.h"
+
+// Per-instance state behind the engine's callbacks: two sensors, no globals
+class CallableSensor {
+public:
+    CallableSensor(const char* name, bool online, const char* const* rows, size_t rowCount)
+        : name(name), online(online), rows(rows), rowCount(rowCount), cursor(0), reads(0) {}
+
+    ConditionalBranchResult isOnline() const {
+        return online ? ConditionalBranchResult::TRUE_BRANCH : ConditionalBranchResult::FALSE_BRANCH;
+    }
+
+    const char* name;
+    bool online;
+    const char* const* rows;
+    size_t rowCount;
+    size_t cursor;
+    int reads;
+
+    Callable<const char*()> label{[this] {
+        reads++;
+        return name;
+    }};
+    Callable<ConditionalBranchResult()> status{this, &CallableSensor::isOnline};
+    // open rewinds this sensor's cursor and hands next its own wrapper as the handle
+    Callable<void*()> openRows{[this]() -> void* {
+        cursor = 0;
+        return nextRow.context();
+    }};
+    Callable<IteratorStepResult(IteratorItemView&)> nextRow{[this](IteratorItemView& view) {
+        if (cursor >= rowCount) {
+            return IteratorStepResult::COMPLETE;
+        }
+        view.templateData = rows[cursor++];
+        view.templateLength = strlen(view.templateData);
+        view.templateIsProgmem = false;
+        return IteratorStepResult::ITEM_READY;
+    }};
+
+    DynamicDataDescriptor labelData{label.function(), nullptr, label.context()};
+    ConditionalDescriptor statusBranch{status.function(), "%ONLINE%", "%OFFLINE%", status.context()};
+    IteratorDescriptor rowIterator{openRows.function(), nextRow.function(), nullptr, openRows.context()};
+};
+
+struct CallableCaptureCounter {
+    static int live;
+    CallableCaptureCounter() { live++; }
+    CallableCaptureCounter(const CallableCaptureCounter&) { live++; }
+    ~CallableCaptureCounter() { live--; }
+};
+int CallableCaptureCounter::live = 0;
+
+// Test capturing lambdas and member bindings as getters, evaluators, iterator handlers and writers
+void test_callable_render() {
+    Serial.println("[TEST]   Testing inline callables behind placeholder callbacks...");
+
+    static const char PROGMEM sensorTemplate[] = "%NAME%:%STATUS%[%ROWS%]";
+    static const char* const kitchenRows[] = {"k1;", "k2;"};
+    static const char* const cellarRows[] = {"c1;"};
+    CallableSensor kitchen("kitchen", true, kitchenRows, 2);
+    CallableSensor cellar("cellar", false, cellarRows, 1);
+
+    PlaceholderRegistry shared(2);
+    TEST_ASSERT_TRUE(shared.registerProgmemData("%ONLINE%", PSTR("up")));
+    TEST_ASSERT_TRUE(shared.registerProgmemData("%OFFLINE%", PSTR("down")));
+
+    CallableSensor* sensors[] = {&kitchen, &cellar};
+    const char* expected[] = {"kitchen:up[k1;k2;]", "cellar:down[c1;]"};
+    for (size_t i = 0; i < 2; ++i) {
+        PlaceholderOverlay overlay(&shared);
+        TEST_ASSERT_TRUE(overlay.registerDynamicData("%NAME%", &sensors[i]->labelData));
+        TEST_ASSERT_TRUE(overlay.registerConditional("%STATUS%", &sensors[i]->statusBranch));
+        TEST_ASSERT_TRUE(overlay.registerIterator("%ROWS%", &sensors[i]->rowIterator));
+        for (int pass = 0; pass < 2; ++pass) {
+            TemplateContext ctx;
+            ctx.setRegistry(&overlay);
+            TemplateRenderer::initializeContext(ctx, sensorTemplate);
+            TEST_ASSERT_EQUAL_STRING(expected[i], captureRenderedOutput(ctx, 5).c_str());
+        }
+    }
+    TEST_ASSERT_EQUAL(2, kitchen.reads);
+    TEST_ASSERT_EQUAL(2, cellar.reads);
+
+    // Called directly, the wrapper is the same single call
+    TEST_ASSERT_EQUAL_STRING("kitchen", kitchen.label());
+    TEST_ASSERT_EQUAL(ConditionalBranchResult::FALSE_BRANCH, cellar.status());
+
+    // Callbacks taking userData last (writers, data providers) use trailingFunction()
+    uint32_t boots = 41;
+    Callable<bool(PlaceholderWriter&)> bootWriter{[&boots](PlaceholderWriter& out) {
+        return out.printUnsigned(++boots);
+    }};
+    WriterDataDescriptor bootData = {bootWriter.trailingFunction(), bootWriter.context()};
+    PlaceholderRegistry registry(2);
+    TEST_ASSERT_TRUE(registry.registerWriter("%BOOTS%", &bootData));
+    static const char PROGMEM bootTemplate[] = "boot %BOOTS%";
+    TemplateContext bootCtx;
+    bootCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(bootCtx, bootTemplate);
+    TEST_ASSERT_EQUAL_STRING("boot 42", captureRenderedOutput(bootCtx, 3).c_str());
+
+    // Captures with destructors are destroyed with the wrapper; larger captures pick a larger storage
+    {
+        CallableCaptureCounter counter;
+        Callable<int()> counting{[counter] { return CallableCaptureCounter::live; }};
+        TEST_ASSERT_EQUAL(2, counting());
+        char big[40] = "forty bytes of captured state";
+        Callable<size_t(), 48> sized{[big] { return strlen(big); }};
+        TEST_ASSERT_EQUAL(29, sized());
+    }
+    TEST_ASSERT_EQUAL(0, CallableCaptureCounter::live);
+}
@@ -0,0 +1,190 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <pgmspace.h>
+#include <memory>
+#include "../utils/test_utils.h"
+
+#if !defined(ESP8266)
+  #include <atomic>
+  #include <thread>
+#endif
+
+static const char PROGMEM concurrentOne[] = "one";
+static const char PROGMEM concurrentTwo[] = "two";
+static const char concurrentTemplate[] = "%A%|%B%|%C%";
+
+// Publish A, B and C as one version, all with the same value
+static bool publishConcurrentSet(ConcurrentPlaceholderRegistry& registry, const char* value) {
+    return registry.update([value](PlaceholderRegistry& staging) {
+        return staging.registerProgmemData("%A%", value) &&
+               staging.registerProgmemData("%B%", value) &&
+               staging.registerProgmemData("%C%", value);
+    });
+}
+
+static String renderConcurrent(ConcurrentPlaceholderRegistry::Reader& reader, size_t chunkSize) {
+    std::unique_ptr<TemplateContext> ctx(new TemplateContext());
+    ctx->setRegistry(&reader);
+    TemplateRenderer::initializeContext(*ctx, concurrentTemplate, false);
+    String output;
+    char text[17];
+    while (!TemplateRenderer::isComplete(*ctx) && !ctx->hasError()) {
+        size_t written = TemplateRenderer::renderNextChunk(*ctx, reinterpret_cast<uint8_t*>(text), chunkSize);
+        text[written] = '\0';
+        output += text;
+    }
+    return output;
+}
+
+// Test ConcurrentPlaceholderRegistry versioning, pinning and reclamation (single task)
+void test_concurrent_registry_snapshots() {
+    Serial.println("[TEST]   Testing ConcurrentPlaceholderRegistry snapshots...");
+
+    ConcurrentPlaceholderRegistry registry(4);
+    uint32_t initialVersion = registry.getVersion();
+    TEST_ASSERT_EQUAL(0, registry.getCount());
+    {
+        ConcurrentPlaceholderRegistry::Reader empty(registry);
+        TEST_ASSERT_TRUE(empty.isPinned());
+        TEST_ASSERT_NULL(empty.getPlaceholder("%A%"));
+    }
+
+    TEST_ASSERT_TRUE(publishConcurrentSet(registry, concurrentOne));
+    TEST_ASSERT_EQUAL(initialVersion + 1, registry.getVersion());
+    TEST_ASSERT_EQUAL(3, registry.getCount());
+
+    // A pinned reader keeps its version while writers publish and clear
+    ConcurrentPlaceholderRegistry::Reader reader(registry);
+    TEST_ASSERT_EQUAL(registry.getVersion(), reader.getVersion());
+    const PlaceholderEntry* a = reader.getPlaceholder("%A%");
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_PTR(concurrentOne, a->data);
+
+    TEST_ASSERT_TRUE(publishConcurrentSet(registry, concurrentTwo));
+    registry.clear();
+    TEST_ASSERT_EQUAL(0, registry.getCount());
+    TEST_ASSERT_EQUAL_PTR(a, reader.getPlaceholder("%A%"));
+    TEST_ASSERT_EQUAL_STRING("one|one|one", renderConcurrent(reader, 2).c_str());
+    TEST_ASSERT_EQUAL_MESSAGE(2, registry.getRetiredCount(), "Versions replaced while pinned should wait");
+
+    // Moving the reader on lets the writer free them
+    TEST_ASSERT_TRUE(reader.refresh());
+    TEST_ASSERT_NULL(reader.getPlaceholder("%A%"));
+    registry.reclaim();
+    TEST_ASSERT_EQUAL(0, registry.getRetiredCount());
+
+    // Re-registration replaces in place; staging is compacted so capacity is not used up
+    for (int i = 0; i < 20; ++i) {
+        TEST_ASSERT_TRUE_MESSAGE(publishConcurrentSet(registry, (i & 1) ? concurrentTwo : concurrentOne),
+                                 "Republishing the same names should not fill the registry");
+    }
+    TEST_ASSERT_EQUAL(3, registry.getCount());
+    TEST_ASSERT_TRUE(registry.registerRamData("%D%", []() -> const char* { return "d"; }));
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerRamData("%E%", []() -> const char* { return "e"; }), "Capacity still applies");
+    TEST_ASSERT_FALSE(registry.update([](PlaceholderRegistry&) { return false; }));
+
+    TEST_ASSERT_TRUE(reader.refresh());
+    TEST_ASSERT_EQUAL_STRING("two|two|two", renderConcurrent(reader, 5).c_str());
+
+    // Token lookups resolve through the pinned snapshot
+    static const char PROGMEM tokenName0[] = "%D%";
+    static const char* const tokenNames[] PROGMEM = {tokenName0};
+    static const TokenTable tokens = {tokenNames, 1};
+    TEST_ASSERT_EQUAL_PTR(reader.getPlaceholder("%D%"), reader.getPlaceholderByToken(&tokens, 0));
+    TEST_ASSERT_NULL(reader.acquirePlan(concurrentOne, 3));
+
+    // Reader slots are bounded; an unpinned reader finds nothing
+    std::unique_ptr<ConcurrentPlaceholderRegistry::Reader> readers[ConcurrentPlaceholderRegistry::READER_SLOTS];
+    for (size_t i = 1; i < ConcurrentPlaceholderRegistry::READER_SLOTS; ++i) {
+        readers[i].reset(new ConcurrentPlaceholderRegistry::Reader(registry));
+        TEST_ASSERT_TRUE(readers[i]->isPinned());
+    }
+    ConcurrentPlaceholderRegistry::Reader overflow(registry);
+    TEST_ASSERT_FALSE(overflow.isPinned());
+    TEST_ASSERT_NULL(overflow.getPlaceholder("%A%"));
+    TEST_ASSERT_EQUAL(0, overflow.getVersion());
+    readers[1].reset();
+    TEST_ASSERT_TRUE(overflow.refresh());
+
+    Serial.println("[TEST]   ConcurrentPlaceholderRegistry snapshot tests completed successfully");
+}
+
+// Test that renders racing a writer always see one whole version
+void test_concurrent_registry_stress() {
+    Serial.println("[TEST]   Testing ConcurrentPlaceholderRegistry under concurrent render and publish...");
+
+    ConcurrentPlaceholderRegistry registry(8);
+    TEST_ASSERT_TRUE(publishConcurrentSet(registry, concurrentOne));
+
+#if defined(ESP8266)
+    // Single core, no threads: publish between the chunks of in-flight renders instead
+    for (int round = 0; round < 200; ++round) {
+        ConcurrentPlaceholderRegistry::Reader reader(registry);
+        std::unique_ptr<TemplateContext> ctx(new TemplateContext());
+        ctx->setRegistry(&reader);
+        TemplateRenderer::initializeContext(*ctx, concurrentTemplate, false);
+        String output;
+        char text[4];
+        while (!TemplateRenderer::isComplete(*ctx) && !ctx->hasError()) {
+            size_t written = TemplateRenderer::renderNextChunk(*ctx, reinterpret_cast<uint8_t*>(text), 2);
+            text[written] = '\0';
+            output += text;
+            TEST_ASSERT_TRUE(publishConcurrentSet(registry, (round & 1) ? concurrentOne : concurrentTwo));
+        }
+        TEST_ASSERT_TRUE_MESSAGE(output == "one|one|one" || output == "two|two|two", output.c_str());
+    }
+#else
+    static const size_t READER_THREADS = 4;
+    static const size_t RENDERS_PER_READER = 2000;
+    static const size_t PUBLISHES = 4000;
+
+    std::atomic<size_t> torn(0);
+    std::atomic<size_t> renders(0);
+    std::atomic<bool> writing(true);
+
+    std::thread readerThreads[READER_THREADS];
+    for (size_t t = 0; t < READER_THREADS; ++t) {
+        readerThreads[t] = std::thread([&registry, &torn, &renders, t]() {
+            for (size_t i = 0; i < RENDERS_PER_READER; ++i) {
+                ConcurrentPlaceholderRegistry::Reader reader(registry);
+                if (!reader.isPinned()) {
+                    continue;
+                }
+                String output = renderConcurrent(reader, 1 + (i + t) % 4);
+                if (output != "one|one|one" && output != "two|two|two") {
+                    torn++;
+                }
+                renders++;
+            }
+        });
+    }
+
+    std::thread writer([&registry, &writing]() {
+        for (size_t i = 0; i < PUBLISHES; ++i) {
+            publishConcurrentSet(registry, (i & 1) ? concurrentTwo : concurrentOne);
+            if (i % 64 == 0) {
+                registry.clear();
+                publishConcurrentSet(registry, concurrentOne);
+            }
+        }
+        writing = false;
+    });
+
+    for (size_t t = 0; t < READER_THREADS; ++t) {
+        readerThreads[t].join();
+    }
+    writer.join();
+
+    TEST_ASSERT_FALSE(writing);
+    TEST_ASSERT_EQUAL_MESSAGE(0, torn.load(), "A render mixed values from two versions");
+    TEST_ASSERT_TRUE(renders.load() > 0);
+#endif
+
+    // With every reader gone nothing stays retired
+    registry.reclaim();
+    TEST_ASSERT_EQUAL(0, registry.getRetiredCount());
+    TEST_ASSERT_EQUAL(3, registry.getCount());
+
+    Serial.println("[TEST]   ConcurrentPlaceholderRegistry stress test completed successfully");
+}
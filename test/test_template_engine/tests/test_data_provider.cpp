@@ -0,0 +1,267 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <pgmspace.h>
+#include "../utils/test_utils.h"
+
+#if !defined(ESP8266)
+  #include <atomic>
+  #include <thread>
+#endif
+
+struct PowerSample {
+    float voltage;
+    float current;
+    int32_t temperature;
+    bool charging;
+};
+
+static PowerSample powerSample;
+static int powerReads = 0;
+static bool powerReadFails = false;
+#if !defined(ESP8266)
+static std::atomic<bool> powerReadHeld(false);
+static std::atomic<bool> powerReadStarted(false);
+#endif
+
+// Every read moves all fields together, so a mixed page shows up as mismatched numbers
+static bool readPowerSample(void* sample, void* userData) {
+    (void)userData;
+#if !defined(ESP8266)
+    // A slow bus transaction: holds until the test lets it go (or two seconds pass)
+    powerReadStarted = true;
+    unsigned long start = millis();
+    while (powerReadHeld.load() && millis() - start < 2000) {
+        std::this_thread::yield();
+    }
+#endif
+    if (powerReadFails) {
+        powerReads++;
+        return false;
+    }
+    PowerSample* power = static_cast<PowerSample*>(sample);
+    powerReads++;
+    power->voltage = 3.0f + powerReads;
+    power->current = 0.5f * powerReads;
+    power->temperature = 20 + powerReads;
+    power->charging = (powerReads % 2) == 1;
+    return true;
+}
+
+static void waitProviderMillis(uint32_t ms) {
+    unsigned long start = millis();
+    while (millis() - start < ms) {
+        yield();
+    }
+}
+
+static const char PROGMEM powerTemplate[] = "%VOLTS%V %AMPS%A %TEMP%C %CHARGING% / %VOLTS%V";
+
+static String renderPower(DeviceFrameworkPlaceholderLookup* registry, size_t chunkSize) {
+    TemplateContext ctx;
+    ctx.setRegistry(registry);
+    TemplateRenderer::initializeContext(ctx, powerTemplate);
+    String output = captureRenderedOutput(ctx, chunkSize);
+    TEST_ASSERT_FALSE(ctx.hasError());
+    return output;
+}
+
+// Test a provider without TTL: one sample per render, shared by every field of the render
+void test_data_provider_per_render() {
+    Serial.println("[TEST]   Testing DataProvider per-render sampling...");
+
+    powerReads = 0;
+    powerReadFails = false;
+    static DataProvider provider(readPowerSample, &powerSample);
+    static const ProviderFieldDescriptor volts = {&provider, TypedValue::ofFixed(&powerSample.voltage, 2)};
+    static const ProviderFieldDescriptor amps = {&provider, TypedValue::ofFixed(&powerSample.current, 1)};
+    static const ProviderFieldDescriptor temp = {&provider, TypedValue::ofInt32(&powerSample.temperature)};
+    static const ProviderFieldDescriptor charging = {&provider, TypedValue::ofBool(&powerSample.charging, "charging", "idle")};
+    static const ProviderFieldDescriptor noProvider = {nullptr, TypedValue::ofInt32(&powerSample.temperature)};
+    static const ProviderFieldDescriptor badField = {&provider, TypedValue::ofFixed(&powerSample.voltage, 9)};
+
+    PlaceholderRegistry registry(6);
+    TEST_ASSERT_TRUE(registry.registerProviderField("%VOLTS%", &volts));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%AMPS%", &amps));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%TEMP%", &temp));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%CHARGING%", &charging));
+    TEST_ASSERT_FALSE(registry.registerProviderField("%BAD%", &noProvider));
+    TEST_ASSERT_FALSE(registry.registerProviderField("%BAD%", &badField));
+    TEST_ASSERT_FALSE(registry.registerProviderField("%BAD%", nullptr));
+    TEST_ASSERT_EQUAL(PlaceholderType::PROVIDER_FIELD, registry.getPlaceholder("%VOLTS%")->type);
+
+    TEST_ASSERT_EQUAL_STRING("4.00V 0.5A 21C charging / 4.00V", renderPower(&registry, 1).c_str());
+    TEST_ASSERT_EQUAL_MESSAGE(1, powerReads, "Five fields should share one sample");
+    TEST_ASSERT_EQUAL(1, provider.getSamples());
+    TEST_ASSERT_EQUAL(4, provider.getHits());
+
+    // The next render takes a fresh sample
+    TEST_ASSERT_EQUAL_STRING("5.00V 1.0A 22C idle / 5.00V", renderPower(&registry, 64).c_str());
+    TEST_ASSERT_EQUAL(2, powerReads);
+
+    // A failed read renders the previous values and is not retried by the other fields of that render
+    powerReadFails = true;
+    TEST_ASSERT_EQUAL_STRING("5.00V 1.0A 22C idle / 5.00V", renderPower(&registry, 7).c_str());
+    TEST_ASSERT_EQUAL(3, powerReads);
+    powerReadFails = false;
+
+    // Without a TTL there is nothing to sample ahead of time
+    TEST_ASSERT_FALSE(provider.refreshIfDue());
+
+    // Overlay bindings and renderPlaceholder format the same fields
+    PlaceholderOverlay overlay(&registry);
+    TEST_ASSERT_TRUE(overlay.registerProviderField("%TEMP%", &volts));
+    TEST_ASSERT_FALSE(overlay.registerProviderField("%BAD%", &noProvider));
+    TEST_ASSERT_EQUAL_STRING("7.00V 2.0A 7.00C idle / 7.00V", renderPower(&overlay, 5).c_str());
+
+    uint8_t direct[8];
+    TEST_ASSERT_EQUAL(2, PlaceholderRegistry::renderPlaceholder(registry.getPlaceholder("%TEMP%"), 0, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("25", direct, 2);
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::providerField("%VOLTS%", &volts).type == PlaceholderType::PROVIDER_FIELD,
+                  "Static registries should accept provider fields");
+#endif
+}
+
+// Test a provider with a TTL: one sample shared across renders and contexts, refreshed ahead from loop()
+void test_data_provider_ttl() {
+    Serial.println("[TEST]   Testing DataProvider TTL sharing and refresh-ahead...");
+
+    powerReads = 0;
+    powerReadFails = false;
+    static DataProvider provider(readPowerSample, &powerSample, 200, 100);
+    static const ProviderFieldDescriptor volts = {&provider, TypedValue::ofFixed(&powerSample.voltage, 2)};
+    static const ProviderFieldDescriptor amps = {&provider, TypedValue::ofFixed(&powerSample.current, 1)};
+    static const ProviderFieldDescriptor temp = {&provider, TypedValue::ofInt32(&powerSample.temperature)};
+    static const ProviderFieldDescriptor charging = {&provider, TypedValue::ofBool(&powerSample.charging, "charging", "idle")};
+    TEST_ASSERT_EQUAL(200, provider.getTtl());
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerProviderField("%VOLTS%", &volts));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%AMPS%", &amps));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%TEMP%", &temp));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%CHARGING%", &charging));
+
+    // Two interleaved renders within the TTL share one sample
+    TemplateContext first;
+    TemplateContext second;
+    first.setRegistry(&registry);
+    second.setRegistry(&registry);
+    TemplateRenderer::initializeContext(first, powerTemplate);
+    TemplateRenderer::initializeContext(second, powerTemplate);
+    char firstOutput[48] = {};
+    char secondOutput[48] = {};
+    size_t firstLength = 0;
+    size_t secondLength = 0;
+    while (!TemplateRenderer::isComplete(first) || !TemplateRenderer::isComplete(second)) {
+        firstLength += TemplateRenderer::renderNextChunk(first, reinterpret_cast<uint8_t*>(firstOutput) + firstLength, 4);
+        secondLength += TemplateRenderer::renderNextChunk(second, reinterpret_cast<uint8_t*>(secondOutput) + secondLength, 4);
+        TEST_ASSERT_FALSE(first.hasError() || second.hasError());
+        TEST_ASSERT_TRUE(firstLength < sizeof(firstOutput) - 4 && secondLength < sizeof(secondOutput) - 4);
+    }
+    TEST_ASSERT_EQUAL_STRING("4.00V 0.5A 21C charging / 4.00V", firstOutput);
+    TEST_ASSERT_EQUAL_STRING(firstOutput, secondOutput);
+    TEST_ASSERT_EQUAL(1, powerReads);
+
+    // Inside the refresh-ahead window loop() takes the next sample, so the render pays nothing
+    TEST_ASSERT_FALSE(provider.refreshIfDue());
+    waitProviderMillis(110);
+    TEST_ASSERT_TRUE(provider.refreshIfDue());
+    TEST_ASSERT_EQUAL(2, powerReads);
+    provider.resetStats();
+    TEST_ASSERT_EQUAL_STRING("5.00V 1.0A 22C idle / 5.00V", renderPower(&registry, 16).c_str());
+    TEST_ASSERT_EQUAL(0, provider.getSamples());
+    TEST_ASSERT_EQUAL(5, provider.getHits());
+
+    // Expired with nobody refreshing ahead: the render samples once
+    waitProviderMillis(210);
+    TEST_ASSERT_EQUAL_STRING("6.00V 1.5A 23C charging / 6.00V", renderPower(&registry, 16).c_str());
+    TEST_ASSERT_EQUAL(3, powerReads);
+
+    provider.invalidate();
+    TEST_ASSERT_TRUE(provider.refreshIfDue());
+    TEST_ASSERT_EQUAL(4, powerReads);
+    TEST_ASSERT_TRUE(provider.refresh());
+    TEST_ASSERT_EQUAL(5, powerReads);
+}
+
+// Test that a render keeps the sample its first field saw while the TTL expires and other tasks sample
+void test_data_provider_mid_render() {
+    Serial.println("[TEST]   Testing DataProvider samples held by a render...");
+
+    powerReads = 0;
+    powerReadFails = false;
+    static DataProvider provider(readPowerSample, &powerSample, 50);
+    static const ProviderFieldDescriptor volts = {&provider, TypedValue::ofFixed(&powerSample.voltage, 2)};
+    static const ProviderFieldDescriptor amps = {&provider, TypedValue::ofFixed(&powerSample.current, 1)};
+    static const ProviderFieldDescriptor temp = {&provider, TypedValue::ofInt32(&powerSample.temperature)};
+    static const ProviderFieldDescriptor charging = {&provider, TypedValue::ofBool(&powerSample.charging, "charging", "idle")};
+    static int32_t elsewhere = 0;
+    static const ProviderFieldDescriptor outside = {&provider, TypedValue::ofInt32(&elsewhere)};
+
+    PlaceholderRegistry registry(5);
+    TEST_ASSERT_TRUE(registry.registerProviderField("%VOLTS%", &volts));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%AMPS%", &amps));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%TEMP%", &temp));
+    TEST_ASSERT_TRUE(registry.registerProviderField("%CHARGING%", &charging));
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerProviderField("%OUTSIDE%", &outside), "Fields must point into the sample");
+
+    // The first field comes from a TTL sample taken before the render started
+    TEST_ASSERT_TRUE(provider.refresh());
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, powerTemplate);
+    char output[48] = {};
+    size_t length = TemplateRenderer::renderNextChunk(ctx, reinterpret_cast<uint8_t*>(output), 4);
+    TEST_ASSERT_EQUAL_STRING("4.00", output);
+
+    // The TTL runs out and another task samples twice before the render reaches its other fields
+    waitProviderMillis(60);
+    TEST_ASSERT_TRUE(provider.refresh());
+    TEST_ASSERT_FALSE_MESSAGE(provider.refreshIfDue(), "A fresh sample should not be due");
+    TEST_ASSERT_TRUE(provider.refresh());
+    while (!TemplateRenderer::isComplete(ctx)) {
+        length += TemplateRenderer::renderNextChunk(ctx, reinterpret_cast<uint8_t*>(output) + length, 4);
+        TEST_ASSERT_TRUE(length < sizeof(output) - 4);
+    }
+    TEST_ASSERT_FALSE(ctx.hasError());
+    TEST_ASSERT_EQUAL_STRING("4.00V 0.5A 21C charging / 4.00V", output);
+    TEST_ASSERT_EQUAL_MESSAGE(3, powerReads, "The render should not sample again");
+
+    // The next render starts from the latest sample
+    TemplateRenderer::initializeContext(ctx, powerTemplate);
+    String latest = captureRenderedOutput(ctx, 5);
+    TEST_ASSERT_EQUAL_STRING("6.00V 1.5A 23C charging / 6.00V", latest.c_str());
+
+    // With no room for the copy the render reads the live struct, but still samples only once
+    ScratchArenaPool tiny(1, sizeof(PowerSample) - 1);
+    ctx.setScratchPool(&tiny);
+    provider.invalidate();
+    TemplateRenderer::initializeContext(ctx, powerTemplate);
+    String live = captureRenderedOutput(ctx, 3);
+    TEST_ASSERT_EQUAL_STRING("7.00V 2.0A 24C idle / 7.00V", live.c_str());
+    TEST_ASSERT_EQUAL(4, powerReads);
+    ctx.setScratchPool(nullptr);
+
+#if !defined(ESP8266)
+    // A render finding the sample due while another task is reading the sensor renders the current sample
+    waitProviderMillis(60);
+    powerReadHeld = true;
+    powerReadStarted = false;
+    std::thread sampler([]() { provider.refresh(); });
+    while (!powerReadStarted.load()) {
+        std::this_thread::yield();
+    }
+    unsigned long start = millis();
+    TemplateRenderer::initializeContext(ctx, powerTemplate);
+    String during = captureRenderedOutput(ctx, 4);
+    unsigned long waited = millis() - start;
+    powerReadHeld = false;
+    sampler.join();
+    TEST_ASSERT_EQUAL_STRING("7.00V 2.0A 24C idle / 7.00V", during.c_str());
+    TEST_ASSERT_TRUE_MESSAGE(waited < 1000, "A render with a valid sample should not wait for the callback");
+    TEST_ASSERT_EQUAL(5, powerReads);
+    TEST_ASSERT_EQUAL_MESSAGE(25, powerSample.temperature, "The callback's sample should be published when it returns");
+#endif
+}
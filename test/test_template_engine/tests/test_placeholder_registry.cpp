@@ -258,3 +258,353 @@ void test_placeholder_registry_edge_cases() {
     Serial.println("[TEST]   PlaceholderRegistry edge case tests completed successfully");
 }
 
+
+// Test the hash index against many names, misses, re-registration and clear()
+void test_placeholder_registry_hash_index() {
+    Serial.println("[TEST]   Testing PlaceholderRegistry hash index...");
+
+    const uint16_t capacity = 300;
+    PlaceholderRegistry registry(capacity);
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+
+    for (uint16_t i = 0; i < capacity - 2; ++i) {
+        snprintf(name, sizeof(name), "%%SENSOR_%u%%", static_cast<unsigned>(i));
+        TEST_ASSERT_TRUE_MESSAGE(registry.registerProgmemData(name, test_css_data), "Should register indexed placeholder");
+    }
+    for (uint16_t i = 0; i < capacity - 2; ++i) {
+        snprintf(name, sizeof(name), "%%SENSOR_%u%%", static_cast<unsigned>(i));
+        const PlaceholderEntry* entry = registry.getPlaceholder(name);
+        TEST_ASSERT_NOT_NULL_MESSAGE(entry, "Every registered name should be found");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(name, entry->name, "Lookup should return the matching entry");
+    }
+
+    // Misses, including prefixes/suffixes of registered names and a bare "%%"
+    TEST_ASSERT_NULL(registry.getPlaceholder("%SENSOR_%"));
+    TEST_ASSERT_NULL(registry.getPlaceholder("%SENSOR_1"));
+    TEST_ASSERT_NULL(registry.getPlaceholder("%SENSOR_298%"));
+    TEST_ASSERT_NULL(registry.getPlaceholder("%%"));
+    TEST_ASSERT_NULL(registry.getPlaceholder(""));
+
+    // Re-registering a name makes the newest entry win
+    TEST_ASSERT_TRUE(registry.registerProgmemData("%SENSOR_7%", test_js_data));
+    TEST_ASSERT_TRUE(registry.registerRamData("%SENSOR_7%", getTestRamData));
+    const PlaceholderEntry* latest = registry.getPlaceholder("%SENSOR_7%");
+    TEST_ASSERT_NOT_NULL(latest);
+    TEST_ASSERT_EQUAL_MESSAGE(PlaceholderType::RAM_DATA, latest->type, "Last registration should win");
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerRamData("%FULL%", getTestRamData), "Registry should be full");
+
+    registry.clear();
+    TEST_ASSERT_NULL_MESSAGE(registry.getPlaceholder("%SENSOR_7%"), "clear() should empty the index");
+    TEST_ASSERT_TRUE(registry.registerRamData("%SENSOR_7%", getTestRamData));
+    TEST_ASSERT_NOT_NULL_MESSAGE(registry.getPlaceholder("%SENSOR_7%"), "Index should work after clear()");
+    TEST_ASSERT_NULL(registry.getPlaceholder("%SENSOR_8%"));
+
+    Serial.println("[TEST]   PlaceholderRegistry hash index tests completed successfully");
+}
+
+// Entries hold a name pointer and hash instead of an inline DFTE_PLACEHOLDER_NAME_SIZE buffer
+static_assert(sizeof(void*) != 4 || sizeof(PlaceholderEntry) == 24, "PlaceholderEntry should stay at 24 bytes on 32-bit targets");
+
+void test_placeholder_registry_interned_names() {
+    Serial.println("[TEST]   Testing PlaceholderRegistry interned names...");
+
+    PlaceholderRegistry registry(10);
+    size_t emptyUsage = registry.getMemoryUsage();
+
+    // Names are copied, so the caller's buffer can be reused
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+    strcpy(name, "%FIRST%");
+    TEST_ASSERT_TRUE(registry.registerProgmemData(name, test_css_data));
+    strcpy(name, "%SECOND%");
+    TEST_ASSERT_TRUE(registry.registerProgmemData(name, test_js_data));
+    const PlaceholderEntry* first = registry.getPlaceholder("%FIRST%");
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_EQUAL_STRING("%FIRST%", first->name);
+    TEST_ASSERT_TRUE_MESSAGE(first->name != name, "Registry should keep its own copy of the name");
+    TEST_ASSERT_TRUE_MESSAGE(first->nameHash != 0, "Registry should hash names on registration");
+    TEST_ASSERT_TRUE_MESSAGE(registry.getMemoryUsage() > emptyUsage, "Interned names should be accounted for");
+
+    // Re-registration shares the interned copy and still wins the lookup
+    size_t usage = registry.getMemoryUsage();
+    TEST_ASSERT_TRUE(registry.registerRamData("%FIRST%", getTestRamData));
+    const PlaceholderEntry* latest = registry.getPlaceholder("%FIRST%");
+    TEST_ASSERT_NOT_NULL(latest);
+    TEST_ASSERT_EQUAL(PlaceholderType::RAM_DATA, latest->type);
+    TEST_ASSERT_EQUAL_PTR(first->name, latest->name);
+    TEST_ASSERT_EQUAL_MESSAGE(usage, registry.getMemoryUsage(), "Re-registering a name should not copy it again");
+
+    // Names longer than a pool block still fit, and clear() hands the pool back
+    for (int i = 0; i < 6; ++i) {
+        snprintf(name, sizeof(name), "%%LONG_PLACEHOLDER_%02d%%", i);
+        TEST_ASSERT_TRUE(registry.registerProgmemData(name, test_css_data));
+    }
+    TEST_ASSERT_NOT_NULL(registry.getPlaceholder("%LONG_PLACEHOLDER_00%"));
+    TEST_ASSERT_NOT_NULL(registry.getPlaceholder("%LONG_PLACEHOLDER_05%"));
+    TEST_ASSERT_NOT_NULL(registry.getPlaceholder("%SECOND%"));
+    registry.clear();
+    TEST_ASSERT_EQUAL_MESSAGE(emptyUsage, registry.getMemoryUsage(), "clear() should release interned names");
+    TEST_ASSERT_NULL(registry.getPlaceholder("%FIRST%"));
+
+    Serial.println("[TEST]   PlaceholderRegistry interned name tests completed successfully");
+}
+
+#if __cplusplus >= 201402L
+// Namespace-scope table; test_placeholder_registry_static_table also declares one at function scope
+DFTE_STATIC_REGISTRY(staticSensorRegistry,
+    dfte::progmemData("%SENSOR_0%", test_css_data),
+    dfte::progmemData("%SENSOR_1%", test_css_data),
+    dfte::progmemData("%SENSOR_2%", test_css_data),
+    dfte::progmemData("%SENSOR_3%", test_css_data),
+    dfte::progmemData("%SENSOR_4%", test_css_data),
+    dfte::progmemData("%SENSOR_5%", test_css_data),
+    dfte::progmemData("%SENSOR_6%", test_css_data),
+    dfte::progmemData("%SENSOR_7%", test_css_data),
+    dfte::progmemData("%SENSOR_8%", test_css_data),
+    dfte::progmemData("%SENSOR_9%", test_css_data),
+    dfte::progmemData("%SENSOR_10%", test_css_data),
+    dfte::progmemData("%SENSOR_11%", test_css_data),
+    dfte::progmemData("%SENSOR_12%", test_css_data),
+    dfte::progmemData("%SENSOR_13%", test_css_data),
+    dfte::progmemData("%SENSOR_14%", test_css_data),
+    dfte::progmemData("%SENSOR_15%", test_css_data),
+    dfte::progmemData("%SENSOR_16%", test_css_data),
+    dfte::progmemData("%SENSOR_17%", test_css_data),
+    dfte::progmemData("%SENSOR_18%", test_css_data),
+    dfte::progmemData("%SENSOR_19%", test_css_data),
+    dfte::progmemData("%SENSOR_20%", test_css_data),
+    dfte::progmemData("%SENSOR_21%", test_css_data),
+    dfte::progmemData("%SENSOR_22%", test_css_data),
+    dfte::progmemData("%SENSOR_23%", test_css_data),
+    dfte::progmemData("%SENSOR_24%", test_css_data),
+    dfte::progmemData("%SENSOR_25%", test_css_data),
+    dfte::progmemData("%SENSOR_26%", test_css_data),
+    dfte::progmemData("%SENSOR_27%", test_css_data),
+    dfte::progmemData("%SENSOR_28%", test_css_data),
+    dfte::progmemData("%SENSOR_29%", test_css_data),
+    dfte::progmemData("%SENSOR_30%", test_css_data),
+    dfte::progmemData("%SENSOR_31%", test_css_data),
+    dfte::progmemData("%SENSOR_32%", test_css_data),
+    dfte::progmemData("%SENSOR_33%", test_css_data),
+    dfte::progmemData("%SENSOR_34%", test_css_data),
+    dfte::progmemData("%SENSOR_35%", test_css_data),
+    dfte::progmemData("%SENSOR_36%", test_css_data),
+    dfte::progmemData("%SENSOR_37%", test_css_data),
+    dfte::progmemData("%SENSOR_38%", test_css_data),
+    dfte::progmemData("%SENSOR_39%", test_css_data),
+    dfte::ramData<getTestRamData>("%TITLE%"));
+
+static constexpr dfte::StaticPlaceholder duplicateStaticNames[] = {
+    dfte::progmemData("%CSS%", test_css_data), dfte::progmemData("%CSS%", test_js_data)};
+static constexpr dfte::StaticPlaceholder overlongStaticName[] = {
+    dfte::progmemData("%ABCDEFGHIJKLMNOPQRSTUV%", test_css_data)};
+static_assert(!::dfte::detail::staticNamesUnique(duplicateStaticNames), "Duplicate names must be rejected");
+static_assert(!::dfte::detail::staticNamesFit(overlongStaticName), "Overlong names must be rejected");
+static_assert(::dfte::detail::staticNameHash("%TITLE%") != ::dfte::detail::staticNameHash("%TITLE"), "Hash covers every byte");
+#endif
+
+void test_placeholder_registry_static_table() {
+    Serial.println("[TEST]   Testing StaticPlaceholderRegistry...");
+#if __cplusplus >= 201402L
+    TEST_ASSERT_EQUAL_MESSAGE(41, staticSensorRegistry.getCount(), "Static registry should hold every registration");
+    TEST_ASSERT_EQUAL_MESSAGE(64, staticSensorRegistry.getSlotCount(), "Slots should round up to a power of two");
+
+    char name[DFTE_PLACEHOLDER_NAME_SIZE];
+    for (unsigned i = 0; i < 40; ++i) {
+        snprintf(name, sizeof(name), "%%SENSOR_%u%%", i);
+        const PlaceholderEntry* entry = staticSensorRegistry.getPlaceholder(name);
+        TEST_ASSERT_NOT_NULL_MESSAGE(entry, "Every static name should be found");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(name, entry->name, "Lookup should return the matching entry");
+        TEST_ASSERT_EQUAL(PlaceholderType::PROGMEM_DATA, entry->type);
+        TEST_ASSERT_TRUE_MESSAGE(entry->hasCachedLength, "PROGMEM array length should be known at compile time");
+        TEST_ASSERT_EQUAL(strlen_P(test_css_data), entry->cachedLength);
+    }
+
+    // Tables hashed at compile time must agree with the runtime hash every lookup uses
+    TEST_ASSERT_EQUAL_UINT32(::dfte::detail::staticNameHash("%SENSOR_7%"), PlaceholderRegistry::hashName("%SENSOR_7%"));
+
+    // RAM getters become forwarding DYNAMIC_DATA entries and render the same bytes
+    const PlaceholderEntry* title = staticSensorRegistry.getPlaceholder("%TITLE%");
+    TEST_ASSERT_NOT_NULL(title);
+    uint8_t buffer[32];
+    size_t written = PlaceholderRegistry::renderPlaceholder(title, 0, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING_LEN(testRamData.c_str(), reinterpret_cast<const char*>(buffer), written);
+    TEST_ASSERT_EQUAL(testRamData.length(), written);
+
+    // Misses land on one slot and fail the name compare, including empty slots
+    TEST_ASSERT_NULL(staticSensorRegistry.getPlaceholder("%SENSOR_40%"));
+    TEST_ASSERT_NULL(staticSensorRegistry.getPlaceholder("%SENSOR_%"));
+    TEST_ASSERT_NULL(staticSensorRegistry.getPlaceholder("%SENSOR_1"));
+    TEST_ASSERT_NULL(staticSensorRegistry.getPlaceholder(""));
+    TEST_ASSERT_NULL(staticSensorRegistry.getPlaceholder(nullptr));
+
+    // Function-scope tables are constant-initialized too
+    DFTE_STATIC_REGISTRY(localRegistry, dfte::progmemData("%JS%", test_js_data));
+    TEST_ASSERT_EQUAL(1, localRegistry.getSlotCount());
+    TEST_ASSERT_NOT_NULL(localRegistry.getPlaceholder("%JS%"));
+    TEST_ASSERT_NULL(localRegistry.getPlaceholder("%CSS%"));
+
+    // Token lookups go through the interface default (copy name, perfect-hash lookup)
+    static const char PROGMEM tokenName0[] = "%SENSOR_3%";
+    static const char PROGMEM tokenName1[] = "%UNKNOWN%";
+    static const char* const tokenNames[] PROGMEM = {tokenName0, tokenName1};
+    static const TokenTable tokens = {tokenNames, 2};
+    DeviceFrameworkPlaceholderLookup& lookup = staticSensorRegistry;
+    TEST_ASSERT_EQUAL_PTR(staticSensorRegistry.getPlaceholder("%SENSOR_3%"), lookup.getPlaceholderByToken(&tokens, 0));
+    TEST_ASSERT_NULL(lookup.getPlaceholderByToken(&tokens, 1));
+    TEST_ASSERT_NULL(lookup.getPlaceholderByToken(&tokens, 2));
+    TEST_ASSERT_NULL_MESSAGE(lookup.acquirePlan(progmem_data_template, strlen_P(progmem_data_template)), "Static registry has no plan cache");
+#endif
+    Serial.println("[TEST]   StaticPlaceholderRegistry tests completed successfully");
+}
+
+// Test PlaceholderOverlay bindings, capacity and fallthrough to the base
+void test_placeholder_registry_overlay() {
+    Serial.println("[TEST]   Testing PlaceholderOverlay...");
+
+    PlaceholderRegistry base(4);
+    TEST_ASSERT_TRUE(base.registerProgmemData("%CSS%", test_css_data));
+    TEST_ASSERT_TRUE(base.registerRamData("%TITLE%", getTestRamData));
+
+    PlaceholderOverlay overlay(&base);
+    TEST_ASSERT_EQUAL(0, overlay.getCount());
+    TEST_ASSERT_EQUAL_PTR(base.getPlaceholder("%CSS%"), overlay.getPlaceholder("%CSS%"));
+    TEST_ASSERT_NULL(overlay.getPlaceholder("%USER%"));
+    TEST_ASSERT_NULL(overlay.getPlaceholder(nullptr));
+
+    // Bindings are visible through the overlay only
+    TEST_ASSERT_TRUE(overlay.registerString("%USER%", "alice"));
+    const PlaceholderEntry* user = overlay.getPlaceholder("%USER%");
+    TEST_ASSERT_NOT_NULL(user);
+    TEST_ASSERT_EQUAL(PlaceholderType::DYNAMIC_DATA, user->type);
+    TEST_ASSERT_NULL(base.getPlaceholder("%USER%"));
+    uint8_t buffer[16];
+    size_t written = PlaceholderRegistry::renderPlaceholder(user, 0, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING_LEN("alice", reinterpret_cast<const char*>(buffer), written);
+    TEST_ASSERT_EQUAL(5, written);
+
+    // Plans stay with the base until a binding shadows one of its names
+    const TemplatePlan* plan = overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template));
+    TEST_ASSERT_NOT_NULL_MESSAGE(plan, "Non-shadowing overlay should use the base plan cache");
+    TEST_ASSERT_TRUE(overlay.isPlanCurrent(plan));
+    TEST_ASSERT_TRUE(overlay.registerProgmemData("%CSS%", test_js_data));
+    TEST_ASSERT_FALSE_MESSAGE(overlay.isPlanCurrent(plan), "Shadowing binding should retire base plans");
+    PlaceholderRegistry::releasePlan(plan);
+    TEST_ASSERT_NULL(overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template)));
+    const PlaceholderEntry* css = overlay.getPlaceholder("%CSS%");
+    TEST_ASSERT_NOT_NULL(css);
+    TEST_ASSERT_EQUAL_PTR(test_js_data, css->data);
+    TEST_ASSERT_EQUAL(strlen_P(test_js_data), css->cachedLength);
+    TEST_ASSERT_EQUAL_PTR(test_css_data, base.getPlaceholder("%CSS%")->data);
+
+    // Token lookups check the bindings, then the base
+    static const char PROGMEM tokenName0[] = "%USER%";
+    static const char PROGMEM tokenName1[] = "%TITLE%";
+    static const char PROGMEM tokenName2[] = "%UNKNOWN%";
+    static const char* const tokenNames[] PROGMEM = {tokenName0, tokenName1, tokenName2};
+    static const TokenTable tokens = {tokenNames, 3};
+    TEST_ASSERT_EQUAL_PTR(user, overlay.getPlaceholderByToken(&tokens, 0));
+    TEST_ASSERT_EQUAL_PTR(base.getPlaceholder("%TITLE%"), overlay.getPlaceholderByToken(&tokens, 1));
+    TEST_ASSERT_NULL(overlay.getPlaceholderByToken(&tokens, 2));
+    TEST_ASSERT_NULL(overlay.getPlaceholderByToken(&tokens, 3));
+
+    // Rebinding replaces in place; a full overlay still accepts rebinds
+    static const char* const names[] = {"%O0%", "%O1%", "%O2%", "%O3%", "%O4%", "%O5%", "%O6%", "%O7%", "%O8%"};
+    static_assert(sizeof(names) / sizeof(names[0]) > PlaceholderOverlay::CAPACITY, "Test needs more names than slots");
+    for (uint8_t i = 0; overlay.getCount() < PlaceholderOverlay::CAPACITY; ++i) {
+        TEST_ASSERT_TRUE(overlay.registerString(names[i], "x"));
+    }
+    TEST_ASSERT_FALSE_MESSAGE(overlay.registerString(names[PlaceholderOverlay::CAPACITY], "x"), "Full overlay should reject new names");
+    TEST_ASSERT_TRUE(overlay.registerString("%USER%", "bob"));
+    TEST_ASSERT_EQUAL(PlaceholderOverlay::CAPACITY, overlay.getCount());
+    TEST_ASSERT_EQUAL_PTR(user, overlay.getPlaceholder("%USER%"));
+    written = PlaceholderRegistry::renderPlaceholder(user, 0, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING_LEN("bob", reinterpret_cast<const char*>(buffer), written);
+
+    // Invalid bindings
+    TEST_ASSERT_FALSE(overlay.registerString(nullptr, "x"));
+    TEST_ASSERT_FALSE(overlay.registerString("", "x"));
+    TEST_ASSERT_FALSE(overlay.registerString("%USER%", nullptr));
+    TEST_ASSERT_FALSE(overlay.registerRamData("%USER%", nullptr));
+    TEST_ASSERT_FALSE(overlay.registerString("%THIS_NAME_IS_FAR_TOO_LONG%", "x"));
+
+    // clear() drops bindings but keeps the base
+    overlay.clear();
+    TEST_ASSERT_EQUAL(0, overlay.getCount());
+    TEST_ASSERT_NULL(overlay.getPlaceholder("%USER%"));
+    TEST_ASSERT_EQUAL_PTR(base.getPlaceholder("%CSS%"), overlay.getPlaceholder("%CSS%"));
+    plan = overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template));
+    TEST_ASSERT_NOT_NULL(plan);
+    PlaceholderRegistry::releasePlan(plan);
+
+    // A base that later registers a bound name makes the binding shadow it
+    TEST_ASSERT_TRUE(overlay.registerString("%LATE%", "overlay"));
+    plan = overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template));
+    TEST_ASSERT_NOT_NULL(plan);
+    PlaceholderRegistry::releasePlan(plan);
+    TEST_ASSERT_TRUE(base.registerRamData("%LATE%", getTestRamData));
+    TEST_ASSERT_NULL(overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template)));
+    TEST_ASSERT_EQUAL(PlaceholderType::DYNAMIC_DATA, overlay.getPlaceholder("%LATE%")->type);
+
+    // No base: only the bindings resolve
+    overlay.setBase(nullptr);
+    TEST_ASSERT_NULL(overlay.getPlaceholder("%CSS%"));
+    TEST_ASSERT_NOT_NULL(overlay.getPlaceholder("%LATE%"));
+    TEST_ASSERT_NULL(overlay.acquirePlan(progmem_data_template, strlen_P(progmem_data_template)));
+
+    Serial.println("[TEST]   PlaceholderOverlay tests completed successfully");
+}
+
+// Test token tables bound at registration: kept current by the writer, read-only for renders
+void test_placeholder_registry_token_bindings() {
+    Serial.println("[TEST]   Testing token table bindings...");
+
+    static const char PROGMEM bindName0[] = "%ALPHA%";
+    static const char PROGMEM bindName1[] = "%BETA%";
+    static const char* const bindNames[] PROGMEM = {bindName0, bindName1};
+    // One table per converter run; more runs than binding slots
+    static const TokenTable tables[] = {
+        {bindNames, 2}, {bindNames, 2}, {bindNames, 2}, {bindNames, 2}, {bindNames, 2}, {bindNames, 2}};
+    static const size_t TABLE_COUNT = sizeof(tables) / sizeof(tables[0]);
+    static const char PROGMEM encoded[] = "\000\000";
+    static const TokenizedTemplate templates[TABLE_COUNT] = {
+        {encoded, 2, &tables[0]}, {encoded, 2, &tables[1]}, {encoded, 2, &tables[2]},
+        {encoded, 2, &tables[3]}, {encoded, 2, &tables[4]}, {encoded, 2, &tables[5]}};
+    static const char* const templateNames[TABLE_COUNT] = {"%T0%", "%T1%", "%T2%", "%T3%", "%T4%", "%T5%"};
+
+    PlaceholderRegistry registry(12);
+    TEST_ASSERT_TRUE(registry.registerRamData("%ALPHA%", getTestRamData));
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        TEST_ASSERT_TRUE(registry.registerTokenizedTemplate(templateNames[i], &templates[i]));
+    }
+    TEST_ASSERT_TRUE_MESSAGE(registry.bindTokenTable(&tables[0]), "Bound tables should bind again without a new slot");
+    TEST_ASSERT_FALSE_MESSAGE(registry.bindTokenTable(&tables[TABLE_COUNT - 1]), "Tables past the slots should stay unbound");
+    TEST_ASSERT_FALSE(registry.bindTokenTable(nullptr));
+
+    // Bound and unbound tables resolve the same entries, through a const registry
+    const PlaceholderRegistry& reader = registry;
+    const PlaceholderEntry* alpha = registry.getPlaceholder("%ALPHA%");
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        TEST_ASSERT_EQUAL_PTR(alpha, reader.getPlaceholderByToken(&tables[i], 0));
+        TEST_ASSERT_NULL(reader.getPlaceholderByToken(&tables[i], 1));
+        TEST_ASSERT_NULL(reader.getPlaceholderByToken(&tables[i], 2));
+    }
+
+    // Registrations update bound tables in place: new names resolve, re-registrations win
+    TEST_ASSERT_TRUE(registry.registerRamData("%BETA%", getTestRamData));
+    TEST_ASSERT_TRUE(registry.registerRamData("%ALPHA%", getTestRamData, true));
+    for (size_t i = 0; i < TABLE_COUNT; ++i) {
+        TEST_ASSERT_EQUAL_PTR(registry.getPlaceholder("%ALPHA%"), reader.getPlaceholderByToken(&tables[i], 0));
+        TEST_ASSERT_EQUAL_PTR(registry.getPlaceholder("%BETA%"), reader.getPlaceholderByToken(&tables[i], 1));
+    }
+    TEST_ASSERT_TRUE(registry.getPlaceholderByToken(&tables[0], 0) != alpha);
+
+    // clear() keeps the tables bound but empty
+    registry.clear();
+    TEST_ASSERT_NULL(reader.getPlaceholderByToken(&tables[0], 0));
+    TEST_ASSERT_TRUE(registry.registerRamData("%BETA%", getTestRamData));
+    TEST_ASSERT_EQUAL_PTR(registry.getPlaceholder("%BETA%"), reader.getPlaceholderByToken(&tables[0], 1));
+    TEST_ASSERT_TRUE(registry.bindTokenTable(&tables[3]));
+    TEST_ASSERT_FALSE(registry.bindTokenTable(&tables[4]));
+
+    Serial.println("[TEST]   Token binding tests completed successfully");
+}
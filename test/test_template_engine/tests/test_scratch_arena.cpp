@@ -0,0 +1,183 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <pgmspace.h>
+#include "../utils/test_utils.h"
+
+// Test bump allocation, alignment, exhaustion and rewinding on one arena
+void test_scratch_arena_allocation() {
+    Serial.println("[TEST]   Testing ScratchArena allocation...");
+
+    TEST_ASSERT_NULL(ScratchArena::current());
+
+    uint8_t storage[64];
+    ScratchArena arena(storage, sizeof(storage));
+    TEST_ASSERT_EQUAL(64, arena.getCapacity());
+
+    const char* name = arena.copy("sensor");
+    TEST_ASSERT_EQUAL_STRING("sensor", name);
+    TEST_ASSERT_EQUAL(7, arena.getUsed());
+    uint32_t* counters = static_cast<uint32_t*>(arena.allocate(2 * sizeof(uint32_t), alignof(uint32_t)));
+    TEST_ASSERT_NOT_NULL(counters);
+    TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(counters) % alignof(uint32_t));
+    TEST_ASSERT_NULL(arena.allocate(4, 3));
+
+    size_t mark = arena.mark();
+    const char* reading = arena.format("%d.%02dV", 3, 7);
+    TEST_ASSERT_EQUAL_STRING("3.07V", reading);
+    TEST_ASSERT_EQUAL(mark + 6, arena.getUsed());
+    TEST_ASSERT_EQUAL_STRING("", arena.allocateText(4));
+
+    // Requests that do not fit fail without consuming anything
+    size_t before = arena.getUsed();
+    TEST_ASSERT_NULL(arena.allocate(64, 1));
+    TEST_ASSERT_NULL(arena.format("%064d", 1));
+    TEST_ASSERT_EQUAL(before, arena.getUsed());
+    TEST_ASSERT_EQUAL(3, arena.getFailures());
+
+    arena.rewind(mark);
+    TEST_ASSERT_EQUAL(mark, arena.getUsed());
+    TEST_ASSERT_EQUAL_STRING("sensor", name);
+    TEST_ASSERT_EQUAL(before, arena.getHighWater());
+
+    // Pinned allocations survive any rewind until the arena is reset
+    const char* kept = arena.copy("kept");
+    arena.pin();
+    arena.rewind(0);
+    TEST_ASSERT_EQUAL(mark + 5, arena.getUsed());
+    TEST_ASSERT_TRUE(arena.contains(kept));
+    TEST_ASSERT_FALSE(arena.contains(storage + arena.getUsed()));
+
+    arena.reset();
+    TEST_ASSERT_FALSE(arena.contains(kept));
+    TEST_ASSERT_EQUAL(0, arena.getUsed());
+    TEST_ASSERT_EQUAL(before, arena.getHighWater());
+    arena.resetStats();
+    TEST_ASSERT_EQUAL(0, arena.getHighWater());
+    TEST_ASSERT_EQUAL(0, arena.getFailures());
+
+    // An owned arena allocates its buffer on first use
+    ScratchArena owned(16);
+    TEST_ASSERT_EQUAL_STRING("0123456789abcde", owned.copy("0123456789abcde"));
+    TEST_ASSERT_NULL(owned.copy("x"));
+
+    ScratchArenaPool pool(2, 32);
+    TEST_ASSERT_EQUAL(2, pool.getAvailable());
+    ScratchArena* first = pool.acquire();
+    ScratchArena* second = pool.acquire();
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_TRUE(first != second);
+    TEST_ASSERT_NULL(pool.acquire());
+    TEST_ASSERT_NOT_NULL(second->allocate(20, 1));
+    pool.release(second);
+    TEST_ASSERT_EQUAL(0, second->getUsed());
+    TEST_ASSERT_EQUAL(20, pool.getHighWater());
+    TEST_ASSERT_TRUE(pool.acquire() == second);
+    pool.release(first);
+    pool.release(second);
+    TEST_ASSERT_EQUAL(2, pool.getAvailable());
+}
+
+static uint32_t scratchReadings = 0;
+
+// Formats into the arena of whichever context is rendering: no static buffer to share
+static const char* getScratchReading() {
+    ScratchArena* scratch = ScratchArena::current();
+    return scratch ? scratch->format("reading-%lu", static_cast<unsigned long>(++scratchReadings)) : "";
+}
+
+struct ScratchRows {
+    size_t count;
+    size_t index;
+    size_t mark;
+};
+
+static void* openScratchRows(void* userData) {
+    ScratchArena* scratch = ScratchArena::current();
+    ScratchRows* rows = scratch ? static_cast<ScratchRows*>(scratch->allocate(sizeof(ScratchRows), alignof(ScratchRows))) : nullptr;
+    if (rows) {
+        *rows = ScratchRows{*static_cast<size_t*>(userData), 0, scratch->mark()};
+    }
+    return rows;
+}
+
+static IteratorStepResult nextScratchRow(void* handle, IteratorItemView& view) {
+    ScratchRows* rows = static_cast<ScratchRows*>(handle);
+    if (rows == nullptr || rows->index >= rows->count) {
+        return IteratorStepResult::COMPLETE;
+    }
+    // The previous row has been written, so each row reuses the same bytes
+    ScratchArena* scratch = ScratchArena::current();
+    scratch->rewind(rows->mark);
+    view.templateData = scratch->format("<%u>", static_cast<unsigned>(rows->index++));
+    view.templateLength = strlen(view.templateData);
+    view.templateIsProgmem = false;
+    return IteratorStepResult::ITEM_READY;
+}
+
+// Test two interleaved renders formatting into their own arenas, reset when each render completes
+void test_scratch_arena_render() {
+    Serial.println("[TEST]   Testing per-render scratch arenas...");
+
+    static const char PROGMEM scratchTemplate[] = "%READING%|%ROWS%|%READING%";
+    static size_t rowCount = 12;
+    static const IteratorDescriptor rowIterator = {openScratchRows, nextScratchRow, nullptr, &rowCount};
+    PlaceholderRegistry registry(2);
+    TEST_ASSERT_TRUE(registry.registerRamData("%READING%", getScratchReading));
+    TEST_ASSERT_TRUE(registry.registerIterator("%ROWS%", &rowIterator));
+
+    scratchReadings = 0;
+    TemplateContext first;
+    TemplateContext second;
+    first.setRegistry(&registry);
+    second.setRegistry(&registry);
+    TemplateRenderer::initializeContext(first, scratchTemplate);
+    TemplateRenderer::initializeContext(second, scratchTemplate);
+    char firstOutput[96] = {};
+    char secondOutput[96] = {};
+    size_t firstLength = 0;
+    size_t secondLength = 0;
+    // One byte at a time, so each reading is still streaming while the other context formats its own
+    while (!TemplateRenderer::isComplete(first) || !TemplateRenderer::isComplete(second)) {
+        firstLength += TemplateRenderer::renderNextChunk(first, reinterpret_cast<uint8_t*>(firstOutput) + firstLength, 1);
+        secondLength += TemplateRenderer::renderNextChunk(second, reinterpret_cast<uint8_t*>(secondOutput) + secondLength, 1);
+        TEST_ASSERT_TRUE(firstLength < sizeof(firstOutput) - 1 && secondLength < sizeof(secondOutput) - 1);
+    }
+    TEST_ASSERT_FALSE(first.hasError() || second.hasError());
+    TEST_ASSERT_EQUAL_STRING("reading-1|<0><1><2><3><4><5><6><7><8><9><10><11>|reading-3", firstOutput);
+    TEST_ASSERT_EQUAL_STRING("reading-2|<0><1><2><3><4><5><6><7><8><9><10><11>|reading-4", secondOutput);
+    TEST_ASSERT_NULL(ScratchArena::current());
+
+    // Reset in one step at the end of the render; the high-water mark is what sizing needs
+    ScratchArena* arena = first.getScratchArena();
+    TEST_ASSERT_TRUE(arena == &first.scratch);
+    TEST_ASSERT_EQUAL(0, arena->getUsed());
+    TEST_ASSERT_TRUE(arena->getHighWater() > 2 * sizeof("reading-1"));
+    TEST_ASSERT_TRUE(arena->getHighWater() < 2 * sizeof("reading-1") + sizeof(ScratchRows) + 2 * sizeof("<11>") + 16);
+    TEST_ASSERT_EQUAL(0, arena->getFailures());
+
+    // Contexts sharing a pool borrow an arena per render and give it back when done
+    ScratchArenaPool pool(1, 64);
+    first.setScratchPool(&pool);
+    second.setScratchPool(&pool);
+    TemplateRenderer::initializeContext(first, scratchTemplate);
+    TemplateRenderer::initializeContext(second, scratchTemplate);
+    uint8_t chunk[8];
+    TemplateRenderer::renderNextChunk(first, chunk, sizeof(chunk));
+    TemplateRenderer::renderNextChunk(second, chunk, sizeof(chunk));
+    TEST_ASSERT_EQUAL(0, pool.getAvailable());
+    TEST_ASSERT_TRUE(second.borrowedScratch == &second.scratch);
+    first.reset();
+    TEST_ASSERT_EQUAL(1, pool.getAvailable());
+    TemplateRenderer::initializeContext(first, scratchTemplate);
+    scratchReadings = 0;
+    TEST_ASSERT_EQUAL_STRING("reading-1|<0><1><2><3><4><5><6><7><8><9><10><11>|reading-2",
+                             captureRenderedOutput(first, 16).c_str());
+    TEST_ASSERT_EQUAL(1, pool.getAvailable());
+    TEST_ASSERT_TRUE(pool.getHighWater() > 0);
+    captureRenderedOutput(second, 16);
+    TEST_ASSERT_FALSE(second.hasError());
+    first.setScratchPool(nullptr);
+    second.setScratchPool(nullptr);
+}
@@ -322,3 +322,45 @@ void test_template_context_state() {
     Serial.println("[TEST]   TemplateContext state tests completed successfully");
 }
 
+
+// Test literal run extraction for PROGMEM and RAM templates
+void test_template_context_literal_runs() {
+    Serial.println("[TEST]   Testing TemplateContext literal runs...");
+
+    static const char ramTemplate[] = "Hello, %NAME%!";
+    uint8_t out[32];
+    bool delimiterFound = false;
+
+    TemplateContext ctx;
+    ctx.pushContext(RenderingContextType::TEMPLATE, "PROGMEM");
+    RenderingContext* currentCtx = ctx.getCurrentContext();
+    currentCtx->context.templateCtx.templateData = single_placeholder_template;
+    currentCtx->context.templateCtx.templateLen = strlen_P(single_placeholder_template);
+    currentCtx->context.templateCtx.isProgmem = true;
+    currentCtx->context.templateCtx.position = 0;
+
+    size_t run = ctx.readLiteralRun(out, sizeof(out), delimiterFound);
+    TEST_ASSERT_EQUAL_MESSAGE(7, run, "PROGMEM run should stop at the delimiter");
+    TEST_ASSERT_TRUE_MESSAGE(delimiterFound, "PROGMEM run should report the delimiter");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE("Hello, ", out, 7, "PROGMEM run should copy the literal prefix");
+    TEST_ASSERT_EQUAL_MESSAGE(8, currentCtx->context.templateCtx.position, "Delimiter should be consumed");
+    TEST_ASSERT_EQUAL_MESSAGE('N', ctx.getNextChar(), "Character reads should resume after the delimiter");
+
+    ctx.reset();
+    ctx.pushContext(RenderingContextType::TEMPLATE, "RAM");
+    currentCtx = ctx.getCurrentContext();
+    currentCtx->context.templateCtx.templateData = ramTemplate;
+    currentCtx->context.templateCtx.templateLen = strlen(ramTemplate);
+    currentCtx->context.templateCtx.isProgmem = false;
+    currentCtx->context.templateCtx.position = 0;
+
+    run = ctx.readLiteralRun(out, 4, delimiterFound);
+    TEST_ASSERT_EQUAL_MESSAGE(4, run, "RAM run should be bounded by maxLen");
+    TEST_ASSERT_FALSE_MESSAGE(delimiterFound, "Bounded RAM run should not report a delimiter");
+    run = ctx.readLiteralRun(out, sizeof(out), delimiterFound);
+    TEST_ASSERT_EQUAL_MESSAGE(3, run, "RAM run should resume where it stopped");
+    TEST_ASSERT_TRUE_MESSAGE(delimiterFound, "RAM run should report the delimiter");
+    TEST_ASSERT_EQUAL_MESSAGE(0, ctx.bufferLen, "RAM templates should not stage through readBuffer");
+
+    Serial.println("[TEST]   TemplateContext literal run tests completed successfully");
+}
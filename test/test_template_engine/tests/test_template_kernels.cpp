@@ -0,0 +1,143 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include "DeviceFrameworkTemplateKernels.h"
+#include "../utils/test_utils.h"
+
+using Kernels = DeviceFrameworkTemplateKernels;
+
+static const size_t KERNEL_TEST_MAX_LEN = 96;
+static const size_t KERNEL_TEST_MAX_ALIGN = 8;
+
+// Deterministic generator so failures reproduce on every target
+static uint32_t kernelTestSeed = 0x2545F491u;
+static uint32_t nextKernelRandom() {
+    kernelTestSeed = kernelTestSeed * 1664525u + 1013904223u;
+    return kernelTestSeed >> 8;
+}
+
+// Fill with printable text and sprinkle `needle` at random positions
+static void fillKernelInput(uint8_t* data, size_t len, uint8_t needle, uint32_t density) {
+    static const char alphabet[] = "abcXYZ019_-. <>/\"=\x80\xff";
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = static_cast<uint8_t>(alphabet[nextKernelRandom() % (sizeof(alphabet) - 1)]);
+        if (density && nextKernelRandom() % density == 0) {
+            data[i] = needle;
+        }
+    }
+}
+
+static size_t availableKernelSets(const Kernels::KernelSet** sets) {
+    size_t count = Kernels::available(sets, 8);
+    TEST_ASSERT_TRUE_MESSAGE(count >= 1, "Scalar kernels should always be available");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("scalar", sets[0]->name, "Scalar kernels should be listed first");
+    return count;
+}
+
+// Test findByte against the scalar reference for every length/alignment
+void test_template_kernels_find_byte() {
+    Serial.println("[TEST]   Testing kernel findByte equivalence...");
+
+    const Kernels::KernelSet* sets[8];
+    size_t count = availableKernelSets(sets);
+    uint8_t storage[KERNEL_TEST_MAX_LEN + KERNEL_TEST_MAX_ALIGN];
+
+    for (size_t s = 1; s < count; ++s) {
+        Serial.println(String("[TEST]     Checking ") + sets[s]->name);
+        for (uint32_t density = 0; density <= 64; density += 16) {
+            for (size_t align = 0; align < KERNEL_TEST_MAX_ALIGN; ++align) {
+                for (size_t len = 0; len <= KERNEL_TEST_MAX_LEN; ++len) {
+                    uint8_t* data = storage + align;
+                    fillKernelInput(data, len, '%', density);
+                    size_t expected = Kernels::scalar().findByte(data, len, '%');
+                    size_t actual = sets[s]->findByte(data, len, '%');
+                    TEST_ASSERT_EQUAL_MESSAGE(expected, actual, "findByte should match scalar");
+                }
+            }
+        }
+    }
+
+    Serial.println("[TEST]   Kernel findByte tests completed successfully");
+}
+
+// Test copyUntil copies the same prefix and reports the same delimiter
+void test_template_kernels_copy_until() {
+    Serial.println("[TEST]   Testing kernel copyUntil equivalence...");
+
+    const Kernels::KernelSet* sets[8];
+    size_t count = availableKernelSets(sets);
+    uint8_t storage[KERNEL_TEST_MAX_LEN + KERNEL_TEST_MAX_ALIGN];
+    uint8_t expectedOut[KERNEL_TEST_MAX_LEN + 1];
+    uint8_t actualOut[KERNEL_TEST_MAX_LEN + KERNEL_TEST_MAX_ALIGN + 1];
+
+    for (size_t s = 1; s < count; ++s) {
+        Serial.println(String("[TEST]     Checking ") + sets[s]->name);
+        for (uint32_t density = 0; density <= 64; density += 16) {
+            for (size_t align = 0; align < KERNEL_TEST_MAX_ALIGN; ++align) {
+                for (size_t len = 0; len <= KERNEL_TEST_MAX_LEN; ++len) {
+                    uint8_t* data = storage + align;
+                    uint8_t* dest = actualOut + (KERNEL_TEST_MAX_ALIGN - 1 - align);
+                    fillKernelInput(data, len, '%', density);
+                    memset(expectedOut, 0xA5, sizeof(expectedOut));
+                    memset(actualOut, 0xA5, sizeof(actualOut));
+
+                    bool expectedFound = false;
+                    bool actualFound = true;
+                    size_t expected = Kernels::scalar().copyUntil(expectedOut, data, len, '%', expectedFound);
+                    size_t actual = sets[s]->copyUntil(dest, data, len, '%', actualFound);
+                    TEST_ASSERT_EQUAL_MESSAGE(expected, actual, "copyUntil length should match scalar");
+                    TEST_ASSERT_EQUAL_MESSAGE(expectedFound, actualFound, "copyUntil delimiter flag should match scalar");
+                    if (expected > 0) {
+                        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expectedOut, dest, expected, "copyUntil bytes should match scalar");
+                    }
+                    TEST_ASSERT_EQUAL_HEX8_MESSAGE(0xA5, dest[actual], "copyUntil should not write past the run");
+                }
+            }
+        }
+    }
+
+    Serial.println("[TEST]   Kernel copyUntil tests completed successfully");
+}
+
+// Test nameSpan classification, including bytes with the high bit set
+void test_template_kernels_name_span() {
+    Serial.println("[TEST]   Testing kernel nameSpan equivalence...");
+
+    const Kernels::KernelSet* sets[8];
+    size_t count = availableKernelSets(sets);
+    uint8_t storage[KERNEL_TEST_MAX_LEN + KERNEL_TEST_MAX_ALIGN];
+
+    // Every byte value in every lane position
+    for (size_t s = 0; s < count; ++s) {
+        for (int value = 0; value < 256; ++value) {
+            for (size_t lane = 0; lane < 40; ++lane) {
+                memset(storage, 'A', 40);
+                storage[lane] = static_cast<uint8_t>(value);
+                size_t expected = Kernels::scalar().nameSpan(storage, 40);
+                TEST_ASSERT_EQUAL_MESSAGE(expected, sets[s]->nameSpan(storage, 40), "nameSpan should classify each byte like scalar");
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(11, Kernels::scalar().nameSpan(reinterpret_cast<const uint8_t*>("WIFI_ssid_2%"), 12),
+        "Scalar nameSpan should stop at the delimiter");
+
+    for (size_t s = 1; s < count; ++s) {
+        Serial.println(String("[TEST]     Checking ") + sets[s]->name);
+        for (size_t align = 0; align < KERNEL_TEST_MAX_ALIGN; ++align) {
+            for (size_t len = 0; len <= KERNEL_TEST_MAX_LEN; ++len) {
+                uint8_t* data = storage + align;
+                for (size_t i = 0; i < len; ++i) {
+                    static const char nameChars[] = "ABCxyz059_";
+                    data[i] = static_cast<uint8_t>(nameChars[nextKernelRandom() % (sizeof(nameChars) - 1)]);
+                }
+                if (len > 0 && nextKernelRandom() % 2 == 0) {
+                    data[nextKernelRandom() % len] = (nextKernelRandom() % 2) ? '%' : 0xC3;
+                }
+                size_t expected = Kernels::scalar().nameSpan(data, len);
+                TEST_ASSERT_EQUAL_MESSAGE(expected, sets[s]->nameSpan(data, len), "nameSpan should match scalar");
+            }
+        }
+    }
+
+    Serial.println("[TEST]   Kernel nameSpan tests completed successfully");
+}
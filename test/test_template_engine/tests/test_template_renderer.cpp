@@ -3,10 +3,16 @@
 #include <TemplateEngine.h>
 #include <pgmspace.h>
 #include <array>
+#if !defined(ESP8266)
+  #include <atomic>
+  #include <thread>
+#endif
 #include "../templates/simple_templates.h"
 #include "../templates/placeholder_templates.h"
 #include "../templates/nested_templates.h"
 #include "../templates/large_templates.h"
+#include "../templates/compiled_templates.h"
+#include "../templates/tokenized_templates.h"
 #include "../utils/test_utils.h"
 
 // Test RAM data getters
@@ -354,8 +360,7 @@ static void initializeWifiOverrides() {
     for (size_t item = 0; item < 3; ++item) {
         for (size_t field = 0; field < 2; ++field) {
             PlaceholderEntry& entry = wifiOverrideEntries[item][field];
-            memset(entry.name, 0, sizeof(entry.name));
-            strncpy(entry.name, placeholderNames[field], sizeof(entry.name) - 1);
+            entry.name = placeholderNames[field];
             entry.type = PlaceholderType::PROGMEM_DATA;
             entry.data = progmemData[item][field];
             entry.getLength = DeviceFrameworkPlaceholderRegistry::getProgmemLength;
@@ -1378,3 +1383,1322 @@ void test_template_renderer_iterator_stall_guard() {
     TEST_ASSERT_TRUE_MESSAGE(stalledIteratorState.calls > 0, "Stalling iterator should be advanced at least once");
 }
 
+
+static const char PROGMEM planCacheTemplate[] = "A%TITLE%B%LATE%C 100%% %CONTENT%D";
+
+static String renderInChunks(TemplateContext& ctx, size_t chunkSize) {
+    String output;
+    uint8_t buffer[64];
+    char text[65];
+    while (!TemplateRenderer::isComplete(ctx) && !ctx.hasError()) {
+        size_t written = TemplateRenderer::renderNextChunk(ctx, buffer, chunkSize);
+        memcpy(text, buffer, written);
+        text[written] = '\0';
+        output += text;
+    }
+    return output;
+}
+
+void test_template_renderer_plan_cache_reuse() {
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+
+    // Reference output from the interpreter (RAM copy of the same template)
+    char ramCopy[sizeof(planCacheTemplate)];
+    strcpy_P(ramCopy, planCacheTemplate);
+    TemplateContext ramCtx;
+    ramCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ramCtx, ramCopy, false);
+    String expected = renderInChunks(ramCtx, 64);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("ATest TitleBC 100 Test ContentD", expected.c_str(), "Interpreter reference output mismatch");
+
+    for (size_t chunkSize = 1; chunkSize <= 40; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, planCacheTemplate);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Planned render should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), output.c_str(), "Planned render should match interpreter at every chunk size");
+    }
+
+    // Every context above shares one plan; once they are done nothing pins it
+    const TemplatePlan* first = registry.acquirePlan(planCacheTemplate, strlen_P(planCacheTemplate));
+    const TemplatePlan* second = registry.acquirePlan(planCacheTemplate, strlen_P(planCacheTemplate));
+    TEST_ASSERT_NOT_NULL_MESSAGE(first, "Template plan should be cached");
+    TEST_ASSERT_TRUE_MESSAGE(first == second, "Repeated lookups should share the cached plan");
+    TEST_ASSERT_EQUAL_MESSAGE(3, first->refCount.load(), "Only the cache and the two lookups should hold the plan");
+    TEST_ASSERT_EQUAL_MESSAGE(9, first->segmentCount, "Plan should hold literal and token segments");
+    TEST_ASSERT_TRUE_MESSAGE(first->segments[1].kind == TemplateSegmentKind::PLACEHOLDER, "%TITLE% should be pre-resolved");
+    TEST_ASSERT_TRUE_MESSAGE(first->segments[3].kind == TemplateSegmentKind::TOKEN, "%LATE% should stay a token");
+    DeviceFrameworkPlaceholderRegistry::releasePlan(first);
+    DeviceFrameworkPlaceholderRegistry::releasePlan(second);
+}
+
+void test_template_renderer_plan_cache_invalidation() {
+    static String lateValue = "Late";
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+
+    String before = renderTemplateToString(planCacheTemplate, registry);
+    TEST_ASSERT_EQUAL_STRING("ATest TitleBC 100 Test ContentD", before.c_str());
+
+    // Start a render, then register %LATE% while the context is mid-template
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, planCacheTemplate);
+    uint8_t buffer[4];
+    size_t written = TemplateRenderer::renderNextChunk(ctx, buffer, 1);
+    TEST_ASSERT_EQUAL_MESSAGE(1, written, "First chunk should hold the leading literal");
+
+    uint32_t generation = registry.getGeneration();
+    TEST_ASSERT_TRUE(registry.registerRamData("%LATE%", []() -> const char* { return lateValue.c_str(); }));
+    TEST_ASSERT_TRUE_MESSAGE(registry.getGeneration() != generation, "Registration should bump the generation");
+
+    String rest = renderInChunks(ctx, 3);
+    TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Stale plan should fall back without error");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("Test TitleBLateC 100 Test ContentD", rest.c_str(), "In-flight render should see the new placeholder");
+
+    String after = renderTemplateToString(planCacheTemplate, registry);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("ATest TitleBLateC 100 Test ContentD", after.c_str(), "New renders should rebuild the plan");
+
+    registry.clear();
+    String cleared = renderTemplateToString(planCacheTemplate, registry);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("ABC 100 D", cleared.c_str(), "clear() should invalidate cached plans");
+}
+
+// More templates than plan cache slots, so renders evict plans other contexts are still walking
+static const char PROGMEM sharedPlan0[] = "0:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan1[] = "1:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan2[] = "2:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan3[] = "3:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan4[] = "4:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan5[] = "5:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan6[] = "6:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan7[] = "7:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan8[] = "8:%TITLE%|%CONTENT%";
+static const char PROGMEM sharedPlan9[] = "9:%TITLE%|%CONTENT%";
+static const char* const sharedPlanTemplates[] = {sharedPlan0, sharedPlan1, sharedPlan2, sharedPlan3, sharedPlan4,
+                                                  sharedPlan5, sharedPlan6, sharedPlan7, sharedPlan8, sharedPlan9};
+static const size_t SHARED_PLAN_TEMPLATES = sizeof(sharedPlanTemplates) / sizeof(sharedPlanTemplates[0]);
+
+static bool isSharedPlanOutput(const String& output, size_t index) {
+    return output.length() > 0 && output[0] == static_cast<char>('0' + index) &&
+           strcmp(output.c_str() + 1, ":Test Title|Test Content") == 0;
+}
+
+// Test several contexts rendering through one registry's plan cache at once
+void test_template_renderer_plan_cache_concurrent() {
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+
+    static const size_t CONTEXTS = 4;
+#if defined(ESP8266)
+    // Single core, no threads: interleave the contexts chunk by chunk instead
+    for (size_t round = 0; round < 50; ++round) {
+        std::array<TemplateContext, CONTEXTS> contexts;
+        String outputs[CONTEXTS];
+        for (size_t c = 0; c < CONTEXTS; ++c) {
+            contexts[c].setRegistry(&registry);
+            TemplateRenderer::initializeContext(contexts[c], sharedPlanTemplates[(round + c * 3) % SHARED_PLAN_TEMPLATES]);
+        }
+        bool pending = true;
+        while (pending) {
+            pending = false;
+            for (size_t c = 0; c < CONTEXTS; ++c) {
+                if (TemplateRenderer::isComplete(contexts[c])) {
+                    continue;
+                }
+                uint8_t buffer[4];
+                char text[5];
+                size_t written = TemplateRenderer::renderNextChunk(contexts[c], buffer, 1 + (round + c) % 4);
+                memcpy(text, buffer, written);
+                text[written] = '\0';
+                outputs[c] += text;
+                pending = true;
+            }
+        }
+        for (size_t c = 0; c < CONTEXTS; ++c) {
+            TEST_ASSERT_TRUE_MESSAGE(isSharedPlanOutput(outputs[c], (round + c * 3) % SHARED_PLAN_TEMPLATES), outputs[c].c_str());
+        }
+    }
+#else
+    static const size_t RENDERS_PER_CONTEXT = 500;
+    std::atomic<size_t> wrong(0);
+    std::thread threads[CONTEXTS];
+    for (size_t t = 0; t < CONTEXTS; ++t) {
+        threads[t] = std::thread([&registry, &wrong, t]() {
+            TemplateContext ctx;
+            ctx.setRegistry(&registry);
+            for (size_t i = 0; i < RENDERS_PER_CONTEXT; ++i) {
+                size_t index = (i + t * 3) % SHARED_PLAN_TEMPLATES;
+                TemplateRenderer::initializeContext(ctx, sharedPlanTemplates[index]);
+                if (!isSharedPlanOutput(renderInChunks(ctx, 1 + (i + t) % 8), index)) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (size_t t = 0; t < CONTEXTS; ++t) {
+        threads[t].join();
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(0, wrong.load(), "A render through the shared plan cache produced the wrong output");
+#endif
+
+    // Whatever is still cached is held by the cache alone once every render is done
+    const TemplatePlan* plan = registry.acquirePlan(sharedPlan9, strlen_P(sharedPlan9));
+    TEST_ASSERT_NOT_NULL(plan);
+    TEST_ASSERT_EQUAL(2, plan->refCount.load());
+    DeviceFrameworkPlaceholderRegistry::releasePlan(plan);
+}
+
+#if __cplusplus >= 201402L
+DFTE_TEMPLATE(staticLayoutTemplate, "<main>%TITLE%|%STATIC_ITEM%|%MISSING%</main>");
+DFTE_TEMPLATE(staticItemTemplate, "<i>%CONTENT%</i>");
+
+// Token limits are enforced by the compiler, not at render time
+static_assert(staticLayoutTemplate.segmentCount == 7, "Static layout should split into 7 segments");
+static_assert(::dfte::detail::staticTokensFit("%ABCDEFGHIJKLMNOPQRSTU%", 23), "22-byte names fit the default limit");
+static_assert(!::dfte::detail::staticTokensFit("%ABCDEFGHIJKLMNOPQRSTUV%", 24), "Overlong names must be rejected");
+static_assert(!::dfte::detail::staticTokensFit("50% done", 8), "Unterminated tokens must be rejected");
+#endif
+
+void test_template_renderer_static_template() {
+#if __cplusplus >= 201402L
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE_MESSAGE(registry.registerStaticTemplate("%STATIC_ITEM%", &staticItemTemplate), "Static template placeholder should register");
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerStaticTemplate("%NULL%", nullptr), "Null static template should be rejected");
+
+    for (size_t chunkSize = 1; chunkSize <= 24; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, staticLayoutTemplate);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Static template render should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE("<main>Test Title|<i>Test Content</i>|</main>", output.c_str(),
+            "Static template should render like its PROGMEM equivalent");
+    }
+
+    // The plan comes from the compile-time table and is keyed by the flash text
+    const TemplatePlan* plan = registry.acquirePlan(staticLayoutTemplate.text, staticLayoutTemplate.length, &staticLayoutTemplate);
+    TEST_ASSERT_NOT_NULL_MESSAGE(plan, "Static template plan should be cached");
+    TEST_ASSERT_EQUAL_MESSAGE(staticLayoutTemplate.segmentCount, plan->segmentCount, "Plan should mirror the static table");
+    TEST_ASSERT_TRUE_MESSAGE(plan->segments[3].kind == TemplateSegmentKind::PLACEHOLDER, "%STATIC_ITEM% should be resolved");
+    TEST_ASSERT_TRUE_MESSAGE(plan->segments[5].kind == TemplateSegmentKind::TOKEN, "%MISSING% should stay a token");
+    DeviceFrameworkPlaceholderRegistry::releasePlan(plan);
+#else
+    TEST_IGNORE_MESSAGE("DFTE_TEMPLATE requires C++14");
+#endif
+}
+
+// Same bytes as templates/compiled_layout.html and compiled_card.html, for the interpreter reference
+static const char PROGMEM compiledLayoutSource[] =
+    "<html><head><title>%TITLE%</title></head>\n"
+    "<body class=\"main\">%CONTENT% 100%% done?\? %CARD%%TITLE%<p>%MISSING%</p></body></html>\n";
+static const char PROGMEM compiledCardSource[] = "<div class=\"card\">%CONTENT%</div>";
+
+void test_template_renderer_compiled_template() {
+    PlaceholderRegistry interpretedRegistry(4);
+    TEST_ASSERT_TRUE(interpretedRegistry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(interpretedRegistry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(interpretedRegistry.registerProgmemTemplate("%CARD%", compiledCardSource));
+    String expected = renderTemplateToString(compiledLayoutSource, interpretedRegistry);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(
+        "<html><head><title>Test Title</title></head>\n"
+        "<body class=\"main\">Test Content 100 done?\? <div class=\"card\">Test Content</div>Test Title<p></p></body></html>\n",
+        expected.c_str(), "Interpreter reference output mismatch");
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE_MESSAGE(registry.registerCompiledTemplate("%CARD%", &dfte_test_compiled_card), "Compiled template placeholder should register");
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerCompiledTemplate("%NULL%", nullptr), "Null compiled template should be rejected");
+
+    for (size_t chunkSize = 1; chunkSize <= 48; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, dfte_test_compiled_layout);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Compiled template render should not error");
+        TEST_ASSERT_TRUE_MESSAGE(ctx.isComplete(), "Compiled template render should complete");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), output.c_str(), "Compiled render should match interpreter at every chunk size");
+    }
+
+    TemplateContext emptyCtx;
+    emptyCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(emptyCtx, dfte_test_compiled_empty);
+    uint8_t buffer[8];
+    TEST_ASSERT_EQUAL_MESSAGE(0, TemplateRenderer::renderNextChunk(emptyCtx, buffer, sizeof(buffer)), "Empty compiled template should emit nothing");
+    TEST_ASSERT_TRUE_MESSAGE(emptyCtx.isComplete() && !emptyCtx.hasError(), "Empty compiled template should complete cleanly");
+}
+
+void test_template_renderer_compiled_template_nested() {
+    static const char PROGMEM outerTemplate[] = "[%CARD%|%MAYBE_CARD%|%EMPTY%|%FOOTER%]";
+    static ConditionalDescriptor maybeCard = {
+        [](void*) { return ConditionalBranchResult::TRUE_BRANCH; }, "%CARD%", nullptr, nullptr};
+
+    PlaceholderRegistry registry(6);
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(registry.registerCompiledTemplate("%CARD%", &dfte_test_compiled_card));
+    TEST_ASSERT_TRUE(registry.registerCompiledTemplate("%EMPTY%", &dfte_test_compiled_empty));
+    TEST_ASSERT_TRUE(registry.registerCompiledTemplate("%FOOTER%", &dfte_test_compiled_footer));
+    TEST_ASSERT_TRUE(registry.registerConditional("%MAYBE_CARD%", &maybeCard));
+
+    for (size_t chunkSize = 1; chunkSize <= 16; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, outerTemplate);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Nested compiled template render should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(
+            "[<div class=\"card\">Test Content</div>|<div class=\"card\">Test Content</div>||"
+            "<footer><div class=\"card\">Test Content</div>]", output.c_str(),
+            "Compiled templates should nest inside interpreted templates and conditionals");
+        TEST_ASSERT_EQUAL_MESSAGE(0, ctx.renderingDepth, "Compiled frames should be popped on completion");
+    }
+}
+
+void test_template_renderer_tokenized_template() {
+    static String lateValue = "Late";
+    PlaceholderRegistry interpretedRegistry(4);
+    TEST_ASSERT_TRUE(interpretedRegistry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(interpretedRegistry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(interpretedRegistry.registerProgmemTemplate("%CARD%", compiledCardSource));
+    String expected = renderTemplateToString(compiledLayoutSource, interpretedRegistry);
+
+    PlaceholderRegistry registry(6);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE_MESSAGE(registry.registerTokenizedTemplate("%CARD%", &dfte_test_tok_compiled_card), "Tokenized template placeholder should register");
+    TEST_ASSERT_FALSE_MESSAGE(registry.registerTokenizedTemplate("%NULL%", nullptr), "Null tokenized template should be rejected");
+
+    for (size_t chunkSize = 1; chunkSize <= 48; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, dfte_test_tok_compiled_layout);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Tokenized template render should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), output.c_str(), "Tokenized render should match interpreter at every chunk size");
+    }
+
+    // Token ids index straight into the registry entries
+    const PlaceholderEntry* title = registry.getPlaceholderByToken(&dfte_test_tok_tokens, 1);
+    TEST_ASSERT_TRUE_MESSAGE(title == registry.getPlaceholder("%TITLE%"), "Token id should map to the %TITLE% entry");
+    TEST_ASSERT_NULL_MESSAGE(registry.getPlaceholderByToken(&dfte_test_tok_tokens, 4), "%MISSING% should not resolve");
+    TEST_ASSERT_NULL_MESSAGE(registry.getPlaceholderByToken(&dfte_test_tok_tokens, 99), "Ids outside the table should not resolve");
+
+    // A registration after the index was built must be picked up
+    TEST_ASSERT_TRUE(registry.registerRamData("%MISSING%", []() -> const char* { return lateValue.c_str(); }));
+    TemplateContext lateCtx;
+    lateCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(lateCtx, dfte_test_tok_compiled_layout);
+    String late = renderInChunks(lateCtx, 64);
+    TEST_ASSERT_TRUE_MESSAGE(late.indexOf("<p>Late</p>") >= 0, "Late registration should rebuild the token index");
+
+    TemplateContext emptyCtx;
+    emptyCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(emptyCtx, dfte_test_tok_compiled_empty);
+    uint8_t buffer[8];
+    TEST_ASSERT_EQUAL_MESSAGE(0, TemplateRenderer::renderNextChunk(emptyCtx, buffer, sizeof(buffer)), "Empty tokenized template should emit nothing");
+    TEST_ASSERT_TRUE_MESSAGE(emptyCtx.isComplete() && !emptyCtx.hasError(), "Empty tokenized template should complete cleanly");
+}
+
+// Multi-byte varint ids, ids outside the table and a truncated trailing id
+void test_template_renderer_tokenized_varint_ids() {
+    static const uint16_t TOKEN_COUNT = 200;
+    static char names[TOKEN_COUNT][8];
+    static const char* nameTable[TOKEN_COUNT];
+    for (uint16_t i = 0; i < TOKEN_COUNT; ++i) {
+        snprintf(names[i], sizeof(names[i]), "%%T%u%%", static_cast<unsigned>(i));
+        nameTable[i] = names[i];
+    }
+    static const TokenTable table = {nameTable, TOKEN_COUNT};
+
+    // "a" <0> "b" <127> "c" <128> "d" <199> "e" <250: unknown> "f" <truncated>
+    static const char PROGMEM encoded[] =
+        "a\000\000b\000\177c\000\200\001d\000\307\001e\000\372\001f\000\200";
+    static const TokenizedTemplate tokenized = {encoded, sizeof(encoded) - 1, &table};
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%T0%", []() -> const char* { return "[0]"; }));
+    TEST_ASSERT_TRUE(registry.registerRamData("%T127%", []() -> const char* { return "[127]"; }));
+    TEST_ASSERT_TRUE(registry.registerRamData("%T128%", []() -> const char* { return "[128]"; }));
+    TEST_ASSERT_TRUE(registry.registerRamData("%T199%", []() -> const char* { return "[199]"; }));
+
+    for (size_t chunkSize = 1; chunkSize <= 8; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, tokenized);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Varint ids should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE("a[0]b[127]c[128]d[199]ef", output.c_str(), "Varint ids should resolve across byte boundaries");
+    }
+}
+
+// Dynamic template that includes itself `remaining` more times before switching to `last`
+struct NestingChain {
+    size_t remaining;
+    const char* repeat;
+    const char* last;
+};
+
+static const char* nestingChainTemplate(void* userData) {
+    NestingChain* chain = static_cast<NestingChain*>(userData);
+    if (chain->remaining == 0) {
+        return chain->last;
+    }
+    chain->remaining--;
+    return chain->repeat;
+}
+
+static TemplateContext* nestingProbeCtx = nullptr;
+static int nestingProbeDepth = 0;
+static String nestingProbeValue;
+
+static const char* nestingDepthProbe() {
+    nestingProbeDepth = nestingProbeCtx ? nestingProbeCtx->renderingDepth : -1;
+    nestingProbeValue = String(nestingProbeDepth);
+    return nestingProbeValue.c_str();
+}
+
+static ConditionalBranchResult nestingAlwaysTrue(void*) {
+    return ConditionalBranchResult::TRUE_BRANCH;
+}
+
+// Nested templates and conditional delegates take a single stack frame each
+void test_template_renderer_single_frame_nesting() {
+    const size_t levels = TemplateContext::MAX_RENDERING_DEPTH - 2;
+
+    NestingChain chain = {0, "[%NEST_IF%]", "%DEPTH%."};
+    DynamicTemplateDescriptor nestDescriptor = {nestingChainTemplate, nullptr, &chain};
+    ConditionalDescriptor nestIf = {nestingAlwaysTrue, "%NEST%", nullptr, nullptr};
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerDynamicTemplate("%NEST%", &nestDescriptor));
+    TEST_ASSERT_TRUE(registry.registerConditional("%NEST_IF%", &nestIf));
+    TEST_ASSERT_TRUE(registry.registerRamData("%DEPTH%", nestingDepthProbe));
+
+    // Root + `levels` templates + the data leaf fills the stack exactly
+    String expected;
+    for (size_t i = 1; i < levels; ++i) {
+        expected += "[";
+    }
+    expected += String(TemplateContext::MAX_RENDERING_DEPTH) + ".";
+    for (size_t i = 1; i < levels; ++i) {
+        expected += "]";
+    }
+    expected += "!";
+
+    for (size_t chunkSize = 1; chunkSize <= 16; chunkSize += 15) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        nestingProbeCtx = &ctx;
+        chain.remaining = levels - 1;
+        TemplateRenderer::initializeContext(ctx, "%NEST%!", false);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Nesting up to the stack depth should not overflow");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), output.c_str(), "Each nesting level should use one frame");
+        TEST_ASSERT_EQUAL_MESSAGE(0, ctx.renderingDepth, "All frames should be popped on completion");
+    }
+
+    // One level more than the stack holds still fails cleanly
+    TemplateContext overflowCtx;
+    overflowCtx.setRegistry(&registry);
+    nestingProbeCtx = &overflowCtx;
+    chain.remaining = levels;
+    TemplateRenderer::initializeContext(overflowCtx, "%NEST%!", false);
+    renderInChunks(overflowCtx, 32);
+    TEST_ASSERT_TRUE_MESSAGE(overflowCtx.hasError(), "Nesting past the stack depth should report an error");
+    nestingProbeCtx = nullptr;
+}
+
+// Includes in tail position replace the finished caller frame instead of stacking on it
+void test_template_renderer_tail_include_elision() {
+    const size_t links = TemplateContext::MAX_RENDERING_DEPTH * 3;
+
+    NestingChain chain = {0, "x%TAIL%", "end:%DEPTH%"};
+    DynamicTemplateDescriptor tailDescriptor = {nestingChainTemplate, nullptr, &chain};
+    NestingChain selfChain = {0, "A%SELF%", "A%SELF%"};
+    DynamicTemplateDescriptor selfDescriptor = {nestingChainTemplate, nullptr, &selfChain};
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerDynamicTemplate("%TAIL%", &tailDescriptor));
+    TEST_ASSERT_TRUE(registry.registerDynamicTemplate("%SELF%", &selfDescriptor));
+    TEST_ASSERT_TRUE(registry.registerRamData("%DEPTH%", nestingDepthProbe));
+
+    String expected = "<";
+    for (size_t i = 0; i < links; ++i) {
+        expected += "x";
+    }
+    expected += "end:2>";
+
+    for (size_t chunkSize = 1; chunkSize <= 64; chunkSize *= 4) {
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        nestingProbeCtx = &ctx;
+        chain.remaining = links;
+        TemplateRenderer::initializeContext(ctx, "<%TAIL%>", false);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "A tail include chain longer than the stack should render");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), output.c_str(), "Tail includes should render in order");
+    }
+    nestingProbeCtx = nullptr;
+
+    // A template that includes itself in tail position is stopped instead of looping forever
+    TemplateContext selfCtx;
+    selfCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(selfCtx, "%SELF%", false);
+    String selfOutput = renderInChunks(selfCtx, 16);
+    TEST_ASSERT_TRUE_MESSAGE(selfCtx.hasError(), "Unbounded tail recursion should report an error");
+    TEST_ASSERT_EQUAL_MESSAGE(DFTE_MAX_TAIL_INCLUDES, selfOutput.length(), "Tail recursion should stop at DFTE_MAX_TAIL_INCLUDES");
+}
+
+#if __cplusplus >= 201402L
+static const char PROGMEM staticRegistryPage[] = "<%HEADER%>%CSS%|%BANNER%|%CARD%|%TOK_CARD%|%MISSING%.";
+static const char PROGMEM staticRegistryHeader[] = "h:%TITLE%";
+static const char PROGMEM staticRegistryCss[] = "b{}";
+static const ConditionalDescriptor staticRegistryBanner = {
+    [](void*) { return ConditionalBranchResult::FALSE_BRANCH; }, "%HEADER%", "%CSS%", nullptr};
+
+DFTE_STATIC_REGISTRY(staticPageRegistry,
+    dfte::progmemTemplate("%HEADER%", staticRegistryHeader),
+    dfte::progmemData("%CSS%", staticRegistryCss),
+    dfte::ramData<getTestTitle>("%TITLE%"),
+    dfte::ramData<getTestContent>("%CONTENT%"),
+    dfte::conditional("%BANNER%", &staticRegistryBanner),
+    dfte::compiledTemplate("%CARD%", &dfte_test_compiled_card),
+    dfte::tokenizedTemplate("%TOK_CARD%", &dfte_test_tok_compiled_card));
+#endif
+
+void test_template_renderer_static_registry() {
+#if __cplusplus >= 201402L
+    for (size_t chunkSize = 1; chunkSize <= 24; ++chunkSize) {
+        TemplateContext ctx;
+        ctx.setRegistry(&staticPageRegistry);
+        TemplateRenderer::initializeContext(ctx, staticRegistryPage);
+        String output = renderInChunks(ctx, chunkSize);
+        TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Static registry render should not error");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(
+            "<h:Test Title>b{}|b{}|<div class=\"card\">Test Content</div>|<div class=\"card\">Test Content</div>|.",
+            output.c_str(), "Static registry should render like a runtime registry");
+    }
+
+    // Same page against the runtime registry
+    PlaceholderRegistry registry(8);
+    TEST_ASSERT_TRUE(registry.registerProgmemTemplate("%HEADER%", staticRegistryHeader));
+    TEST_ASSERT_TRUE(registry.registerProgmemData("%CSS%", staticRegistryCss));
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(registry.registerConditional("%BANNER%", &staticRegistryBanner));
+    TEST_ASSERT_TRUE(registry.registerCompiledTemplate("%CARD%", &dfte_test_compiled_card));
+    TEST_ASSERT_TRUE(registry.registerTokenizedTemplate("%TOK_CARD%", &dfte_test_tok_compiled_card));
+    TemplateContext staticCtx;
+    staticCtx.setRegistry(&staticPageRegistry);
+    TemplateRenderer::initializeContext(staticCtx, staticRegistryPage);
+    TEST_ASSERT_EQUAL_STRING(renderTemplateToString(staticRegistryPage, registry).c_str(), renderInChunks(staticCtx, 7).c_str());
+#endif
+}
+
+static const char PROGMEM overlayPage[] = "<%HEADER%>[%USER%]%CARD%|%TOK_CARD%.";
+static const char PROGMEM overlayHeader[] = "h:%TITLE%";
+
+void test_template_renderer_overlay() {
+    PlaceholderRegistry registry(8);
+    TEST_ASSERT_TRUE(registry.registerProgmemTemplate("%HEADER%", overlayHeader));
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(registry.registerCompiledTemplate("%CARD%", &dfte_test_compiled_card));
+    TEST_ASSERT_TRUE(registry.registerTokenizedTemplate("%TOK_CARD%", &dfte_test_tok_compiled_card));
+    uint32_t generation = registry.getGeneration();
+
+    for (size_t chunkSize = 1; chunkSize <= 24; ++chunkSize) {
+        // Two requests share the base; only the second shadows a base name
+        PlaceholderOverlay alice(&registry);
+        TEST_ASSERT_TRUE(alice.registerString("%USER%", "alice"));
+        PlaceholderOverlay bob(&registry);
+        TEST_ASSERT_TRUE(bob.registerString("%USER%", "bob"));
+        TEST_ASSERT_TRUE(bob.registerString("%CONTENT%", "Bob Content"));
+
+        TemplateContext aliceCtx;
+        aliceCtx.setRegistry(&alice);
+        TemplateRenderer::initializeContext(aliceCtx, overlayPage);
+        TemplateContext bobCtx;
+        bobCtx.setRegistry(&bob);
+        TemplateRenderer::initializeContext(bobCtx, overlayPage);
+
+        // Interleave the chunks like concurrent responses
+        String aliceOutput;
+        String bobOutput;
+        char text[32];
+        while (!TemplateRenderer::isComplete(aliceCtx) || !TemplateRenderer::isComplete(bobCtx)) {
+            TEST_ASSERT_FALSE(aliceCtx.hasError());
+            TEST_ASSERT_FALSE(bobCtx.hasError());
+            size_t written = TemplateRenderer::renderNextChunk(aliceCtx, reinterpret_cast<uint8_t*>(text), chunkSize);
+            text[written] = '\0';
+            aliceOutput += text;
+            written = TemplateRenderer::renderNextChunk(bobCtx, reinterpret_cast<uint8_t*>(text), chunkSize);
+            text[written] = '\0';
+            bobOutput += text;
+        }
+
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(
+            "<h:Test Title>[alice]<div class=\"card\">Test Content</div>|<div class=\"card\">Test Content</div>.",
+            aliceOutput.c_str(), "Overlay binding should render alongside base placeholders");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(
+            "<h:Test Title>[bob]<div class=\"card\">Bob Content</div>|<div class=\"card\">Bob Content</div>.",
+            bobOutput.c_str(), "Overlay binding should shadow the base in every template format");
+    }
+
+    TEST_ASSERT_EQUAL_MESSAGE(generation, registry.getGeneration(), "Overlays must not modify the shared registry");
+    TEST_ASSERT_NULL(registry.getPlaceholder("%USER%"));
+}
+
+// Iterator rows with many item placeholders, one of which shadows a registry name
+static const char PROGMEM scopeItemTemplate[] = "<%TITLE%:%F1%,%F5%,%F9%,%CONTENT%>";
+static const char scopeRamItemTemplate[] = "<%TITLE%:%F1%,%F5%,%F9%,%CONTENT%>";
+static const char PROGMEM scopeValues[10][4] = {"t", "f1", "f2", "f3", "f4", "f5", "f6", "f7", "f8", "f9"};
+static const char* const scopeNames[10] = {"%TITLE%", "%F1%", "%F2%", "%F3%", "%F4%", "%F5%", "%F6%", "%F7%", "%F8%", "%F9%"};
+
+struct ScopeIteratorState {
+    size_t index;
+    size_t rows;
+    bool progmem;
+    size_t placeholderCount;
+    bool alternateArrays;
+    bool renameRows;
+    PlaceholderEntry entries[2][10];
+};
+
+static ScopeIteratorState scopeIteratorState;
+
+static void* scopeIteratorOpen(void* userData) {
+    ScopeIteratorState* state = static_cast<ScopeIteratorState*>(userData);
+    state->index = 0;
+    return state;
+}
+
+static IteratorStepResult scopeIteratorNext(void* handle, IteratorItemView& view) {
+    ScopeIteratorState* state = static_cast<ScopeIteratorState*>(handle);
+    if (state->index >= state->rows) {
+        return IteratorStepResult::COMPLETE;
+    }
+    size_t row = state->index++;
+    view.templateData = state->progmem ? scopeItemTemplate : scopeRamItemTemplate;
+    view.templateLength = 0;
+    view.templateIsProgmem = state->progmem;
+    view.placeholders = state->entries[state->alternateArrays ? row % 2 : 0];
+    view.placeholderCount = state->placeholderCount;
+    if (state->renameRows) {
+        // Same array and count on every row, but odd rows bind the field to another name
+        state->entries[0][1].name = (row % 2) ? scopeNames[5] : scopeNames[1];
+    }
+    return IteratorStepResult::ITEM_READY;
+}
+
+static const IteratorDescriptor scopeIteratorDescriptor = {scopeIteratorOpen, scopeIteratorNext, nullptr, &scopeIteratorState};
+static const char PROGMEM scopePage[] = "[%ROWS%]";
+
+void test_template_renderer_iterator_scope() {
+    for (size_t array = 0; array < 2; ++array) {
+        for (size_t field = 0; field < 10; ++field) {
+            PlaceholderEntry& entry = scopeIteratorState.entries[array][field];
+            entry.name = scopeNames[field];
+            entry.type = PlaceholderType::PROGMEM_DATA;
+            entry.data = scopeValues[field];
+            entry.getLength = DeviceFrameworkPlaceholderRegistry::getProgmemLength;
+        }
+    }
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%TITLE%", getTestTitle));
+    TEST_ASSERT_TRUE(registry.registerRamData("%CONTENT%", getTestContent));
+    TEST_ASSERT_TRUE(registry.registerIterator("%ROWS%", &scopeIteratorDescriptor));
+
+    // 4 placeholders fit the index, 10 are scanned; both resolve item names before the registry
+    const size_t counts[] = {4, 10};
+    for (size_t count : counts) {
+        for (int variant = 0; variant < 4; ++variant) {
+            scopeIteratorState.rows = 3;
+            scopeIteratorState.progmem = (variant & 1) != 0;
+            scopeIteratorState.alternateArrays = (variant & 2) != 0;
+            scopeIteratorState.placeholderCount = count;
+
+            // Names past the item's count are unknown and render nothing
+            const char* expected = count == 4
+                ? "[<t:f1,,,Test Content><t:f1,,,Test Content><t:f1,,,Test Content>]"
+                : "[<t:f1,f5,f9,Test Content><t:f1,f5,f9,Test Content><t:f1,f5,f9,Test Content>]";
+
+            for (size_t chunkSize = 1; chunkSize <= 16; chunkSize += 5) {
+                TemplateContext ctx;
+                ctx.setRegistry(&registry);
+                TemplateRenderer::initializeContext(ctx, scopePage);
+                String output = renderInChunks(ctx, chunkSize);
+                TEST_ASSERT_FALSE_MESSAGE(ctx.hasError(), "Iterator scope render should not error");
+                TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, output.c_str(), "Item placeholders should shadow the registry");
+            }
+        }
+    }
+
+    // Duplicate item names: the first entry wins, as with a scan
+    scopeIteratorState.entries[0][1].name = "%TITLE%";
+    scopeIteratorState.entries[0][1].data = scopeValues[1];
+    scopeIteratorState.alternateArrays = false;
+    scopeIteratorState.placeholderCount = 4;
+    scopeIteratorState.rows = 1;
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, scopePage);
+    TEST_ASSERT_EQUAL_STRING("[<t:,,,Test Content>]", renderInChunks(ctx, 8).c_str());
+
+    // The index is keyed by the row's name pointers, so renaming a field in the same array re-indexes it
+    scopeIteratorState.entries[0][0].name = scopeNames[0];
+    scopeIteratorState.entries[0][0].data = scopeValues[0];
+    scopeIteratorState.renameRows = true;
+    scopeIteratorState.rows = 3;
+    TemplateRenderer::initializeContext(ctx, scopePage);
+    String renamed = renderInChunks(ctx, 8);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("[<t:f1,,,Test Content><t:,f1,,Test Content><t:f1,,,Test Content>]", renamed.c_str(),
+                                     "Rows with other names in the same array should not reuse the index");
+    scopeIteratorState.renameRows = false;
+    scopeIteratorState.entries[0][1].name = scopeNames[1];
+}
+
+// Getter that changes its value on every call, counting calls (a sensor read or formatter)
+struct SnapshotGetterState {
+    int calls;
+    char buffers[2][48];
+};
+static SnapshotGetterState snapshotState = {};
+
+static const char* getSnapshotRamValue() {
+    snapshotState.calls++;
+    char* buffer = snapshotState.buffers[snapshotState.calls & 1];
+    snprintf(buffer, sizeof(snapshotState.buffers[0]), "reading-%d-%s", snapshotState.calls,
+             (snapshotState.calls & 1) ? "odd-and-longer" : "even");
+    return buffer;
+}
+
+static const char* getSnapshotDynamicValue(void* userData) {
+    (void)userData;
+    return getSnapshotRamValue();
+}
+
+static const DynamicDataDescriptor snapshotDynamicDescriptor = {getSnapshotDynamicValue, nullptr, nullptr};
+
+// Test that RAM_DATA and DYNAMIC_DATA getters run once per occurrence and stream a consistent value
+void test_template_renderer_data_snapshot() {
+    static const char PROGMEM snapshotTemplate[] = "[%SNAP_RAM%][%SNAP_DYN%][%SNAP_RAM%]";
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRamData("%SNAP_RAM%", getSnapshotRamValue));
+    TEST_ASSERT_TRUE(registry.registerDynamicData("%SNAP_DYN%", &snapshotDynamicDescriptor));
+
+    static const size_t CHUNK_SIZES[] = {1, 3, 7, 64};
+    for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+        snapshotState.calls = 0;
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, snapshotTemplate);
+        String output = captureRenderedOutput(ctx, CHUNK_SIZES[c]);
+
+        TEST_ASSERT_EQUAL_MESSAGE(3, snapshotState.calls, "Each occurrence should call its getter exactly once");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE("[reading-1-odd-and-longer][reading-2-even][reading-3-odd-and-longer]",
+                                         output.c_str(), "Values should not tear across chunks");
+    }
+}
+
+static int memoTitleCalls = 0;
+static int memoConditionCalls = 0;
+static int memoPlainCalls = 0;
+static char memoTitle[24];
+
+static const char* getMemoTitle() {
+    memoTitleCalls++;
+    snprintf(memoTitle, sizeof(memoTitle), "Title%d", memoTitleCalls);
+    return memoTitle;
+}
+
+static const char* getMemoPlain() {
+    memoPlainCalls++;
+    return "plain";
+}
+
+// Reuses the memoized getter's buffer, which it may do once that value has been streamed
+static const char* getMemoClobber() {
+    snprintf(memoTitle, sizeof(memoTitle), "Clobbered");
+    return memoTitle;
+}
+
+struct MemoRows {
+    unsigned index;
+    size_t mark;
+};
+
+static void* openMemoRows(void* userData) {
+    MemoRows* rows = static_cast<MemoRows*>(userData);
+    *rows = MemoRows{0, ScratchArena::current()->mark()};
+    return rows;
+}
+
+// Each row formats its template over the previous one, the way long lists keep the arena small; later
+// rows are longer, so they reach past where the previous row ended
+static IteratorStepResult nextMemoRow(void* handle, IteratorItemView& view) {
+    MemoRows* rows = static_cast<MemoRows*>(handle);
+    unsigned row = rows->index++;
+    if (row == 3) {
+        return IteratorStepResult::COMPLETE;
+    }
+    ScratchArena* scratch = ScratchArena::current();
+    scratch->rewind(rows->mark);
+    view.templateData = scratch->format("%.*s<%%MEMO_TITLE%%>", static_cast<int>(row * 4), "........");
+    view.templateLength = strlen(view.templateData);
+    view.templateIsProgmem = false;
+    return IteratorStepResult::ITEM_READY;
+}
+
+static ConditionalBranchResult evaluateMemoCondition(void* userData) {
+    (void)userData;
+    memoConditionCalls++;
+    return (memoConditionCalls & 1) ? ConditionalBranchResult::TRUE_BRANCH : ConditionalBranchResult::FALSE_BRANCH;
+}
+
+static const char PROGMEM memoYes[] = "yes";
+static const char PROGMEM memoNo[] = "no";
+static const ConditionalDescriptor memoConditionDescriptor = {evaluateMemoCondition, "%MEMO_YES%", "%MEMO_NO%", nullptr};
+
+#if __cplusplus >= 201402L
+static_assert(dfte::memoized(dfte::conditional("%MEMO_COND%", &memoConditionDescriptor)).memoize,
+              "memoized() should mark static placeholders");
+static_assert(!dfte::conditional("%MEMO_COND%", &memoConditionDescriptor).memoize, "Memoization is opt-in");
+#endif
+
+// Test that memoized getters and conditionals are computed once per render and reused by every occurrence
+void test_template_renderer_render_memo() {
+    static const char PROGMEM memoTemplate[] =
+        "<title>%MEMO_TITLE%</title>%MEMO_COND%|%MEMO_TITLE%|%MEMO_COND%|%MEMO_PLAIN%%MEMO_PLAIN%|%MEMO_TITLE%";
+
+    PlaceholderRegistry registry(8);
+    TEST_ASSERT_TRUE(registry.registerRamData("%MEMO_TITLE%", getMemoTitle, true));
+    TEST_ASSERT_TRUE(registry.registerRamData("%MEMO_PLAIN%", getMemoPlain));
+    TEST_ASSERT_TRUE(registry.registerConditional("%MEMO_COND%", &memoConditionDescriptor, true));
+    TEST_ASSERT_TRUE(registry.registerProgmemData("%MEMO_YES%", memoYes));
+    TEST_ASSERT_TRUE(registry.registerProgmemData("%MEMO_NO%", memoNo));
+    TEST_ASSERT_TRUE(registry.getPlaceholder("%MEMO_TITLE%")->memoize);
+    TEST_ASSERT_FALSE(registry.getPlaceholder("%MEMO_PLAIN%")->memoize);
+
+    memoTitleCalls = memoConditionCalls = memoPlainCalls = 0;
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, memoTemplate);
+    String first = captureRenderedOutput(ctx, 5);
+    TEST_ASSERT_EQUAL_STRING("<title>Title1</title>yes|Title1|yes|plainplain|Title1", first.c_str());
+    TEST_ASSERT_EQUAL_MESSAGE(1, memoTitleCalls, "Memoized getter should run once per render");
+    TEST_ASSERT_EQUAL_MESSAGE(1, memoConditionCalls, "Memoized conditional should be evaluated once per render");
+    TEST_ASSERT_EQUAL_MESSAGE(2, memoPlainCalls, "Unmemoized getters still run per occurrence");
+    TEST_ASSERT_EQUAL(2, ctx.memoCount);
+
+    // The memo lives for one render: the next render computes fresh values
+    TemplateRenderer::initializeContext(ctx, memoTemplate);
+    TEST_ASSERT_EQUAL(0, ctx.memoCount);
+    String second = captureRenderedOutput(ctx, 64);
+    TEST_ASSERT_EQUAL_STRING("<title>Title2</title>no|Title2|no|plainplain|Title2", second.c_str());
+    TEST_ASSERT_EQUAL(2, memoTitleCalls);
+    TEST_ASSERT_EQUAL(2, memoConditionCalls);
+
+    // A full memo table falls back to computing per occurrence, with the same output
+    PlaceholderOverlay overlay(&registry);
+    char names[TemplateContext::MEMO_SLOTS][12];
+    String fillTemplate;
+    for (uint8_t i = 0; i < TemplateContext::MEMO_SLOTS; ++i) {
+        snprintf(names[i], sizeof(names[i]), "%%FILL_%u%%", static_cast<unsigned>(i));
+        TEST_ASSERT_TRUE(overlay.registerRamData(names[i], getMemoPlain, true));
+        fillTemplate += names[i];
+    }
+    fillTemplate += "%MEMO_TITLE%%MEMO_TITLE%";
+    memoTitleCalls = 0;
+    ctx.setRegistry(&overlay);
+    TemplateRenderer::initializeContext(ctx, fillTemplate.c_str(), false);
+    String filled = captureRenderedOutput(ctx, 16);
+    TEST_ASSERT_EQUAL(TemplateContext::MEMO_SLOTS, ctx.memoCount);
+    TEST_ASSERT_EQUAL_MESSAGE(2, memoTitleCalls, "Entries that do not fit are computed per occurrence");
+    TEST_ASSERT_TRUE(filled.endsWith("Title1Title2"));
+
+    // Later occurrences read the render's copy, not the getter's buffer, which another getter may reuse
+    static const char PROGMEM clobberTemplate[] = "%MEMO_TITLE%|%MEMO_CLOBBER%|%MEMO_TITLE%";
+    TEST_ASSERT_TRUE(registry.registerRamData("%MEMO_CLOBBER%", getMemoClobber));
+    memoTitleCalls = 0;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, clobberTemplate);
+    String clobbered = captureRenderedOutput(ctx, 4);
+    TEST_ASSERT_EQUAL_STRING("Title1|Clobbered|Title1", clobbered.c_str());
+    TEST_ASSERT_EQUAL(1, memoTitleCalls);
+
+    // An iterator rewinding the arena for each row cannot free a copy memoized inside an earlier row
+    static MemoRows memoRows;
+    static const IteratorDescriptor memoRowIterator = {openMemoRows, nextMemoRow, nullptr, &memoRows};
+    static const char PROGMEM rowTemplate[] = "%MEMO_ROWS%|%MEMO_TITLE%";
+    TEST_ASSERT_TRUE(registry.registerIterator("%MEMO_ROWS%", &memoRowIterator));
+    memoTitleCalls = 0;
+    TemplateRenderer::initializeContext(ctx, rowTemplate);
+    String rows = captureRenderedOutput(ctx, 3);
+    TEST_ASSERT_EQUAL_STRING("<Title1>....<Title1>........<Title1>|Title1", rows.c_str());
+    TEST_ASSERT_EQUAL(1, memoTitleCalls);
+    TEST_ASSERT_FALSE(ctx.hasError());
+}
+
+static int sizedGetterCalls = 0;
+
+static PlaceholderValue getSizedBinaryValue(void* userData) {
+    sizedGetterCalls++;
+    // Binary payload with embedded NULs; length comes from the caller, not strlen
+    static const char payload[] = {'B', '\0', 'I', 'N', '\0', '\0', 'Y'};
+    (void)userData;
+    return PlaceholderValue{payload, sizeof(payload)};
+}
+
+static PlaceholderValue getSizedSlice(void* userData) {
+    // First five bytes of an unterminated view into a larger buffer
+    return PlaceholderValue{static_cast<const char*>(userData), 5};
+}
+
+static PlaceholderValue getSizedNull(void* userData) {
+    (void)userData;
+    return PlaceholderValue{nullptr, 42};
+}
+
+// Test SIZED_DATA placeholders: explicit length, binary-safe, one getter call per occurrence
+void test_template_renderer_sized_data() {
+    static const char PROGMEM sizedTemplate[] = "<%SIZED_BIN%|%SIZED_SLICE%|%SIZED_NULL%|%SIZED_BIN%>";
+    static const char expected[] = {'<', 'B', '\0', 'I', 'N', '\0', '\0', 'Y', '|', 'h', 'e', 'l', 'l', 'o', '|', '|',
+                                    'B', '\0', 'I', 'N', '\0', '\0', 'Y', '>'};
+    static char sliceSource[] = "hello world";
+    static const SizedDataDescriptor binaryDescriptor = {getSizedBinaryValue, nullptr};
+    static const SizedDataDescriptor sliceDescriptor = {getSizedSlice, sliceSource};
+    static const SizedDataDescriptor nullDescriptor = {getSizedNull, nullptr};
+    static const SizedDataDescriptor invalidDescriptor = {nullptr, nullptr};
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerSizedData("%SIZED_BIN%", &binaryDescriptor));
+    TEST_ASSERT_TRUE(registry.registerSizedData("%SIZED_SLICE%", &sliceDescriptor));
+    TEST_ASSERT_FALSE(registry.registerSizedData("%SIZED_BAD%", &invalidDescriptor));
+    TEST_ASSERT_FALSE(registry.registerSizedData("%SIZED_BAD%", nullptr));
+    TEST_ASSERT_EQUAL(PlaceholderType::SIZED_DATA, registry.getPlaceholder("%SIZED_BIN%")->type);
+
+    // Overlay bindings take the same descriptor
+    PlaceholderOverlay overlay(&registry);
+    TEST_ASSERT_TRUE(overlay.registerSizedData("%SIZED_NULL%", &nullDescriptor));
+
+    static const size_t CHUNK_SIZES[] = {1, 3, 64};
+    for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+        sizedGetterCalls = 0;
+        TemplateContext ctx;
+        ctx.setRegistry(&overlay);
+        TemplateRenderer::initializeContext(ctx, sizedTemplate);
+
+        uint8_t output[64];
+        size_t total = 0;
+        while (!TemplateRenderer::isComplete(ctx) && !ctx.hasError() && total < sizeof(output)) {
+            size_t chunk = min(CHUNK_SIZES[c], sizeof(output) - total);
+            total += TemplateRenderer::renderNextChunk(ctx, output + total, chunk);
+        }
+        TEST_ASSERT_FALSE(ctx.hasError());
+        TEST_ASSERT_EQUAL(sizeof(expected), total);
+        TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+        TEST_ASSERT_EQUAL_MESSAGE(2, sizedGetterCalls, "The getter should run once per occurrence");
+    }
+
+    // renderPlaceholder serves the same bytes for callers streaming entries themselves
+    uint8_t direct[8];
+    const PlaceholderEntry* entry = registry.getPlaceholder("%SIZED_BIN%");
+    TEST_ASSERT_EQUAL(4, PlaceholderRegistry::renderPlaceholder(entry, 3, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("N\0\0Y", direct, 4);
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::sizedData("%SIZED_BIN%", &binaryDescriptor).type == PlaceholderType::SIZED_DATA,
+                  "Static registries should accept sized data");
+#endif
+}
+
+static int writerNumberCalls = 0;
+
+static bool writeWriterNumbers(PlaceholderWriter& out, void* userData) {
+    (void)userData;
+    writerNumberCalls++;
+    out.printSigned(INT32_MIN);
+    out.write('/');
+    out.printUnsigned(4294967295u);
+    return true;
+}
+
+// Writes ROWS pieces of "row N;" across as many calls as the chunks need, resuming from the cookie
+static bool writeWriterRows(PlaceholderWriter& out, void* userData) {
+    const uint32_t rows = *static_cast<const uint32_t*>(userData);
+    while (out.cookie() < rows) {
+        if (out.remaining() < 11) {
+            return false;
+        }
+        out.print("row ");
+        out.printUnsigned(out.cookie());
+        out.write(';');
+        out.cookie()++;
+    }
+    return true;
+}
+
+static bool writeWriterStall(PlaceholderWriter& out, void* userData) {
+    (void)out;
+    (void)userData;
+    return false;
+}
+
+static bool writeWriterOversized(PlaceholderWriter& out, void* userData) {
+    (void)userData;
+    static const char PROGMEM longValue[] = "0123456789012345678901234567890123456789012345678901234567890123456789";
+    TEST_ASSERT_FALSE(out.printProgmem(longValue));
+    TEST_ASSERT_TRUE(out.hasOverflowed());
+    return true;
+}
+
+// Test WRITER_DATA placeholders: output formatted straight into the chunk, spilling and resuming across chunks
+void test_template_renderer_writer() {
+    static const char PROGMEM writerTemplate[] = "[%NUMBERS%|%ROWS%|%NUMBERS%]";
+    static uint32_t rowCount = 40;
+    static const WriterDataDescriptor numbersDescriptor = {writeWriterNumbers, nullptr};
+    static const WriterDataDescriptor rowsDescriptor = {writeWriterRows, &rowCount};
+    static const WriterDataDescriptor invalidDescriptor = {nullptr, nullptr};
+
+    String rows;
+    for (uint32_t i = 0; i < rowCount; ++i) {
+        rows += "row " + String(i) + ";";
+    }
+    String expected = "[-2147483648/4294967295|" + rows + "|-2147483648/4294967295]";
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerWriter("%NUMBERS%", &numbersDescriptor));
+    TEST_ASSERT_TRUE(registry.registerWriter("%ROWS%", &rowsDescriptor));
+    TEST_ASSERT_FALSE(registry.registerWriter("%BAD%", &invalidDescriptor));
+    TEST_ASSERT_FALSE(registry.registerWriter("%BAD%", nullptr));
+    TEST_ASSERT_EQUAL(PlaceholderType::WRITER_DATA, registry.getPlaceholder("%ROWS%")->type);
+
+    static const size_t CHUNK_SIZES[] = {1, 2, 7, 25, 512};
+    for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+        writerNumberCalls = 0;
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, writerTemplate);
+        String output = captureRenderedOutput(ctx, CHUNK_SIZES[c]);
+        TEST_ASSERT_FALSE(ctx.hasError());
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+        TEST_ASSERT_EQUAL_MESSAGE(2, writerNumberCalls, "Short values are formatted once, whatever the chunk size");
+    }
+
+    // A callback that neither writes nor finishes fails the render instead of looping
+    static const WriterDataDescriptor stallDescriptor = {writeWriterStall, nullptr};
+    static const char PROGMEM stallTemplate[] = "a%STALL%b";
+    TEST_ASSERT_TRUE(registry.registerWriter("%STALL%", &stallDescriptor));
+    TemplateContext stallCtx;
+    stallCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(stallCtx, stallTemplate);
+    captureRenderedOutput(stallCtx, 16);
+    TEST_ASSERT_TRUE(stallCtx.hasError());
+
+    // Writes larger than chunk plus spill are truncated; the render carries on
+    static const WriterDataDescriptor oversizedDescriptor = {writeWriterOversized, nullptr};
+    static const char PROGMEM oversizedTemplate[] = "<%OVERSIZED%>";
+    TEST_ASSERT_TRUE(registry.registerWriter("%OVERSIZED%", &oversizedDescriptor));
+    TemplateContext oversizedCtx;
+    oversizedCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(oversizedCtx, oversizedTemplate);
+    String oversized = captureRenderedOutput(oversizedCtx, 4);
+    TEST_ASSERT_FALSE(oversizedCtx.hasError());
+    TEST_ASSERT_EQUAL(2 + 3 + DFTE_WRITER_SPILL_SIZE, oversized.length());
+    TEST_ASSERT_TRUE(oversized.startsWith("<012"));
+    TEST_ASSERT_TRUE(oversized.endsWith(">"));
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::writer("%NUMBERS%", &numbersDescriptor).type == PlaceholderType::WRITER_DATA,
+                  "Static registries should accept writers");
+#endif
+}
+
+// Generated log: "line N\n" for N < rows, produced a few bytes at a time with no copy of the whole value
+struct ProducerLogState {
+    uint32_t rows;
+    uint32_t line;       // Line being produced
+    uint8_t linePos;     // Bytes of it already produced
+    size_t produced;     // Must match the offset the renderer passes
+    int opens;
+    int closes;
+    bool offsetMismatch;
+};
+
+static ProducerLogState producerLog = {};
+
+static void* openProducerLog(void* userData) {
+    ProducerLogState* state = static_cast<ProducerLogState*>(userData);
+    state->opens++;
+    state->line = 0;
+    state->linePos = 0;
+    state->produced = 0;
+    return state;
+}
+
+static size_t readProducerLog(void* handle, size_t offset, uint8_t* dest, size_t maxLen) {
+    ProducerLogState* state = static_cast<ProducerLogState*>(handle);
+    if (offset != state->produced) {
+        state->offsetMismatch = true;
+    }
+    size_t count = 0;
+    while (count < maxLen && state->line < state->rows) {
+        char text[16];
+        size_t length = 5;
+        memcpy(text, "line ", 5);
+        length += DeviceFrameworkTypedValue::formatUnsigned(state->line, text + length);
+        text[length++] = '\n';
+        size_t piece = min(maxLen - count, length - state->linePos);
+        memcpy(dest + count, text + state->linePos, piece);
+        count += piece;
+        state->linePos += piece;
+        if (state->linePos == length) {
+            state->line++;
+            state->linePos = 0;
+        }
+    }
+    state->produced += count;
+    return count;
+}
+
+static void closeProducerLog(void* handle) {
+    static_cast<ProducerLogState*>(handle)->closes++;
+}
+
+// Stateless producer over a constant: the handle is userData and any offset can be served
+static size_t readProducerText(void* handle, size_t offset, uint8_t* dest, size_t maxLen) {
+    const char* text = static_cast<const char*>(handle);
+    size_t length = strlen(text);
+    if (offset >= length) {
+        return 0;
+    }
+    size_t count = min(maxLen, length - offset);
+    memcpy(dest, text + offset, count);
+    return count;
+}
+
+static void* openProducerNothing(void* userData) {
+    (void)userData;
+    return nullptr;
+}
+
+// Test PRODUCER_DATA placeholders: content pulled in chunk-sized pieces with open/close once per occurrence
+void test_template_renderer_producer() {
+    static const char PROGMEM producerTemplate[] = "<pre>%EVENT_LOG%</pre>%TEXT%";
+    static const ProducerDescriptor logDescriptor = {openProducerLog, readProducerLog, closeProducerLog, &producerLog};
+    static char producerText[] = "tail";
+    static const ProducerDescriptor textDescriptor = {nullptr, readProducerText, nullptr, producerText};
+    static const ProducerDescriptor invalidDescriptor = {openProducerLog, nullptr, closeProducerLog, &producerLog};
+
+    producerLog = ProducerLogState{};
+    producerLog.rows = 300;
+    String expected = "<pre>";
+    for (uint32_t i = 0; i < producerLog.rows; ++i) {
+        expected += "line " + String(i) + "\n";
+    }
+    expected += "</pre>tail";
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerProducer("%EVENT_LOG%", &logDescriptor));
+    TEST_ASSERT_FALSE(registry.registerProducer("%BAD%", &invalidDescriptor));
+    TEST_ASSERT_FALSE(registry.registerProducer("%BAD%", nullptr));
+    TEST_ASSERT_EQUAL(PlaceholderType::PRODUCER_DATA, registry.getPlaceholder("%EVENT_LOG%")->type);
+
+    // Overlay bindings take the same descriptor
+    PlaceholderOverlay overlay(&registry);
+    TEST_ASSERT_TRUE(overlay.registerProducer("%TEXT%", &textDescriptor));
+
+    static const size_t CHUNK_SIZES[] = {1, 7, 512};
+    for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+        producerLog.opens = 0;
+        producerLog.closes = 0;
+        TemplateContext ctx;
+        ctx.setRegistry(&overlay);
+        TemplateRenderer::initializeContext(ctx, producerTemplate);
+        String output = captureRenderedOutput(ctx, CHUNK_SIZES[c]);
+        TEST_ASSERT_FALSE(ctx.hasError());
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+        TEST_ASSERT_EQUAL_MESSAGE(1, producerLog.opens, "open should run once per occurrence");
+        TEST_ASSERT_EQUAL_MESSAGE(1, producerLog.closes, "close should run once per occurrence");
+    }
+    TEST_ASSERT_FALSE_MESSAGE(producerLog.offsetMismatch, "Offsets should follow the bytes already produced");
+
+    // An abandoned render (client gone) still closes the producer, on reset or when the context goes away
+    producerLog.opens = 0;
+    producerLog.closes = 0;
+    {
+        TemplateContext ctx;
+        ctx.setRegistry(&overlay);
+        TemplateRenderer::initializeContext(ctx, producerTemplate);
+        uint8_t chunk[16];
+        TemplateRenderer::renderNextChunk(ctx, chunk, sizeof(chunk));
+        TEST_ASSERT_EQUAL(1, producerLog.opens);
+        TEST_ASSERT_EQUAL(0, producerLog.closes);
+        ctx.reset();
+        TEST_ASSERT_EQUAL(1, producerLog.closes);
+
+        TemplateRenderer::initializeContext(ctx, producerTemplate);
+        TemplateRenderer::renderNextChunk(ctx, chunk, sizeof(chunk));
+        TEST_ASSERT_EQUAL(2, producerLog.opens);
+    }
+    TEST_ASSERT_EQUAL(2, producerLog.closes);
+
+    // open returning nullptr renders nothing and is not closed
+    static const ProducerDescriptor nothingDescriptor = {openProducerNothing, readProducerLog, closeProducerLog, &producerLog};
+    static const char PROGMEM nothingTemplate[] = "a%NOTHING%b";
+    TEST_ASSERT_TRUE(registry.registerProducer("%NOTHING%", &nothingDescriptor));
+    producerLog.closes = 0;
+    TemplateContext nothingCtx;
+    nothingCtx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(nothingCtx, nothingTemplate);
+    TEST_ASSERT_EQUAL_STRING("ab", captureRenderedOutput(nothingCtx, 16).c_str());
+    TEST_ASSERT_EQUAL(0, producerLog.closes);
+
+    // renderPlaceholder serves producers without an open hook for callers streaming entries themselves
+    uint8_t direct[8];
+    TEST_ASSERT_EQUAL(2, PlaceholderRegistry::renderPlaceholder(overlay.getPlaceholder("%TEXT%"), 2, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("il", direct, 2);
+    TEST_ASSERT_EQUAL(0, PlaceholderRegistry::renderPlaceholder(registry.getPlaceholder("%EVENT_LOG%"), 0, direct, sizeof(direct)));
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::producer("%EVENT_LOG%", &logDescriptor).type == PlaceholderType::PRODUCER_DATA,
+                  "Static registries should accept producers");
+#endif
+}
+
+static char ringStorage[16];
+static std::atomic<size_t> ringHead(0);
+static std::atomic<size_t> ringTail(0);
+static std::atomic<bool> ringFull(false);
+
+static void setRing(const char* contents, size_t tail, size_t head, bool full) {
+    memcpy(ringStorage, contents, sizeof(ringStorage));
+    ringTail = tail;
+    ringHead = head;
+    ringFull = full;
+}
+
+static String renderRing(DeviceFrameworkPlaceholderLookup* registry, size_t chunkSize) {
+    static const char PROGMEM ringTemplate[] = "[%RING%]";
+    TemplateContext ctx;
+    ctx.setRegistry(registry);
+    TemplateRenderer::initializeContext(ctx, ringTemplate);
+    String output = captureRenderedOutput(ctx, chunkSize);
+    TEST_ASSERT_FALSE(ctx.hasError());
+    return output;
+}
+
+// Test RING_DATA placeholders: wrapped contents streamed oldest first as two segments from one index snapshot
+void test_template_renderer_ring_buffer() {
+    static const RingBufferDescriptor ringDescriptor = {ringStorage, sizeof(ringStorage), &ringHead, &ringTail, &ringFull};
+    static const RingBufferDescriptor noStorage = {nullptr, sizeof(ringStorage), &ringHead, &ringTail, nullptr};
+    static const RingBufferDescriptor noCapacity = {ringStorage, 0, &ringHead, &ringTail, nullptr};
+    static const RingBufferDescriptor noHead = {ringStorage, sizeof(ringStorage), nullptr, &ringTail, nullptr};
+
+    PlaceholderRegistry registry(4);
+    TEST_ASSERT_TRUE(registry.registerRingBuffer("%RING%", &ringDescriptor));
+    TEST_ASSERT_FALSE(registry.registerRingBuffer("%BAD%", &noStorage));
+    TEST_ASSERT_FALSE(registry.registerRingBuffer("%BAD%", &noCapacity));
+    TEST_ASSERT_FALSE(registry.registerRingBuffer("%BAD%", &noHead));
+    TEST_ASSERT_FALSE(registry.registerRingBuffer("%BAD%", nullptr));
+    TEST_ASSERT_EQUAL(PlaceholderType::RING_DATA, registry.getPlaceholder("%RING%")->type);
+
+    struct RingCase {
+        const char* storage;
+        size_t tail;
+        size_t head;
+        bool full;
+        const char* expected;
+    };
+    static const RingCase CASES[] = {
+        {"abcdefghijklmnop", 3, 3, false, "[]"},                  // Empty
+        {"abcdefghijklmnop", 2, 9, false, "[cdefghi]"},           // Contiguous
+        {"klmnopXXXXabcdef", 10, 6, false, "[abcdefklmnop]"},     // Wrapped
+        {"mnopabcdefghijkl", 4, 4, true, "[abcdefghijklmnop]"},   // Full, oldest overwritten
+        {"abcdefghijklmnop", 0, 0, true, "[abcdefghijklmnop]"},   // Full, nothing to wrap
+        {"pabcdefghijklmno", 1, 0, false, "[abcdefghijklmno]"},   // Ends exactly at the end of storage
+        {"abcdefghijklmnop", 3, 16, false, "[]"}                  // Index out of range renders nothing
+    };
+    static const size_t CHUNK_SIZES[] = {1, 5, 64};
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); ++i) {
+        for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+            setRing(CASES[i].storage, CASES[i].tail, CASES[i].head, CASES[i].full);
+            TEST_ASSERT_EQUAL_STRING(CASES[i].expected, renderRing(&registry, CHUNK_SIZES[c]).c_str());
+        }
+    }
+
+    // Indices are read once per occurrence: bytes logged after the token is reached wait for the next render
+    setRing("abcdefghijklmnop", 0, 4, false);
+    {
+        static const char PROGMEM snapshotTemplate[] = "%RING%";
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, snapshotTemplate);
+        uint8_t output[32];
+        size_t total = TemplateRenderer::renderNextChunk(ctx, output, 2);
+        ringHead = 8;
+        while (!TemplateRenderer::isComplete(ctx) && !ctx.hasError() && total < sizeof(output)) {
+            total += TemplateRenderer::renderNextChunk(ctx, output + total, 2);
+        }
+        TEST_ASSERT_EQUAL(4, total);
+        TEST_ASSERT_EQUAL_MEMORY("abcd", output, 4);
+    }
+
+    // Overlay bindings and renderPlaceholder serve the same bytes
+    PlaceholderOverlay overlay(&registry);
+    TEST_ASSERT_TRUE(overlay.registerRingBuffer("%RING%", &ringDescriptor));
+    TEST_ASSERT_FALSE(overlay.registerRingBuffer("%BAD%", &noCapacity));
+    setRing("klmnopXXXXabcdef", 10, 6, false);
+    TEST_ASSERT_EQUAL_STRING("[abcdefklmnop]", renderRing(&overlay, 3).c_str());
+
+    uint8_t direct[8];
+    const PlaceholderEntry* entry = registry.getPlaceholder("%RING%");
+    TEST_ASSERT_EQUAL(2, PlaceholderRegistry::renderPlaceholder(entry, 4, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("ef", direct, 2);
+    TEST_ASSERT_EQUAL(4, PlaceholderRegistry::renderPlaceholder(entry, 8, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("mnop", direct, 4);
+    TEST_ASSERT_EQUAL(0, PlaceholderRegistry::renderPlaceholder(entry, 12, direct, sizeof(direct)));
+
+#if !defined(ESP8266)
+    // A writer on another task appends byte by byte and publishes head after each one: every snapshot
+    // covers only bytes that have landed (reads are checked byte by byte so the race detector sees them)
+    static char liveStorage[256];
+    static std::atomic<size_t> liveHead(0);
+    static std::atomic<size_t> liveTail(0);
+    static const RingBufferDescriptor liveDescriptor = {liveStorage, sizeof(liveStorage), &liveHead, &liveTail, nullptr};
+    std::thread writer([]() {
+        for (size_t i = 0; i + 1 < sizeof(liveStorage); ++i) {
+            liveStorage[i] = static_cast<char>('a' + i % 26);
+            liveHead.store(i + 1, std::memory_order_release);
+            std::this_thread::yield();
+        }
+    });
+    RingBufferSnapshot live = {nullptr, 0, nullptr, 0};
+    bool prefix = true;
+    while (live.firstLength + 1 < sizeof(liveStorage) && prefix) {
+        live = PlaceholderRegistry::snapshotRing(&liveDescriptor);
+        for (size_t i = 0; i < live.firstLength && prefix; ++i) {
+            prefix = live.first[i] == static_cast<char>('a' + i % 26);
+        }
+    }
+    writer.join();
+    TEST_ASSERT_TRUE_MESSAGE(prefix, "A snapshot covered a ring byte before it was written");
+    TEST_ASSERT_NULL(live.second);
+#endif
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::ringBuffer("%RING%", &ringDescriptor).type == PlaceholderType::RING_DATA,
+                  "Static registries should accept ring buffers");
+#endif
+}
@@ -0,0 +1,171 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <TemplateEngine.h>
+#include <math.h>
+#include "../utils/test_utils.h"
+
+static String formatted(size_t (*format)(uint32_t, char*), uint32_t value) {
+    char text[TypedValue::MAX_TEXT + 1];
+    text[format(value, text)] = '\0';
+    return String(text);
+}
+
+static String formattedFixed(float value, uint8_t decimals) {
+    char text[TypedValue::MAX_TEXT + 1];
+    text[TypedValue::formatFixed(value, decimals, text)] = '\0';
+    return String(text);
+}
+
+// Test the number formatters against snprintf and at their edges
+void test_typed_value_format() {
+    Serial.println("[TEST]   Testing typed value formatting...");
+
+    char expected[32];
+    char text[TypedValue::MAX_TEXT + 1];
+
+    // Digit-count boundaries and a pseudo-random sweep, signed and unsigned
+    uint32_t values[64] = {0, 9, 10, 99, 100, 999, 1000, 65535, 99999999, 100000000, 999999999, 1000000000, 4294967295u};
+    uint32_t seed = 12345;
+    for (size_t i = 13; i < 64; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = seed >> (i % 24);
+    }
+    for (size_t i = 0; i < 64; ++i) {
+        snprintf(expected, sizeof(expected), "%lu", static_cast<unsigned long>(values[i]));
+        TEST_ASSERT_EQUAL_STRING(expected, formatted(TypedValue::formatUnsigned, values[i]).c_str());
+
+        int32_t signedValue = static_cast<int32_t>(values[i]);
+        snprintf(expected, sizeof(expected), "%ld", static_cast<long>(signedValue));
+        text[TypedValue::formatSigned(signedValue, text)] = '\0';
+        TEST_ASSERT_EQUAL_STRING(expected, text);
+    }
+
+    text[TypedValue::formatSigned(INT32_MIN, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-2147483648", text);
+    text[TypedValue::formatSigned64(INT64_MIN, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-9223372036854775808", text);
+    text[TypedValue::formatSigned64(INT64_MAX, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("9223372036854775807", text);
+    text[TypedValue::formatUnsigned64(4294967296ull, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("4294967296", text);
+    text[TypedValue::formatUnsigned64(1000000000000000000ull, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("1000000000000000000", text);
+
+    // Fixed point: rounding half away from zero, no negative zero, non-finite values
+    TEST_ASSERT_EQUAL_STRING("23.5", formattedFixed(23.46f, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("-1.3", formattedFixed(-1.25f, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.0", formattedFixed(-0.04f, 1).c_str());
+    TEST_ASSERT_EQUAL_STRING("3", formattedFixed(2.5f, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.050000", formattedFixed(0.05f, 6).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.050000", formattedFixed(0.05f, 9).c_str());
+    TEST_ASSERT_EQUAL_STRING("ovf", formattedFixed(1e20f, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("-ovf", formattedFixed(-1e20f, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("inf", formattedFixed(INFINITY, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("-inf", formattedFixed(-INFINITY, 2).c_str());
+    TEST_ASSERT_EQUAL_STRING("nan", formattedFixed(NAN, 2).c_str());
+    for (int i = -2000; i <= 2000; i += 37) {
+        float value = i / 16.0f;  // Exact in binary, so snprintf's rounding cannot disagree
+        snprintf(expected, sizeof(expected), "%.4f", static_cast<double>(value));
+        TEST_ASSERT_EQUAL_STRING(expected, formattedFixed(value, 4).c_str());
+    }
+
+    // IPv4 (as converted from IPAddress) and durations
+    uint32_t address = 192u | (168u << 8) | (1u << 16) | (42u << 24);
+    TEST_ASSERT_EQUAL_STRING("192.168.1.42", formatted(TypedValue::formatIPv4, address).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.0.0.0", formatted(TypedValue::formatIPv4, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("255.255.255.255", formatted(TypedValue::formatIPv4, 0xFFFFFFFFu).c_str());
+    TEST_ASSERT_EQUAL_STRING("00:00:00", formatted(TypedValue::formatDuration, 0).c_str());
+    TEST_ASSERT_EQUAL_STRING("01:01:01", formatted(TypedValue::formatDuration, 3661).c_str());
+    TEST_ASSERT_EQUAL_STRING("100:00:59", formatted(TypedValue::formatDuration, 360059).c_str());
+    TEST_ASSERT_EQUAL_STRING("1193046:28:15", formatted(TypedValue::formatDuration, 4294967295u).c_str());
+
+    Serial.println("[TEST]   Typed value formatting tests completed successfully");
+}
+
+static int64_t readTypedCounter(void* userData) {
+    return ++*static_cast<int64_t*>(userData);
+}
+
+static float readTypedTemperature(void* userData) {
+    (void)userData;
+    return -3.14159f;
+}
+
+// Test TYPED_VALUE placeholders bound to variables and accessors
+void test_typed_value_render() {
+    Serial.println("[TEST]   Testing typed value placeholders...");
+
+    static int32_t rssi = -61;
+    static uint32_t heap = 38112;
+    static int64_t bytesSent = 5000000000ll;
+    static float humidity = 61.25f;
+    static bool online = true;
+    static uint32_t ip = 10u | (0u << 8) | (0u << 16) | (7u << 24);
+    static uint32_t uptime = 93784;
+    static int64_t counter = 0;
+
+    static const TypedValueDescriptor rssiValue = TypedValue::ofInt32(&rssi);
+    static const TypedValueDescriptor heapValue = TypedValue::ofUint32(&heap);
+    static const TypedValueDescriptor sentValue = TypedValue::ofInt64(&bytesSent);
+    static const TypedValueDescriptor humidityValue = TypedValue::ofFixed(&humidity, 1);
+    static const TypedValueDescriptor temperatureValue = TypedValue::ofFixed(readTypedTemperature, 2);
+    static const TypedValueDescriptor onlineValue = TypedValue::ofBool(&online, "online", "offline");
+    static const TypedValueDescriptor ipValue = TypedValue::ofIPv4(&ip);
+    static const TypedValueDescriptor uptimeValue = TypedValue::ofDuration(&uptime);
+    static const TypedValueDescriptor counterValue = TypedValue::ofUint32(readTypedCounter, &counter);
+
+    PlaceholderRegistry registry(12);
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%RSSI%", &rssiValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%HEAP%", &heapValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%SENT%", &sentValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%HUMIDITY%", &humidityValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%TEMP%", &temperatureValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%ONLINE%", &onlineValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%IP%", &ipValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%UPTIME%", &uptimeValue));
+    TEST_ASSERT_TRUE(registry.registerTypedValue("%COUNTER%", &counterValue));
+
+    // Descriptors without a value source, with too many decimals or without bool texts are refused
+    static const TypedValueDescriptor noSource = TypedValue::ofInt32(static_cast<const int32_t*>(nullptr));
+    static const TypedValueDescriptor tooPrecise = TypedValue::ofFixed(&humidity, 7);
+    static const TypedValueDescriptor noTexts = TypedValue::ofBool(&online, nullptr, nullptr);
+    TEST_ASSERT_FALSE(registry.registerTypedValue("%BAD%", nullptr));
+    TEST_ASSERT_FALSE(registry.registerTypedValue("%BAD%", &noSource));
+    TEST_ASSERT_FALSE(registry.registerTypedValue("%BAD%", &tooPrecise));
+    TEST_ASSERT_FALSE(registry.registerTypedValue("%BAD%", &noTexts));
+
+    static const char PROGMEM typedTemplate[] =
+        "%RSSI% dBm|%HEAP%|%SENT%|%HUMIDITY% pct|%TEMP%|%ONLINE%|%IP%|%UPTIME%|%COUNTER%,%COUNTER%";
+    static const size_t CHUNK_SIZES[] = {1, 5, 256};
+    for (size_t c = 0; c < sizeof(CHUNK_SIZES) / sizeof(CHUNK_SIZES[0]); ++c) {
+        counter = 0;
+        TemplateContext ctx;
+        ctx.setRegistry(&registry);
+        TemplateRenderer::initializeContext(ctx, typedTemplate);
+        TEST_ASSERT_EQUAL_STRING("-61 dBm|38112|5000000000|61.3 pct|-3.14|online|10.0.0.7|26:03:04|1,2",
+                                 captureRenderedOutput(ctx, CHUNK_SIZES[c]).c_str());
+        TEST_ASSERT_FALSE(ctx.hasError());
+    }
+
+    // Variables are read at render time
+    rssi = -70;
+    online = false;
+    uptime = 59;
+    static const char PROGMEM changedTemplate[] = "%RSSI%/%ONLINE%/%UPTIME%";
+    TemplateContext ctx;
+    ctx.setRegistry(&registry);
+    TemplateRenderer::initializeContext(ctx, changedTemplate);
+    TEST_ASSERT_EQUAL_STRING("-70/offline/00:00:59", captureRenderedOutput(ctx, 64).c_str());
+
+    // renderPlaceholder serves the same text for callers streaming entries themselves
+    uint8_t direct[8];
+    TEST_ASSERT_EQUAL(5, PlaceholderRegistry::renderPlaceholder(registry.getPlaceholder("%IP%"), 3, direct, sizeof(direct)));
+    TEST_ASSERT_EQUAL_MEMORY("0.0.7", direct, 5);
+
+#if __cplusplus >= 201402L
+    static_assert(dfte::typedValue("%RSSI%", &rssiValue).type == PlaceholderType::TYPED_VALUE,
+                  "Static registries should accept typed values");
+#endif
+
+    Serial.println("[TEST]   Typed value placeholder tests completed successfully");
+}
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""
+DeviceFramework Template Compiler
+Turns a directory of .html templates into generated C++ for the template engine
+
+--format emitter (default)
+    Each template becomes a CompiledTemplate whose emitter is a switch over the cursor resume point:
+    literal runs are copied with memcpy_P straight from flash and every %NAME% token returns its
+    placeholder index to the renderer.
+
+--format tokenized
+    Each template becomes a TokenizedTemplate: literal bytes with every %NAME% token replaced by
+    DFTE_TOKEN_ESCAPE (0x00) and a LEB128 varint id. All templates of one run share a TokenTable,
+    which the registry resolves once into an id -> entry index.
+
+Token rules match the runtime parser, so a template renders the same bytes in every format.
+
+Usage:
+    python tools/dfte_template_compiler.py <template dir or files...> <output base>
+
+    python tools/dfte_template_compiler.py data/templates src/generated/dfte_templates
+      -> src/generated/dfte_templates.h   (extern const CompiledTemplate dfte_tpl_<name>;)
+         src/generated/dfte_templates.cpp
+
+Options:
+    --prefix       Symbol prefix (default: dfte_tpl_)
+    --name-size    DFTE_PLACEHOLDER_NAME_SIZE of the target build (default: 24)
+    --extension    Template file extension when scanning directories (default: .html)
+    --format       emitter | tokenized (default: emitter)
+"""
+
+import argparse
+import os
+import re
+import sys
+
+LINE_WIDTH = 100
+
+
+def scan_template(data, name_size, source):
+    """Split template bytes into ('literal', bytes) and ('token', bytes) items like the runtime parser."""
+    limit = name_size - 1
+    items = []
+    literal = bytearray()
+    pos = 0
+    length = len(data)
+
+    while pos < length:
+        byte = data[pos]
+        if byte != ord('%'):
+            literal.append(byte)
+            pos += 1
+            continue
+
+        token_start = pos
+        pos += 1
+        token_len = 1
+        closed = False
+        while token_len < limit and pos < length:
+            token_len += 1
+            if data[pos] == ord('%'):
+                pos += 1
+                closed = True
+                break
+            pos += 1
+
+        if closed:
+            if literal:
+                items.append(('literal', bytes(literal)))
+                literal = bytearray()
+            items.append(('token', data[token_start:pos]))
+        else:
+            # The renderer drops these bytes too; keep output identical but tell the author
+            reason = 'unterminated' if pos >= length else 'longer than %d bytes' % limit
+            sys.stderr.write('%s: dropping placeholder at offset %d (%s)\n' % (source, token_start, reason))
+
+    if literal:
+        items.append(('literal', bytes(literal)))
+    return items
+
+
+def c_escape_byte(byte):
+    char = chr(byte)
+    if char == '"':
+        return '\\"'
+    if char == '\\':
+        return '\\\\'
+    if char == '?':
+        return '\\?'  # Avoid trigraphs
+    if char == '\n':
+        return '\\n'
+    if char == '\t':
+        return '\\t'
+    if char == '\r':
+        return '\\r'
+    if 0x20 <= byte < 0x7F:
+        return char
+    return '\\%03o' % byte  # Octal escapes never swallow the following character
+
+
+def c_escape(data):
+    return ''.join(c_escape_byte(byte) for byte in data)
+
+
+def c_string_lines(data, indent):
+    """Render bytes as adjacent C string literals, breaking after newlines and at LINE_WIDTH."""
+    lines = []
+    current = ''
+    for byte in data:
+        piece = c_escape_byte(byte)
+        if len(current) + len(piece) > LINE_WIDTH:
+            lines.append(current)
+            current = ''
+        current += piece
+        if byte == ord('\n'):
+            lines.append(current)
+            current = ''
+    if current or not lines:
+        lines.append(current)
+    return '\n'.join('%s"%s"' % (indent, line) for line in lines)
+
+
+def symbol_for(path, root, prefix):
+    relative = os.path.relpath(path, root) if root else os.path.basename(path)
+    stem = os.path.splitext(relative)[0]
+    symbol = re.sub(r'[^A-Za-z0-9_]', '_', stem)
+    return prefix + symbol
+
+
+def generate_template(symbol, items, source):
+    literals = bytearray()
+    names = []
+    steps = []  # ((literal offset, literal length) or None, placeholder index or None)
+    pending_literal = None
+
+    for kind, value in items:
+        if kind == 'literal':
+            pending_literal = (len(literals), len(value))
+            literals += value
+            continue
+        if value not in names:
+            names.append(value)
+        steps.append((pending_literal, names.index(value)))
+        pending_literal = None
+    if pending_literal is not None:
+        steps.append((pending_literal, None))
+
+    out = []
+    out.append('// %s' % source)
+    out.append('static const char %s_text[] PROGMEM =' % symbol)
+    out.append(c_string_lines(bytes(literals), '    ') + ';')
+    for index, name in enumerate(names):
+        out.append('static const char %s_name%d[] PROGMEM = "%s";' % (symbol, index, c_escape(name)))
+    if names:
+        out.append('static const char* const %s_names[] PROGMEM = {' % symbol)
+        for index in range(len(names)):
+            out.append('    %s_name%d,' % (symbol, index))
+        out.append('};')
+    out.append('')
+    out.append('static size_t %s_emit(CompiledTemplateCursor& cursor, uint8_t* buffer, size_t maxLen, int& placeholderIndex) {' % symbol)
+    out.append('    size_t written = 0;')
+    out.append('    placeholderIndex = -1;')
+    if not steps:
+        out.append('    (void)buffer;')
+        out.append('    (void)maxLen;')
+    out.append('    switch (cursor.resumePoint) {')
+    for point, (literal, placeholder) in enumerate(steps):
+        out.append('        case %d:' % point)
+        if literal is not None:
+            offset, length = literal
+            out.append('            if (!dfte::emitCompiledLiteral(cursor, %s_text + %d, %d, buffer, maxLen, written)) {'
+                       % (symbol, offset, length))
+            out.append('                return written;')
+            out.append('            }')
+        if placeholder is not None:
+            if point + 1 < len(steps):
+                out.append('            cursor.resumePoint = %d;' % (point + 1))
+            else:
+                # Tail position: the renderer can reuse this frame for the placeholder
+                out.append('            cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;')
+            name = names[placeholder]
+            comment = '  // ' + name.decode('ascii') if re.match(br'^[ -\[\]-~]*$', name) else ''
+            out.append('            placeholderIndex = %d;%s' % (placeholder, comment))
+            out.append('            return written;')
+        else:
+            out.append('            break;')
+    out.append('        default:')
+    out.append('            break;')
+    out.append('    }')
+    out.append('    cursor.resumePoint = DFTE_COMPILED_TEMPLATE_DONE;')
+    out.append('    return written;')
+    out.append('}')
+    out.append('')
+    out.append('const CompiledTemplate %s = {%s_emit, {%s, %d}};' % (
+        symbol, symbol, '%s_names' % symbol if names else 'nullptr', len(names)))
+    return '\n'.join(out)
+
+
+TOKEN_ESCAPE = 0x00
+
+
+def encode_varint(value):
+    encoded = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            encoded.append(byte | 0x80)
+        else:
+            encoded.append(byte)
+            return bytes(encoded)
+
+
+def generate_tokenized(symbol, items, source, tokens, table_symbol):
+    encoded = bytearray()
+    for kind, value in items:
+        if kind == 'literal':
+            encoded += value
+            continue
+        if value not in tokens:
+            tokens.append(value)
+        encoded.append(TOKEN_ESCAPE)
+        encoded += encode_varint(tokens.index(value))
+
+    out = []
+    out.append('// %s' % source)
+    out.append('static const char %s_data[] PROGMEM =' % symbol)
+    out.append(c_string_lines(bytes(encoded), '    ') + ';')
+    out.append('const TokenizedTemplate %s = {%s_data, %d, &%s};' % (symbol, symbol, len(encoded), table_symbol))
+    return '\n'.join(out)
+
+
+def generate_token_table(table_symbol, tokens):
+    out = []
+    for index, name in enumerate(tokens):
+        out.append('static const char %s_name%d[] PROGMEM = "%s";' % (table_symbol, index, c_escape(name)))
+    if tokens:
+        out.append('static const char* const %s_names[] PROGMEM = {' % table_symbol)
+        for index in range(len(tokens)):
+            out.append('    %s_name%d,' % (table_symbol, index))
+        out.append('};')
+    out.append('const TokenTable %s = {%s, %d};' % (
+        table_symbol, '%s_names' % table_symbol if tokens else 'nullptr', len(tokens)))
+    return '\n'.join(out)
+
+
+def collect_sources(inputs, extension):
+    sources = []
+    for entry in inputs:
+        if os.path.isdir(entry):
+            for directory, _, files in os.walk(entry):
+                for filename in files:
+                    if filename.endswith(extension):
+                        sources.append((os.path.join(directory, filename), entry))
+        else:
+            sources.append((entry, None))
+    return sorted(sources)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compile DFTE templates into generated C++')
+    parser.add_argument('inputs', nargs='+', help='Template directories or files')
+    parser.add_argument('output', help='Output base path (writes <output>.h and <output>.cpp)')
+    parser.add_argument('--prefix', default='dfte_tpl_')
+    parser.add_argument('--name-size', type=int, default=24)
+    parser.add_argument('--extension', default='.html')
+    parser.add_argument('--format', choices=['emitter', 'tokenized'], default='emitter')
+    args = parser.parse_args()
+
+    sources = collect_sources(args.inputs, args.extension)
+    if not sources:
+        sys.stderr.write('No %s templates found\n' % args.extension)
+        return 1
+
+    header_name = os.path.basename(args.output) + '.h'
+    guard = re.sub(r'[^A-Za-z0-9]', '_', header_name).upper()
+    symbols = []
+    bodies = []
+    tokens = []
+    table_symbol = args.prefix + 'tokens'
+    for path, root in sources:
+        symbol = symbol_for(path, root, args.prefix)
+        if symbol in symbols:
+            sys.stderr.write('%s: duplicate symbol %s\n' % (path, symbol))
+            return 1
+        with open(path, 'rb') as handle:
+            data = handle.read()
+        source = os.path.relpath(path, root) if root else os.path.basename(path)
+        symbols.append(symbol)
+        items = scan_template(data, args.name_size, path)
+        if args.format == 'tokenized':
+            bodies.append(generate_tokenized(symbol, items, source, tokens, table_symbol))
+        else:
+            bodies.append(generate_template(symbol, items, source))
+    if args.format == 'tokenized':
+        if len(tokens) > 0xFFFF:
+            sys.stderr.write('Too many distinct placeholders for one token table (%d)\n' % len(tokens))
+            return 1
+        bodies.insert(0, generate_token_table(table_symbol, tokens))
+
+    notice = '// Generated by tools/dfte_template_compiler.py - do not edit'
+    header = [notice, '#ifndef %s' % guard, '#define %s' % guard, '', '#include <TemplateEngine.h>', '']
+    if args.format == 'tokenized':
+        header += ['extern const TokenTable %s;' % table_symbol]
+        header += ['extern const TokenizedTemplate %s;' % symbol for symbol in symbols]
+    else:
+        header += ['extern const CompiledTemplate %s;' % symbol for symbol in symbols]
+    header += ['', '#endif // %s' % guard, '']
+
+    source = [notice, '#include "%s"' % header_name, '']
+    source.append('\n\n'.join(bodies))
+    source.append('')
+
+    output_dir = os.path.dirname(args.output)
+    if output_dir:
+        os.makedirs(output_dir, exist_ok=True)
+    with open(args.output + '.h', 'w', newline='\n') as handle:
+        handle.write('\n'.join(header))
+    with open(args.output + '.cpp', 'w', newline='\n') as handle:
+        handle.write('\n'.join(source))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())